@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/AsyncIO.h"
+#include "Concurrency/WorkContractGroup.h"
+#include "Concurrency/WorkGraph.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace EntropyEngine::Core::Concurrency;
+
+namespace {
+    // Anonymous temp file filled with a known pattern, removed on close
+    struct TempFile {
+        std::FILE* file = std::tmpfile();
+
+        explicit TempFile(size_t size) {
+            std::vector<char> bytes(size);
+            for (size_t i = 0; i < size; ++i) {
+                bytes[i] = static_cast<char>('a' + i % 26);
+            }
+            std::fwrite(bytes.data(), 1, bytes.size(), file);
+            std::fflush(file);
+        }
+
+        ~TempFile() { std::fclose(file); }
+
+        int fd() const { return fileno(file); }
+    };
+
+    // Shared checks, run once per backend
+    void exerciseBackend(const AsyncIO::Config& config) {
+        TempFile temp(4096);
+        WorkContractGroup group(64);
+        AsyncIO io(&group, config);
+
+        WHEN("Many chunks are read with continuations") {
+            constexpr size_t CHUNK = 256;
+            std::vector<std::string> chunks(16, std::string(CHUNK, '\0'));
+            std::atomic<int> continuations{0};
+            std::atomic<int64_t> bytes{0};
+
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                io.read(temp.fd(), chunks[i].data(), CHUNK, i * CHUNK, [&](const AsyncIO::Result& r) {
+                    bytes += r.bytes;
+                    continuations++;
+                });
+            }
+            io.waitIdle();
+            group.executeAllBackgroundWork();
+
+            THEN("Every continuation ran in the group with the right data") {
+                REQUIRE(continuations.load() == 16);
+                REQUIRE(bytes.load() == 4096);
+                REQUIRE(io.getPendingCount() == 0);
+                for (size_t i = 0; i < chunks.size(); ++i) {
+                    REQUIRE(chunks[i][0] == static_cast<char>('a' + (i * CHUNK) % 26));
+                }
+            }
+        }
+
+        WHEN("A write is followed by a read of the same range") {
+            const std::string text = "entropy";
+            auto written = io.write(temp.fd(), text.data(), text.size(), 100);
+            written->wait();
+
+            std::string back(text.size(), '\0');
+            auto read = io.read(temp.fd(), back.data(), back.size(), 100);
+            read->wait();
+
+            THEN("The read sees the written bytes") {
+                REQUIRE(written->getResult().succeeded());
+                REQUIRE(written->getResult().bytes == static_cast<int64_t>(text.size()));
+                REQUIRE(read->isComplete());
+                REQUIRE(back == text);
+            }
+        }
+
+        WHEN("A read targets an invalid descriptor") {
+            char buffer[16];
+            auto op = io.read(-1, buffer, sizeof(buffer), 0);
+            op->wait();
+
+            THEN("The error is reported rather than thrown") {
+                REQUIRE_FALSE(op->getResult().succeeded());
+                REQUIRE(op->getResult().error != 0);
+            }
+        }
+    }
+}
+
+SCENARIO("AsyncIO reads and writes", "[asyncio]") {
+    GIVEN("The blocking thread pool backend") {
+        AsyncIO::Config config;
+        config.forceThreadPool = true;
+        REQUIRE(AsyncIO(nullptr, config).getBackend() == AsyncIO::Backend::ThreadPool);
+        exerciseBackend(config);
+    }
+
+    GIVEN("The default backend with a tiny ring") {
+        AsyncIO::Config config;
+        config.queueDepth = 4;   // Small, so requests overflow into the user-space queue
+        if (AsyncIO::isIoUringAvailable()) {
+            REQUIRE(AsyncIO(nullptr, config).getBackend() == AsyncIO::Backend::IoUring);
+        }
+        exerciseBackend(config);
+    }
+}
+
+SCENARIO("AsyncIO continuations wait for group capacity", "[asyncio]") {
+    GIVEN("A group with room for only two contracts") {
+        TempFile temp(1024);
+        WorkContractGroup group(2);
+        std::atomic<int> continuations{0};
+        char buffer[8][16];
+
+        {
+            AsyncIO io(&group);
+            for (int i = 0; i < 8; ++i) {
+                io.read(temp.fd(), buffer[i], sizeof(buffer[i]), i * 16, [&](const AsyncIO::Result&) {
+                    continuations++;
+                });
+            }
+            io.waitIdle();
+
+            WHEN("The group is drained") {
+                group.executeAllBackgroundWork();
+
+                THEN("Deferred continuations are admitted as slots free up") {
+                    REQUIRE(continuations.load() == 8);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("AsyncIO parks yieldable nodes until their I/O completes", "[asyncio]") {
+    GIVEN("A yieldable node that reads through the thread pool backend") {
+        TempFile temp(1024);
+        WorkContractGroup group(16);
+        AsyncIO::Config config;
+        config.forceThreadPool = true;
+        AsyncIO io(&group, config);
+        WorkGraph graph(&group);
+
+        char buffer[16] = {};
+        std::shared_ptr<AsyncIO::Operation> pending;
+        std::atomic<int> runs{0};
+        graph.addYieldableNode([&]() -> WorkResult {
+            runs++;
+            if (!pending) pending = io.read(temp.fd(), buffer, sizeof(buffer), 0);
+            if (pending->parkUntilComplete()) return WorkResult::Yield;
+            return WorkResult::Complete;
+        }, "load");
+
+        WHEN("The graph runs until the node completes") {
+            graph.execute();
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (!graph.isComplete() && std::chrono::steady_clock::now() < deadline) {
+                group.executeAllBackgroundWork();
+                std::this_thread::yield();
+            }
+
+            THEN("It is re-run once, by the completion, instead of polling") {
+                REQUIRE(graph.isComplete());
+                REQUIRE(runs.load() <= 2);
+                REQUIRE(buffer[0] == 'a');
+            }
+        }
+    }
+
+    GIVEN("Code that is not running inside a yieldable node") {
+        TempFile temp(64);
+        AsyncIO io;
+        char buffer[8];
+        auto op = io.read(temp.fd(), buffer, sizeof(buffer), 0);
+        op->wait();
+
+        THEN("Parking a finished operation is a no-op and parking nothing at all throws") {
+            REQUIRE_FALSE(op->parkUntilComplete());
+            REQUIRE_THROWS_AS(WorkGraph::parkRunningNode(), std::runtime_error);
+        }
+    }
+}
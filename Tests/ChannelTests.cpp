@@ -0,0 +1,311 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Concurrency/Channel.h"
+#include "Concurrency/WorkContractGroup.h"
+#include "Concurrency/WorkService.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace EntropyEngine::Core::Concurrency;
+
+namespace {
+    // The ad-hoc queue Channel replaces, kept here as the benchmark baseline
+    template<typename T>
+    class MutexQueue {
+    public:
+        explicit MutexQueue(size_t capacity) : _capacity(capacity) {}
+
+        void send(T value) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notFull.wait(lock, [&]() { return _items.size() < _capacity; });
+            _items.push_back(std::move(value));
+            _notEmpty.notify_one();
+        }
+
+        T receive() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notEmpty.wait(lock, [&]() { return !_items.empty(); });
+            T value = std::move(_items.front());
+            _items.pop_front();
+            _notFull.notify_one();
+            return value;
+        }
+
+    private:
+        size_t _capacity;
+        std::mutex _mutex;
+        std::condition_variable _notEmpty;
+        std::condition_variable _notFull;
+        std::deque<T> _items;
+    };
+
+    constexpr int PRODUCERS = 2;
+    constexpr int CONSUMERS = 2;
+    constexpr int ITEMS_PER_PRODUCER = 20000;
+
+    // Pushes PRODUCERS * ITEMS_PER_PRODUCER values through send/receive, returns their sum
+    template<typename Queue, typename Receive>
+    int64_t pump(Queue& queue, Receive receiveOne) {
+        std::atomic<int64_t> sum{0};
+        std::vector<std::thread> threads;
+        for (int p = 0; p < PRODUCERS; ++p) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                    queue.send(i);
+                }
+            });
+        }
+        for (int c = 0; c < CONSUMERS; ++c) {
+            threads.emplace_back([&]() {
+                int64_t local = 0;
+                for (int i = 0; i < PRODUCERS * ITEMS_PER_PRODUCER / CONSUMERS; ++i) {
+                    local += receiveOne(queue);
+                }
+                sum += local;
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        return sum.load();
+    }
+
+    constexpr int64_t EXPECTED_SUM = int64_t(PRODUCERS) * ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER - 1) / 2;
+}
+
+SCENARIO("Channel non-blocking operations", "[channel]") {
+    GIVEN("A channel of capacity 3") {
+        Channel<std::unique_ptr<int>> channel(3);
+
+        THEN("Capacity is rounded up to a power of two") {
+            REQUIRE(channel.capacity() == 4);
+            REQUIRE(channel.empty());
+        }
+
+        WHEN("It is filled past capacity") {
+            int accepted = 0;
+            for (int i = 0; i < 6; ++i) {
+                if (channel.trySend(std::make_unique<int>(i))) {
+                    accepted++;
+                }
+            }
+
+            THEN("Extra sends are refused and receives come out in order") {
+                REQUIRE(accepted == 4);
+                REQUIRE(channel.size() == 4);
+                for (int i = 0; i < 4; ++i) {
+                    auto value = channel.tryReceive();
+                    REQUIRE(value.has_value());
+                    REQUIRE(**value == i);
+                }
+                REQUIRE_FALSE(channel.tryReceive().has_value());
+            }
+        }
+
+        WHEN("The channel is closed with an element buffered") {
+            REQUIRE(channel.trySend(std::make_unique<int>(7)));
+            channel.close();
+
+            THEN("Sends fail but the buffered element is still delivered") {
+                REQUIRE_FALSE(channel.trySend(std::make_unique<int>(8)));
+                auto value = channel.receive();
+                REQUIRE(value.has_value());
+                REQUIRE(**value == 7);
+                REQUIRE_FALSE(channel.receive().has_value());
+            }
+        }
+    }
+}
+
+SCENARIO("Channel blocking operations across threads", "[channel]") {
+    GIVEN("A small channel shared by producer and consumer threads") {
+        Channel<int> channel(16);
+
+        WHEN("Producers send more than the channel can hold") {
+            int64_t sum = pump(channel, [](Channel<int>& c) { return *c.receive(); });
+
+            THEN("Every element arrives exactly once") {
+                REQUIRE(sum == EXPECTED_SUM);
+                REQUIRE(channel.empty());
+            }
+        }
+    }
+
+    GIVEN("A single worker and a producer contract that outruns the channel") {
+        WorkService::Config config;
+        config.threadCount = 1;
+        WorkService service(config);
+        WorkContractGroup group(64);
+        service.addWorkContractGroup(&group);
+        service.start();
+
+        Channel<int> channel(4, &group);
+        std::atomic<int> received{0};
+
+        WHEN("The consumer is a contract queued behind the producer") {
+            channel.setConsumer(&group, [&](Channel<int>& c) {
+                while (c.tryReceive()) {
+                    received++;
+                }
+            });
+            auto producer = group.createContract([&]() {
+                for (int i = 0; i < 100; ++i) {
+                    channel.send(i);   // Helps run the consumer when full
+                }
+            });
+            producer.schedule();
+            group.wait();
+            channel.clearConsumer();
+
+            THEN("The blocked send runs the consumer instead of deadlocking") {
+                REQUIRE(received.load() == 100);
+            }
+        }
+
+        service.stop();
+    }
+}
+
+SCENARIO("Channel consumer contracts", "[channel]") {
+    GIVEN("A channel with a consumer registered on a group") {
+        WorkContractGroup group(2);
+        Channel<int> channel(64);
+        std::vector<int> seen;
+        std::atomic<int> runs{0};
+
+        REQUIRE(channel.trySend(-1));   // Sent before the consumer exists
+        channel.setConsumer(&group, [&](Channel<int>& c) {
+            runs++;
+            while (auto value = c.tryReceive()) {
+                seen.push_back(*value);
+            }
+        });
+
+        WHEN("Many elements are sent before the group is drained") {
+            for (int i = 0; i < 20; ++i) {
+                REQUIRE(channel.trySend(i));
+            }
+            group.executeAllBackgroundWork();
+
+            THEN("One consumer run picks everything up in order") {
+                REQUIRE(runs.load() == 1);
+                REQUIRE(seen.size() == 21);
+                REQUIRE(seen.front() == -1);
+                REQUIRE(seen.back() == 19);
+            }
+        }
+
+        WHEN("Elements are sent after each drain") {
+            group.executeAllBackgroundWork();
+            REQUIRE(channel.trySend(1));
+            group.executeAllBackgroundWork();
+            REQUIRE(channel.trySend(2));
+            group.executeAllBackgroundWork();
+
+            THEN("A new consumer run is scheduled each time data arrives") {
+                REQUIRE(runs.load() == 3);
+                REQUIRE(seen == std::vector<int>{-1, 1, 2});
+            }
+        }
+
+        WHEN("The group is full when data arrives") {
+            group.executeAllBackgroundWork();
+            auto first = group.createContract([]() {});
+            auto second = group.createContract([]() {});
+            REQUIRE(channel.trySend(7));
+            REQUIRE(group.waitingAdmissionCount() == 1);
+
+            AND_WHEN("A slot frees up") {
+                first.release();
+                group.executeAllBackgroundWork();
+
+                THEN("The deferred consumer runs on its admission turn") {
+                    REQUIRE(runs.load() == 2);
+                    REQUIRE(seen == std::vector<int>{-1, 7});
+                    REQUIRE(group.waitingAdmissionCount() == 0);
+                }
+            }
+
+            AND_WHEN("The consumer is replaced before a slot frees up") {
+                std::atomic<int> replacementRuns{0};
+                channel.setConsumer(&group, [&](Channel<int>& c) {
+                    replacementRuns++;
+                    while (c.tryReceive()) {
+                    }
+                });
+                first.release();
+                group.executeAllBackgroundWork();
+                REQUIRE(channel.trySend(8));
+                group.executeAllBackgroundWork();
+
+                THEN("The replacement is not locked out by the dropped deferral") {
+                    REQUIRE(runs.load() == 1);
+                    REQUIRE(replacementRuns.load() >= 1);
+                    REQUIRE(channel.empty());
+                }
+            }
+        }
+
+        WHEN("The consumer is cleared while it runs on another thread") {
+            std::atomic<bool> entered{false};
+            std::atomic<bool> release{false};
+            std::atomic<bool> returned{false};
+            channel.setConsumer(&group, [&](Channel<int>& c) {
+                entered = true;
+                while (!release) {
+                    std::this_thread::yield();
+                }
+                while (c.tryReceive()) {
+                }
+                returned = true;
+            });
+            std::thread worker([&]() { group.executeAllBackgroundWork(); });
+            while (!entered) {
+                std::this_thread::yield();
+            }
+            std::thread releaser([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                release = true;
+            });
+            channel.clearConsumer();
+            bool returnedBeforeClear = returned.load();
+            worker.join();
+            releaser.join();
+
+            THEN("clearConsumer waits for the call to return") {
+                REQUIRE(returnedBeforeClear);
+            }
+        }
+
+        WHEN("The consumer is cleared") {
+            group.executeAllBackgroundWork();
+            channel.clearConsumer();
+            REQUIRE(channel.trySend(5));
+            group.executeAllBackgroundWork();
+
+            THEN("No further runs are scheduled") {
+                REQUIRE(runs.load() == 1);
+                REQUIRE(channel.size() == 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("Channel throughput versus mutex queue", "[benchmark][channel]") {
+    BENCHMARK("Channel<int> 2x2 threads") {
+        Channel<int> channel(1024);
+        return pump(channel, [](Channel<int>& c) { return *c.receive(); });
+    };
+
+    BENCHMARK("Mutex + condvar queue 2x2 threads") {
+        MutexQueue<int> queue(1024);
+        return pump(queue, [](MutexQueue<int>& q) { return q.receive(); });
+    };
+}
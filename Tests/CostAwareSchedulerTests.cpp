@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/CostAwareScheduler.h"
+#include "Concurrency/AdaptiveRankingScheduler.h"
+#include "Concurrency/WorkService.h"
+#include "Concurrency/WorkContractGroup.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace EntropyEngine::Core::Concurrency;
+using namespace std::chrono_literals;
+
+namespace {
+    void scheduleWork(WorkContractGroup& group, size_t count, std::chrono::microseconds duration) {
+        for (size_t i = 0; i < count; ++i) {
+            group.createContract([duration]() {
+                if (duration.count() > 0) {
+                    std::this_thread::sleep_for(duration);
+                }
+            }).schedule();
+        }
+    }
+}
+
+SCENARIO("WorkContractGroup samples contract durations", "[scheduler][costaware]") {
+    GIVEN("A group that has not run anything") {
+        WorkContractGroup group(64, "Sampled");
+
+        THEN("It has no estimate") {
+            REQUIRE(group.averageContractDuration().count() == 0);
+        }
+
+        WHEN("A slow contract runs") {
+            scheduleWork(group, 1, 2000us);
+            group.executeAllBackgroundWork();
+
+            THEN("The first contract seeds the estimate") {
+                REQUIRE(group.averageContractDuration() >= 2ms);
+            }
+
+            AND_WHEN("Many fast contracts follow") {
+                for (int round = 0; round < 8; ++round) {
+                    scheduleWork(group, 32, 0us);
+                    group.executeAllBackgroundWork();
+                }
+
+                THEN("The average decays toward the new cost") {
+                    REQUIRE(group.averageContractDuration() < 1ms);
+                    REQUIRE(group.averageContractDuration().count() > 0);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("CostAwareScheduler ranks by estimated remaining work", "[scheduler][costaware]") {
+    GIVEN("A group of few slow contracts and a group of many fast ones") {
+        IWorkScheduler::Config config;
+        config.threadCount = 4;
+        CostAwareScheduler scheduler(config);
+
+        WorkContractGroup slow(64, "Slow");
+        WorkContractGroup fast(256, "Fast");
+        scheduleWork(slow, 1, 5000us);
+        slow.executeAllBackgroundWork();
+        scheduleWork(fast, 1, 0us);
+        fast.executeAllBackgroundWork();
+
+        scheduleWork(slow, 2, 5000us);
+        scheduleWork(fast, 100, 0us);
+        std::vector<WorkContractGroup*> groups{&fast, &slow};
+        scheduler.notifyGroupsChanged(groups);
+
+        THEN("The slow group is picked although it holds fewer contracts") {
+            auto result = scheduler.selectNextGroup(groups, {});
+            REQUIRE(result.group == &slow);
+            REQUIRE(CostAwareScheduler::estimateRemainingWork(&slow, 1.0) >
+                    CostAwareScheduler::estimateRemainingWork(&fast, 1.0));
+        }
+
+        THEN("A count-based ranking would have picked the fast group") {
+            AdaptiveRankingScheduler adaptive(config);
+            REQUIRE(adaptive.selectNextGroup(groups, {}).group == &fast);
+        }
+
+        WHEN("The slow group runs dry") {
+            slow.executeAllBackgroundWork();
+
+            THEN("The fast group is picked next") {
+                REQUIRE(scheduler.selectNextGroup(groups, {}).group == &fast);
+            }
+        }
+
+        fast.executeAllBackgroundWork();
+        slow.executeAllBackgroundWork();
+    }
+
+    GIVEN("No group with work") {
+        IWorkScheduler::Config config;
+        CostAwareScheduler scheduler(config);
+        WorkContractGroup idle(16, "Idle");
+
+        THEN("The worker is told to sleep") {
+            auto result = scheduler.selectNextGroup({&idle}, {});
+            REQUIRE(result.group == nullptr);
+            REQUIRE(result.shouldSleep);
+        }
+    }
+}
+
+SCENARIO("CostAwareScheduler drives a WorkService", "[scheduler][costaware][workservice]") {
+    GIVEN("A service with heterogeneous groups") {
+        WorkService::Config serviceConfig;
+        serviceConfig.threadCount = 4;
+        IWorkScheduler::Config config;
+        config.threadCount = 4;
+        WorkService service(serviceConfig, std::make_unique<CostAwareScheduler>(config));
+
+        WorkContractGroup slow(64, "Slow");
+        WorkContractGroup fast(1024, "Fast");
+        service.addWorkContractGroup(&slow);
+        service.addWorkContractGroup(&fast);
+        service.start();
+
+        WHEN("Both groups are given work") {
+            std::atomic<size_t> executed{0};
+            for (int i = 0; i < 8; ++i) {
+                slow.createContract([&executed]() {
+                    std::this_thread::sleep_for(1ms);
+                    executed.fetch_add(1);
+                }).schedule();
+            }
+            for (int i = 0; i < 500; ++i) {
+                fast.createContract([&executed]() { executed.fetch_add(1); }).schedule();
+            }
+
+            THEN("All of it runs") {
+                slow.wait();
+                fast.wait();
+                REQUIRE(executed.load() == 508);
+            }
+        }
+
+        service.stop();
+        service.removeWorkContractGroup(&slow);
+        service.removeWorkContractGroup(&fast);
+    }
+}
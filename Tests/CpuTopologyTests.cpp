@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/CpuTopology.h"
+#include "Concurrency/WorkService.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace EntropyEngine::Core::Concurrency;
+namespace fs = std::filesystem;
+
+namespace {
+    // Builds a throwaway /proc + /sys tree that discovery can be pointed at
+    class FakeSystem {
+    public:
+        FakeSystem() {
+            _root = fs::temp_directory_path() / ("entropy-topology-" + std::to_string(reinterpret_cast<uintptr_t>(this)));
+            fs::remove_all(_root);
+        }
+        ~FakeSystem() { fs::remove_all(_root); }
+
+        void write(const std::string& relative, const std::string& contents) {
+            fs::path path = _root / relative;
+            fs::create_directories(path.parent_path());
+            std::ofstream(path) << contents << "\n";
+        }
+
+        // Two packages of two cores, each core with two SMT threads; one L3 per package
+        void addTwoSocketLayout() {
+            for (uint32_t cpu = 0; cpu < 8; ++cpu) {
+                uint32_t package = cpu / 4;
+                uint32_t core = (cpu % 4) / 2;
+                uint32_t firstSibling = package * 4 + core * 2;
+                std::string base = "sys/devices/system/cpu/cpu" + std::to_string(cpu);
+                write(base + "/topology/physical_package_id", std::to_string(package));
+                write(base + "/topology/core_cpus_list",
+                      std::to_string(firstSibling) + "-" + std::to_string(firstSibling + 1));
+                write(base + "/cache/index2/level", "2");
+                write(base + "/cache/index2/type", "Unified");
+                write(base + "/cache/index2/shared_cpu_list",
+                      std::to_string(firstSibling) + "-" + std::to_string(firstSibling + 1));
+                write(base + "/cache/index3/level", "3");
+                write(base + "/cache/index3/type", "Unified");
+                write(base + "/cache/index3/shared_cpu_list",
+                      std::to_string(package * 4) + "-" + std::to_string(package * 4 + 3));
+            }
+        }
+
+        CpuTopology::Sources sources(std::vector<uint32_t> allowed) const {
+            CpuTopology::Sources sources;
+            sources.procRoot = (_root / "proc").string();
+            sources.sysRoot = (_root / "sys").string();
+            sources.allowedCpus = std::move(allowed);
+            return sources;
+        }
+
+    private:
+        fs::path _root;
+    };
+}
+
+SCENARIO("CpuTopology reads cgroup CPU quotas", "[topology]") {
+    GIVEN("A cgroup v2 hierarchy with a quota on the parent") {
+        FakeSystem system;
+        system.write("proc/self/cgroup", "0::/app/worker");
+        system.write("sys/fs/cgroup/app/cpu.max", "250000 100000");
+        system.write("sys/fs/cgroup/app/worker/cpu.max", "max 100000");
+
+        auto topology = CpuTopology::discover(system.sources({0, 1, 2, 3, 4, 5, 6, 7}));
+
+        THEN("The inherited quota limits the worker count") {
+            REQUIRE(topology.getCpuQuota() == 2.5);
+            REQUIRE(topology.getRecommendedWorkerCount() == 3);
+        }
+    }
+
+    GIVEN("A container whose recorded cgroup path is not mounted") {
+        FakeSystem system;
+        system.write("proc/self/cgroup", "0::/host/slice/container");
+        system.write("sys/fs/cgroup/cpu.max", "100000 100000");
+
+        THEN("The mount root is used as the process's own cgroup") {
+            auto topology = CpuTopology::discover(system.sources({0, 1, 2, 3}));
+            REQUIRE(topology.getRecommendedWorkerCount() == 1);
+        }
+    }
+
+    GIVEN("A cgroup v1 cpu controller") {
+        FakeSystem system;
+        system.write("proc/self/cgroup", "4:cpu,cpuacct:/job\n3:memory:/job");
+        system.write("sys/fs/cgroup/cpu,cpuacct/job/cpu.cfs_quota_us", "400000");
+        system.write("sys/fs/cgroup/cpu,cpuacct/job/cpu.cfs_period_us", "100000");
+
+        THEN("quota / period is used") {
+            auto topology = CpuTopology::discover(system.sources({0, 1, 2, 3, 4, 5, 6, 7}));
+            REQUIRE(topology.getCpuQuota() == 4.0);
+            REQUIRE(topology.getRecommendedWorkerCount() == 4);
+        }
+    }
+
+    GIVEN("No quota at all") {
+        FakeSystem system;
+        system.write("proc/self/cgroup", "0::/");
+        system.write("sys/fs/cgroup/cpu.max", "max 100000");
+
+        THEN("The affinity mask alone decides") {
+            auto topology = CpuTopology::discover(system.sources({2, 3, 5}));
+            REQUIRE(topology.getCpuQuota() == 0.0);
+            REQUIRE(topology.getRecommendedWorkerCount() == 3);
+        }
+    }
+}
+
+SCENARIO("CpuTopology reads core and cache layout", "[topology]") {
+    GIVEN("A two-socket machine with SMT") {
+        FakeSystem system;
+        system.addTwoSocketLayout();
+        auto topology = CpuTopology::discover(system.sources({0, 1, 2, 3, 4, 5, 6, 7}));
+
+        THEN("Cores and packages are counted") {
+            REQUIRE(topology.getCpus().size() == 8);
+            REQUIRE(topology.getCoreCount() == 4);
+            REQUIRE(topology.getPackageCount() == 2);
+        }
+
+        WHEN("Four workers are planned") {
+            auto locality = topology.planWorkers(4);
+
+            THEN("Each gets its own physical core, neighbours grouped by L3") {
+                REQUIRE(locality.cpus == std::vector<uint32_t>{0, 2, 4, 6});
+                REQUIRE(locality.sharesCache(0, 1, CacheLevel::L3));
+                REQUIRE_FALSE(locality.sharesCache(1, 2, CacheLevel::L3));
+                REQUIRE_FALSE(locality.sharesCache(0, 1, CacheLevel::L2));
+            }
+        }
+
+        WHEN("Eight workers are planned") {
+            auto locality = topology.planWorkers(8);
+
+            THEN("SMT siblings are used last and share L2 with their core's first worker") {
+                REQUIRE(locality.cpus[4] == 1);
+                REQUIRE(locality.sharesCache(0, 4, CacheLevel::L2));
+                REQUIRE(locality.getNeighbours(0, CacheLevel::L3) == std::vector<size_t>{1, 4, 5});
+            }
+        }
+    }
+
+    GIVEN("A system without sysfs topology") {
+        FakeSystem system;
+        auto topology = CpuTopology::discover(system.sources({0, 1, 2}));
+
+        THEN("Every CPU is its own core sharing a single L3") {
+            REQUIRE(topology.getCoreCount() == 3);
+            auto locality = topology.planWorkers(3);
+            REQUIRE(locality.sharesCache(0, 2, CacheLevel::L3));
+            REQUIRE_FALSE(locality.sharesCache(0, 2, CacheLevel::L2));
+        }
+    }
+}
+
+SCENARIO("WorkService sizes itself from the topology", "[topology][workservice]") {
+    GIVEN("A service with the default thread count") {
+        WorkService::Config config;
+        WorkService service(config);
+
+        THEN("It runs one worker per usable CPU and publishes their placement") {
+            REQUIRE(service.getThreadCount() == CpuTopology::get().getRecommendedWorkerCount());
+            REQUIRE(service.getWorkerLocality().size() == service.getThreadCount());
+        }
+    }
+}
@@ -0,0 +1,218 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/FiberWorker.h"
+#include "Concurrency/WorkService.h"
+#include "Concurrency/WorkContractGroup.h"
+#include "Concurrency/WorkGraph.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace EntropyEngine::Core::Concurrency;
+
+namespace {
+    thread_local void* tlTestLocal = nullptr;
+
+    const bool tlTestLocalRegistered = FiberWorker::registerFiberLocal({
+        []() -> void* { return tlTestLocal; },
+        [](void* value) { tlTestLocal = value; }
+    });
+}
+
+#if ENTROPY_FIBERS_SUPPORTED
+
+SCENARIO("FiberWorker suspension", "[fiber]") {
+    GIVEN("A fiber worker on this thread") {
+        FiberWorker fibers(64 * 1024, 4);
+        std::atomic<bool> gate{false};
+        std::vector<std::string> trace;
+
+        WHEN("A fiber waits on a condition another fiber satisfies") {
+            fibers.execute([&]() {
+                trace.push_back("waiter start");
+                FiberWorker::suspendUntil([&]() { return gate.load(); });
+                trace.push_back("waiter resumed");
+            });
+            fibers.execute([&]() {
+                trace.push_back("opener");
+                gate = true;
+            });
+            size_t resumed = fibers.resumeReady();
+
+            THEN("The first fiber parks and resumes after the second runs") {
+                REQUIRE(resumed == 1);
+                REQUIRE(trace == std::vector<std::string>{"waiter start", "opener", "waiter resumed"});
+                REQUIRE(fibers.getSuspendedCount() == 0);
+                REQUIRE(fibers.getFiberCount() == 2);
+            }
+        }
+
+        WHEN("Interleaved fibers use a registered fiber-local") {
+            REQUIRE(tlTestLocalRegistered);
+            int first = 1;
+            int second = 2;
+            void* seenByFirst = nullptr;
+            std::atomic<bool> release{false};
+
+            fibers.execute([&]() {
+                tlTestLocal = &first;
+                FiberWorker::suspendUntil([&]() { return gate.load(); });
+                seenByFirst = tlTestLocal;
+            });
+            fibers.execute([&]() {
+                tlTestLocal = &second;
+                gate = true;
+                FiberWorker::suspendUntil([&]() { return release.load(); });
+            });
+            fibers.resumeReady();
+
+            THEN("Each fiber keeps its own value and the thread's is untouched") {
+                REQUIRE(seenByFirst == &first);
+                REQUIRE(tlTestLocal == nullptr);
+                REQUIRE(fibers.getSuspendedCount() == 1);
+            }
+
+            // Let the parked fiber finish so the worker can be torn down cleanly
+            release = true;
+            fibers.resumeReady();
+        }
+
+        WHEN("A fiber throws and catches across a suspension") {
+            double scale = 1.5;
+            double product = 0;
+            bool caught = false;
+            fibers.execute([&]() {
+                double local = std::sqrt(scale * 4.0);
+                FiberWorker::suspendUntil([&]() { return gate.load(); });
+                try {
+                    throw std::runtime_error("unwinds on the fiber stack");
+                } catch (const std::runtime_error&) {
+                    caught = true;
+                }
+                product = local * scale;
+            });
+            gate = true;
+            fibers.resumeReady();
+
+            THEN("Registers, FP state and unwinding survive the switches") {
+                REQUIRE(caught);
+                REQUIRE(product == std::sqrt(6.0) * 1.5);
+                REQUIRE(fibers.getSuspendedCount() == 0);
+            }
+        }
+
+        WHEN("Finished fibers are reused") {
+            for (int i = 0; i < 10; ++i) {
+                fibers.execute([]() {});
+            }
+
+            THEN("Only one stack was ever allocated") {
+                REQUIRE(fibers.getFiberCount() == 1);
+                REQUIRE(fibers.canStart());
+            }
+        }
+    }
+
+    GIVEN("Code not running on a fiber") {
+        THEN("suspendUntil declines so callers block normally") {
+            REQUIRE_FALSE(FiberWorker::isOnFiber());
+            REQUIRE_FALSE(FiberWorker::suspendUntil([]() { return true; }));
+        }
+    }
+}
+
+SCENARIO("WorkService fiber mode", "[fiber][workservice]") {
+    GIVEN("A single worker running contracts on fibers") {
+        WorkService::Config config;
+        config.threadCount = 1;
+        config.useFibers = true;
+        WorkService service(config);
+        WorkContractGroup group(64);
+        service.addWorkContractGroup(&group);
+        service.start();
+
+        WHEN("A contract waits on a graph whose nodes need the same worker") {
+            std::atomic<int> innerRan{0};
+            std::atomic<bool> outerDone{false};
+
+            auto outer = group.createContract([&]() {
+                WorkGraph inner(&group);
+                auto a = inner.addNode([&]() { innerRan++; }, "a");
+                auto b = inner.addNode([&]() { innerRan++; }, "b");
+                inner.addDependency(a, b);
+                inner.execute();
+                inner.wait();  // Would park the only worker forever without fibers
+                outerDone = true;
+            });
+            outer.schedule();
+            group.wait();
+
+            THEN("The wait suspends and the worker runs the inner nodes") {
+                REQUIRE(outerDone.load());
+                REQUIRE(innerRan.load() == 2);
+            }
+        }
+
+        WHEN("A fiber waits on a flag that is set from outside") {
+            std::atomic<bool> flag{false};
+            std::atomic<bool> done{false};
+            auto waiter = group.createContract([&]() {
+                FiberWorker::suspendUntil([&]() { return flag.load(); });
+                done = true;
+            });
+            waiter.schedule();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            auto before = service.getWorkerStats();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            auto after = service.getWorkerStats();
+
+            flag = true;
+            FiberWorker::notifyResumable();
+            group.wait();
+
+            THEN("The idle worker sleeps instead of polling, and wakes on notifyResumable") {
+                REQUIRE(after[0].selectionFailures - before[0].selectionFailures < 100);
+                REQUIRE(done.load());
+            }
+        }
+
+        service.stop();
+    }
+
+    GIVEN("A fiber that will never be resumed") {
+        WorkService::Config config;
+        config.threadCount = 1;
+        config.useFibers = true;
+        config.fiberStopTimeout = 20;
+        WorkService service(config);
+        WorkContractGroup group(64);
+        service.addWorkContractGroup(&group);
+        service.start();
+
+        auto stuck = group.createContract([]() {
+            FiberWorker::suspendUntil([]() { return false; });
+        });
+        stuck.schedule();
+        while (group.executingCount() == 0) {
+            std::this_thread::yield();
+        }
+
+        WHEN("The service stops") {
+            auto start = std::chrono::steady_clock::now();
+            service.stop();
+            auto elapsed = std::chrono::steady_clock::now() - start;
+
+            THEN("The suspended fiber is abandoned after the grace period and its slot freed") {
+                REQUIRE(elapsed < std::chrono::seconds(5));
+                REQUIRE(group.executingCount() == 0);
+            }
+        }
+
+        service.removeWorkContractGroup(&group);
+    }
+}
+
+#endif
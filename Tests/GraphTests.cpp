@@ -293,4 +293,21 @@ TEST_CASE("DirectedAcyclicGraph edge cases", "[graph][dag]") {
         auto sorted = graph.topologicalSort();
         REQUIRE(sorted.size() == nodeCount);
     }
-}
\ No newline at end of file
+    
+    SECTION("Data pointers survive growth") {
+        DirectedAcyclicGraph<TestNode> graph;
+        auto first = graph.addNode(TestNode{"first", 0});
+        TestNode* firstData = graph.getNodeData(first);
+        graph.reserve(16);
+        
+        std::vector<AcyclicNodeHandle<TestNode>> nodes;
+        for (int i = 1; i <= 5000; ++i) {
+            nodes.push_back(graph.addNode(TestNode{std::to_string(i), i}));
+        }
+        
+        // Storage grew through many chunks without moving the first node
+        REQUIRE(graph.getNodeData(first) == firstData);
+        REQUIRE(firstData->name == "first");
+        REQUIRE(graph.getNodeData(nodes.back())->value == 5000);
+    }
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Concurrency/HugePageAllocator.h"
+#include "Concurrency/WorkContractGroup.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace EntropyEngine::Core::Concurrency;
+
+namespace {
+    // Creates `count` contracts, schedules them in random slot order and drains the group
+    size_t scatterAndDrain(WorkContractGroup& group, size_t count, std::mt19937& rng) {
+        std::vector<WorkContractHandle> handles;
+        handles.reserve(count);
+        std::atomic<size_t> executed{0};
+        for (size_t i = 0; i < count; ++i) {
+            handles.push_back(group.createContract([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }));
+        }
+        std::shuffle(handles.begin(), handles.end(), rng);
+        for (auto& handle : handles) {
+            handle.schedule();
+        }
+        group.executeAllBackgroundWork();
+        return executed.load();
+    }
+}
+
+SCENARIO("HugePageAllocator backing", "[hugepages]") {
+    GIVEN("A transparent huge page allocator") {
+        HugePageAllocator<uint64_t> allocator(PageAllocationPolicy::TransparentHugePages);
+        const size_t hugePage = HugePageMemory::hugePageSize();
+
+        WHEN("An allocation smaller than a huge page is made") {
+            auto before = HugePageMemory::getStats();
+            uint64_t* small = allocator.allocate(64);
+            small[63] = 1;
+            allocator.deallocate(small, 64);
+
+            THEN("It comes from the heap") {
+                REQUIRE(HugePageMemory::getStats().heapFallbacks == before.heapFallbacks + 1);
+            }
+        }
+
+        WHEN("An allocation of several huge pages is made") {
+            const size_t count = (3 * hugePage) / sizeof(uint64_t) + 1;
+            uint64_t* large = allocator.allocate(count);
+            large[0] = 1;
+            large[count - 1] = 2;
+
+            THEN("It is usable across its whole range") {
+                REQUIRE(large[0] == 1);
+                REQUIRE(large[count - 1] == 2);
+#if defined(EntropyLinux)
+                REQUIRE(reinterpret_cast<uintptr_t>(large) % hugePage == 0);
+#endif
+            }
+            allocator.deallocate(large, count);
+        }
+    }
+
+    GIVEN("An explicit huge page allocator") {
+        HugePageAllocator<uint64_t> allocator(PageAllocationPolicy::ExplicitHugePages);
+        const size_t count = (2 * HugePageMemory::hugePageSize()) / sizeof(uint64_t);
+
+        THEN("It succeeds whether or not the hugetlb pool is configured") {
+            auto before = HugePageMemory::getStats();
+            uint64_t* memory = allocator.allocate(count);
+            std::fill(memory, memory + count, 7u);
+            REQUIRE(memory[count - 1] == 7);
+            allocator.deallocate(memory, count);
+#if defined(EntropyLinux)
+            auto after = HugePageMemory::getStats();
+            REQUIRE(after.explicitMappings + after.transparentMappings ==
+                    before.explicitMappings + before.transparentMappings + 1);
+#endif
+        }
+    }
+
+    GIVEN("Allocators with different policies") {
+        THEN("They only compare equal when the policy matches") {
+            HugePageAllocator<int> heap;
+            HugePageAllocator<int> thp(PageAllocationPolicy::TransparentHugePages);
+            HugePageAllocator<double> rebound(thp);
+            REQUIRE_FALSE(heap == thp);
+            REQUIRE(thp == rebound);
+        }
+    }
+}
+
+SCENARIO("Large WorkContractGroups on huge pages", "[hugepages][workcontract]") {
+    GIVEN("A group of 2^17 contracts backed by transparent huge pages") {
+        WorkContractGroup group(1 << 17, "HugeGroup", PageAllocationPolicy::TransparentHugePages);
+        std::mt19937 rng(17);
+
+        THEN("Contracts scheduled in random order all run") {
+            REQUIRE(scatterAndDrain(group, 1 << 16, rng) == (1 << 16));
+            REQUIRE(group.activeCount() == 0);
+        }
+    }
+}
+
+// Run under `perf stat -e dTLB-load-misses,dTLB-loads` with the two benchmark names as
+// filters to compare TLB behaviour; Catch2 itself only reports wall time.
+TEST_CASE("Random select/complete on large groups", "[benchmark][hugepages]") {
+    constexpr size_t CAPACITY = 1 << 18;
+    constexpr size_t BATCH = CAPACITY / 2;
+    std::mt19937 rng(42);
+
+    WorkContractGroup heapGroup(CAPACITY, "HeapGroup");
+    BENCHMARK("4 KiB pages, 2^18 slots") {
+        return scatterAndDrain(heapGroup, BATCH, rng);
+    };
+
+    WorkContractGroup hugeGroup(CAPACITY, "HugeGroup", PageAllocationPolicy::TransparentHugePages);
+    BENCHMARK("Transparent huge pages, 2^18 slots") {
+        return scatterAndDrain(hugeGroup, BATCH, rng);
+    };
+}
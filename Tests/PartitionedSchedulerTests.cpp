@@ -0,0 +1,175 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/PartitionedScheduler.h"
+#include "Concurrency/WorkService.h"
+#include "Concurrency/WorkContractGroup.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace EntropyEngine::Core::Concurrency;
+using namespace std::chrono_literals;
+
+namespace {
+    IWorkScheduler::SchedulingContext worker(size_t threadId) {
+        IWorkScheduler::SchedulingContext context;
+        context.threadId = threadId;
+        return context;
+    }
+
+    void scheduleWork(WorkContractGroup& group, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            group.createContract([]() {}).schedule();
+        }
+    }
+}
+
+SCENARIO("PartitionedScheduler keeps groups on their partition", "[scheduler][partitioned]") {
+    GIVEN("Four workers split into two partitions and two groups") {
+        IWorkScheduler::Config config;
+        config.threadCount = 4;
+        PartitionedScheduler::Options options;
+        options.partitionCount = 2;
+        PartitionedScheduler scheduler(config, options);
+
+        WorkContractGroup first(64, "First");
+        WorkContractGroup second(64, "Second");
+        std::vector<WorkContractGroup*> groups{&first, &second};
+        scheduler.notifyGroupsChanged(groups);
+
+        THEN("Workers and groups are spread over both partitions") {
+            REQUIRE(scheduler.getPartitionCount() == 2);
+            REQUIRE(scheduler.getWorkerPartition(0) == 0);
+            REQUIRE(scheduler.getWorkerPartition(1) == 0);
+            REQUIRE(scheduler.getWorkerPartition(3) == 1);
+            REQUIRE(scheduler.getGroupPartition(&first) == 0u);
+            REQUIRE(scheduler.getGroupPartition(&second) == 1u);
+        }
+
+        WHEN("Both groups have work") {
+            scheduleWork(first, 4);
+            scheduleWork(second, 4);
+
+            THEN("Each worker serves its own partition") {
+                for (int i = 0; i < 4; ++i) {
+                    REQUIRE(scheduler.selectNextGroup(groups, worker(0)).group == &first);
+                    REQUIRE(scheduler.selectNextGroup(groups, worker(3)).group == &second);
+                }
+            }
+        }
+
+        WHEN("Only the other partition has work") {
+            scheduleWork(second, 1);
+
+            THEN("An idle worker steals it") {
+                auto result = scheduler.selectNextGroup(groups, worker(1));
+                REQUIRE(result.group == &second);
+                REQUIRE_FALSE(result.shouldSleep);
+            }
+        }
+
+        WHEN("No group has work") {
+            THEN("The worker is told to sleep") {
+                auto result = scheduler.selectNextGroup(groups, worker(2));
+                REQUIRE(result.group == nullptr);
+                REQUIRE(result.shouldSleep);
+            }
+        }
+
+        WHEN("A group is pinned to the other partition") {
+            scheduler.assignGroup(&second, 0);
+            scheduleWork(second, 1);
+
+            THEN("Its new partition serves it first") {
+                REQUIRE(scheduler.getGroupPartition(&second) == 0u);
+                REQUIRE(scheduler.selectNextGroup(groups, worker(0)).group == &second);
+                REQUIRE_THROWS_AS(scheduler.assignGroup(&second, 2), std::invalid_argument);
+            }
+        }
+
+        WHEN("A group is removed") {
+            scheduler.notifyGroupsChanged({&first});
+
+            THEN("The scheduler forgets it") {
+                REQUIRE_FALSE(scheduler.getGroupPartition(&second).has_value());
+            }
+        }
+    }
+}
+
+SCENARIO("PartitionedScheduler rebalances by backlog", "[scheduler][partitioned]") {
+    GIVEN("Two partitions where both busy groups landed on the first") {
+        IWorkScheduler::Config config;
+        config.threadCount = 2;
+        PartitionedScheduler::Options options;
+        options.partitionCount = 2;
+        options.assignment = PartitionAssignment::ByLoad;
+        PartitionedScheduler scheduler(config, options);
+
+        WorkContractGroup busyA(64, "BusyA");
+        WorkContractGroup idle(64, "Idle");
+        WorkContractGroup busyB(64, "BusyB");
+        WorkContractGroup idle2(64, "Idle2");
+        std::vector<WorkContractGroup*> groups{&busyA, &idle, &busyB, &idle2};
+        scheduler.notifyGroupsChanged(groups);
+        REQUIRE(scheduler.getGroupPartition(&busyA) == scheduler.getGroupPartition(&busyB));
+
+        scheduleWork(busyA, 10);
+        scheduleWork(busyB, 8);
+
+        WHEN("The scheduler rebalances") {
+            size_t moved = scheduler.rebalance();
+
+            THEN("The busy groups end up on different partitions and idle ones stay") {
+                REQUIRE(moved == 1);
+                REQUIRE(scheduler.getGroupPartition(&busyA) != scheduler.getGroupPartition(&busyB));
+                REQUIRE(scheduler.getGroupPartition(&idle) == 1u);
+                REQUIRE(scheduler.getGroupPartition(&idle2) == 1u);
+                REQUIRE(scheduler.rebalance() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("PartitionedScheduler drives a WorkService", "[scheduler][partitioned][workservice]") {
+    GIVEN("A service running several groups on a partitioned scheduler") {
+        WorkService::Config serviceConfig;
+        serviceConfig.threadCount = 4;
+        IWorkScheduler::Config config;
+        config.threadCount = 4;
+        PartitionedScheduler::Options options;
+        options.partitionCount = 2;
+        options.assignment = PartitionAssignment::ByLoad;
+        options.rebalanceInterval = 1ms;
+        WorkService service(serviceConfig, std::make_unique<PartitionedScheduler>(config, options));
+
+        std::vector<std::unique_ptr<WorkContractGroup>> groups;
+        for (int i = 0; i < 4; ++i) {
+            groups.push_back(std::make_unique<WorkContractGroup>(256, "Group" + std::to_string(i)));
+            service.addWorkContractGroup(groups.back().get());
+        }
+        service.start();
+
+        WHEN("Every group is given work") {
+            std::atomic<size_t> executed{0};
+            for (auto& group : groups) {
+                for (int i = 0; i < 200; ++i) {
+                    group->createContract([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }).schedule();
+                }
+            }
+
+            THEN("All of it runs") {
+                auto deadline = std::chrono::steady_clock::now() + 10s;
+                while (executed.load() < 800 && std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::sleep_for(1ms);
+                }
+                REQUIRE(executed.load() == 800);
+            }
+        }
+
+        service.stop();
+        for (auto& group : groups) {
+            service.removeWorkContractGroup(group.get());
+        }
+    }
+}
@@ -0,0 +1,184 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/Pipeline.h"
+#include "Concurrency/WorkContractGroup.h"
+#include "Concurrency/WorkService.h"
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace EntropyEngine::Core::Concurrency;
+
+namespace {
+    // Yields 0..count-1, then ends the stream
+    auto countingSource(int count) {
+        return [next = 0, count]() mutable -> std::optional<int> {
+            if (next == count) return std::nullopt;
+            return next++;
+        };
+    }
+}
+
+SCENARIO("Pipeline stage ordering", "[pipeline]") {
+    GIVEN("A parallel transform feeding an in-order sink") {
+        WorkContractGroup group(256);
+        Pipeline pipeline(&group, 4);
+        std::vector<std::string> written;
+
+        pipeline.setSource(countingSource(50), "numbers")
+                .addStage<int>(PipelineStageKind::Parallel, [](int& n) { return std::to_string(n * 2); }, "format")
+                .addStage<std::string>(PipelineStageKind::SerialInOrder,
+                                       [&](std::string& s) { written.push_back(s); }, "write");
+
+        WHEN("The stream is drained") {
+            pipeline.run();
+            group.executeAllBackgroundWork();
+            pipeline.wait();
+
+            THEN("Every item arrives in source order") {
+                REQUIRE(pipeline.isComplete());
+                REQUIRE(pipeline.getItemsCompleted() == 50);
+                REQUIRE(written.size() == 50);
+                for (int i = 0; i < 50; ++i) {
+                    REQUIRE(written[i] == std::to_string(i * 2));
+                }
+            }
+
+            THEN("The token limit held and stats cover every stage") {
+                REQUIRE(pipeline.getPeakTokensInFlight() <= 4);
+                REQUIRE(pipeline.getTokensInFlight() == 0);
+
+                auto stats = pipeline.getStageStats();
+                REQUIRE(stats.size() == 3);
+                REQUIRE(stats[0].name == "numbers");
+                REQUIRE(stats[0].itemsProcessed == 50);
+                REQUIRE(stats[1].name == "format");
+                REQUIRE(stats[1].itemsProcessed == 50);
+                REQUIRE(stats[2].kind == PipelineStageKind::SerialInOrder);
+                REQUIRE(stats[2].itemsProcessed == 50);
+                REQUIRE(stats[2].itemsPerSecond > 0.0);
+            }
+        }
+    }
+
+    GIVEN("Worker threads and a serial out-of-order stage") {
+        WorkService::Config config;
+        config.threadCount = 4;
+        WorkService service(config);
+        WorkContractGroup group(256);
+        service.addWorkContractGroup(&group);
+        service.start();
+
+        std::atomic<int> inside{0};
+        std::atomic<int> maxInside{0};
+        std::atomic<int> total{0};
+
+        {
+            Pipeline pipeline(&group, 8);
+            pipeline.setSource(countingSource(200))
+                    .addStage<int>(PipelineStageKind::Parallel, [](int& n) { return n + 1; })
+                    .addStage<int>(PipelineStageKind::SerialOutOfOrder, [&](int& n) {
+                        int now = ++inside;
+                        int seen = maxInside.load();
+                        while (now > seen && !maxInside.compare_exchange_weak(seen, now)) {}
+                        total += n;
+                        --inside;
+                    });
+            pipeline.run();
+            pipeline.wait();
+        }
+
+        service.stop();
+
+        THEN("The serial stage never ran two items at once and saw them all") {
+            REQUIRE(maxInside.load() == 1);
+            REQUIRE(total.load() == 200 * 201 / 2);
+        }
+    }
+}
+
+SCENARIO("Pipeline failure and back-pressure", "[pipeline]") {
+    GIVEN("A stage that throws on some items") {
+        WorkContractGroup group(64);
+        Pipeline pipeline(&group, 3);
+        std::vector<int> written;
+
+        pipeline.setSource(countingSource(10))
+                .addStage<int>(PipelineStageKind::Parallel, [](int& n) {
+                    if (n % 3 == 0) throw std::runtime_error("bad item");
+                    return n;
+                }, "validate")
+                .addStage<int>(PipelineStageKind::SerialInOrder, [&](int& n) { written.push_back(n); }, "write");
+
+        pipeline.run();
+        group.executeAllBackgroundWork();
+        pipeline.wait();
+
+        THEN("Failed items skip later stages without stalling the ordered ones") {
+            REQUIRE(pipeline.isComplete());
+            REQUIRE(pipeline.getItemsFailed() == 4);
+            REQUIRE(pipeline.getItemsCompleted() == 6);
+            REQUIRE(written == std::vector<int>{1, 2, 4, 5, 7, 8});
+            REQUIRE(pipeline.getStageStats()[1].itemsFailed == 4);
+        }
+    }
+
+    GIVEN("A group with fewer slots than the token limit") {
+        WorkContractGroup group(2);
+        Pipeline pipeline(&group, 16);
+        std::atomic<int> sum{0};
+
+        pipeline.setSource(countingSource(40))
+                .addStage<int>(PipelineStageKind::Parallel, [](int& n) { return n * 2; })
+                .addStage<int>(PipelineStageKind::SerialOutOfOrder, [&](int& n) { sum += n; });
+
+        pipeline.run();
+        group.executeAllBackgroundWork();
+        pipeline.wait();
+
+        THEN("Runs that found the group full are retried as capacity frees up") {
+            REQUIRE(pipeline.getItemsCompleted() == 40);
+            REQUIRE(sum.load() == 40 * 39);
+            REQUIRE(group.waitingAdmissionCount() == 0);
+        }
+    }
+
+    GIVEN("A cancelled pipeline") {
+        WorkContractGroup group(64);
+        Pipeline pipeline(&group, 2);
+        std::atomic<int> produced{0};
+
+        pipeline.setSource([&]() -> std::optional<int> { return ++produced; })
+                .addStage<int>(PipelineStageKind::SerialInOrder, [&](int& n) {
+                    if (n == 5) pipeline.cancel();
+                });
+
+        pipeline.run();
+        group.executeAllBackgroundWork();
+        pipeline.wait();
+
+        THEN("The source stops and in-flight items still finish") {
+            REQUIRE(pipeline.isComplete());
+            REQUIRE(produced.load() >= 5);
+            REQUIRE(produced.load() <= 7);
+            REQUIRE(pipeline.getItemsCompleted() == static_cast<uint64_t>(produced.load()));
+        }
+    }
+
+    GIVEN("An incomplete configuration") {
+        WorkContractGroup group(8);
+        Pipeline pipeline(&group);
+
+        THEN("Running without a source or twice is rejected") {
+            REQUIRE_THROWS_AS(pipeline.run(), std::logic_error);
+            pipeline.setSource(countingSource(1));
+            pipeline.run();
+            REQUIRE_THROWS_AS(pipeline.run(), std::logic_error);
+            REQUIRE_THROWS_AS(pipeline.addStage<int>(PipelineStageKind::Parallel, [](int&) {}), std::logic_error);
+            group.executeAllBackgroundWork();
+            pipeline.wait();
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/ScratchArena.h"
+#include "Concurrency/WorkService.h"
+#include "Concurrency/WorkContractGroup.h"
+#include <atomic>
+#include <cstdint>
+#include <set>
+
+using namespace EntropyEngine::Core::Concurrency;
+
+SCENARIO("ScratchArena bump allocation", "[scratch]") {
+    GIVEN("An arena with small chunks") {
+        ScratchArena arena(1024);
+
+        WHEN("Objects of mixed alignment are allocated") {
+            auto* byte = arena.create<uint8_t>(uint8_t{7});
+            auto* wide = arena.create<uint64_t>(uint64_t{42});
+            auto* floats = arena.allocateArray<float>(16);
+
+            THEN("Each is aligned and the usage is counted") {
+                REQUIRE(*byte == 7);
+                REQUIRE(*wide == 42);
+                REQUIRE(reinterpret_cast<uintptr_t>(wide) % alignof(uint64_t) == 0);
+                REQUIRE(reinterpret_cast<uintptr_t>(floats) % alignof(float) == 0);
+                REQUIRE(arena.bytesInUse() >= 1 + 8 + 16 * sizeof(float));
+            }
+        }
+
+        WHEN("A cycle spills over several chunks and is reset") {
+            for (int i = 0; i < 10; ++i) {
+                arena.allocate(700);
+            }
+            size_t spilled = arena.bytesInUse();
+            auto before = arena.getStats();
+            arena.reset();
+            auto after = arena.getStats();
+
+            THEN("The chunks are merged and the high-water mark recorded") {
+                REQUIRE(before.chunkGrowths > 0);
+                REQUIRE(after.highWaterMark == spilled);
+                REQUIRE(after.resetCount == 1);
+                REQUIRE(arena.bytesInUse() == 0);
+            }
+
+            AND_THEN("The same cycle now fits without growing") {
+                for (int i = 0; i < 10; ++i) {
+                    arena.allocate(700);
+                }
+                REQUIRE(arena.getStats().chunkGrowths == after.chunkGrowths);
+            }
+        }
+    }
+}
+
+SCENARIO("WorkService scratch arenas", "[scratch][workservice]") {
+    GIVEN("A running service with the default reset policy") {
+        WorkService::Config config;
+        config.threadCount = 2;
+        WorkService service(config);
+        WorkContractGroup group(256);
+        service.addWorkContractGroup(&group);
+        service.start();
+
+        WHEN("Contracts use scratch memory") {
+            std::atomic<int> ok{0};
+            for (int i = 0; i < 100; ++i) {
+                auto handle = group.createContract([&ok, i]() {
+                    auto& scratch = WorkService::scratch();
+                    if (scratch.bytesInUse() != 0) {
+                        return;   // Previous contract's memory was not reclaimed
+                    }
+                    int* values = scratch.allocateArray<int>(256);
+                    values[255] = i;
+                    if (values[255] == i) {
+                        ok++;
+                    }
+                });
+                handle.schedule();
+            }
+            group.wait();
+            service.stop();
+
+            THEN("Every contract starts from an empty arena and stats are reported per worker") {
+                REQUIRE(ok.load() == 100);
+                auto stats = service.getScratchStats();
+                REQUIRE(stats.size() == service.getThreadCount());
+                uint64_t resets = 0;
+                for (const auto& s : stats) {
+                    resets += s.resetCount;
+                    if (s.resetCount > 0) {
+                        REQUIRE(s.highWaterMark >= 256 * sizeof(int));
+                    }
+                }
+                REQUIRE(resets == 100);
+            }
+        }
+
+        service.stop();
+    }
+
+    GIVEN("A thread that is not a worker") {
+        THEN("scratch() still hands out a usable thread-local arena") {
+            auto& arena = WorkService::scratch();
+            REQUIRE(&arena == &WorkService::scratch());
+            REQUIRE(arena.allocate(64) != nullptr);
+            arena.reset();
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Concurrency/ShardedCounter.h"
+#include "Concurrency/WorkContractGroup.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace EntropyEngine::Core::Concurrency;
+
+SCENARIO("ShardedCounter sums its shards", "[shardedcounter]") {
+    GIVEN("A counter with eight shards") {
+        ShardedCounter counter(8);
+
+        THEN("It starts empty") {
+            REQUIRE(counter.shardCount() == 8);
+            REQUIRE(counter.load() == 0);
+            REQUIRE(counter.approximate() == 0);
+        }
+
+        WHEN("Threads add on their shards and others remove") {
+            constexpr size_t PER_THREAD = 20000;
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&counter]() {
+                    for (size_t i = 0; i < PER_THREAD; ++i) counter.add();
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            threads.clear();
+            REQUIRE(counter.load() == 4 * PER_THREAD);
+
+            for (int t = 0; t < 3; ++t) {
+                threads.emplace_back([&counter]() {
+                    for (size_t i = 0; i < PER_THREAD; ++i) counter.sub();
+                });
+            }
+            for (auto& thread : threads) thread.join();
+
+            THEN("The exact sum nets out across shards") {
+                REQUIRE(counter.load() == PER_THREAD);
+            }
+        }
+
+        WHEN("The count drops to zero after an approximate read cached it") {
+            counter.add(5);
+            REQUIRE(counter.approximate() == 5);
+            counter.sub(5);
+
+            THEN("The cached value expires and new work is seen at once") {
+                size_t value = counter.approximate();
+                for (uint32_t i = 0; i < ShardedCounter::APPROXIMATE_REFRESH && value != 0; ++i) {
+                    value = counter.approximate();
+                }
+                REQUIRE(value == 0);
+                counter.add();
+                REQUIRE(counter.approximate() == 1);
+            }
+        }
+
+        WHEN("The counter is reset") {
+            counter.add(3);
+            counter.reset(7);
+
+            THEN("It holds the new value") {
+                REQUIRE(counter.load() == 7);
+            }
+        }
+    }
+}
+
+SCENARIO("Sharded group counters stay exact under contention", "[shardedcounter][workcontract]") {
+    GIVEN("A group fed and drained by several threads") {
+        WorkContractGroup group(1024, "Sharded");
+        std::atomic<size_t> executed{0};
+        std::atomic<bool> producing{true};
+
+        std::vector<std::thread> workers;
+        for (int w = 0; w < 3; ++w) {
+            workers.emplace_back([&]() {
+                while (producing.load() || group.scheduledCount() > 0) {
+                    auto handle = group.selectForExecution();
+                    if (handle.valid()) {
+                        group.executeContract(handle);
+                        group.completeExecution(handle);
+                    }
+                }
+            });
+        }
+
+        size_t submitted = 0;
+        while (submitted < 5000) {
+            auto handle = group.createContract([&executed]() { executed.fetch_add(1); });
+            if (handle.valid()) {
+                handle.schedule();
+                ++submitted;
+            }
+        }
+        group.wait();
+        producing = false;
+        for (auto& worker : workers) worker.join();
+
+        THEN("Every contract ran and all counters returned to zero") {
+            REQUIRE(executed.load() == 5000);
+            REQUIRE(group.scheduledCount() == 0);
+            REQUIRE(group.executingCount() == 0);
+            REQUIRE(group.activeCount() == 0);
+            REQUIRE(group.approximateScheduledCount() == 0);
+        }
+    }
+}
+
+TEST_CASE("Sharded vs single atomic counter", "[benchmark][shardedcounter]") {
+    const unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+    constexpr size_t OPS = 100000;
+
+    std::atomic<size_t> single{0};
+    BENCHMARK("Single atomic") {
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&]() {
+                for (size_t i = 0; i < OPS; ++i) {
+                    single.fetch_add(1, std::memory_order_acq_rel);
+                    single.fetch_sub(1, std::memory_order_acq_rel);
+                }
+            });
+        }
+        for (auto& thread : pool) thread.join();
+        return single.load();
+    };
+
+    ShardedCounter sharded;
+    BENCHMARK("ShardedCounter") {
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&]() {
+                for (size_t i = 0; i < OPS; ++i) {
+                    sharded.add();
+                    sharded.sub();
+                }
+            });
+        }
+        for (auto& thread : pool) thread.join();
+        return sharded.load();
+    };
+}
@@ -0,0 +1,218 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/SharedWorkContractGroup.h"
+#include "Concurrency/WorkContractGroup.h"
+#include "Concurrency/WorkService.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#if !defined(EntropyWindows)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace EntropyEngine::Core::Concurrency;
+using namespace std::chrono_literals;
+
+namespace {
+    struct AddJob {
+        uint32_t value;
+        uint16_t repeat;
+    };
+
+    constexpr SharedWorkContractGroup::HandlerId ADD_HANDLER = 3;
+
+    std::string uniqueSegmentName(const char* test) {
+#if defined(EntropyWindows)
+        return std::string("EntropyTest-") + test;
+#else
+        return std::string("EntropyTest-") + test + "-" + std::to_string(getpid());
+#endif
+    }
+}
+
+TEST_CASE("JobDescriptor round-trips trivially copyable payloads", "[sharedworkcontract]") {
+    auto job = JobDescriptor::make(ADD_HANDLER, AddJob{42, 3});
+    REQUIRE(job.handlerId == ADD_HANDLER);
+    REQUIRE(job.payloadSize == sizeof(AddJob));
+    auto payload = job.get<AddJob>();
+    REQUIRE(payload.value == 42);
+    REQUIRE(payload.repeat == 3);
+}
+
+SCENARIO("SharedWorkContractGroup shares one queue between mappings", "[sharedworkcontract]") {
+    GIVEN("A segment created once and opened a second time") {
+        auto name = uniqueSegmentName("Mappings");
+        SharedWorkContractGroup::remove(name);
+        auto owner = SharedWorkContractGroup::create(name, 100);
+        auto other = SharedWorkContractGroup::open(name);
+
+        std::atomic<uint64_t> sum{0};
+        owner->registerHandler(ADD_HANDLER, [&sum](const JobDescriptor& job) {
+            auto payload = job.get<AddJob>();
+            sum.fetch_add(uint64_t(payload.value) * payload.repeat);
+        });
+
+        REQUIRE(owner->isOwner());
+        REQUIRE_FALSE(other->isOwner());
+        REQUIRE(other->capacity() == 100);
+
+        WHEN("Jobs are submitted through the second mapping") {
+            for (uint32_t i = 1; i <= 10; ++i) {
+                REQUIRE(other->submit(ADD_HANDLER, AddJob{i, 2}));
+            }
+
+            THEN("The first mapping sees and runs them") {
+                REQUIRE(owner->scheduledCount() == 10);
+                REQUIRE(owner->waitForWork(0us));
+                REQUIRE(owner->executeReady() == 10);
+                REQUIRE(sum.load() == 110);
+                REQUIRE(other->scheduledCount() == 0);
+                REQUIRE_FALSE(other->executeNext());
+            }
+        }
+
+        WHEN("The segment fills up") {
+            size_t accepted = 0;
+            while (other->submit(ADD_HANDLER, AddJob{1, 1})) {
+                accepted++;
+            }
+
+            THEN("Submission fails at capacity and recovers once slots are freed") {
+                REQUIRE(accepted == 100);
+                REQUIRE(owner->executeReady(5) == 5);
+                REQUIRE(other->submit(ADD_HANDLER, AddJob{1, 1}));
+                owner->executeReady();
+                REQUIRE(sum.load() == 101);
+            }
+        }
+
+        WHEN("A job names a handler this process never registered") {
+            other->submit(ADD_HANDLER + 1, AddJob{1, 1});
+
+            THEN("It is dropped and counted") {
+                REQUIRE(owner->executeNext());
+                REQUIRE(owner->droppedCount() == 1);
+                REQUIRE(sum.load() == 0);
+            }
+        }
+
+        WHEN("A waiter sleeps until another thread submits") {
+            std::thread producer([&]() {
+                std::this_thread::sleep_for(20ms);
+                other->submit(ADD_HANDLER, AddJob{4, 1});
+            });
+            auto start = std::chrono::steady_clock::now();
+            bool woke = owner->waitForWork(5s);
+            auto waited = std::chrono::steady_clock::now() - start;
+            producer.join();
+
+            THEN("The submission wakes it long before the timeout") {
+                REQUIRE(woke);
+                REQUIRE(waited < 2s);
+                REQUIRE(owner->executeReady() == 1);
+            }
+        }
+
+        WHEN("It is attached to a local group nobody executes") {
+            WorkContractGroup local(16, "Unserviced");
+            owner->attach(local, 4);
+            for (uint32_t i = 1; i <= 8; ++i) {
+                REQUIRE(other->submit(ADD_HANDLER, AddJob{i, 1}));
+            }
+            auto deadline = std::chrono::steady_clock::now() + 5s;
+            while (local.scheduledCount() == 0 && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(1ms);
+            }
+            REQUIRE(local.scheduledCount() > 0);
+            owner->detach();
+
+            THEN("Detaching takes the queued drain contracts back instead of waiting on them") {
+                REQUIRE_FALSE(owner->isAttached());
+                REQUIRE(local.activeCount() == 0);
+                REQUIRE(owner->scheduledCount() == 8);
+                REQUIRE(owner->executeReady() == 8);
+            }
+        }
+    }
+
+    GIVEN("A name that is already taken") {
+        auto name = uniqueSegmentName("Taken");
+        SharedWorkContractGroup::remove(name);
+        auto owner = SharedWorkContractGroup::create(name, 8);
+
+        THEN("Creating it again fails, and bad names are rejected") {
+            REQUIRE_THROWS_AS(SharedWorkContractGroup::create(name, 8), std::runtime_error);
+            REQUIRE_THROWS_AS(SharedWorkContractGroup::create("bad/name", 8), std::invalid_argument);
+            REQUIRE_THROWS_AS(SharedWorkContractGroup::open(uniqueSegmentName("Missing")), std::runtime_error);
+        }
+    }
+}
+
+#if !defined(EntropyWindows)
+SCENARIO("Workers of one process run jobs submitted by another", "[sharedworkcontract][workservice]") {
+    GIVEN("A segment attached to a local WorkService") {
+        auto name = uniqueSegmentName("CrossProcess");
+        SharedWorkContractGroup::remove(name);
+        auto shared = SharedWorkContractGroup::create(name, 256);
+
+        std::atomic<uint64_t> sum{0};
+        std::atomic<size_t> executed{0};
+        shared->registerHandler(ADD_HANDLER, [&](const JobDescriptor& job) {
+            sum.fetch_add(job.get<AddJob>().value);
+            executed.fetch_add(1);
+        });
+
+        constexpr uint32_t JOBS = 1000;
+
+        // Fork before any worker threads exist so the child starts from a quiet process
+        pid_t child = fork();
+        if (child == 0) {
+            int status = 0;
+            try {
+                auto producer = SharedWorkContractGroup::open(name);
+                for (uint32_t i = 1; i <= JOBS; ) {
+                    if (producer->submit(ADD_HANDLER, AddJob{i, 1})) {
+                        ++i;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            } catch (...) {
+                status = 1;
+            }
+            _exit(status);
+        }
+        REQUIRE(child > 0);
+
+        WorkService::Config config;
+        config.threadCount = 2;
+        WorkService service(config);
+        WorkContractGroup local(64, "SharedDrain");
+        service.addWorkContractGroup(&local);
+        service.start();
+        shared->attach(local, service.getThreadCount());
+
+        int status = -1;
+        REQUIRE(waitpid(child, &status, 0) == child);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+
+        auto deadline = std::chrono::steady_clock::now() + 10s;
+        while (executed.load() < JOBS && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+
+        shared->detach();
+        service.stop();
+        service.removeWorkContractGroup(&local);
+
+        THEN("Every job ran exactly once") {
+            REQUIRE(executed.load() == JOBS);
+            REQUIRE(sum.load() == uint64_t(JOBS) * (JOBS + 1) / 2);
+            REQUIRE(shared->scheduledCount() == 0);
+        }
+    }
+}
+#endif
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/matchers/catch_matchers_string.hpp>
 #include "Concurrency/WorkContractGroup.h"
 #include "Concurrency/WorkService.h"
@@ -9,6 +10,8 @@
 #include <chrono>
 #include <iostream>
 #include <mutex>
+#include <set>
+#include <functional>
 
 using namespace EntropyEngine::Core::Concurrency;
 using namespace Catch::Matchers;
@@ -531,4 +534,418 @@ SCENARIO("WorkContractGroup safe destruction with epoch synchronization", "[work
         
         service->stop();
     }
-}
\ No newline at end of file
+}
+SCENARIO("WorkContractGroup lazy slot materialization", "[workcontract][experimental][lazy]") {
+    GIVEN("A group far larger than its working set") {
+        WorkContractGroup group(1 << 20, "Oversized");
+
+        WHEN("Contracts are created and released repeatedly") {
+            std::vector<uint32_t> firstIndices;
+            std::vector<uint32_t> secondIndices;
+            for (int round = 0; round < 2; ++round) {
+                std::vector<WorkContractHandle> handles;
+                for (int i = 0; i < 8; ++i) {
+                    handles.push_back(group.createContract([]() {}));
+                    (round == 0 ? firstIndices : secondIndices).push_back(handles.back().getIndex());
+                }
+                for (auto& handle : handles) {
+                    handle.release();
+                }
+            }
+
+            THEN("Released slots are reused before untouched ones") {
+                for (uint32_t index : secondIndices) {
+                    REQUIRE(index < 8);
+                }
+                REQUIRE(group.activeCount() == 0);
+            }
+        }
+
+        WHEN("No main thread contract has been created") {
+            THEN("Main thread selection finds nothing") {
+                REQUIRE_FALSE(group.selectForMainThreadExecution().valid());
+                REQUIRE(group.executeMainThreadWork(16) == 0);
+            }
+        }
+
+        WHEN("A main thread contract is scheduled") {
+            bool ran = false;
+            auto handle = group.createContract([&ran]() { ran = true; }, ExecutionType::MainThread);
+            handle.schedule();
+
+            THEN("Its tree is created on demand and the work runs") {
+                REQUIRE(group.hasMainThreadWork());
+                REQUIRE(group.executeMainThreadWork(16) == 1);
+                REQUIRE(ran);
+            }
+        }
+    }
+
+    GIVEN("A small group filled to capacity") {
+        WorkContractGroup group(16);
+        std::vector<WorkContractHandle> handles;
+        for (int i = 0; i < 16; ++i) {
+            handles.push_back(group.createContract([]() {}));
+        }
+
+        THEN("Every slot is handed out exactly once and the next request fails") {
+            std::vector<bool> seen(16, false);
+            for (auto& handle : handles) {
+                REQUIRE(handle.valid());
+                REQUIRE_FALSE(seen[handle.getIndex()]);
+                seen[handle.getIndex()] = true;
+            }
+            REQUIRE_FALSE(group.createContract([]() {}).valid());
+        }
+
+        AND_THEN("A released slot is handed out again") {
+            uint32_t freed = handles[5].getIndex();
+            handles[5].release();
+            auto reused = group.createContract([]() {});
+            REQUIRE(reused.valid());
+            REQUIRE(reused.getIndex() == freed);
+            REQUIRE_FALSE(handles[5].valid());
+        }
+    }
+}
+
+SCENARIO("WorkContractGroup reschedule on completion", "[workcontract][experimental][reschedule]") {
+    GIVEN("A contract that asks to run again until its third run") {
+        WorkContractGroup group(4);
+        int runs = 0;
+        WorkContractHandle self;
+        self = group.createContract([&]() {
+            if (++runs < 3) {
+                REQUIRE(group.rescheduleOnCompletion(self));
+            }
+        });
+        uint32_t index = self.getIndex();
+        self.schedule();
+
+        WHEN("Background work is drained") {
+            group.executeAllBackgroundWork();
+
+            THEN("The same slot and handle served every run and were freed at the end") {
+                REQUIRE(runs == 3);
+                REQUIRE(index == self.getIndex());
+                REQUIRE_FALSE(self.valid());
+                REQUIRE(group.activeCount() == 0);
+                REQUIRE(group.scheduledCount() == 0);
+                REQUIRE(group.executingCount() == 0);
+            }
+        }
+    }
+
+    GIVEN("A contract that is not executing") {
+        WorkContractGroup group(4);
+        auto handle = group.createContract([]() {});
+
+        THEN("A reschedule request is refused") {
+            REQUIRE_FALSE(group.rescheduleOnCompletion(handle));
+            handle.schedule();
+            REQUIRE_FALSE(group.rescheduleOnCompletion(handle));
+            handle.release();
+        }
+    }
+}
+
+SCENARIO("WorkContractGroup admission queue", "[workcontract][experimental][admission]") {
+    GIVEN("A full group and three clients waiting for capacity") {
+        WorkContractGroup group(2);
+        std::vector<WorkContractHandle> held;
+        held.reserve(16);   // Turns append while an element is releasing
+        held.push_back(group.createContract([]() {}));
+        held.push_back(group.createContract([]() {}));
+
+        // Like a real client, each turn takes the freed slot
+        std::vector<int> turns;
+        std::vector<int> remaining{2, 2, 2};
+        std::vector<WorkContractGroup::AdmissionTicket> tickets;
+        for (int client = 0; client < 3; ++client) {
+            tickets.push_back(group.registerAdmission([&, client]() {
+                turns.push_back(client);
+                held.push_back(group.createContract([]() {}));
+                return --remaining[client] > 0;
+            }));
+        }
+        auto idle = group.registerAdmission([&turns]() {
+            turns.push_back(99);
+            return false;
+        });
+
+        for (auto& ticket : tickets) {
+            group.requestAdmission(ticket);
+            group.requestAdmission(ticket);   // Already queued - no second place
+        }
+        REQUIRE(group.waitingAdmissionCount() == 3);
+        REQUIRE(turns.empty());
+
+        WHEN("Slots are freed one at a time") {
+            for (size_t i = 0; i < 6; ++i) {
+                held[i].release();
+            }
+
+            THEN("Each freed slot gives one waiting client a turn, round-robin") {
+                REQUIRE(turns == std::vector<int>{0, 1, 2, 0, 1, 2});
+                REQUIRE(group.waitingAdmissionCount() == 0);
+            }
+        }
+
+        WHEN("A waiting client unregisters") {
+            group.unregisterAdmission(tickets[1]);
+            tickets.erase(tickets.begin() + 1);
+            held[0].release();
+            held[1].release();
+
+            THEN("Its turn is skipped") {
+                REQUIRE(turns == std::vector<int>{0, 2});
+            }
+        }
+
+        // Before `held` releases its contracts and hands out turns to dead state
+        for (auto& ticket : tickets) {
+            group.unregisterAdmission(ticket);
+        }
+        group.unregisterAdmission(idle);
+    }
+}
+
+SCENARIO("WorkContractGroup bulk creation", "[workcontract][experimental][bulk]") {
+    GIVEN("A group of 1024 contracts") {
+        WorkContractGroup group(1024);
+        std::atomic<int> executed{0};
+        auto makeWork = [&executed](size_t count) {
+            std::vector<std::function<void()>> works(count, [&executed]() { executed++; });
+            return works;
+        };
+
+        WHEN("600 contracts are created in one call") {
+            auto works = makeWork(600);
+            std::vector<WorkContractHandle> handles(600);
+            size_t created = group.createContracts(works, handles);
+
+            THEN("Every handle is valid and distinct") {
+                REQUIRE(created == 600);
+                REQUIRE(group.activeCount() == 600);
+                std::set<uint32_t> indices;
+                for (auto& handle : handles) {
+                    REQUIRE(handle.valid());
+                    indices.insert(handle.getIndex());
+                }
+                REQUIRE(indices.size() == 600);
+            }
+
+            AND_WHEN("Half are released and a larger batch is requested") {
+                for (size_t i = 0; i < 300; ++i) {
+                    handles[i].release();
+                }
+                auto more = makeWork(800);
+                std::vector<WorkContractHandle> moreHandles(800);
+                size_t extra = group.createContracts(more, moreHandles);
+
+                THEN("Recycled and untouched slots fill the group exactly") {
+                    REQUIRE(extra == 724);
+                    REQUIRE(group.activeCount() == 1024);
+                    REQUIRE_FALSE(group.createContract([]() {}).valid());
+                    REQUIRE(more[723] == nullptr);   // Taken works are moved from
+                    REQUIRE(more[724] != nullptr);   // The rest are left alone
+                }
+
+                AND_THEN("They all run") {
+                    for (size_t i = 300; i < 600; ++i) {
+                        handles[i].schedule();
+                    }
+                    for (size_t i = 0; i < extra; ++i) {
+                        moreHandles[i].schedule();
+                    }
+                    group.executeAllBackgroundWork();
+                    REQUIRE(executed == 1024);
+                    REQUIRE(group.activeCount() == 0);
+                }
+            }
+        }
+
+        WHEN("Bulk and single creation run concurrently") {
+            std::vector<std::thread> threads;
+            std::atomic<size_t> total{0};
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&, t]() {
+                    for (int round = 0; round < 50; ++round) {
+                        if (t % 2 == 0) {
+                            auto works = makeWork(8);
+                            std::vector<WorkContractHandle> handles(8);
+                            size_t created = group.createContracts(works, handles);
+                            for (size_t i = 0; i < created; ++i) {
+                                handles[i].release();
+                            }
+                            total += created;
+                        } else {
+                            auto handle = group.createContract([]() {});
+                            if (handle.valid()) {
+                                handle.release();
+                                total++;
+                            }
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            THEN("Every slot comes back") {
+                REQUIRE(total > 0);
+                REQUIRE(group.activeCount() == 0);
+                auto works = makeWork(1024);
+                std::vector<WorkContractHandle> handles(1024);
+                REQUIRE(group.createContracts(works, handles) == 1024);
+            }
+        }
+
+        WHEN("Only recycled slots are left and bulk and single creation race for them") {
+            {
+                auto works = makeWork(1024);
+                std::vector<WorkContractHandle> handles(1024);
+                REQUIRE(group.createContracts(works, handles) == 1024);
+                for (auto& handle : handles) {
+                    handle.release();
+                }
+            }
+            std::atomic<bool> bulkDone{false};
+            std::atomic<int> singleFailures{0};
+            std::thread bulk([&]() {
+                for (int round = 0; round < 2000; ++round) {
+                    auto works = makeWork(256);
+                    std::vector<WorkContractHandle> handles(256);
+                    size_t created = group.createContracts(works, handles);
+                    for (size_t i = 0; i < created; ++i) {
+                        handles[i].release();
+                    }
+                }
+                bulkDone = true;
+            });
+            std::thread single([&]() {
+                while (!bulkDone) {
+                    auto handle = group.createContract([]() {});
+                    if (!handle.valid()) {
+                        singleFailures++;
+                        continue;
+                    }
+                    handle.release();
+                }
+            });
+            bulk.join();
+            single.join();
+
+            THEN("Single creation never sees the free list empty") {
+                REQUIRE(singleFailures == 0);
+                REQUIRE(group.activeCount() == 0);
+            }
+        }
+
+        WHEN("Bulk creation, single creation and completions overlap") {
+            std::atomic<bool> creating{true};
+            std::atomic<int> creatorsLeft{4};
+            std::vector<std::vector<WorkContractHandle>> held(4);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&, t]() {
+                    for (int round = 0; round < 2000; ++round) {
+                        // Keep a few contracts allocated so the final tally is not trivially empty
+                        bool keep = round % 200 == 0;
+                        if (t % 2 == 0) {
+                            auto works = makeWork(8);
+                            std::vector<WorkContractHandle> handles(8);
+                            size_t created = group.createContracts(works, handles);
+                            for (size_t i = 0; i < created; ++i) {
+                                if (keep && i == 0) {
+                                    held[t].push_back(handles[i]);
+                                } else {
+                                    handles[i].schedule();
+                                }
+                            }
+                        } else {
+                            auto handle = group.createContract([&executed]() { executed++; });
+                            if (!handle.valid()) {
+                                continue;
+                            }
+                            if (keep) {
+                                held[t].push_back(handle);
+                            } else {
+                                handle.schedule();
+                            }
+                        }
+                    }
+                    if (--creatorsLeft == 0) {
+                        creating = false;
+                    }
+                });
+            }
+            for (int t = 0; t < 2; ++t) {
+                threads.emplace_back([&]() {
+                    while (true) {
+                        auto handle = group.selectForExecution();
+                        if (!handle.valid()) {
+                            if (!creating) {
+                                break;
+                            }
+                            std::this_thread::yield();
+                            continue;
+                        }
+                        group.executeContract(handle);
+                        group.completeExecution(handle);
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            group.executeAllBackgroundWork();
+
+            THEN("Every slot is either active or free") {
+                size_t kept = 0;
+                for (auto& handles : held) {
+                    for (auto& handle : handles) {
+                        REQUIRE(handle.valid());
+                        kept++;
+                    }
+                }
+                size_t active = group.activeCount();
+                REQUIRE(active == kept);
+
+                size_t freeSlots = 0;
+                std::vector<WorkContractHandle> drained;
+                for (auto handle = group.createContract([]() {}); handle.valid(); handle = group.createContract([]() {})) {
+                    drained.push_back(handle);
+                    freeSlots++;
+                }
+                REQUIRE(group.capacity() == active + freeSlots);
+            }
+        }
+    }
+}
+
+TEST_CASE("Bulk vs single contract creation", "[benchmark][workcontract]") {
+    constexpr size_t BURST = 4096;
+    WorkContractGroup group(BURST);
+    std::vector<WorkContractHandle> handles(BURST);
+
+    BENCHMARK("createContract x4096") {
+        for (size_t i = 0; i < BURST; ++i) {
+            handles[i] = group.createContract([]() {});
+        }
+        for (auto& handle : handles) {
+            handle.release();
+        }
+        return handles.size();
+    };
+
+    BENCHMARK("createContracts(4096)") {
+        std::vector<std::function<void()>> works(BURST, []() {});
+        size_t created = group.createContracts(works, handles);
+        for (auto& handle : handles) {
+            handle.release();
+        }
+        return created;
+    };
+}
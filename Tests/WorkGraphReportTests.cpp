@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/WorkGraph.h"
+#include "Concurrency/WorkGraphReport.h"
+#include "Concurrency/WorkContractGroup.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace EntropyEngine::Core::Concurrency;
+using namespace std::chrono_literals;
+
+namespace {
+    ExecutionTrace::Node traced(const char* name, int64_t ready, int64_t scheduled, int64_t start, int64_t end,
+                                std::vector<uint32_t> successors = {}) {
+        ExecutionTrace::Node node;
+        node.name = name;
+        node.timing.readyNs = ready;
+        node.timing.scheduledNs = scheduled;
+        node.timing.startNs = start;
+        node.timing.endNs = end;
+        node.successors = std::move(successors);
+        return node;
+    }
+}
+
+SCENARIO("WorkGraphReport analyzes a recorded diamond", "[workgraph][report]") {
+    GIVEN("a -> {b, c} -> d where c sat deferred behind a full group") {
+        // Times in ns; c was ready at 2000 but only got a contract at 4500
+        ExecutionTrace trace;
+        trace.nodes.push_back(traced("a", 1000, 1000, 1000, 2000, {1, 2}));
+        trace.nodes.push_back(traced("b", 2000, 2000, 2000, 5000, {3}));
+        trace.nodes.push_back(traced("c", 2000, 4500, 4500, 5500, {3}));
+        trace.nodes.push_back(traced("d", 5500, 5500, 5500, 6500));
+
+        WorkGraphReport::Options options;
+        options.workerCount = 2;
+        options.timelineSamples = 11;
+        auto report = WorkGraphReport::analyze(trace, options);
+
+        THEN("The critical path and parallelism follow from the durations") {
+            REQUIRE(report.nodeCount == 4);
+            REQUIRE(report.wallTime == 5500ns);
+            REQUIRE(report.totalWork == 6000ns);
+            REQUIRE(report.criticalPathTime == 5000ns);
+            REQUIRE(report.criticalPath == std::vector<uint32_t>{0, 1, 3});
+            REQUIRE(std::abs(report.availableParallelism - 1.2) < 1e-9);
+            REQUIRE(std::abs(report.achievedParallelism - 6000.0 / 5500.0) < 1e-9);
+        }
+
+        THEN("Idle worker-time is split between dependencies and deferral") {
+            // 1000-2000 and 5000-6500 one worker had nothing ready; 2000-4500 c was deferred
+            REQUIRE(report.idle.dependency == 2500ns);
+            REQUIRE(report.idle.deferral == 2500ns);
+            REQUIRE(report.idle.dispatch == 0ns);
+        }
+
+        THEN("The timeline shows achieved and available parallelism") {
+            REQUIRE(report.timeline.size() == 11);
+            REQUIRE(std::abs(report.timeline[0].running - 1.0) < 1e-9);
+            REQUIRE(std::abs(report.timeline[2].deferred - 1.0) < 1e-9);
+            REQUIRE(std::abs(report.timeline[2].available() - 2.0) < 1e-9);
+            REQUIRE(std::abs(report.timeline[7].running - 2.0) < 1e-9);
+        }
+
+        THEN("Only c waited longer than its slack") {
+            REQUIRE(report.topSlack.size() == 1);
+            const auto& c = report.topSlack.front();
+            REQUIRE(c.name == "c");
+            REQUIRE(c.slack == 2000ns);
+            REQUIRE(c.wait == 2500ns);
+            REQUIRE(c.deferred == 2500ns);
+            REQUIRE(c.slackContribution == 500ns);
+            REQUIRE_FALSE(c.critical);
+        }
+
+        THEN("Without a worker count the peak concurrency is used") {
+            REQUIRE(WorkGraphReport::analyze(trace).workerCount == 2);
+        }
+    }
+
+    GIVEN("Malformed traces") {
+        THEN("Cycles and unfinished nodes are rejected") {
+            ExecutionTrace cyclic;
+            cyclic.nodes.push_back(traced("a", 1, 1, 1, 2, {1}));
+            cyclic.nodes.push_back(traced("b", 2, 2, 2, 3, {0}));
+            REQUIRE_THROWS_AS(WorkGraphReport::analyze(cyclic), std::invalid_argument);
+
+            ExecutionTrace unfinished;
+            unfinished.nodes.push_back(traced("a", 1, 1, 0, 0));
+            REQUIRE_THROWS_AS(WorkGraphReport::analyze(unfinished), std::invalid_argument);
+        }
+    }
+}
+
+SCENARIO("WorkGraph records timing for analyzeExecution()", "[workgraph][report]") {
+    GIVEN("A timed graph whose fan-out exceeds its contract group") {
+        WorkContractGroup contractGroup(2);
+        WorkGraphConfig config;
+        config.enableTiming = true;
+        WorkGraph graph(&contractGroup, config);
+
+        auto slow = []() { std::this_thread::sleep_for(1ms); };
+        auto root = graph.addNode(slow, "root");
+        auto sink = graph.addNode(slow, "sink");
+        for (int i = 0; i < 6; ++i) {
+            auto leaf = graph.addNode([]() {}, "leaf");
+            graph.addDependency(root, leaf);
+            graph.addDependency(leaf, sink);
+        }
+
+        graph.execute();
+        while (!graph.isComplete()) {
+            contractGroup.executeAllBackgroundWork();
+        }
+        graph.wait();
+
+        WHEN("The run is analyzed") {
+            auto trace = graph.getExecutionTrace();
+            auto report = graph.analyzeExecution();
+
+            THEN("Every node is traced with its edges") {
+                REQUIRE(trace.nodes.size() == 8);
+                REQUIRE(trace.nodes[0].handle == root);
+                REQUIRE(trace.nodes[0].successors.size() == 6);
+                for (const auto& node : trace.nodes) {
+                    REQUIRE(node.timing.readyNs <= node.timing.startNs);
+                    REQUIRE(node.timing.startNs <= node.timing.endNs);
+                }
+            }
+
+            THEN("Leaves that found no free contract were stamped as deferred") {
+                auto deferred = std::count_if(trace.nodes.begin(), trace.nodes.end(), [](const auto& node) {
+                    return node.timing.scheduledNs > node.timing.readyNs;
+                });
+                REQUIRE(deferred > 0);
+            }
+
+            THEN("The critical path runs root -> leaf -> sink") {
+                REQUIRE(report.criticalPath.size() == 3);
+                REQUIRE(report.criticalPath.front() == 0);
+                REQUIRE(report.criticalPath.back() == 1);
+                REQUIRE(report.criticalPathTime >= 2ms);
+                REQUIRE(report.totalWork >= report.criticalPathTime);
+                REQUIRE(report.wallTime >= report.criticalPathTime);
+            }
+        }
+    }
+
+    GIVEN("A graph created without enableTiming") {
+        WorkContractGroup contractGroup(4);
+        WorkGraph graph(&contractGroup);
+
+        THEN("Analysis is refused") {
+            REQUIRE_THROWS_AS(graph.getExecutionTrace(), std::logic_error);
+            REQUIRE_THROWS_AS(graph.analyzeExecution(), std::logic_error);
+        }
+    }
+}
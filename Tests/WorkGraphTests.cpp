@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 #include "Concurrency/WorkGraph.h"
+#include "Concurrency/WorkGraphEvents.h"
+#include "Concurrency/NodeScheduler.h"
 #include "Concurrency/WorkContractGroup.h"
 #include "Concurrency/WorkService.h"
 #include <thread>
@@ -8,6 +10,8 @@
 #include <vector>
 #include <chrono>
 #include <sstream>
+#include <algorithm>
+#include <mutex>
 
 using namespace EntropyEngine::Core::Concurrency;
 using namespace std::chrono_literals;
@@ -240,6 +244,595 @@ SCENARIO("WorkGraph dynamic construction", "[workgraph][experimental][dynamic]")
     }
 }
 
+SCENARIO("WorkGraph spawned subgraphs", "[workgraph][experimental][spawn]") {
+    GIVEN("A work graph with a contract group") {
+        WorkContractGroup contractGroup(256);
+        WorkGraph graph(&contractGroup);
+        
+        std::vector<std::string> executionOrder;
+        std::mutex orderMutex;
+        auto record = [&executionOrder, &orderMutex](const std::string& name) {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            executionOrder.push_back(name);
+        };
+        
+        WHEN("A running node spawns a diamond and has a dependant") {
+            auto split = graph.addNode([&]() {
+                record("split");
+                auto left = graph.spawn([&]() { record("left"); }, "left");
+                auto right = graph.spawn([&]() { record("right"); }, "right");
+                auto merge = graph.spawn([&]() { record("merge"); }, "merge");
+                graph.spawnDependency(left, merge);
+                graph.spawnDependency(right, merge);
+            }, "split");
+            auto consume = graph.addNode([&]() { record("consume"); }, "consume");
+            graph.addDependency(split, consume);
+            
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            auto result = graph.wait();
+            
+            THEN("The subgraph runs after its spawner and before the dependant") {
+                REQUIRE(result.allCompleted);
+                REQUIRE(result.completedCount == 5);
+                REQUIRE(executionOrder.size() == 5);
+                REQUIRE(executionOrder.front() == "split");
+                REQUIRE(executionOrder[3] == "merge");
+                REQUIRE(executionOrder.back() == "consume");
+                REQUIRE(graph.getChildren(split).size() == 3);
+            }
+        }
+        
+        WHEN("Spawned nodes spawn recursively") {
+            std::atomic<int> leaves{0};
+            std::function<void(int)> subdivide = [&](int depth) {
+                if (depth == 0) {
+                    leaves.fetch_add(1);
+                    return;
+                }
+                graph.spawn([&, depth]() { subdivide(depth - 1); });
+                graph.spawn([&, depth]() { subdivide(depth - 1); });
+            };
+            std::atomic<bool> finalized{false};
+            auto root = graph.addNode([&]() { subdivide(4); }, "root");
+            auto finalize = graph.addNode([&]() {
+                finalized = (leaves.load() == 16);
+            }, "finalize");
+            graph.addDependency(root, finalize);
+            
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            graph.wait();
+            
+            THEN("Every leaf runs before the original dependant") {
+                REQUIRE(leaves.load() == 16);
+                REQUIRE(finalized.load());
+                REQUIRE(graph.isComplete());
+            }
+        }
+        
+        WHEN("Spawning is attempted outside a running node") {
+            THEN("It is rejected") {
+                REQUIRE_FALSE(graph.canSpawn());
+                REQUIRE_THROWS_AS(graph.spawn([]() {}), std::runtime_error);
+            }
+        }
+        
+        WHEN("Spawned dependencies go against spawn order") {
+            std::atomic<bool> threw{false};
+            graph.addNode([&]() {
+                auto a = graph.spawn([]() {});
+                auto b = graph.spawn([]() {});
+                try {
+                    graph.spawnDependency(b, a);
+                } catch (const std::invalid_argument&) {
+                    threw = true;
+                }
+            }, "bad-order");
+            
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            graph.wait();
+            
+            THEN("The edge is rejected") {
+                REQUIRE(threw.load());
+            }
+        }
+    }
+}
+
+SCENARIO("WorkGraph conditional branches", "[workgraph][experimental][branch]") {
+    GIVEN("A work graph with a contract group") {
+        WorkContractGroup contractGroup(256);
+        WorkGraph graph(&contractGroup);
+        
+        std::atomic<int> thenRuns{0};
+        std::atomic<int> thenChildRuns{0};
+        std::atomic<int> elseRuns{0};
+        std::atomic<int> joinRuns{0};
+        
+        auto buildIfElse = [&](uint32_t choice) {
+            auto branch = graph.addBranchNode([choice]() { return choice; }, "branch");
+            auto thenNode = graph.addNode([&]() { thenRuns++; }, "then");
+            auto thenChild = graph.addNode([&]() { thenChildRuns++; }, "then-child");
+            auto elseNode = graph.addNode([&]() { elseRuns++; }, "else");
+            auto join = graph.addNode([&]() { joinRuns++; }, "join");
+            graph.addBranchDependency(branch, thenNode, 0);
+            graph.addBranchDependency(branch, elseNode, 1);
+            graph.addDependency(thenNode, thenChild);
+            graph.addDependency(thenChild, join);
+            graph.addDependency(elseNode, join);
+        };
+        
+        WHEN("The branch selects the else side") {
+            buildIfElse(1);
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            auto result = graph.wait();
+            
+            THEN("The then subtree is skipped and the join still runs") {
+                REQUIRE(thenRuns == 0);
+                REQUIRE(thenChildRuns == 0);
+                REQUIRE(elseRuns == 1);
+                REQUIRE(joinRuns == 1);
+                REQUIRE(result.allCompleted);
+                REQUIRE(result.skippedCount == 2);
+                REQUIRE(result.completedCount == 3);
+                REQUIRE(graph.getStats().skippedNodes == 2);
+            }
+        }
+        
+        WHEN("The branch selects the then side") {
+            buildIfElse(0);
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            auto result = graph.wait();
+            
+            THEN("Only the else node is skipped") {
+                REQUIRE(thenRuns == 1);
+                REQUIRE(thenChildRuns == 1);
+                REQUIRE(elseRuns == 0);
+                REQUIRE(joinRuns == 1);
+                REQUIRE(result.skippedCount == 1);
+            }
+        }
+        
+        WHEN("A branch selects an index with no edges") {
+            std::atomic<int> gatedRuns{0};
+            std::atomic<int> alwaysRuns{0};
+            auto branch = graph.addBranchNode([]() -> uint32_t { return 7; }, "branch");
+            auto gated = graph.addNode([&]() { gatedRuns++; }, "gated");
+            auto gatedTail = graph.addNode([&]() { gatedRuns++; }, "gated-tail");
+            auto always = graph.addNode([&]() { alwaysRuns++; }, "always");
+            graph.addBranchDependency(branch, gated, 0);
+            graph.addDependency(gated, gatedTail);
+            graph.addDependency(branch, always);
+            
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            auto result = graph.wait();
+            
+            THEN("Conditional edges are untaken while plain edges still run") {
+                REQUIRE(gatedRuns == 0);
+                REQUIRE(alwaysRuns == 1);
+                REQUIRE(result.skippedCount == 2);
+                REQUIRE(graph.isComplete());
+            }
+        }
+        
+        WHEN("A branch dependency is added from a plain node") {
+            auto plain = graph.addNode([]() {}, "plain");
+            auto other = graph.addNode([]() {}, "other");
+            
+            THEN("It is rejected") {
+                REQUIRE_THROWS_AS(graph.addBranchDependency(plain, other, 0), std::invalid_argument);
+            }
+        }
+    }
+}
+
+SCENARIO("WorkGraph cross-graph dependencies", "[workgraph][experimental][external]") {
+    GIVEN("Two work graphs sharing a contract group") {
+        WorkContractGroup contractGroup(256);
+        WorkGraph producer(&contractGroup);
+        WorkGraph consumer(&contractGroup);
+        
+        std::vector<std::string> executionOrder;
+        std::mutex orderMutex;
+        auto record = [&executionOrder, &orderMutex](const std::string& name) {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            executionOrder.push_back(name);
+        };
+        auto positionOf = [&executionOrder](const std::string& name) {
+            return std::find(executionOrder.begin(), executionOrder.end(), name) - executionOrder.begin();
+        };
+        
+        WHEN("A consumer node waits on a producer node") {
+            auto produce = producer.addNode([&]() { record("produce"); }, "produce");
+            auto independent = consumer.addNode([&]() { record("independent"); }, "independent");
+            auto consume = consumer.addNode([&]() { record("consume"); }, "consume");
+            consumer.addDependency(producer.getExternalHandle(produce), consume);
+            
+            // Consumer starts first; only its independent part can run
+            consumer.execute();
+            contractGroup.executeAllBackgroundWork();
+            REQUIRE(executionOrder == std::vector<std::string>{"independent"});
+            
+            producer.execute();
+            contractGroup.executeAllBackgroundWork();
+            auto result = consumer.wait();
+            
+            THEN("The consumer node runs after the producer node") {
+                REQUIRE(result.completedCount == 2);
+                REQUIRE(positionOf("produce") < positionOf("consume"));
+            }
+        }
+        
+        WHEN("A consumer node waits on the producer's completion") {
+            for (int i = 0; i < 3; ++i) {
+                producer.addNode([&, i]() { record("p" + std::to_string(i)); });
+            }
+            auto consume = consumer.addNode([&]() { record("consume"); }, "consume");
+            consumer.addDependency(producer.getCompletionHandle(), consume);
+            
+            consumer.execute();
+            producer.execute();
+            contractGroup.executeAllBackgroundWork();
+            consumer.wait();
+            
+            THEN("It runs after every producer node") {
+                REQUIRE(executionOrder.size() == 4);
+                REQUIRE(executionOrder.back() == "consume");
+            }
+        }
+        
+        WHEN("The producer node has already completed") {
+            auto produce = producer.addNode([&]() { record("produce"); }, "produce");
+            producer.execute();
+            contractGroup.executeAllBackgroundWork();
+            producer.wait();
+            
+            auto consume = consumer.addNode([&]() { record("consume"); }, "consume");
+            consumer.addDependency(producer.getExternalHandle(produce), consume);
+            consumer.execute();
+            contractGroup.executeAllBackgroundWork();
+            
+            THEN("The dependency resolves immediately") {
+                REQUIRE(consumer.wait().completedCount == 1);
+                REQUIRE(executionOrder.back() == "consume");
+            }
+        }
+        
+        WHEN("The producer node fails") {
+            auto produce = producer.addNode([]() { throw std::runtime_error("boom"); }, "produce");
+            auto consume = consumer.addNode([&]() { record("consume"); }, "consume");
+            auto after = consumer.addNode([&]() { record("after"); }, "after");
+            consumer.addDependency(producer.getExternalHandle(produce), consume);
+            consumer.addDependency(consume, after);
+            
+            consumer.execute();
+            producer.execute();
+            contractGroup.executeAllBackgroundWork();
+            consumer.wait();
+            
+            THEN("The consumer node and its dependants are cancelled") {
+                REQUIRE(executionOrder.empty());
+                REQUIRE(consumer.getStats().cancelledNodes == 2);
+                REQUIRE(consumer.isComplete());
+            }
+        }
+        
+        WHEN("A graph is made to wait on its own completion") {
+            auto node = consumer.addNode([]() {});
+            
+            THEN("It is rejected") {
+                REQUIRE_THROWS_AS(consumer.addDependency(consumer.getCompletionHandle(), node), std::invalid_argument);
+            }
+        }
+        
+        WHEN("A link would close a cycle through both graphs") {
+            auto p1 = producer.addNode([]() {}, "p1");
+            auto p2 = producer.addNode([]() {}, "p2");
+            auto c1 = consumer.addNode([]() {}, "c1");
+            producer.addDependency(p1, p2);
+            consumer.addDependency(producer.getExternalHandle(p2), c1);
+            
+            THEN("Links back into the chain are rejected and independent ones still work") {
+                REQUIRE_THROWS_AS(producer.addDependency(consumer.getExternalHandle(c1), p1), std::invalid_argument);
+                REQUIRE_THROWS_AS(producer.addDependency(consumer.getCompletionHandle(), p1), std::invalid_argument);
+                auto p3 = producer.addNode([]() {}, "p3");
+                REQUIRE_NOTHROW(producer.addDependency(consumer.getExternalHandle(c1), p3));
+            }
+        }
+        
+        WHEN("The waiting graph is destroyed before the producer runs") {
+            auto produce = producer.addNode([&]() { record("produce"); }, "produce");
+            {
+                WorkGraph doomed(&contractGroup);
+                auto consume = doomed.addNode([&]() { record("consume"); }, "consume");
+                doomed.addDependency(producer.getExternalHandle(produce), consume);
+                doomed.addDependency(producer.getCompletionHandle(), doomed.addNode([]() {}));
+            }
+            producer.execute();
+            contractGroup.executeAllBackgroundWork();
+            
+            THEN("The producer completes without touching the destroyed graph") {
+                REQUIRE(producer.wait().completedCount == 1);
+                REQUIRE(executionOrder == std::vector<std::string>{"produce"});
+            }
+        }
+        
+        WHEN("The producer is destroyed before its node runs") {
+            auto consume = consumer.addNode([&]() { record("consume"); }, "consume");
+            {
+                WorkGraph doomed(&contractGroup);
+                auto produce = doomed.addNode([&]() { record("produce"); }, "produce");
+                consumer.addDependency(doomed.getExternalHandle(produce), consume);
+            }
+            consumer.execute();
+            contractGroup.executeAllBackgroundWork();
+            consumer.wait();
+            
+            THEN("The waiting node is cancelled instead of waiting forever") {
+                REQUIRE(executionOrder.empty());
+                REQUIRE(consumer.getStats().cancelledNodes == 1);
+                REQUIRE(consumer.isComplete());
+            }
+        }
+    }
+}
+
+namespace {
+    struct TrackedValue {
+        static inline std::atomic<int> liveCount{0};
+        int value;
+        explicit TrackedValue(int v) : value(v) { liveCount++; }
+        TrackedValue(const TrackedValue& other) : value(other.value) { liveCount++; }
+        ~TrackedValue() { liveCount--; }
+    };
+}
+
+SCENARIO("WorkGraph typed dataflow", "[workgraph][experimental][dataflow]") {
+    GIVEN("A work graph with a contract group") {
+        WorkContractGroup contractGroup(256);
+        
+        WHEN("Typed nodes form a diamond") {
+            WorkGraph graph(&contractGroup);
+            auto source = graph.addNode<int>([]() { return 20; }, "source");
+            auto left = graph.addNode<int>([](const int& x) { return x + 1; }, "left", source);
+            auto right = graph.addNode<int>([](const int& x) { return x + 1; }, "right", source);
+            auto sum = graph.addNode<std::string>([](const int& a, const int& b) {
+                return std::to_string(a + b);
+            }, "sum", left, right);
+            
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            auto result = graph.wait();
+            
+            THEN("Each node sees its parents' values and the sink stays readable") {
+                REQUIRE(result.allCompleted);
+                REQUIRE(sum.tryGet() != nullptr);
+                REQUIRE(*sum.tryGet() == "42");
+                REQUIRE(graph.getChildren(source).size() == 2);
+            }
+            
+            THEN("Consumed intermediates are already destroyed") {
+                REQUIRE(source.tryGet() == nullptr);
+                REQUIRE(left.tryGet() == nullptr);
+            }
+        }
+        
+        WHEN("A value is shared by several consumers") {
+            std::atomic<int> liveDuringLastConsumer{-1};
+            std::atomic<int> seen{0};
+            {
+                WorkGraph graph(&contractGroup);
+                auto produced = graph.addNode<TrackedValue>([]() { return TrackedValue(7); }, "produce");
+                auto first = graph.addNode<int>([&](const TrackedValue& v) {
+                    seen += v.value;
+                    return 0;
+                }, "first", produced);
+                auto second = graph.addNode<int>([&](const TrackedValue& v) {
+                    seen += v.value;
+                    return 0;
+                }, "second", produced);
+                auto check = graph.addNode([&]() {
+                    liveDuringLastConsumer = TrackedValue::liveCount.load();
+                }, "check");
+                graph.addDependency(first, check);
+                graph.addDependency(second, check);
+                
+                graph.execute();
+                contractGroup.executeAllBackgroundWork();
+                graph.wait();
+            }
+            
+            THEN("It is passed by reference and destroyed after its last consumer") {
+                REQUIRE(seen.load() == 14);
+                REQUIRE(liveDuringLastConsumer.load() == 0);
+                REQUIRE(TrackedValue::liveCount.load() == 0);
+            }
+        }
+        
+        WHEN("An input is on an untaken branch") {
+            WorkGraph graph(&contractGroup);
+            auto branch = graph.addBranchNode([]() -> uint32_t { return 1; }, "branch");
+            auto optional = graph.addNode<int>([]() { return 1; }, "optional");
+            auto always = graph.addNode<int>([]() { return 2; }, "always");
+            graph.addBranchDependency(branch, optional, 0);
+            graph.addDependency(branch, always);
+            auto combine = graph.addNode<int>([](const int& a, const int& b) { return a + b; },
+                                              "combine", optional, always);
+            
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            auto result = graph.wait();
+            
+            THEN("The consumer fails instead of reading an unproduced value") {
+                REQUIRE(result.failedCount == 1);
+                REQUIRE(combine.tryGet() == nullptr);
+            }
+        }
+        
+        WHEN("A typed node is rejected because one of its inputs failed") {
+            WorkGraph graph(&contractGroup);
+            auto kept = graph.addNode<int>([]() { return 5; }, "kept");
+            auto broken = graph.addNode<int>([]() -> int { throw std::runtime_error("broken"); }, "broken");
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            graph.wait();
+            
+            REQUIRE_THROWS_AS(graph.addNode<int>([](const int& a, const int& b) { return a + b; },
+                                                 "rejected", kept, broken),
+                              std::runtime_error);
+            std::atomic<int> read{0};
+            graph.addNode<int>([&](const int& a) { read = a; return a; }, "reader", kept);
+            contractGroup.executeAllBackgroundWork();
+            graph.wait();
+            
+            THEN("The rejected node did not register as a consumer") {
+                REQUIRE(read.load() == 5);
+                REQUIRE(kept.tryGet() == nullptr);   // Released by its only real consumer
+            }
+        }
+    }
+}
+
+SCENARIO("WorkGraph templates", "[workgraph][experimental][template]") {
+    GIVEN("A finalized diamond template") {
+        WorkContractGroup contractGroup(256);
+        
+        struct Context {
+            std::mutex mutex;
+            std::vector<std::string> order;
+            
+            void record(const char* step) {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.emplace_back(step);
+            }
+        };
+        
+        WorkGraphTemplate tmpl;
+        // Sink is added first so the template has to reorder it
+        auto sink = tmpl.addNode([](void* ctx) { static_cast<Context*>(ctx)->record("sink"); }, "sink");
+        auto source = tmpl.addNode([](void* ctx) { static_cast<Context*>(ctx)->record("source"); }, "source");
+        auto left = tmpl.addNode([](void* ctx) { static_cast<Context*>(ctx)->record("left"); }, "left");
+        auto right = tmpl.addNode([](void* ctx) { static_cast<Context*>(ctx)->record("right"); }, "right");
+        tmpl.addDependency(source, left);
+        tmpl.addDependency(source, right);
+        tmpl.addDependency(left, sink);
+        tmpl.addDependency(right, sink);
+        tmpl.addDependency(right, sink);  // Duplicate, dropped by finalize()
+        tmpl.finalize();
+        
+        THEN("The template is compacted") {
+            REQUIRE(tmpl.isFinalized());
+            REQUIRE(tmpl.getNodeCount() == 4);
+            REQUIRE(tmpl.getEdgeCount() == 4);
+            REQUIRE(tmpl.getRootCount() == 1);
+        }
+        
+        WHEN("It is instantiated several times into one graph") {
+            WorkGraph graph(&contractGroup);
+            std::vector<Context> contexts(3);
+            std::vector<std::vector<WorkGraph::NodeHandle>> instances;
+            for (auto& context : contexts) {
+                instances.push_back(graph.instantiate(tmpl, &context));
+            }
+            
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            auto result = graph.wait();
+            
+            THEN("Every instance runs in dependency order against its own context") {
+                REQUIRE(result.allCompleted);
+                REQUIRE(result.completedCount == 12);
+                for (auto& context : contexts) {
+                    REQUIRE(context.order.size() == 4);
+                    REQUIRE(context.order.front() == "source");
+                    REQUIRE(context.order.back() == "sink");
+                }
+            }
+            
+            THEN("Handles come back in template id order") {
+                for (const auto& nodes : instances) {
+                    REQUIRE(nodes.size() == 4);
+                    REQUIRE(graph.getChildren(nodes[source]).size() == 2);
+                    REQUIRE(graph.getChildren(nodes[sink]).empty());
+                    REQUIRE(nodes[left].getData()->name == "left");
+                }
+            }
+        }
+        
+        WHEN("It is instantiated after execution started") {
+            WorkGraph graph(&contractGroup);
+            Context first;
+            Context late;
+            graph.instantiate(tmpl, &first);
+            graph.execute();
+            graph.instantiate(tmpl, &late);
+            contractGroup.executeAllBackgroundWork();
+            auto result = graph.wait();
+            
+            THEN("The late instance is scheduled immediately") {
+                REQUIRE(result.allCompleted);
+                REQUIRE(late.order.size() == 4);
+                REQUIRE(late.order.back() == "sink");
+            }
+        }
+        
+        WHEN("A running node instantiates it many times") {
+            WorkGraph graph(&contractGroup);
+            std::vector<Context> contexts(64);
+            std::string observedName;
+            WorkGraph::NodeHandle spawner;
+            // Enough nodes to grow node storage several times under the running node
+            spawner = graph.addNode([&]() {
+                for (auto& context : contexts) {
+                    graph.instantiate(tmpl, &context);
+                }
+                observedName = spawner.getData()->name;
+            }, "spawner");
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+            auto result = graph.wait();
+            
+            THEN("The running node and every instance complete") {
+                REQUIRE(result.allCompleted);
+                REQUIRE(result.completedCount == 1 + contexts.size() * 4);
+                REQUIRE(observedName == "spawner");
+                for (auto& context : contexts) {
+                    REQUIRE(context.order.size() == 4);
+                }
+            }
+        }
+    }
+    
+    GIVEN("Templates that are not usable") {
+        WorkContractGroup contractGroup(64);
+        WorkGraph graph(&contractGroup);
+        
+        THEN("Cycles are rejected when finalizing") {
+            WorkGraphTemplate cyclic;
+            auto a = cyclic.addNode([](void*) {});
+            auto b = cyclic.addNode([](void*) {});
+            cyclic.addDependency(a, b);
+            cyclic.addDependency(b, a);
+            REQUIRE_THROWS_AS(cyclic.finalize(), std::invalid_argument);
+            REQUIRE_FALSE(cyclic.isFinalized());
+        }
+        
+        THEN("Unfinalized templates cannot be instantiated or edited after finalizing") {
+            WorkGraphTemplate pending;
+            auto a = pending.addNode([](void*) {});
+            REQUIRE_THROWS_AS(graph.instantiate(pending), std::logic_error);
+            pending.finalize();
+            REQUIRE_THROWS_AS(pending.addNode([](void*) {}), std::logic_error);
+            REQUIRE_THROWS_AS(pending.addDependency(a, a), std::logic_error);
+        }
+    }
+}
+
 SCENARIO("WorkGraph continuation patterns", "[workgraph][experimental][continuation]") {
     GIVEN("A work graph with continuation support") {
         WorkContractGroup contractGroup(256);
@@ -441,4 +1034,260 @@ SCENARIO("WorkGraph stress test", "[workgraph][experimental][stress][!mayfail]")
         
         service.stop();
     }
-}
\ No newline at end of file
+}
+SCENARIO("WorkGraph yielded nodes keep their contract", "[workgraph][experimental][yield]") {
+    GIVEN("A group with room for exactly one contract") {
+        WorkContractGroup contractGroup(1);
+        WorkGraphConfig config;
+        config.enableEvents = true;
+        WorkGraph graph(&contractGroup, config);
+
+        std::atomic<int> deferred{0};
+        graph.getEventBus()->subscribe<NodeDeferredEvent>([&deferred](const NodeDeferredEvent&) {
+            deferred++;
+        });
+
+        WHEN("A node yields several times before completing") {
+            int runs = 0;
+            graph.addYieldableNode([&runs]() -> WorkResult {
+                return ++runs < 6 ? WorkResult::Yield : WorkResult::Complete;
+            }, "poller");
+
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+
+            THEN("Every rerun reuses the running contract instead of waiting for a new one") {
+                REQUIRE(runs == 6);
+                REQUIRE(deferred == 0);
+                REQUIRE(graph.isComplete());
+                REQUIRE(contractGroup.activeCount() == 0);
+            }
+        }
+
+        WHEN("The node hits its reschedule limit") {
+            int runs = 0;
+            graph.addYieldableNode([&runs]() -> WorkResult {
+                ++runs;
+                return WorkResult::Yield;
+            }, "stubborn", nullptr, ExecutionType::AnyThread, 3);
+
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+
+            THEN("The contract is released once the node is treated as complete") {
+                REQUIRE(runs == 4);
+                REQUIRE(graph.isComplete());
+                REQUIRE(contractGroup.activeCount() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO("WorkGraph suspension parks ready nodes", "[workgraph][experimental][suspend]") {
+    GIVEN("A chain executed on the caller's thread") {
+        WorkContractGroup contractGroup(64);
+        WorkGraph graph(&contractGroup);
+
+        std::vector<int> order;
+        auto first = graph.addNode([&order]() { order.push_back(1); }, "first");
+        auto second = graph.addNode([&order]() { order.push_back(2); }, "second");
+        auto third = graph.addNode([&order]() { order.push_back(3); }, "third");
+        graph.addDependency(first, second);
+        graph.addDependency(second, third);
+
+        WHEN("The graph is suspended while the first node runs") {
+            graph.execute();
+            graph.suspend();
+            contractGroup.executeAllBackgroundWork();
+
+            THEN("The released dependant is parked instead of scheduled") {
+                REQUIRE(order == std::vector<int>{1});
+                REQUIRE(graph.getParkedCount() == 1);
+                REQUIRE(contractGroup.scheduledCount() == 0);
+            }
+
+            AND_WHEN("The graph is resumed") {
+                graph.resume();
+                contractGroup.executeAllBackgroundWork();
+
+                THEN("Only the parked node is rescheduled and the chain finishes") {
+                    REQUIRE(order == std::vector<int>{1, 2, 3});
+                    REQUIRE(graph.getParkedCount() == 0);
+                    REQUIRE(graph.isComplete());
+                }
+            }
+        }
+
+        WHEN("The graph is suspended before execute()") {
+            graph.suspend();
+            graph.execute();
+
+            THEN("Roots are parked and still count as roots") {
+                REQUIRE(graph.getParkedCount() == 1);
+                graph.resume();
+                contractGroup.executeAllBackgroundWork();
+                REQUIRE(graph.isComplete());
+            }
+        }
+    }
+
+    GIVEN("Two independent subsets distinguished by tag") {
+        constexpr uint32_t STREAMING = 7;
+        WorkContractGroup contractGroup(64);
+        WorkGraph graph(&contractGroup);
+
+        std::atomic<int> streamed{0};
+        std::atomic<int> simulated{0};
+        for (int i = 0; i < 4; ++i) {
+            auto node = graph.addNode([&streamed]() { streamed++; }, "stream");
+            graph.setSuspendTag(node, STREAMING);
+            graph.addNode([&simulated]() { simulated++; }, "simulate");
+        }
+
+        WHEN("Only the tag is suspended") {
+            graph.suspend(STREAMING);
+            graph.execute();
+            contractGroup.executeAllBackgroundWork();
+
+            THEN("Untagged work runs while tagged work waits") {
+                REQUIRE(graph.isSuspended(STREAMING));
+                REQUIRE_FALSE(graph.isSuspended());
+                REQUIRE(simulated == 4);
+                REQUIRE(streamed == 0);
+                REQUIRE(graph.getParkedCount() == 4);
+            }
+
+            AND_WHEN("The whole graph is suspended, then resumed while the tag stays suspended") {
+                graph.suspend();
+                graph.resume();
+                contractGroup.executeAllBackgroundWork();
+
+                THEN("Tagged nodes remain parked") {
+                    REQUIRE(streamed == 0);
+                    REQUIRE(graph.getParkedCount() == 4);
+                }
+            }
+
+            AND_WHEN("The tag is resumed") {
+                graph.resume(STREAMING);
+                contractGroup.executeAllBackgroundWork();
+
+                THEN("The tagged nodes run") {
+                    REQUIRE(streamed == 4);
+                    REQUIRE(graph.getParkedCount() == 0);
+                    REQUIRE(graph.isComplete());
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("WorkGraph shared admission across graphs", "[workgraph][experimental][admission]") {
+    GIVEN("Many graphs sharing a small contract group") {
+        constexpr int GRAPHS = 40;
+        constexpr int NODES = 12;
+        WorkContractGroup contractGroup(4);
+        std::vector<std::unique_ptr<WorkGraph>> graphs;
+        std::atomic<int> executed{0};
+
+        for (int g = 0; g < GRAPHS; ++g) {
+            auto graph = std::make_unique<WorkGraph>(&contractGroup);
+            for (int n = 0; n < NODES; ++n) {
+                graph->addNode([&executed]() { executed++; }, "node");
+            }
+            graphs.push_back(std::move(graph));
+        }
+
+        WHEN("Every graph executes and the group is drained") {
+            for (auto& graph : graphs) {
+                graph->execute();
+            }
+            REQUIRE(contractGroup.waitingAdmissionCount() > 0);
+            contractGroup.executeAllBackgroundWork();
+
+            THEN("Deferred nodes from every graph are admitted and run") {
+                REQUIRE(executed == GRAPHS * NODES);
+                REQUIRE(contractGroup.waitingAdmissionCount() == 0);
+                for (auto& graph : graphs) {
+                    REQUIRE(graph->isComplete());
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("WorkGraph nodes routed to other groups", "[workgraph][experimental][routing]") {
+    GIVEN("A graph on a bulk group with an interactive group beside it") {
+        WorkContractGroup bulkGroup(1, "Bulk");
+        WorkContractGroup interactiveGroup(1, "Interactive");
+        WorkGraph graph(&bulkGroup);
+
+        WHEN("A batch of ready nodes starts with ones bound for the full group") {
+            auto bulkA = graph.addNode([]() {}, "bulkA");
+            auto bulkB = graph.addNode([]() {}, "bulkB");
+            auto routed = graph.addNode([]() {}, "routed", nullptr,
+                                        ExecutionType::AnyThread, &interactiveGroup);
+            NodeScheduler::Config config;
+            config.batchSize = 1;
+            NodeScheduler scheduler(&bulkGroup, &graph, nullptr, config);
+            size_t scheduled = scheduler.scheduleReadyNodes({bulkA, bulkB, routed});
+
+            THEN("Capacity is checked per target group, not against the graph's group") {
+                REQUIRE(scheduled == 2);
+                REQUIRE(bulkGroup.scheduledCount() == 1);
+                REQUIRE(interactiveGroup.scheduledCount() == 1);
+                REQUIRE(scheduler.getDeferredCount(&bulkGroup) == 1);
+            }
+        }
+
+        WHEN("The bulk group is saturated") {
+            std::atomic<int> bulk{0};
+            std::atomic<int> interactive{0};
+            for (int i = 0; i < 4; ++i) {
+                graph.addNode([&bulk]() { bulk++; }, "bulk");
+            }
+            graph.addNode([&interactive]() { interactive++; }, "first", nullptr,
+                          ExecutionType::AnyThread, &interactiveGroup);
+            auto second = graph.addNode([&interactive]() { interactive++; }, "second");
+            graph.setTargetGroup(second, &interactiveGroup);
+
+            graph.execute();
+            interactiveGroup.executeAllBackgroundWork();
+
+            THEN("Routed nodes use their own group's capacity and deferral") {
+                REQUIRE(interactive == 2);
+                REQUIRE(bulk == 0);
+                REQUIRE(bulkGroup.scheduledCount() == 1);
+            }
+
+            AND_WHEN("The bulk group is drained") {
+                bulkGroup.executeAllBackgroundWork();
+                THEN("The graph completes") {
+                    REQUIRE(bulk == 4);
+                    REQUIRE(graph.isComplete());
+                }
+            }
+        }
+
+        WHEN("Dependencies cross between the groups") {
+            std::vector<std::string> order;
+            auto load = graph.addNode([&order]() { order.push_back("load"); }, "load");
+            auto present = graph.addNode([&order]() { order.push_back("present"); }, "present", nullptr,
+                                         ExecutionType::AnyThread, &interactiveGroup);
+            auto archive = graph.addNode([&order]() { order.push_back("archive"); }, "archive");
+            graph.addDependency(load, present);
+            graph.addDependency(present, archive);
+
+            graph.execute();
+            bulkGroup.executeAllBackgroundWork();
+            REQUIRE(interactiveGroup.scheduledCount() == 1);
+            interactiveGroup.executeAllBackgroundWork();
+            bulkGroup.executeAllBackgroundWork();
+
+            THEN("Each node runs on its group once its parents finish") {
+                REQUIRE(order == std::vector<std::string>{"load", "present", "archive"});
+                REQUIRE(graph.isComplete());
+            }
+        }
+    }
+}
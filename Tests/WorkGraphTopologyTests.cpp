@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Concurrency/WorkGraphTopology.h"
+#include "Concurrency/WorkGraph.h"
+#include "Concurrency/WorkContractGroup.h"
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace EntropyEngine::Core::Concurrency;
+
+namespace {
+    enum Kind : WorkGraphTemplate::KindId {
+        Load = 0,
+        Process = 1,
+        Store = 2,
+        KindCount
+    };
+
+    struct Trace {
+        std::mutex mutex;
+        std::vector<std::string> steps;
+
+        void record(const char* step) {
+            std::lock_guard<std::mutex> lock(mutex);
+            steps.emplace_back(step);
+        }
+    };
+
+    /// load -> process x width -> store, kernels left empty as an offline tool would
+    WorkGraphTemplate buildFanTemplate(uint32_t width) {
+        WorkGraphTemplate tmpl;
+        auto store = tmpl.addNode({}, "store", ExecutionType::AnyThread, Store);
+        auto load = tmpl.addNode({}, "load", ExecutionType::AnyThread, Load);
+        for (uint32_t i = 0; i < width; ++i) {
+            auto process = tmpl.addNode({}, "process", ExecutionType::AnyThread, Process);
+            tmpl.addDependency(load, process);
+            tmpl.addDependency(process, store);
+        }
+        tmpl.finalize();
+        return tmpl;
+    }
+
+    std::vector<WorkGraphTemplate::TemplateWorkFunction> traceKernels() {
+        std::vector<WorkGraphTemplate::TemplateWorkFunction> kernels(KindCount);
+        kernels[Load] = [](void* ctx) { static_cast<Trace*>(ctx)->record("load"); };
+        kernels[Process] = [](void* ctx) { static_cast<Trace*>(ctx)->record("process"); };
+        kernels[Store] = [](void* ctx) { static_cast<Trace*>(ctx)->record("store"); };
+        return kernels;
+    }
+}
+
+SCENARIO("WorkGraphTopology round-trips a template through a mapped file", "[workgraph][topology]") {
+    GIVEN("A finalized template saved to disk") {
+        auto tmpl = buildFanTemplate(8);
+        auto path = (std::filesystem::temp_directory_path() / "entropy_topology_test.egt").string();
+        WorkGraphTopology::save(tmpl, path);
+
+        WHEN("It is mapped back") {
+            auto topology = WorkGraphTopology::open(path);
+
+            THEN("The layout matches and names are interned") {
+                REQUIRE(topology.isMapped());
+                REQUIRE(topology.getNodeCount() == tmpl.getNodeCount());
+                REQUIRE(topology.getEdgeCount() == tmpl.getEdgeCount());
+                REQUIRE(topology.getRootCount() == 1);
+                REQUIRE(topology.getNameCount() == 3);
+
+                uint32_t load = topology.getPosition(1);
+                REQUIRE(topology.getName(load) == "load");
+                REQUIRE(topology.getKind(load) == Load);
+                REQUIRE(topology.getSuccessors(load).size() == 8);
+                REQUIRE(topology.getInDegree(topology.getPosition(0)) == 8);
+            }
+
+            AND_WHEN("It is bound to kernels and instantiated") {
+                auto bound = topology.bind(traceKernels());
+                WorkContractGroup contractGroup(64);
+                WorkGraph graph(&contractGroup);
+                Trace trace;
+                auto nodes = graph.instantiate(bound, &trace);
+                graph.execute();
+                contractGroup.executeAllBackgroundWork();
+                auto result = graph.wait();
+
+                THEN("Nodes run in dependency order under their original ids") {
+                    REQUIRE(result.allCompleted);
+                    REQUIRE(trace.steps.size() == 10);
+                    REQUIRE(trace.steps.front() == "load");
+                    REQUIRE(trace.steps.back() == "store");
+                    REQUIRE(nodes[0].getData()->name == "store");
+                    REQUIRE(graph.getChildren(nodes[1]).size() == 8);
+                }
+            }
+
+            AND_WHEN("The bound template outlives the topology") {
+                WorkGraphTemplate bound = topology.bind(traceKernels());
+                { auto dropped = std::move(topology); }
+                WorkContractGroup contractGroup(64);
+                WorkGraph graph(&contractGroup);
+                Trace trace;
+                graph.instantiate(bound, &trace);
+                graph.execute();
+                contractGroup.executeAllBackgroundWork();
+                auto result = graph.wait();
+
+                THEN("It still runs from the mapping and serializes to the same image") {
+                    REQUIRE(result.allCompleted);
+                    REQUIRE(trace.steps.size() == 10);
+                    REQUIRE(WorkGraphTopology::serialize(bound) == WorkGraphTopology::serialize(tmpl));
+                }
+            }
+        }
+
+        std::filesystem::remove(path);
+    }
+}
+
+SCENARIO("WorkGraphTopology rejects unusable input", "[workgraph][topology]") {
+    GIVEN("Templates that cannot be saved") {
+        THEN("Unfinalized templates and nodes without a kind are refused") {
+            WorkGraphTemplate pending;
+            pending.addNode({}, "a", ExecutionType::AnyThread, Load);
+            REQUIRE_THROWS_AS(WorkGraphTopology::serialize(pending), std::logic_error);
+
+            WorkGraphTemplate unkinded;
+            unkinded.addNode([](void*) {}, "a");
+            unkinded.finalize();
+            REQUIRE_THROWS_AS(WorkGraphTopology::serialize(unkinded), std::invalid_argument);
+        }
+    }
+
+    GIVEN("A valid image") {
+        auto image = WorkGraphTopology::serialize(buildFanTemplate(4));
+
+        THEN("It loads from memory") {
+            auto topology = WorkGraphTopology::fromBytes(image);
+            REQUIRE_FALSE(topology.isMapped());
+            REQUIRE(topology.getNodeCount() == 6);
+        }
+
+        THEN("Missing kernels are reported at bind time") {
+            auto topology = WorkGraphTopology::fromBytes(image);
+            auto kernels = traceKernels();
+            kernels[Process] = nullptr;
+            REQUIRE_THROWS_AS(topology.bind(kernels), std::invalid_argument);
+        }
+
+        THEN("Truncated or corrupted images are rejected") {
+            auto truncated = image;
+            truncated.resize(truncated.size() / 2);
+            REQUIRE_THROWS_AS(WorkGraphTopology::fromBytes(truncated), std::runtime_error);
+
+            auto badMagic = image;
+            badMagic[0] = std::byte{'X'};
+            REQUIRE_THROWS_AS(WorkGraphTopology::fromBytes(badMagic), std::runtime_error);
+
+            // Point an edge back at its source: a cycle must not load
+            auto topology = WorkGraphTopology::fromBytes(image);
+            uint32_t source = 0;
+            while (topology.getSuccessors(source).empty()) ++source;
+            auto edgeOffset = reinterpret_cast<const std::byte*>(topology.getSuccessors(source).data()) -
+                              topology.getBytes();
+            auto cyclic = image;
+            std::memcpy(cyclic.data() + edgeOffset, &source, sizeof(source));
+            REQUIRE_THROWS_AS(WorkGraphTopology::fromBytes(cyclic), std::runtime_error);
+        }
+    }
+}
+
+TEST_CASE("Loading a topology vs rebuilding the graph", "[workgraph][topology][benchmark]") {
+    constexpr uint32_t WIDTH = 1000;
+    auto image = WorkGraphTopology::serialize(buildFanTemplate(WIDTH));
+    WorkContractGroup contractGroup(64);
+
+    BENCHMARK("Rebuild via addNode/addDependency") {
+        WorkGraph graph(&contractGroup);
+        auto store = graph.addNode([]() {}, "store");
+        auto load = graph.addNode([]() {}, "load");
+        for (uint32_t i = 0; i < WIDTH; ++i) {
+            auto process = graph.addNode([]() {}, "process");
+            graph.addDependency(load, process);
+            graph.addDependency(process, store);
+        }
+        return graph.getPendingCount();
+    };
+
+    auto kernels = traceKernels();
+    BENCHMARK("Load topology, bind and instantiate") {
+        WorkGraph graph(&contractGroup);
+        auto topology = WorkGraphTopology::fromBytes(image);
+        auto bound = topology.bind(kernels);
+        graph.instantiate(bound);
+        return graph.getPendingCount();
+    };
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Concurrency/WorkServiceAutoTuner.h"
+#include "Concurrency/WorkService.h"
+#include "Concurrency/WorkContractGroup.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace EntropyEngine::Core::Concurrency;
+using namespace std::chrono_literals;
+
+namespace {
+    WorkServiceAutoTuner::Config quietConfig() {
+        WorkServiceAutoTuner::Config config;
+        config.logDecisions = false;
+        return config;
+    }
+
+    size_t totalExecuted(const std::vector<WorkService::WorkerStats>& stats) {
+        size_t total = 0;
+        for (const auto& worker : stats) total += worker.contractsExecuted;
+        return total;
+    }
+}
+
+SCENARIO("WorkService reports per-worker activity", "[workservice][autotuner]") {
+    GIVEN("A running service with one group") {
+        WorkService::Config config;
+        config.threadCount = 2;
+        WorkService service(config);
+        WorkContractGroup group(256, "Stats");
+        service.addWorkContractGroup(&group);
+        service.start();
+
+        WHEN("Contracts run and the workers go idle") {
+            for (int i = 0; i < 100; ++i) {
+                group.createContract([]() {}).schedule();
+            }
+            group.wait();
+            std::this_thread::sleep_for(50ms);
+
+            THEN("Every contract and some idle time is accounted for") {
+                auto stats = service.getWorkerStats();
+                REQUIRE(stats.size() == service.getThreadCount());
+                REQUIRE(totalExecuted(stats) == 100);
+                uint64_t idle = 0;
+                for (const auto& worker : stats) idle += worker.idleNanoseconds;
+                REQUIRE(idle > 0);
+            }
+        }
+
+        service.stop();
+        service.removeWorkContractGroup(&group);
+    }
+}
+
+SCENARIO("WorkServiceAutoTuner adapts to the workload", "[workservice][autotuner]") {
+    GIVEN("An idle service") {
+        WorkService::Config config;
+        config.threadCount = 2;
+        WorkService service(config);
+        service.start();
+        WorkServiceAutoTuner tuner(service, quietConfig());
+        size_t initialWait = service.getIdleWaitTimeout();
+
+        WHEN("The tuner observes an interval") {
+            REQUIRE(tuner.step().empty());  // Baseline only
+            std::this_thread::sleep_for(100ms);
+            auto decisions = tuner.step();
+
+            THEN("Idle workers park for longer") {
+                REQUIRE(tuner.getLastObservation().idleFraction > 0.5);
+                REQUIRE(service.getIdleWaitTimeout() == initialWait * 2);
+                REQUIRE_FALSE(decisions.empty());
+                REQUIRE(tuner.getHistory().size() == decisions.size());
+            }
+        }
+
+        service.stop();
+    }
+
+    GIVEN("A service flooded with tiny contracts") {
+        WorkService::Config config;
+        config.threadCount = 2;
+        WorkService service(config);
+        WorkContractGroup group(1024, "Flood");
+        service.addWorkContractGroup(&group);
+        service.start();
+
+        auto tunerConfig = quietConfig();
+        tunerConfig.shortContractRate = 1000.0;
+        tunerConfig.longContractRate = 10.0;
+        WorkServiceAutoTuner tuner(service, tunerConfig);
+        size_t initialConsecutive = service.getSchedulerConfig().maxConsecutiveExecutionCount;
+
+        WHEN("The tuner observes the flood") {
+            tuner.step();
+            auto deadline = std::chrono::steady_clock::now() + 100ms;
+            while (std::chrono::steady_clock::now() < deadline) {
+                group.createContract([]() {}).schedule();
+            }
+            tuner.step();
+            group.wait();
+
+            THEN("Workers stay on a group for longer runs") {
+                auto scheduler = service.getSchedulerConfig();
+                REQUIRE(scheduler.maxConsecutiveExecutionCount == initialConsecutive * 2);
+                REQUIRE(scheduler.updateCycleInterval == scheduler.maxConsecutiveExecutionCount * 2);
+            }
+        }
+
+        service.stop();
+        service.removeWorkContractGroup(&group);
+    }
+}
+
+SCENARIO("WorkServiceAutoTuner stays within its bounds", "[workservice][autotuner]") {
+    GIVEN("Bounds pinned to the current values") {
+        WorkService::Config config;
+        config.threadCount = 2;
+        WorkService service(config);
+        service.start();
+
+        auto tunerConfig = quietConfig();
+        tunerConfig.interval = 10ms;
+        tunerConfig.minIdleWaitTimeout = tunerConfig.maxIdleWaitTimeout = service.getIdleWaitTimeout();
+        tunerConfig.minSoftFailureCount = tunerConfig.maxSoftFailureCount = service.getSoftFailureCount();
+        WorkServiceAutoTuner tuner(service, tunerConfig);
+
+        WHEN("It runs in the background for a while") {
+            tuner.start();
+            REQUIRE(tuner.isRunning());
+            std::this_thread::sleep_for(100ms);
+            tuner.stop();
+
+            THEN("Nothing moved") {
+                REQUIRE_FALSE(tuner.isRunning());
+                REQUIRE(service.getIdleWaitTimeout() == tunerConfig.maxIdleWaitTimeout);
+                REQUIRE(service.getSoftFailureCount() == tunerConfig.maxSoftFailureCount);
+                REQUIRE(tuner.getHistory().empty());
+            }
+        }
+
+        service.stop();
+    }
+}
@@ -20,7 +20,9 @@ namespace Concurrency {
 thread_local AdaptiveRankingScheduler::ThreadState AdaptiveRankingScheduler::stThreadState;
 
 AdaptiveRankingScheduler::AdaptiveRankingScheduler(const Config& config)
-    : _config(config) {
+    : _config(config)
+    , _maxConsecutiveExecutionCount(config.maxConsecutiveExecutionCount)
+    , _updateCycleInterval(config.updateCycleInterval) {
 }
 
 IWorkScheduler::ScheduleResult AdaptiveRankingScheduler::selectNextGroup(
@@ -28,9 +30,9 @@ IWorkScheduler::ScheduleResult AdaptiveRankingScheduler::selectNextGroup(
     const SchedulingContext& context
 ) {
     // Phase 1: Try to execute from the current sticky group for cache locality
-    if (stThreadState.consecutiveExecutionCount < _config.maxConsecutiveExecutionCount) {
+    if (stThreadState.consecutiveExecutionCount < _maxConsecutiveExecutionCount.load(std::memory_order_relaxed)) {
         WorkContractGroup* stickyGroup = getCurrentGroupIfValid();
-        if (stickyGroup && stickyGroup->scheduledCount() > 0) {
+        if (stickyGroup && stickyGroup->approximateScheduledCount() > 0) {
             return {stickyGroup, false};
         }
     }
@@ -62,6 +64,11 @@ void AdaptiveRankingScheduler::notifyGroupsChanged(const std::vector<WorkContrac
     _groupsGeneration.fetch_add(1, std::memory_order_relaxed);
 }
 
+void AdaptiveRankingScheduler::applyTuning(size_t maxConsecutiveExecutionCount, size_t updateCycleInterval) {
+    _maxConsecutiveExecutionCount.store(maxConsecutiveExecutionCount, std::memory_order_relaxed);
+    _updateCycleInterval.store(updateCycleInterval, std::memory_order_relaxed);
+}
+
 void AdaptiveRankingScheduler::reset() {
     stThreadState.reset();
     _groupsGeneration = 0;
@@ -81,13 +88,13 @@ bool AdaptiveRankingScheduler::needsRankingUpdate(const std::vector<WorkContract
     }
     
     // 3. Update interval reached
-    if (stThreadState.rankingUpdateCounter >= _config.updateCycleInterval) {
+    if (stThreadState.rankingUpdateCounter >= _updateCycleInterval.load(std::memory_order_relaxed)) {
         return true;
     }
     
     // 4. Current sticky group has no more work
     WorkContractGroup* currentGroup = getCurrentGroupIfValid();
-    if (currentGroup && currentGroup->scheduledCount() == 0) {
+    if (currentGroup && currentGroup->approximateScheduledCount() == 0) {
         return true;
     }
     
@@ -101,10 +108,10 @@ void AdaptiveRankingScheduler::updateRankings(const std::vector<WorkContractGrou
     for (auto* group : groups) {
         if (!group) continue;
         
-        size_t scheduled = group->scheduledCount();
+        size_t scheduled = group->approximateScheduledCount();
         if (scheduled == 0) continue; // Skip groups with no work
         
-        size_t executing = group->executingCount();
+        size_t executing = group->approximateExecutingCount();
         
         // Using the SRS formula with floating point math
         double executionCountF = static_cast<double>(executing) + 1.0;
@@ -148,7 +155,7 @@ WorkContractGroup* AdaptiveRankingScheduler::executeWorkPlan(const std::vector<W
         auto it = std::find(groups.begin(), groups.end(), group);
         if (it == groups.end()) continue;
         
-        if (group->scheduledCount() > 0) {
+        if (group->approximateScheduledCount() > 0) {
             // Success! We found work
             // Set this as our new sticky group for the next loop
             stThreadState.currentGroupIndex = i;
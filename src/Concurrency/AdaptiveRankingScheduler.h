@@ -18,6 +18,7 @@
 #pragma once
 
 #include "IWorkScheduler.h"
+#include <atomic>
 #include <mutex>
 #include <unordered_map>
 
@@ -67,6 +68,8 @@ namespace Concurrency {
 class AdaptiveRankingScheduler : public IWorkScheduler {
 private:
     Config _config;
+    std::atomic<size_t> _maxConsecutiveExecutionCount;   ///< Tunable copy of Config::maxConsecutiveExecutionCount
+    std::atomic<size_t> _updateCycleInterval;            ///< Tunable copy of Config::updateCycleInterval
     
     /**
      * @brief Per-thread state for adaptive scheduling.
@@ -172,6 +175,11 @@ public:
      * Only resets calling thread. Others reset lazily on next schedule.
      */
     void reset() override;
+
+    /**
+     * @brief Updates affinity length and ranking refresh interval
+     */
+    void applyTuning(size_t maxConsecutiveExecutionCount, size_t updateCycleInterval) override;
     
     /**
      * @brief Returns "AdaptiveRanking"
@@ -0,0 +1,527 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "AsyncIO.h"
+#include "FiberWorker.h"
+#include "WorkGraph.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <exception>
+#include <format>
+#include <limits>
+
+#if defined(EntropyLinux) && __has_include(<linux/io_uring.h>)
+#define ENTROPY_ASYNCIO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#else
+#define ENTROPY_ASYNCIO_URING 0
+#endif
+
+#if defined(_WIN32)
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+#if ENTROPY_ASYNCIO_URING
+
+/**
+ * @brief Minimal io_uring wrapper over the raw syscalls
+ *
+ * Only what AsyncIO needs: one submitter at a time (callers hold _queueMutex) and one
+ * reaper. Avoids a liburing dependency. Requires IORING_OP_READ/WRITE (Linux 5.6),
+ * detected through IORING_FEAT_RW_CUR_POS which shipped in the same release.
+ */
+class AsyncIO::UringQueue {
+public:
+    static constexpr uint64_t WAKE_TAG = 0;   ///< user_data of the NOP used to wake the reaper
+
+    static std::unique_ptr<UringQueue> create(uint32_t entries) {
+        io_uring_params params{};
+        int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd < 0) {
+            return nullptr;
+        }
+
+        auto queue = std::unique_ptr<UringQueue>(new UringQueue());
+        queue->_fd = fd;
+        if (!(params.features & IORING_FEAT_RW_CUR_POS) || !queue->map(params)) {
+            return nullptr;
+        }
+        return queue;
+    }
+
+    ~UringQueue() {
+        if (_sqes) munmap(_sqes, _sqesSize);
+        if (_cqRing && _cqRing != _sqRing) munmap(_cqRing, _cqRingSize);
+        if (_sqRing) munmap(_sqRing, _sqRingSize);
+        if (_fd >= 0) close(_fd);
+    }
+
+    uint32_t capacity() const noexcept { return _sqEntries; }
+
+    /// Queues and submits one request; false if the submission ring is full
+    bool push(uint8_t opcode, int fd, uint64_t addr, uint32_t len, uint64_t offset, uint64_t tag) {
+        uint32_t tail = *_sqTail;
+        uint32_t head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        if (tail - head == _sqEntries) {
+            return false;
+        }
+
+        uint32_t index = tail & _sqMask;
+        io_uring_sqe& sqe = _sqes[index];
+        sqe = io_uring_sqe{};
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = addr;
+        sqe.len = len;
+        sqe.off = offset;
+        sqe.user_data = tag;
+        _sqArray[index] = index;
+        __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+        while (syscall(__NR_io_uring_enter, _fd, 1, 0, 0, nullptr, 0) < 0) {
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                break;   // The entry stays queued; the next enter submits it
+            }
+        }
+        return true;
+    }
+
+    /// Blocks for at least one completion, then hands every available one to sink
+    template<typename Sink>
+    size_t reap(Sink&& sink) {
+        while (syscall(__NR_io_uring_enter, _fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0) {
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        size_t count = 0;
+        uint32_t head = *_cqHead;
+        uint32_t tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const io_uring_cqe& cqe = _cqes[head & _cqMask];
+            sink(cqe.user_data, cqe.res);
+            ++head;
+            ++count;
+        }
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+private:
+    UringQueue() = default;
+
+    bool map(const io_uring_params& params) {
+        _sqEntries = params.sq_entries;
+        _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) {
+            _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+        }
+
+        _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+        if (_sqRing == MAP_FAILED) {
+            _sqRing = nullptr;
+            return false;
+        }
+        if (single) {
+            _cqRing = _sqRing;
+        } else {
+            _cqRing = mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+            if (_cqRing == MAP_FAILED) {
+                _cqRing = nullptr;
+                return false;
+            }
+        }
+
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            return false;
+        }
+        _sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<char*>(_sqRing);
+        _sqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+        _sqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+        _sqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+        _sqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+
+        auto* cq = static_cast<char*>(_cqRing);
+        _cqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+        _cqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+        _cqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+        _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    int _fd = -1;
+    uint32_t _sqEntries = 0;
+    void* _sqRing = nullptr;
+    size_t _sqRingSize = 0;
+    void* _cqRing = nullptr;
+    size_t _cqRingSize = 0;
+    io_uring_sqe* _sqes = nullptr;
+    size_t _sqesSize = 0;
+
+    uint32_t* _sqHead = nullptr;
+    uint32_t* _sqTail = nullptr;
+    uint32_t _sqMask = 0;
+    uint32_t* _sqArray = nullptr;
+    uint32_t* _cqHead = nullptr;
+    uint32_t* _cqTail = nullptr;
+    uint32_t _cqMask = 0;
+    io_uring_cqe* _cqes = nullptr;
+};
+
+#else
+
+class AsyncIO::UringQueue {};
+
+#endif
+
+AsyncIO::Result AsyncIO::Operation::getResult() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _result;
+}
+
+void AsyncIO::Operation::wait() {
+    if (FiberWorker::suspendUntil([this]() { return isComplete(); })) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _completion.wait(lock, [this]() { return _complete.load(std::memory_order_acquire); });
+}
+
+bool AsyncIO::Operation::parkUntilComplete() {
+    // finish() publishes completion under this lock, so a wake is never registered late
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_complete.load(std::memory_order_acquire)) {
+        return false;
+    }
+    _parkedNodes.push_back(WorkGraph::parkRunningNode());
+    return true;
+}
+
+AsyncIO::AsyncIO(WorkContractGroup* continuationGroup)
+    : AsyncIO(continuationGroup, Config{}) {
+}
+
+AsyncIO::AsyncIO(WorkContractGroup* continuationGroup, const Config& config)
+    : _group(continuationGroup)
+    , _config(config) {
+#if ENTROPY_ASYNCIO_URING
+    if (!_config.forceThreadPool) {
+        _uring = UringQueue::create(std::max<uint32_t>(_config.queueDepth, 1));
+    }
+#endif
+
+    if (_uring) {
+        _backend = Backend::IoUring;
+        _threads.emplace_back([this]() { reapLoop(); });
+    } else {
+        if (!_config.forceThreadPool) {
+            ENTROPY_LOG_DEBUG_CAT("Concurrency", "AsyncIO: io_uring unavailable, using blocking thread pool");
+        }
+        _backend = Backend::ThreadPool;
+        const uint32_t threads = std::max<uint32_t>(_config.threadPoolSize, 1);
+        for (uint32_t i = 0; i < threads; ++i) {
+            _threads.emplace_back([this](std::stop_token token) { threadPoolLoop(token); });
+        }
+    }
+
+    // Continuations that found the group full wait in its admission queue, so only
+    // completions that happen while some are waiting give us a turn
+    if (_group) {
+        _admissionTicket = _group->registerAdmission([this]() { return drainDeferred(); });
+    }
+}
+
+AsyncIO::~AsyncIO() {
+    waitIdle();
+
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _stopping = true;
+#if ENTROPY_ASYNCIO_URING
+        if (_uring) {
+            // Nothing is in flight, so the ring has room for the wake-up
+            _uring->push(IORING_OP_NOP, -1, 0, 0, 0, UringQueue::WAKE_TAG);
+        }
+#endif
+    }
+    _queueCondition.notify_all();
+    for (auto& thread : _threads) {
+        thread.request_stop();
+    }
+    _threads.clear();
+
+    // Every finish() has returned, so no admission request can still be in flight
+    if (_group) {
+        _group->unregisterAdmission(_admissionTicket);
+    }
+
+    // No admission turn left to retry these - run them here rather than drop them
+    std::deque<std::shared_ptr<Operation>> leftovers;
+    {
+        std::lock_guard<std::mutex> lock(_deferredMutex);
+        leftovers.swap(_deferred);
+    }
+    for (auto& op : leftovers) {
+        runContinuation(*op);
+    }
+}
+
+bool AsyncIO::isIoUringAvailable() {
+#if ENTROPY_ASYNCIO_URING
+    return UringQueue::create(1) != nullptr;
+#else
+    return false;
+#endif
+}
+
+std::shared_ptr<AsyncIO::Operation> AsyncIO::read(int fd, void* buffer, size_t size, uint64_t offset,
+                                                  Completion onComplete) {
+    auto op = std::make_shared<Operation>();
+    op->_kind = Operation::Kind::Read;
+    op->_fd = fd;
+    op->_buffer = buffer;
+    op->_size = size;
+    op->_offset = offset;
+    op->_onComplete = std::move(onComplete);
+    return submit(std::move(op));
+}
+
+std::shared_ptr<AsyncIO::Operation> AsyncIO::write(int fd, const void* buffer, size_t size, uint64_t offset,
+                                                   Completion onComplete) {
+    auto op = std::make_shared<Operation>();
+    op->_kind = Operation::Kind::Write;
+    op->_fd = fd;
+    op->_buffer = const_cast<void*>(buffer);
+    op->_size = size;
+    op->_offset = offset;
+    op->_onComplete = std::move(onComplete);
+    return submit(std::move(op));
+}
+
+void AsyncIO::waitIdle() {
+    std::unique_lock<std::mutex> lock(_idleMutex);
+    _idleCondition.wait(lock, [this]() { return _pending.load(std::memory_order_acquire) == 0; });
+}
+
+std::shared_ptr<AsyncIO::Operation> AsyncIO::submit(std::shared_ptr<Operation> op) {
+    _pending.fetch_add(1, std::memory_order_acq_rel);
+
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _queue.push_back(op);
+        if (_backend == Backend::IoUring) {
+            submitQueuedToRing();
+            return op;
+        }
+    }
+    _queueCondition.notify_one();
+    return op;
+}
+
+void AsyncIO::submitQueuedToRing() {
+#if ENTROPY_ASYNCIO_URING
+    // Keeping in-flight at or below the SQ size means the (2x larger) CQ never overflows
+    while (!_queue.empty() && _ringInFlight < _uring->capacity()) {
+        Operation* op = _queue.front().get();
+        const uint8_t opcode = op->_kind == Operation::Kind::Read ? IORING_OP_READ : IORING_OP_WRITE;
+        const uint32_t len = static_cast<uint32_t>(std::min<size_t>(op->_size, std::numeric_limits<uint32_t>::max()));
+        const uint64_t tag = reinterpret_cast<uint64_t>(op);
+        if (!_uring->push(opcode, op->_fd, reinterpret_cast<uint64_t>(op->_buffer), len, op->_offset, tag)) {
+            break;
+        }
+        op->_inFlight = std::move(_queue.front());
+        _queue.pop_front();
+        _ringInFlight++;
+    }
+#endif
+}
+
+void AsyncIO::reapLoop() {
+#if ENTROPY_ASYNCIO_URING
+    while (true) {
+        std::vector<std::pair<Operation*, Result>> done;
+        bool woken = false;
+        _uring->reap([&](uint64_t tag, int32_t res) {
+            if (tag == UringQueue::WAKE_TAG) {
+                woken = true;
+                return;
+            }
+            Result result;
+            if (res < 0) {
+                result.error = -res;
+            } else {
+                result.bytes = res;
+            }
+            done.emplace_back(reinterpret_cast<Operation*>(tag), result);
+        });
+
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _ringInFlight -= static_cast<uint32_t>(done.size());
+            submitQueuedToRing();
+            if (woken && _stopping) {
+                return;
+            }
+        }
+
+        for (auto& [op, result] : done) {
+            finish(op, result);
+        }
+    }
+#endif
+}
+
+void AsyncIO::threadPoolLoop(std::stop_token token) {
+    while (true) {
+        std::shared_ptr<Operation> op;
+        {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            _queueCondition.wait(lock, [&]() { return !_queue.empty() || _stopping || token.stop_requested(); });
+            if (_queue.empty()) {
+                return;
+            }
+            op = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        op->_inFlight = op;
+        finish(op.get(), performBlocking(*op));
+    }
+}
+
+AsyncIO::Result AsyncIO::performBlocking(const Operation& op) {
+    Result result;
+#if defined(_WIN32)
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(op._fd));
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(op._offset & 0xFFFFFFFFull);
+    overlapped.OffsetHigh = static_cast<DWORD>(op._offset >> 32);
+    const DWORD len = static_cast<DWORD>(std::min<size_t>(op._size, std::numeric_limits<DWORD>::max()));
+    DWORD transferred = 0;
+    BOOL ok = op._kind == Operation::Kind::Read
+        ? ReadFile(handle, op._buffer, len, &transferred, &overlapped)
+        : WriteFile(handle, op._buffer, len, &transferred, &overlapped);
+    if (!ok && GetLastError() != ERROR_HANDLE_EOF) {
+        result.error = static_cast<int>(GetLastError());
+    } else {
+        result.bytes = transferred;
+    }
+#else
+    ssize_t n;
+    do {
+        n = op._kind == Operation::Kind::Read
+            ? pread(op._fd, op._buffer, op._size, static_cast<off_t>(op._offset))
+            : pwrite(op._fd, op._buffer, op._size, static_cast<off_t>(op._offset));
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+        result.error = errno;
+    } else {
+        result.bytes = n;
+    }
+#endif
+    return result;
+}
+
+void AsyncIO::finish(Operation* raw, Result result) {
+    std::shared_ptr<Operation> op = std::move(raw->_inFlight);
+
+    std::vector<std::function<void()>> parked;
+    {
+        std::lock_guard<std::mutex> lock(op->_mutex);
+        op->_result = result;
+        op->_complete.store(true, std::memory_order_release);
+        parked.swap(op->_parkedNodes);
+    }
+    op->_completion.notify_all();
+    FiberWorker::notifyResumable();   // wait() on a fiber
+
+    // Parked nodes go back to their groups from here, deferring if those are full
+    for (auto& wake : parked) {
+        wake();
+    }
+
+    if (op->_onComplete) {
+        if (_group) {
+            scheduleContinuation(op);
+        } else {
+            runContinuation(*op);
+        }
+    }
+
+    if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(_idleMutex);
+        _idleCondition.notify_all();
+    }
+}
+
+void AsyncIO::scheduleContinuation(std::shared_ptr<Operation> op) {
+    auto handle = _group->createContract([op]() { runContinuation(*op); });
+    if (handle.valid()) {
+        handle.schedule();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_deferredMutex);
+        _deferred.push_back(std::move(op));
+    }
+    // Runs a turn right away if a contract finished between the failed create and the push
+    _group->requestAdmission(_admissionTicket);
+}
+
+bool AsyncIO::drainDeferred() {
+    while (true) {
+        std::shared_ptr<Operation> op;
+        {
+            std::lock_guard<std::mutex> lock(_deferredMutex);
+            if (_deferred.empty()) return false;
+            op = std::move(_deferred.front());
+            _deferred.pop_front();
+        }
+
+        auto handle = _group->createContract([op]() { runContinuation(*op); });
+        if (!handle.valid()) {
+            std::lock_guard<std::mutex> lock(_deferredMutex);
+            _deferred.push_front(std::move(op));
+            return true;
+        }
+        handle.schedule();
+    }
+}
+
+void AsyncIO::runContinuation(const Operation& op) {
+    try {
+        op._onComplete(op.getResult());
+    } catch (const std::exception& e) {
+        ENTROPY_LOG_ERROR_CAT("Concurrency", std::format("AsyncIO: completion callback threw: {}", e.what()));
+    } catch (...) {
+        ENTROPY_LOG_ERROR_CAT("Concurrency", "AsyncIO: completion callback threw");
+    }
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
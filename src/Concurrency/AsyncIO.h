@@ -0,0 +1,279 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file AsyncIO.h
+ * @brief Asynchronous file reads and writes whose completions feed a WorkContractGroup
+ *
+ * A contract that calls read() on a file holds its worker thread until the disk answers.
+ * AsyncIO takes that wait off the workers: requests go to io_uring on Linux, or to a
+ * couple of dedicated blocking threads elsewhere, and each completion schedules a
+ * continuation contract back into a group. Workers only ever see CPU work.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "WorkContractGroup.h"
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief Positional file I/O service with continuation contracts
+ *
+ * Every request is a pread/pwrite-style operation on an already open file descriptor
+ * at an explicit offset, so requests on the same descriptor never race on a file
+ * position. The caller keeps the buffer alive until the operation completes.
+ *
+ * Two backends exist. IoUring submits straight to the kernel ring and one reaper
+ * thread collects completions; requests beyond the ring depth queue in user space
+ * and are submitted as slots free up. ThreadPool runs blocking calls on a few
+ * dedicated threads and is used wherever io_uring is missing or refused (old
+ * kernels, seccomp-restricted containers, other platforms).
+ *
+ * A completion callback runs as a contract in the continuation group, so it executes
+ * on a normal worker alongside other CPU work. If the group is full the continuation
+ * waits in the group's admission queue, the same way WorkGraph defers nodes. Without
+ * a group, callbacks run directly on the I/O thread and should be short.
+ *
+ * Yieldable WorkGraph nodes can issue a request and yield on it instead of using a
+ * callback. The node is parked rather than polled: it takes no worker time while the
+ * request is in flight, and the thread that reaps the completion reschedules it.
+ *
+ * @code
+ * WorkContractGroup group(1024);
+ * AsyncIO io(&group);
+ *
+ * // Continuation style: parse runs on a worker once the bytes are in
+ * io.read(fd, buffer.data(), buffer.size(), 0, [&](const AsyncIO::Result& r) {
+ *     if (r.succeeded()) parse(buffer.data(), r.bytes);
+ * });
+ *
+ * // Yield style: the node is parked until the read lands
+ * std::shared_ptr<AsyncIO::Operation> pending;
+ * graph.addYieldableNode([&]() -> WorkResult {
+ *     if (!pending) pending = io.read(fd, header, sizeof(header), 0);
+ *     if (pending->parkUntilComplete()) return WorkResult::Yield;
+ *     if (!pending->getResult().succeeded()) throw std::runtime_error("header read failed");
+ *     return WorkResult::Complete;
+ * }, "load-header");
+ * @endcode
+ */
+class AsyncIO {
+public:
+    static constexpr uint32_t DEFAULT_QUEUE_DEPTH = 128;
+    static constexpr uint32_t DEFAULT_THREAD_POOL_SIZE = 2;
+
+    /**
+     * @brief Which mechanism carries out the requests
+     */
+    enum class Backend : uint8_t {
+        IoUring = 0,     ///< Linux io_uring, one reaper thread
+        ThreadPool = 1   ///< Blocking calls on dedicated threads
+    };
+
+    /**
+     * @brief Outcome of one operation
+     */
+    struct Result {
+        int64_t bytes = 0;   ///< Bytes transferred; may be short at end of file
+        int error = 0;       ///< errno value (GetLastError() on Windows), 0 on success
+
+        bool succeeded() const noexcept { return error == 0; }
+    };
+
+    using Completion = std::function<void(const Result&)>;
+
+    /**
+     * @brief Handle to one submitted request
+     *
+     * Shared between the caller and the service, so it stays valid after completion
+     * and after the AsyncIO is gone.
+     */
+    class Operation {
+    public:
+        /**
+         * @brief Checks whether the I/O has finished
+         * @return true once getResult() is valid
+         */
+        bool isComplete() const noexcept { return _complete.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Gets the outcome of the I/O
+         * @return Result; default-constructed while still in flight
+         */
+        Result getResult() const;
+
+        /**
+         * @brief Blocks until the I/O has finished
+         *
+         * On a fiber worker the fiber is suspended instead. The completion callback
+         * may still be queued or running when this returns.
+         */
+        void wait();
+
+        /**
+         * @brief Parks the calling yieldable WorkGraph node until the I/O has finished
+         *
+         * Call from a yieldable node and return WorkResult::Yield when this returns
+         * true. The node is not rescheduled until the completion is reaped, so it
+         * is not re-run just to find the request still in flight.
+         *
+         * @return true if the node was parked; false if the I/O already finished
+         * @throws std::runtime_error If no yieldable node is running on the calling thread
+         */
+        bool parkUntilComplete();
+
+    private:
+        friend class AsyncIO;
+
+        enum class Kind : uint8_t { Read, Write };
+
+        Kind _kind = Kind::Read;
+        int _fd = -1;
+        void* _buffer = nullptr;
+        size_t _size = 0;
+        uint64_t _offset = 0;
+        Completion _onComplete;
+        std::shared_ptr<Operation> _inFlight;       ///< Self-reference held while the kernel owns the request
+
+        std::atomic<bool> _complete{false};
+        Result _result;
+        std::vector<std::function<void()>> _parkedNodes;   ///< Wake functions of parked nodes, guarded by _mutex
+        mutable std::mutex _mutex;
+        std::condition_variable _completion;
+    };
+
+    /**
+     * @brief Construction parameters
+     */
+    struct Config {
+        uint32_t queueDepth = DEFAULT_QUEUE_DEPTH;            ///< io_uring submission entries (requests in the kernel at once)
+        uint32_t threadPoolSize = DEFAULT_THREAD_POOL_SIZE;   ///< Blocking threads for the ThreadPool backend
+        bool forceThreadPool = false;                         ///< Skip io_uring even where it is available
+    };
+
+    /**
+     * @brief Creates the service with default configuration
+     * @param continuationGroup Group completion callbacks run in, or nullptr to run them on the I/O thread
+     */
+    explicit AsyncIO(WorkContractGroup* continuationGroup = nullptr);
+
+    /**
+     * @brief Creates the service
+     * @param continuationGroup Group completion callbacks run in, or nullptr to run them on the I/O thread
+     * @param config Backend selection and sizing
+     */
+    AsyncIO(WorkContractGroup* continuationGroup, const Config& config);
+
+    /**
+     * @brief Waits for every outstanding request, then stops the I/O threads
+     *
+     * Continuations still waiting for group capacity run inline on the calling thread.
+     */
+    ~AsyncIO();
+
+    AsyncIO(const AsyncIO&) = delete;
+    AsyncIO& operator=(const AsyncIO&) = delete;
+
+    /**
+     * @brief Reads from a file at an offset
+     * @param fd Open file descriptor
+     * @param buffer Destination, alive until completion
+     * @param size Bytes to read
+     * @param offset File offset to read from
+     * @param onComplete Optional continuation, run as a contract in the continuation group
+     * @return Handle to the request
+     */
+    std::shared_ptr<Operation> read(int fd, void* buffer, size_t size, uint64_t offset,
+                                    Completion onComplete = nullptr);
+
+    /**
+     * @brief Writes to a file at an offset
+     * @param fd Open file descriptor
+     * @param buffer Source, alive until completion
+     * @param size Bytes to write
+     * @param offset File offset to write at
+     * @param onComplete Optional continuation, run as a contract in the continuation group
+     * @return Handle to the request
+     */
+    std::shared_ptr<Operation> write(int fd, const void* buffer, size_t size, uint64_t offset,
+                                     Completion onComplete = nullptr);
+
+    /**
+     * @brief Blocks until every request submitted so far has completed
+     */
+    void waitIdle();
+
+    /**
+     * @brief Gets the backend chosen at construction
+     * @return IoUring or ThreadPool
+     */
+    Backend getBackend() const noexcept { return _backend; }
+
+    /**
+     * @brief Number of requests submitted but not yet completed
+     * @return Pending request count
+     */
+    size_t getPendingCount() const noexcept { return _pending.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Checks whether io_uring can be used by this process
+     * @return true if a ring could be created
+     */
+    static bool isIoUringAvailable();
+
+private:
+    class UringQueue;
+
+    std::shared_ptr<Operation> submit(std::shared_ptr<Operation> op);
+    void finish(Operation* op, Result result);
+    void scheduleContinuation(std::shared_ptr<Operation> op);
+    bool drainDeferred();
+    void submitQueuedToRing();
+    void reapLoop();
+    void threadPoolLoop(std::stop_token token);
+    static Result performBlocking(const Operation& op);
+    static void runContinuation(const Operation& op);
+
+    WorkContractGroup* _group;                                  ///< Continuation target, may be null
+    Config _config;
+    Backend _backend = Backend::ThreadPool;
+    std::unique_ptr<UringQueue> _uring;                         ///< IoUring backend only
+    std::vector<std::jthread> _threads;                         ///< Reaper thread or pool threads
+
+    std::mutex _queueMutex;
+    std::condition_variable _queueCondition;
+    std::deque<std::shared_ptr<Operation>> _queue;              ///< Pool work, or requests waiting for ring space
+    uint32_t _ringInFlight = 0;                                 ///< Requests owned by the kernel, guarded by _queueMutex
+    bool _stopping = false;                                     ///< Guarded by _queueMutex
+
+    std::atomic<size_t> _pending{0};
+    std::mutex _idleMutex;
+    std::condition_variable _idleCondition;
+
+    std::mutex _deferredMutex;
+    std::deque<std::shared_ptr<Operation>> _deferred;           ///< Continuations that found the group full
+    WorkContractGroup::AdmissionTicket _admissionTicket;        ///< Valid only when _group is set
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
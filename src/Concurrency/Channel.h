@@ -0,0 +1,523 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file Channel.h
+ * @brief Bounded lock-free MPMC channel that cooperates with the contract scheduler
+ *
+ * Producer and consumer contracts used to hand data over through a mutex and a deque.
+ * Channel replaces that with a fixed ring of slots that any number of threads can send
+ * into and receive from without locking. Blocking calls help run contracts instead of
+ * sleeping, and a channel can schedule a consumer contract whenever data arrives, so a
+ * consumer never has to sit on a worker waiting for input.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "WorkContractGroup.h"
+#include "FiberWorker.h"
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief Bounded multi-producer multi-consumer channel
+ *
+ * The ring is the classic sequence-numbered bounded queue: each slot carries a sequence
+ * counter that tells producers and consumers whose turn it is, so one CAS on the head or
+ * tail claims a slot and no operation ever waits on another thread mid-update. Capacity
+ * is rounded up to a power of two.
+ *
+ * Blocking send()/receive() first help: if a help group was given they execute one of its
+ * contracts and retry, which keeps the pool making progress when the other side of the
+ * channel is itself a contract waiting to run. On a fiber worker they suspend the fiber;
+ * otherwise they yield for a few time slices, still helping, and then park on an atomic
+ * wait until the other side moves. Sends and receives only touch the wake epoch when
+ * someone is actually parked, so the uncontended path is the ring's own CAS and nothing else.
+ *
+ * close() wakes every waiter. Sends fail after close, receives keep draining what is
+ * left and then report the end of the stream.
+ *
+ * @code
+ * WorkContractGroup group(1024);
+ * Channel<Packet> packets(256, &group);
+ *
+ * // Consumer runs as a contract each time packets arrive, draining what it finds
+ * packets.setConsumer(&group, [](Channel<Packet>& channel) {
+ *     while (auto packet = channel.tryReceive()) {
+ *         process(*packet);
+ *     }
+ * });
+ *
+ * // Producer contracts block (helping) only when the channel is full
+ * for (auto& p : incoming) {
+ *     packets.send(std::move(p));
+ * }
+ * @endcode
+ *
+ * @tparam T Element type, must be move constructible
+ */
+template<typename T>
+class Channel {
+    static_assert(std::is_move_constructible_v<T>, "Channel elements must be move constructible");
+
+public:
+    using Consumer = std::function<void(Channel&)>;
+
+    /**
+     * @brief Creates an empty channel
+     * @param capacity Most elements buffered at once (rounded up to a power of two, at least 2)
+     * @param helpGroup Group whose contracts blocking calls execute while waiting, or nullptr
+     * @throws std::invalid_argument If capacity is 0
+     */
+    explicit Channel(size_t capacity, WorkContractGroup* helpGroup = nullptr)
+        : _helpGroup(helpGroup) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Channel requires capacity > 0");
+        }
+        _capacity = std::bit_ceil(std::max<size_t>(capacity, 2));
+        _mask = _capacity - 1;
+        _cells = std::make_unique<Cell[]>(_capacity);
+        for (size_t i = 0; i < _capacity; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Destroys undelivered elements and detaches the consumer
+     *
+     * A consumer contract must not be running or scheduled when the channel is destroyed.
+     */
+    ~Channel() {
+        clearConsumer();
+        while (tryReceive()) {
+        }
+    }
+
+    Channel(const Channel&) = delete;
+    Channel& operator=(const Channel&) = delete;
+
+    /**
+     * @brief Sends without blocking
+     * @param value Element; only moved from on success
+     * @return false if the channel is full or closed
+     */
+    template<typename U>
+    bool trySend(U&& value) {
+        if (_closed.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        size_t position = _enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[position & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // Full
+            } else {
+                position = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (cell->storage) T(std::forward<U>(value));
+        // seq_cst so that wake() and a parking receiver's canReceive() cannot both miss each other
+        cell->sequence.store(position + 1, std::memory_order_seq_cst);
+
+        wake(_sentEpoch, _receiversParked);
+        if (_hasConsumer.load(std::memory_order_acquire)) {
+            scheduleConsumer();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Receives without blocking
+     * @return The oldest element, or std::nullopt if the channel is empty
+     */
+    std::optional<T> tryReceive() {
+        size_t position = _dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &_cells[position & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (diff == 0) {
+                if (_dequeuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return std::nullopt;   // Empty
+            } else {
+                position = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* element = std::launder(reinterpret_cast<T*>(cell->storage));
+        std::optional<T> result(std::move(*element));
+        element->~T();
+        cell->sequence.store(position + _capacity, std::memory_order_seq_cst);
+
+        wake(_receivedEpoch, _sendersParked);
+        return result;
+    }
+
+    /**
+     * @brief Sends, waiting for space if the channel is full
+     * @param value Element to send
+     * @return false if the channel was closed before the element could be sent
+     */
+    template<typename U>
+    bool send(U&& value) {
+        while (true) {
+            if (trySend(std::forward<U>(value))) {
+                return true;
+            }
+            if (_closed.load(std::memory_order_acquire)) {
+                return false;
+            }
+            waitForChange(_receivedEpoch, _sendersParked, [this]() { return canSend(); });
+        }
+    }
+
+    /**
+     * @brief Receives, waiting for an element if the channel is empty
+     * @return The oldest element, or std::nullopt once the channel is closed and drained
+     */
+    std::optional<T> receive() {
+        while (true) {
+            if (auto value = tryReceive()) {
+                return value;
+            }
+            if (_closed.load(std::memory_order_acquire)) {
+                // A send may have landed between the failed receive and the close check
+                return tryReceive();
+            }
+            waitForChange(_sentEpoch, _receiversParked, [this]() { return canReceive(); });
+        }
+    }
+
+    /**
+     * @brief Closes the channel for sending and wakes all waiters
+     */
+    void close() {
+        _closed.store(true, std::memory_order_release);
+        _sentEpoch.fetch_add(1, std::memory_order_seq_cst);
+        _receivedEpoch.fetch_add(1, std::memory_order_seq_cst);
+        _sentEpoch.notify_all();
+        _receivedEpoch.notify_all();
+        FiberWorker::notifyResumable();
+    }
+
+    /**
+     * @brief Checks whether close() was called
+     * @return true once closed
+     */
+    bool isClosed() const noexcept { return _closed.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Approximate number of buffered elements
+     * @return Element count, exact only when no one is sending or receiving
+     */
+    size_t size() const noexcept {
+        size_t enqueued = _enqueuePos.load(std::memory_order_acquire);
+        size_t dequeued = _dequeuePos.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    /**
+     * @brief Checks whether the channel looks empty
+     * @return true if size() is 0
+     */
+    bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Number of slots in the ring
+     * @return Capacity after rounding
+     */
+    size_t capacity() const noexcept { return _capacity; }
+
+    /**
+     * @brief Runs a consumer contract whenever the channel has data
+     *
+     * At most one consumer contract is scheduled at a time. It is created when a send
+     * finds none pending, and again after it returns if elements are still buffered, so
+     * the consumer only needs to drain what it sees. If the group is full the channel
+     * waits in the group's admission queue and creates the contract on its turn.
+     *
+     * @param group Group the consumer contract runs in (must outlive the consumer)
+     * @param consumer Called with this channel; usually loops on tryReceive()
+     */
+    void setConsumer(WorkContractGroup* group, Consumer consumer) {
+        clearConsumer();
+
+        // Only a deferred consumer asks for turns, so completions cost nothing otherwise
+        auto ticket = group->registerAdmission([this]() {
+            if (_consumerDeferred.exchange(false, std::memory_order_acq_rel)) {
+                createConsumerContract();
+            }
+            return _consumerDeferred.load(std::memory_order_acquire);
+        });
+        {
+            std::lock_guard<std::mutex> lock(_consumerMutex);
+            _consumerGroup = group;
+            _consumer = std::make_shared<Consumer>(std::move(consumer));
+            _admissionTicket = ticket;
+        }
+        _hasConsumer.store(true, std::memory_order_release);
+
+        // Data sent before the consumer existed still needs a consumer run
+        if (!empty()) {
+            scheduleConsumer();
+        }
+    }
+
+    /**
+     * @brief Stops scheduling consumer contracts
+     *
+     * Waits for a consumer call in progress on another thread to return. A consumer
+     * contract that is already scheduled still runs, but no longer calls the consumer.
+     * Safe to call from inside the consumer.
+     */
+    void clearConsumer() {
+        _hasConsumer.store(false, std::memory_order_release);
+
+        WorkContractGroup* group;
+        WorkContractGroup::AdmissionTicket ticket;
+        std::shared_ptr<Consumer> consumer;
+        {
+            std::unique_lock<std::mutex> lock(_consumerMutex);
+            group = std::exchange(_consumerGroup, nullptr);
+            ticket = _admissionTicket;
+            consumer = std::exchange(_consumer, nullptr);
+
+            // Our own run is on the stack below us and cannot finish first
+            const uint32_t own = stRunningConsumer == this ? 1 : 0;
+            _consumerIdle.wait(lock, [this, own]() { return _consumersRunning == own; });
+        }
+        if (group) {
+            // A deferral that saw the group before we cleared it may still be requesting a turn
+            while (_admissionRequests.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+            group->unregisterAdmission(ticket);
+        }
+
+        // A dropped deferral never gets to run, so it must not keep the next consumer out
+        if (_consumerDeferred.exchange(false, std::memory_order_acq_rel)) {
+            _consumerScheduled.store(false, std::memory_order_release);
+        }
+    }
+
+private:
+    static constexpr int YIELDS_BEFORE_PARKING = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /// Wakes threads parked on epoch; without any this is a single load on the fast path
+    static void wake(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& parked) {
+        // Receivers suspended on a fiber don't register as parked
+        FiberWorker::notifyResumable();
+        // The caller's seq_cst sequence store orders before this load, pairing with the
+        // parked registration in waitForChange()
+        if (parked.load(std::memory_order_seq_cst) != 0) {
+            epoch.fetch_add(1, std::memory_order_seq_cst);
+            epoch.notify_all();
+        }
+    }
+
+    /// Whether a send could claim a slot now, or the channel closed
+    bool canSend() const {
+        size_t position = _enqueuePos.load(std::memory_order_relaxed);
+        size_t sequence = _cells[position & _mask].sequence.load(std::memory_order_seq_cst);
+        return static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position) >= 0 ||
+               _closed.load(std::memory_order_acquire);
+    }
+
+    /// Whether a receive could find an element now, or the channel closed
+    bool canReceive() const {
+        size_t position = _dequeuePos.load(std::memory_order_relaxed);
+        size_t sequence = _cells[position & _mask].sequence.load(std::memory_order_seq_cst);
+        return static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1) >= 0 ||
+               _closed.load(std::memory_order_acquire);
+    }
+
+    /// Runs one contract from the help group, if there is one ready
+    bool helpOnce() {
+        if (!_helpGroup) {
+            return false;
+        }
+        auto contract = _helpGroup->selectForExecution();
+        if (!contract.valid()) {
+            return false;
+        }
+        _helpGroup->executeContract(contract);
+        _helpGroup->completeExecution(contract);
+        return true;
+    }
+
+    /// Helps, suspends or parks until ready() may have become true
+    template<typename Ready>
+    void waitForChange(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& parked, Ready ready) {
+        if (helpOnce()) {
+            return;
+        }
+
+        if (FiberWorker::suspendUntil(ready)) {
+            return;
+        }
+
+        // The other side usually moves within a few time slices; a futex sleep per element
+        // costs far more. Contracts scheduled meanwhile still get helped.
+        for (int i = 0; i < YIELDS_BEFORE_PARKING; ++i) {
+            if (ready() || helpOnce()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+
+        // Registering before the re-check pairs with wake(): either ready() sees the other
+        // side's sequence store or wake() sees us and bumps the epoch past seen
+        parked.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t seen = epoch.load(std::memory_order_seq_cst);
+        if (!ready()) {
+            epoch.wait(seen, std::memory_order_acquire);
+        }
+        parked.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void scheduleConsumer() {
+        if (_consumerScheduled.exchange(true, std::memory_order_acq_rel)) {
+            return;   // The pending run will see this element
+        }
+        createConsumerContract();
+    }
+
+    void createConsumerContract() {
+        WorkContractGroup* group;
+        WorkContractGroup::AdmissionTicket ticket;
+        {
+            std::lock_guard<std::mutex> lock(_consumerMutex);
+            if (!_consumerGroup) {
+                _consumerScheduled.store(false, std::memory_order_release);
+                return;
+            }
+
+            auto handle = _consumerGroup->createContract([this]() { runConsumer(); });
+            if (handle.valid()) {
+                handle.schedule();
+                return;
+            }
+            _consumerDeferred.store(true, std::memory_order_release);
+            _admissionRequests.fetch_add(1, std::memory_order_acq_rel);
+            group = _consumerGroup;
+            ticket = _admissionTicket;
+        }
+
+        // Outside the lock: a turn may run right here and come back into this function
+        group->requestAdmission(ticket);
+        _admissionRequests.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void runConsumer() {
+        // Take a reference under the lock so setConsumer() can swap the callable while we run
+        std::shared_ptr<Consumer> consumer;
+        {
+            std::lock_guard<std::mutex> lock(_consumerMutex);
+            consumer = _consumer;
+            if (consumer) {
+                ++_consumersRunning;
+            }
+        }
+        if (!consumer) {
+            _consumerScheduled.store(false, std::memory_order_release);
+            return;
+        }
+
+        Channel* outer = std::exchange(stRunningConsumer, this);
+        try {
+            (*consumer)(*this);
+        } catch (...) {
+            stRunningConsumer = outer;
+            _consumerScheduled.store(false, std::memory_order_release);
+            finishConsumerRun();
+            throw;
+        }
+        stRunningConsumer = outer;
+        _consumerScheduled.store(false, std::memory_order_release);
+
+        // A send that saw us still scheduled relied on this run to pick its element up
+        if (_hasConsumer.load(std::memory_order_acquire) && !empty()) {
+            scheduleConsumer();
+        }
+        finishConsumerRun();
+    }
+
+    // Last touch of the channel from a consumer run: clearConsumer() may return, and
+    // the channel be destroyed, as soon as the lock is released
+    void finishConsumerRun() {
+        std::lock_guard<std::mutex> lock(_consumerMutex);
+        if (--_consumersRunning == 0) {
+            _consumerIdle.notify_all();
+        }
+    }
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _capacity = 0;
+    size_t _mask = 0;
+    WorkContractGroup* _helpGroup;                          ///< Contracts to run while blocked
+
+    alignas(64) std::atomic<size_t> _enqueuePos{0};         ///< Next slot to send into
+    alignas(64) std::atomic<size_t> _dequeuePos{0};         ///< Next slot to receive from
+    alignas(64) std::atomic<uint32_t> _sentEpoch{0};        ///< Bumped by sends while receivers are parked
+    alignas(64) std::atomic<uint32_t> _receivedEpoch{0};    ///< Bumped by receives while senders are parked
+    std::atomic<uint32_t> _receiversParked{0};              ///< Threads in atomic wait on _sentEpoch
+    std::atomic<uint32_t> _sendersParked{0};                ///< Threads in atomic wait on _receivedEpoch
+    std::atomic<bool> _closed{false};
+
+    static inline thread_local Channel* stRunningConsumer = nullptr;  ///< Channel whose consumer this thread is inside
+
+    std::mutex _consumerMutex;                              ///< Guards the consumer registration
+    std::condition_variable _consumerIdle;                  ///< Signalled when the last consumer call returns
+    WorkContractGroup* _consumerGroup = nullptr;
+    std::shared_ptr<Consumer> _consumer;                    ///< Shared so a running call outlives a swap
+    uint32_t _consumersRunning = 0;                         ///< Consumer calls in progress; guarded by _consumerMutex
+    WorkContractGroup::AdmissionTicket _admissionTicket;
+    std::atomic<uint32_t> _admissionRequests{0};            ///< requestAdmission() calls in flight; clearConsumer() waits them out
+    std::atomic<bool> _hasConsumer{false};
+    std::atomic<bool> _consumerScheduled{false};            ///< A consumer contract exists or is deferred
+    std::atomic<bool> _consumerDeferred{false};             ///< Waiting for group capacity
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,105 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "CostAwareScheduler.h"
+#include "WorkContractGroup.h"
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+// Thread-local state definition
+thread_local CostAwareScheduler::ThreadState CostAwareScheduler::stThreadState;
+
+CostAwareScheduler::CostAwareScheduler(const Config& config)
+    : _config(config)
+    , _instanceId(allocateInstanceId())
+    , _maxConsecutiveExecutionCount(config.maxConsecutiveExecutionCount) {
+}
+
+double CostAwareScheduler::estimateRemainingWork(const WorkContractGroup* group, double fallbackCost) {
+    double cost = static_cast<double>(group->averageContractDuration().count());
+    if (cost <= 0.0) {
+        cost = fallbackCost;
+    }
+    return static_cast<double>(group->approximateScheduledCount()) * cost;
+}
+
+IWorkScheduler::ScheduleResult CostAwareScheduler::selectNextGroup(
+    const std::vector<WorkContractGroup*>& groups,
+    const SchedulingContext& /*context*/
+) {
+    auto& state = stThreadState;
+    uint64_t generation = _groupsGeneration.load(std::memory_order_relaxed);
+    if (state.owner != _instanceId || state.lastSeenGeneration != generation) {
+        state.owner = _instanceId;
+        state.currentGroup = nullptr;
+        state.lastSeenGeneration = generation;
+    }
+
+    // Phase 1: Stay on the current group for cache locality
+    if (state.currentGroup && state.consecutiveExecutionCount < _maxConsecutiveExecutionCount.load(std::memory_order_relaxed) &&
+        state.currentGroup->approximateScheduledCount() > 0) {
+        return {state.currentGroup, false};
+    }
+
+    // Phase 2: Cost unmeasured groups at the mean of the measured ones
+    double measuredTotal = 0.0;
+    size_t measuredCount = 0;
+    for (auto* group : groups) {
+        if (!group) continue;
+        auto duration = group->averageContractDuration().count();
+        if (duration > 0) {
+            measuredTotal += static_cast<double>(duration);
+            measuredCount++;
+        }
+    }
+    double fallbackCost = measuredCount > 0 ? measuredTotal / static_cast<double>(measuredCount) : 1.0;
+
+    // Phase 3: Most remaining work per worker already on the group wins
+    WorkContractGroup* best = nullptr;
+    double bestRank = 0.0;
+    for (auto* group : groups) {
+        if (!group || group->approximateScheduledCount() == 0) continue;
+
+        double remaining = estimateRemainingWork(group, fallbackCost);
+        double rank = remaining / (static_cast<double>(group->approximateExecutingCount()) + 1.0);
+        if (!best || rank > bestRank) {
+            best = group;
+            bestRank = rank;
+        }
+    }
+
+    state.currentGroup = best;
+    state.consecutiveExecutionCount = 0;
+    if (best) {
+        return {best, false};
+    }
+    return {nullptr, true};
+}
+
+void CostAwareScheduler::notifyWorkExecuted(WorkContractGroup* /*group*/, size_t /*threadId*/) {
+    stThreadState.consecutiveExecutionCount++;
+}
+
+void CostAwareScheduler::notifyGroupsChanged(const std::vector<WorkContractGroup*>& /*newGroups*/) {
+    _groupsGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CostAwareScheduler::applyTuning(size_t maxConsecutiveExecutionCount, size_t /*updateCycleInterval*/) {
+    _maxConsecutiveExecutionCount.store(maxConsecutiveExecutionCount, std::memory_order_relaxed);
+}
+
+void CostAwareScheduler::reset() {
+    stThreadState = ThreadState{};
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,133 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file CostAwareScheduler.h
+ * @brief Scheduler that weighs each group's backlog by how long its contracts take
+ *
+ * This file contains CostAwareScheduler, which ranks groups by estimated remaining
+ * work (scheduled contracts times their sampled average duration) rather than by
+ * contract count alone.
+ */
+
+#pragma once
+
+#include "IWorkScheduler.h"
+#include <atomic>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief Scheduler that allocates workers by estimated remaining work
+ *
+ * AdaptiveRankingScheduler ranks by contract counts, so a group holding ten 50ms
+ * contracts looks lighter than one holding a thousand 5µs contracts, although it is
+ * the one that will finish last. CostAwareScheduler multiplies each group's scheduled
+ * count by WorkContractGroup::averageContractDuration(), a sampled moving average kept
+ * by the group, and sends workers where the most time remains:
+ *
+ * `rank = scheduledWork * averageDuration / (executingWork + 1)`
+ *
+ * This is longest-remaining-first over the workers a group already has, which shortens
+ * the makespan of mixed workloads: long-running groups start early and get more
+ * workers, while short groups are still drained by whoever frees up. Groups that have
+ * not been timed yet are costed at the mean of those that have.
+ *
+ * Threads keep affinity to their chosen group for up to maxConsecutiveExecutionCount
+ * contracts, like AdaptiveRankingScheduler, and re-rank the live group list when it
+ * runs dry or the limit is reached.
+ *
+ * @code
+ * IWorkScheduler::Config config;
+ * config.maxConsecutiveExecutionCount = 4;
+ * WorkService service(wsConfig, std::make_unique<CostAwareScheduler>(config));
+ * @endcode
+ */
+class CostAwareScheduler : public IWorkScheduler {
+private:
+    Config _config;
+    uint64_t _instanceId;                               ///< Unique per scheduler; tags thread-local state
+    std::atomic<size_t> _maxConsecutiveExecutionCount;  ///< Tunable copy of Config::maxConsecutiveExecutionCount
+
+    /// Per-thread affinity state
+    struct ThreadState {
+        uint64_t owner = 0;                             ///< Instance id of the scheduler this state belongs to
+        WorkContractGroup* currentGroup = nullptr;      ///< Group this thread is sticking to
+        size_t consecutiveExecutionCount = 0;           ///< Contracts run from currentGroup in a row
+        uint64_t lastSeenGeneration = 0;                ///< Group list generation currentGroup came from
+    };
+
+    /// Thread-local affinity state; selection itself only reads group counters
+    static thread_local ThreadState stThreadState;
+
+    // Generation counter for detecting group list changes
+    std::atomic<uint64_t> _groupsGeneration{0};
+
+public:
+    /**
+     * @brief Constructs cost-aware scheduler with given configuration
+     *
+     * @param config Scheduler configuration; maxConsecutiveExecutionCount sets stickiness
+     */
+    explicit CostAwareScheduler(const Config& config);
+
+    ~CostAwareScheduler() override = default;
+
+    /**
+     * @brief Selects the group with the most estimated remaining work per worker
+     *
+     * @param groups Available work groups
+     * @param context Current thread context
+     * @return Selected group or nullptr if no work available
+     */
+    ScheduleResult selectNextGroup(
+        const std::vector<WorkContractGroup*>& groups,
+        const SchedulingContext& context
+    ) override;
+
+    /**
+     * @brief Counts consecutive executions for affinity
+     */
+    void notifyWorkExecuted(WorkContractGroup* group, size_t threadId) override;
+
+    /**
+     * @brief Drops affinity to groups that may have been removed
+     */
+    void notifyGroupsChanged(const std::vector<WorkContractGroup*>& newGroups) override;
+
+    /**
+     * @brief Resets the calling thread's affinity
+     */
+    void reset() override;
+
+    /**
+     * @brief Updates affinity length; the refresh interval is unused
+     */
+    void applyTuning(size_t maxConsecutiveExecutionCount, size_t updateCycleInterval) override;
+
+    /**
+     * @brief Returns "CostAware"
+     */
+    const char* getName() const override { return "CostAware"; }
+
+    /**
+     * @brief Estimated time to drain a group's scheduled contracts on one worker
+     *
+     * @param group Group to estimate
+     * @param fallbackCost Per-contract cost in nanoseconds for an unmeasured group
+     * @return scheduledCount() times the sampled average duration, in nanoseconds
+     */
+    static double estimateRemainingWork(const WorkContractGroup* group, double fallbackCost);
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
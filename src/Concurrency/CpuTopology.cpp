@@ -0,0 +1,375 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "CpuTopology.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#if defined(EntropyLinux)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+namespace {
+    namespace fs = std::filesystem;
+
+    bool readLine(const fs::path& path, std::string& line) {
+        std::ifstream file(path);
+        return file && std::getline(file, line);
+    }
+
+    bool readNumber(const fs::path& path, long long& value) {
+        std::string line;
+        if (!readLine(path, line)) {
+            return false;
+        }
+        try {
+            value = std::stoll(line);
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    /// Parses a kernel CPU list such as "0-3,8,10-11"
+    std::vector<uint32_t> parseCpuList(const std::string& list) {
+        std::vector<uint32_t> cpus;
+        std::stringstream stream(list);
+        std::string range;
+        while (std::getline(stream, range, ',')) {
+            try {
+                size_t dash = range.find('-');
+                uint32_t first = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+                uint32_t last = dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+                for (uint32_t cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            } catch (...) {
+                // Tolerate trailing newlines and blanks
+            }
+        }
+        return cpus;
+    }
+
+    /// Smallest CPU in a sysfs list file - a stable id for the set of CPUs it names
+    bool readDomain(const fs::path& path, uint32_t& domain) {
+        std::string line;
+        if (!readLine(path, line)) {
+            return false;
+        }
+        auto cpus = parseCpuList(line);
+        if (cpus.empty()) {
+            return false;
+        }
+        domain = *std::min_element(cpus.begin(), cpus.end());
+        return true;
+    }
+
+    std::vector<uint32_t> readAffinity() {
+        std::vector<uint32_t> cpus;
+#if defined(EntropyLinux)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+#endif
+        if (cpus.empty()) {
+            uint32_t count = std::max(1u, std::thread::hardware_concurrency());
+            for (uint32_t cpu = 0; cpu < count; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+
+    /// Tightest quota (in CPUs) from cgroup directory `leaf` up to and including `root`
+    template<typename ReadLimit>
+    double walkCgroupLimits(const fs::path& root, fs::path leaf, ReadLimit readLimit) {
+        double tightest = 0.0;
+        std::error_code ec;
+        if (!leaf.has_filename()) {
+            leaf = leaf.parent_path();   // Drop the trailing separator of "<root>/"
+        }
+        if (!fs::exists(leaf, ec)) {
+            // Without a cgroup namespace the recorded path is the host's; our own
+            // cgroup is then what is mounted at the root
+            leaf = root;
+        }
+        for (fs::path dir = leaf; ; dir = dir.parent_path()) {
+            double limit = readLimit(dir);
+            if (limit > 0.0 && (tightest == 0.0 || limit < tightest)) {
+                tightest = limit;
+            }
+            if (dir == root || dir == dir.parent_path() || dir.native().size() <= root.native().size()) {
+                break;
+            }
+        }
+        return tightest;
+    }
+
+    double tighter(double a, double b) {
+        if (a == 0.0) return b;
+        if (b == 0.0) return a;
+        return std::min(a, b);
+    }
+
+    double readCgroupQuota(const CpuTopology::Sources& sources) {
+        std::ifstream cgroups(fs::path(sources.procRoot) / "self" / "cgroup");
+        if (!cgroups) {
+            return 0.0;
+        }
+
+        // Hybrid hosts list both v1 and v2 hierarchies; whichever one carries a limit counts
+        double tightest = 0.0;
+
+        const fs::path mount = fs::path(sources.sysRoot) / "fs" / "cgroup";
+        std::string line;
+        while (std::getline(cgroups, line)) {
+            // Format: hierarchy-id:controller-list:path
+            size_t first = line.find(':');
+            size_t second = first == std::string::npos ? first : line.find(':', first + 1);
+            if (second == std::string::npos) {
+                continue;
+            }
+            std::string controllers = line.substr(first + 1, second - first - 1);
+            std::string path = line.substr(second + 1);
+            std::string relative = path.empty() || path == "/" ? std::string() : path.substr(1);
+
+            if (line.compare(0, first, "0") == 0 && controllers.empty()) {
+                // cgroup v2: cpu.max holds "<quota> <period>" or "max <period>"
+                tightest = tighter(tightest, walkCgroupLimits(mount, mount / relative, [](const fs::path& dir) {
+                    std::string value;
+                    if (!readLine(dir / "cpu.max", value)) {
+                        return 0.0;
+                    }
+                    std::stringstream stream(value);
+                    std::string quota;
+                    double period = 0.0;
+                    stream >> quota >> period;
+                    if (quota == "max" || period <= 0.0) {
+                        return 0.0;
+                    }
+                    try {
+                        return std::stod(quota) / period;
+                    } catch (...) {
+                        return 0.0;
+                    }
+                }));
+                continue;
+            }
+
+            std::stringstream list(controllers);
+            std::string controller;
+            while (std::getline(list, controller, ',')) {
+                if (controller != "cpu") {
+                    continue;
+                }
+                // cgroup v1: the cpu controller is mounted as cpu,cpuacct or plain cpu
+                for (const char* name : {"cpu,cpuacct", "cpuacct,cpu", "cpu"}) {
+                    fs::path root = mount / name;
+                    std::error_code ec;
+                    if (!fs::exists(root, ec)) {
+                        continue;
+                    }
+                    tightest = tighter(tightest, walkCgroupLimits(root, root / relative, [](const fs::path& dir) {
+                        long long quota = 0;
+                        long long period = 0;
+                        if (!readNumber(dir / "cpu.cfs_quota_us", quota) || !readNumber(dir / "cpu.cfs_period_us", period) ||
+                            quota <= 0 || period <= 0) {
+                            return 0.0;
+                        }
+                        return static_cast<double>(quota) / static_cast<double>(period);
+                    }));
+                    break;
+                }
+            }
+        }
+        return tightest;
+    }
+
+    void readCpuLayout(const CpuTopology::Sources& sources, LogicalCpu& cpu) {
+        const fs::path base = fs::path(sources.sysRoot) / "devices" / "system" / "cpu" / ("cpu" + std::to_string(cpu.id));
+
+        // Flat defaults: every CPU its own core and L2, one package sharing one L3
+        cpu.coreId = cpu.id;
+        cpu.packageId = 0;
+        cpu.l2Domain = cpu.id;
+        cpu.l3Domain = 0;
+
+        long long package = 0;
+        if (readNumber(base / "topology" / "physical_package_id", package) && package >= 0) {
+            cpu.packageId = static_cast<uint32_t>(package);
+            cpu.l3Domain = cpu.packageId;
+        }
+        if (!readDomain(base / "topology" / "core_cpus_list", cpu.coreId)) {
+            readDomain(base / "topology" / "thread_siblings_list", cpu.coreId);
+        }
+        cpu.l2Domain = cpu.coreId;
+
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(base / "cache", ec)) {
+            const fs::path& index = entry.path();
+            if (index.filename().string().rfind("index", 0) != 0) {
+                continue;
+            }
+            long long level = 0;
+            std::string type;
+            if (!readNumber(index / "level", level) || !readLine(index / "type", type) || type == "Instruction") {
+                continue;
+            }
+            if (level == 2) {
+                readDomain(index / "shared_cpu_list", cpu.l2Domain);
+            } else if (level == 3) {
+                readDomain(index / "shared_cpu_list", cpu.l3Domain);
+            }
+        }
+    }
+}
+
+bool WorkerLocality::sharesCache(size_t a, size_t b, CacheLevel level) const noexcept {
+    if (a >= size() || b >= size()) {
+        return false;
+    }
+    const auto& domains = level == CacheLevel::L2 ? l2Domains : l3Domains;
+    return domains[a] == domains[b];
+}
+
+std::vector<size_t> WorkerLocality::getNeighbours(size_t worker, CacheLevel level) const {
+    std::vector<size_t> neighbours;
+    for (size_t other = 0; other < size(); ++other) {
+        if (other != worker && sharesCache(worker, other, level)) {
+            neighbours.push_back(other);
+        }
+    }
+    return neighbours;
+}
+
+const CpuTopology& CpuTopology::get() {
+    static const CpuTopology topology = discover();
+    return topology;
+}
+
+CpuTopology CpuTopology::discover() {
+    return discover(Sources{});
+}
+
+CpuTopology CpuTopology::discover(const Sources& sources) {
+    CpuTopology topology;
+    std::vector<uint32_t> allowed = sources.allowedCpus.empty() ? readAffinity() : sources.allowedCpus;
+    std::sort(allowed.begin(), allowed.end());
+    allowed.erase(std::unique(allowed.begin(), allowed.end()), allowed.end());
+
+    for (uint32_t id : allowed) {
+        LogicalCpu cpu;
+        cpu.id = id;
+#if defined(EntropyLinux)
+        readCpuLayout(sources, cpu);
+#else
+        cpu.coreId = id;
+        cpu.l2Domain = id;
+#endif
+        topology._cpus.push_back(cpu);
+    }
+
+#if defined(EntropyLinux)
+    topology._cpuQuota = readCgroupQuota(sources);
+#endif
+    return topology;
+}
+
+uint32_t CpuTopology::getRecommendedWorkerCount() const noexcept {
+    uint32_t count = static_cast<uint32_t>(_cpus.size());
+    if (_cpuQuota > 0.0) {
+        count = std::min(count, static_cast<uint32_t>(std::ceil(_cpuQuota)));
+    }
+    return std::max(count, 1u);
+}
+
+size_t CpuTopology::getCoreCount() const {
+    std::set<uint32_t> cores;
+    for (const auto& cpu : _cpus) {
+        cores.insert(cpu.coreId);
+    }
+    return cores.size();
+}
+
+size_t CpuTopology::getPackageCount() const {
+    std::set<uint32_t> packages;
+    for (const auto& cpu : _cpus) {
+        packages.insert(cpu.packageId);
+    }
+    return packages.size();
+}
+
+WorkerLocality CpuTopology::planWorkers(uint32_t workerCount) const {
+    // Rank each CPU by its position among its core's siblings, so the first pass
+    // takes one hardware thread per core
+    std::vector<std::pair<size_t, const LogicalCpu*>> ranked;
+    for (const auto& cpu : _cpus) {
+        size_t sibling = 0;
+        for (const auto& other : _cpus) {
+            if (other.coreId == cpu.coreId && other.id < cpu.id) {
+                ++sibling;
+            }
+        }
+        ranked.emplace_back(sibling, &cpu);
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+        if (a.first != b.first) return a.first < b.first;
+        if (a.second->packageId != b.second->packageId) return a.second->packageId < b.second->packageId;
+        if (a.second->l3Domain != b.second->l3Domain) return a.second->l3Domain < b.second->l3Domain;
+        if (a.second->l2Domain != b.second->l2Domain) return a.second->l2Domain < b.second->l2Domain;
+        return a.second->id < b.second->id;
+    });
+
+    WorkerLocality locality;
+    if (ranked.empty()) {
+        return locality;
+    }
+    for (uint32_t worker = 0; worker < workerCount; ++worker) {
+        const LogicalCpu& cpu = *ranked[worker % ranked.size()].second;
+        locality.cpus.push_back(cpu.id);
+        locality.l2Domains.push_back(cpu.l2Domain);
+        locality.l3Domains.push_back(cpu.l3Domain);
+    }
+    return locality;
+}
+
+bool CpuTopology::pinCurrentThread(uint32_t cpu) {
+#if defined(EntropyLinux)
+    if (cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,183 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file CpuTopology.h
+ * @brief Discovery of the CPUs this process may actually use, and how they share caches
+ *
+ * std::thread::hardware_concurrency() reports every CPU in the machine. Inside a container
+ * or under taskset the process may be limited to a few of them by its affinity mask, and
+ * a cgroup CPU quota can throttle it further. Sizing a worker pool from the raw count
+ * then oversubscribes: threads preempt each other and the quota runs out early in each
+ * period. CpuTopology reads the real limits and the core/cache layout of the CPUs that
+ * remain.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief Cache level used for locality queries
+ */
+enum class CacheLevel : uint8_t {
+    L2 = 2,
+    L3 = 3
+};
+
+/**
+ * @brief One logical CPU the process is allowed to run on
+ *
+ * Domain ids are opaque: two CPUs share a core, package or cache exactly when
+ * the corresponding ids are equal.
+ */
+struct LogicalCpu {
+    uint32_t id = 0;            ///< OS CPU number
+    uint32_t coreId = 0;        ///< Physical core (SMT siblings share it)
+    uint32_t packageId = 0;     ///< Socket
+    uint32_t l2Domain = 0;      ///< CPUs sharing this CPU's L2
+    uint32_t l3Domain = 0;      ///< CPUs sharing this CPU's L3
+};
+
+/**
+ * @brief Planned placement of a worker pool onto CPUs
+ *
+ * Entry i describes worker i. Placement is only binding when workers are pinned
+ * (WorkService::Config::pinWorkers); otherwise it records where the workers would go
+ * and the OS is free to migrate them.
+ */
+struct WorkerLocality {
+    std::vector<uint32_t> cpus;         ///< CPU per worker
+    std::vector<uint32_t> l2Domains;    ///< L2 domain per worker
+    std::vector<uint32_t> l3Domains;    ///< L3 domain per worker
+
+    size_t size() const noexcept { return cpus.size(); }
+    bool empty() const noexcept { return cpus.empty(); }
+
+    /**
+     * @brief Checks whether two workers share a cache
+     * @param a First worker id
+     * @param b Second worker id
+     * @param level Cache level to compare
+     * @return true if both ids are known and share the cache
+     */
+    bool sharesCache(size_t a, size_t b, CacheLevel level) const noexcept;
+
+    /**
+     * @brief Lists the other workers sharing a cache with one worker
+     * @param worker Worker id
+     * @param level Cache level to compare
+     * @return Worker ids, excluding worker itself
+     */
+    std::vector<size_t> getNeighbours(size_t worker, CacheLevel level) const;
+};
+
+/**
+ * @brief Snapshot of the usable CPUs, their layout and the CPU quota
+ *
+ * On Linux, discovery reads:
+ * - the affinity mask from sched_getaffinity()
+ * - the quota from cgroup v2 cpu.max, or cgroup v1 cpu.cfs_quota_us / cpu.cfs_period_us
+ *   (the tightest limit on the path to the root wins)
+ * - core, package and cache sharing from /sys/devices/system/cpu
+ *
+ * Missing files degrade gracefully: each CPU becomes its own core and L2 domain, and
+ * shares one package and L3. Other platforms get that same flat layout over
+ * hardware_concurrency() CPUs.
+ *
+ * @code
+ * const auto& topology = CpuTopology::get();
+ * uint32_t workers = topology.getRecommendedWorkerCount();   // 4 in a 4-CPU container on a 64-core host
+ * @endcode
+ */
+class CpuTopology {
+public:
+    /**
+     * @brief Where discovery reads from; overridable so tests can supply fake trees
+     */
+    struct Sources {
+        std::string procRoot = "/proc";              ///< Root holding self/cgroup
+        std::string sysRoot = "/sys";                ///< Root holding fs/cgroup and devices/system/cpu
+        std::vector<uint32_t> allowedCpus;           ///< Overrides the affinity mask when non-empty
+    };
+
+    /**
+     * @brief Topology of the running process, discovered on first call
+     * @return Process-wide snapshot
+     */
+    static const CpuTopology& get();
+
+    /**
+     * @brief Runs discovery now against the live system
+     * @return Fresh snapshot
+     */
+    static CpuTopology discover();
+
+    /**
+     * @brief Runs discovery now
+     * @param sources Locations to read from
+     * @return Fresh snapshot
+     */
+    static CpuTopology discover(const Sources& sources);
+
+    /**
+     * @brief CPUs in the affinity mask, ordered by id
+     * @return Never empty
+     */
+    const std::vector<LogicalCpu>& getCpus() const noexcept { return _cpus; }
+
+    /**
+     * @brief CPU quota in CPUs (quota / period)
+     * @return 0 when unlimited
+     */
+    double getCpuQuota() const noexcept { return _cpuQuota; }
+
+    /**
+     * @brief Number of workers that can run without oversubscribing
+     * @return min(allowed CPUs, quota rounded up), at least 1
+     */
+    uint32_t getRecommendedWorkerCount() const noexcept;
+
+    size_t getCoreCount() const;
+    size_t getPackageCount() const;
+
+    /**
+     * @brief Chooses a CPU for each of workerCount workers
+     *
+     * Fills one hardware thread per physical core first, with cores of the same L3
+     * next to each other, and only then doubles up on SMT siblings. Adjacent worker
+     * ids therefore tend to share an L3. More workers than CPUs wrap around.
+     *
+     * @param workerCount Pool size
+     * @return Placement for each worker
+     */
+    WorkerLocality planWorkers(uint32_t workerCount) const;
+
+    /**
+     * @brief Restricts the calling thread to one CPU
+     * @param cpu OS CPU number
+     * @return false if unsupported or rejected by the OS
+     */
+    static bool pinCurrentThread(uint32_t cpu);
+
+private:
+    std::vector<LogicalCpu> _cpus;
+    double _cpuQuota = 0.0;
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -92,7 +92,7 @@ public:
     ) override {
         // Just scan and return first group with work
         for (auto* group : groups) {
-            if (group && group->scheduledCount() > 0) {
+            if (group && group->approximateScheduledCount() > 0) {
                 return {group, false};
             }
         }
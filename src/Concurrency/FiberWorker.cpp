@@ -0,0 +1,440 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "FiberWorker.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <mutex>
+#include <stdexcept>
+
+#if ENTROPY_FIBERS_SUPPORTED && !defined(ENTROPY_FIBERS_UCONTEXT) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__aarch64__))
+#define ENTROPY_FIBERS_ASM 1
+#else
+#define ENTROPY_FIBERS_ASM 0
+#endif
+
+#if ENTROPY_FIBERS_SUPPORTED
+#include <sys/mman.h>
+#include <unistd.h>
+#if !ENTROPY_FIBERS_ASM
+#include <ucontext.h>
+#endif
+#endif
+
+#if ENTROPY_FIBERS_ASM
+
+/**
+ * entropy_fiber_switch(void** saveSp, void* loadSp)
+ *
+ * Pushes the callee-saved registers and FP control state, stores the stack pointer
+ * through saveSp, switches to loadSp and pops the same frame from there. A new fiber's
+ * stack is seeded with that frame so the final ret lands in FiberWorker::fiberEntry.
+ */
+#if defined(__x86_64__)
+asm(R"(
+    .text
+    .globl entropy_fiber_switch
+    .hidden entropy_fiber_switch
+    .type entropy_fiber_switch, @function
+    .p2align 4
+entropy_fiber_switch:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    subq $16, %rsp
+    stmxcsr 8(%rsp)
+    fnstcw (%rsp)
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    fldcw (%rsp)
+    ldmxcsr 8(%rsp)
+    addq $16, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size entropy_fiber_switch, .-entropy_fiber_switch
+)");
+#elif defined(__aarch64__)
+asm(R"(
+    .text
+    .globl entropy_fiber_switch
+    .hidden entropy_fiber_switch
+    .type entropy_fiber_switch, %function
+    .p2align 4
+entropy_fiber_switch:
+    sub sp, sp, #176
+    stp x19, x20, [sp, #0]
+    stp x21, x22, [sp, #16]
+    stp x23, x24, [sp, #32]
+    stp x25, x26, [sp, #48]
+    stp x27, x28, [sp, #64]
+    stp x29, x30, [sp, #80]
+    stp d8, d9, [sp, #96]
+    stp d10, d11, [sp, #112]
+    stp d12, d13, [sp, #128]
+    stp d14, d15, [sp, #144]
+    mrs x9, fpcr
+    str x9, [sp, #160]
+    mov x9, sp
+    str x9, [x0]
+    mov sp, x1
+    ldr x9, [sp, #160]
+    msr fpcr, x9
+    ldp x19, x20, [sp, #0]
+    ldp x21, x22, [sp, #16]
+    ldp x23, x24, [sp, #32]
+    ldp x25, x26, [sp, #48]
+    ldp x27, x28, [sp, #64]
+    ldp x29, x30, [sp, #80]
+    ldp d8, d9, [sp, #96]
+    ldp d10, d11, [sp, #112]
+    ldp d12, d13, [sp, #128]
+    ldp d14, d15, [sp, #144]
+    add sp, sp, #176
+    ret
+    .size entropy_fiber_switch, .-entropy_fiber_switch
+)");
+#endif
+
+extern "C" void entropy_fiber_switch(void** saveSp, void* loadSp);
+
+#endif
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+namespace {
+    std::array<FiberWorker::FiberLocal, FiberWorker::MAX_FIBER_LOCALS> gFiberLocals{};
+    std::atomic<size_t> gFiberLocalCount{0};
+    std::mutex gFiberLocalMutex;
+
+    // notifyResumable() state shared by every worker in the process
+    std::atomic<size_t> gSuspendedFibers{0};
+    std::atomic<uint64_t> gResumeEpoch{0};
+    std::mutex gWakeMutex;
+    std::vector<FiberWorker*> gWakeTargets;                 ///< Workers with a wake hook, guarded by gWakeMutex
+
+    void runGuarded(const std::function<void()>& work) {
+        try {
+            work();
+        } catch (const std::exception& e) {
+            ENTROPY_LOG_ERROR_CAT("Concurrency", std::format("Uncaught exception in fiber work: {}", e.what()));
+        } catch (...) {
+            ENTROPY_LOG_ERROR_CAT("Concurrency", "Uncaught exception in fiber work");
+        }
+    }
+}
+
+struct FiberWorker::Fiber {
+#if ENTROPY_FIBERS_ASM
+    void* stackPointer = nullptr;                           ///< Saved by entropy_fiber_switch while switched out
+#elif ENTROPY_FIBERS_SUPPORTED
+    ucontext_t context{};
+#endif
+    void* mapping = nullptr;                                ///< Guard page + stack
+    size_t mappingSize = 0;
+    FiberWorker* owner = nullptr;
+    std::function<void()> work;                             ///< Current job
+    std::function<void()> onAbandon;                        ///< Run if the job is abandoned while suspended
+    const std::function<bool()>* resumeWhen = nullptr;      ///< Wait condition while suspended
+    bool finished = false;
+    std::array<void*, MAX_FIBER_LOCALS> locals{};           ///< Fiber-local values while switched out
+
+    ~Fiber() {
+#if ENTROPY_FIBERS_SUPPORTED
+        if (mapping) {
+            munmap(mapping, mappingSize);
+        }
+#endif
+    }
+};
+
+thread_local FiberWorker::Fiber* FiberWorker::stCurrentFiber = nullptr;
+
+FiberWorker::FiberWorker(size_t stackSize, size_t maxSuspended, std::function<void()> onResumable)
+    : _stackSize(stackSize)
+    , _maxSuspended(maxSuspended)
+    , _workerContext(std::make_unique<Fiber>())
+    , _onResumable(std::move(onResumable)) {
+    if (_onResumable) {
+        std::lock_guard<std::mutex> lock(gWakeMutex);
+        gWakeTargets.push_back(this);
+    }
+}
+
+FiberWorker::~FiberWorker() {
+    if (_onResumable) {
+        std::lock_guard<std::mutex> lock(gWakeMutex);
+        gWakeTargets.erase(std::find(gWakeTargets.begin(), gWakeTargets.end(), this));
+    }
+
+    if (!_suspended.empty()) {
+        ENTROPY_LOG_ERROR_CAT("Concurrency", std::format("FiberWorker destroyed with {} suspended fibers; abandoning them and leaking their stacks", _suspended.size()));
+        abandonSuspended();
+    }
+}
+
+size_t FiberWorker::abandonSuspended() {
+    auto abandoned = std::move(_suspended);
+    _suspended.clear();
+    _suspendedCount.store(0, std::memory_order_relaxed);
+    gSuspendedFibers.fetch_sub(abandoned.size(), std::memory_order_relaxed);
+    for (auto& fiber : abandoned) {
+        if (fiber->onAbandon) {
+            runGuarded(fiber->onAbandon);
+        }
+        (void)fiber.release();
+    }
+    return abandoned.size();
+}
+
+bool FiberWorker::isOnFiber() noexcept {
+    return stCurrentFiber != nullptr;
+}
+
+void FiberWorker::notifyResumable() noexcept {
+    // Pairs with the fence in retire(): either we see the fiber suspended, or its
+    // worker's next predicate check sees the condition our caller just set
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (gSuspendedFibers.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    gResumeEpoch.fetch_add(1, std::memory_order_seq_cst);
+    std::lock_guard<std::mutex> lock(gWakeMutex);
+    for (FiberWorker* worker : gWakeTargets) {
+        if (worker->_suspendedCount.load(std::memory_order_relaxed) > 0) {
+            worker->_onResumable();
+        }
+    }
+}
+
+uint64_t FiberWorker::getResumeEpoch() noexcept {
+    return gResumeEpoch.load(std::memory_order_seq_cst);
+}
+
+bool FiberWorker::registerFiberLocal(FiberLocal local) {
+    std::lock_guard<std::mutex> lock(gFiberLocalMutex);
+    size_t count = gFiberLocalCount.load(std::memory_order_relaxed);
+    if (count == MAX_FIBER_LOCALS || !local.get || !local.set) {
+        return false;
+    }
+    gFiberLocals[count] = local;
+    gFiberLocalCount.store(count + 1, std::memory_order_release);
+    return true;
+}
+
+#if ENTROPY_FIBERS_SUPPORTED
+
+std::unique_ptr<FiberWorker::Fiber> FiberWorker::createFiber() {
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t usable = (_stackSize + pageSize - 1) / pageSize * pageSize;
+
+    auto fiber = std::make_unique<Fiber>();
+    fiber->owner = this;
+    fiber->mappingSize = usable + pageSize;
+    fiber->mapping = mmap(nullptr, fiber->mappingSize, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (fiber->mapping == MAP_FAILED) {
+        fiber->mapping = nullptr;
+        throw std::runtime_error("Failed to allocate fiber stack");
+    }
+
+    // Stacks grow down, so the guard goes at the low end
+    if (mprotect(fiber->mapping, pageSize, PROT_NONE) != 0) {
+        throw std::runtime_error("Failed to protect fiber stack guard page");
+    }
+
+#if ENTROPY_FIBERS_ASM
+    // Seed the frame entropy_fiber_switch pops: zeroed callee-saved registers, the
+    // current FP control state, and fiberEntry as the return address
+    auto* top = reinterpret_cast<uintptr_t*>(static_cast<char*>(fiber->mapping) + fiber->mappingSize);
+#if defined(__x86_64__)
+    uintptr_t* frame = top - 10;   // 80 bytes; fiberEntry starts with rsp % 16 == 8, as after a call
+    std::fill(frame, top, 0);
+    uint32_t mxcsr;
+    uint16_t fpuControl;
+    asm volatile("stmxcsr %0" : "=m"(mxcsr));
+    asm volatile("fnstcw %0" : "=m"(fpuControl));
+    std::memcpy(frame, &fpuControl, sizeof(fpuControl));
+    std::memcpy(frame + 1, &mxcsr, sizeof(mxcsr));
+    frame[8] = reinterpret_cast<uintptr_t>(&FiberWorker::fiberEntry);
+#else
+    uintptr_t* frame = top - 22;   // 176 bytes; sp stays 16-byte aligned
+    std::fill(frame, top, 0);
+    uint64_t fpcr;
+    asm volatile("mrs %0, fpcr" : "=r"(fpcr));
+    frame[20] = fpcr;
+    frame[11] = reinterpret_cast<uintptr_t>(&FiberWorker::fiberEntry);   // x30
+#endif
+    fiber->stackPointer = frame;
+#else
+    getcontext(&fiber->context);
+    fiber->context.uc_stack.ss_sp = static_cast<char*>(fiber->mapping) + pageSize;
+    fiber->context.uc_stack.ss_size = usable;
+    fiber->context.uc_link = nullptr;  // fiberEntry never returns
+    makecontext(&fiber->context, &FiberWorker::fiberEntry, 0);
+#endif
+
+    _fiberCount++;
+    return fiber;
+}
+
+void FiberWorker::fiberEntry() {
+    // Fibers are reused: each pass runs one job, then parks until the next execute()
+    while (true) {
+        Fiber* self = stCurrentFiber;
+        runGuarded(self->work);
+        self->finished = true;
+        jump(*self, *self->owner->_workerContext);
+    }
+}
+
+void FiberWorker::jump(Fiber& from, Fiber& to) {
+#if ENTROPY_FIBERS_ASM
+    entropy_fiber_switch(&from.stackPointer, to.stackPointer);
+#else
+    swapcontext(&from.context, &to.context);
+#endif
+}
+
+void FiberWorker::switchTo(Fiber* fiber) {
+    const size_t localCount = gFiberLocalCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < localCount; ++i) {
+        _workerLocals[i] = gFiberLocals[i].get();
+        gFiberLocals[i].set(fiber->locals[i]);
+    }
+
+    stCurrentFiber = fiber;
+    jump(*_workerContext, *fiber);
+    stCurrentFiber = nullptr;
+
+    for (size_t i = 0; i < localCount; ++i) {
+        fiber->locals[i] = gFiberLocals[i].get();
+        gFiberLocals[i].set(_workerLocals[i]);
+    }
+}
+
+void FiberWorker::execute(std::function<void()> work, std::function<void()> onAbandon) {
+    // Already on a fiber (nested execution) - just run it here
+    if (stCurrentFiber) {
+        runGuarded(work);
+        return;
+    }
+
+    std::unique_ptr<Fiber> fiber;
+    if (!_idle.empty()) {
+        fiber = std::move(_idle.back());
+        _idle.pop_back();
+    } else {
+        fiber = createFiber();
+    }
+
+    fiber->work = std::move(work);
+    fiber->onAbandon = std::move(onAbandon);
+    fiber->finished = false;
+    switchTo(fiber.get());
+    retire(std::move(fiber));
+}
+
+size_t FiberWorker::resumeReady() {
+    size_t resumed = 0;
+    size_t i = 0;
+    while (i < _suspended.size()) {
+        if (!(*_suspended[i]->resumeWhen)()) {
+            ++i;
+            continue;
+        }
+
+        auto fiber = std::move(_suspended[i]);
+        _suspended[i] = std::move(_suspended.back());
+        _suspended.pop_back();
+        _suspendedCount.fetch_sub(1, std::memory_order_relaxed);
+        gSuspendedFibers.fetch_sub(1, std::memory_order_relaxed);
+
+        switchTo(fiber.get());
+        retire(std::move(fiber));
+        resumed++;
+    }
+    return resumed;
+}
+
+bool FiberWorker::suspendUntil(const std::function<bool()>& ready) {
+    Fiber* self = stCurrentFiber;
+    if (!self) {
+        return false;
+    }
+
+    while (!ready()) {
+        self->resumeWhen = &ready;
+        jump(*self, *self->owner->_workerContext);
+    }
+    self->resumeWhen = nullptr;
+    return true;
+}
+
+#else
+
+std::unique_ptr<FiberWorker::Fiber> FiberWorker::createFiber() {
+    throw std::runtime_error("Fibers are not supported on this platform");
+}
+
+void FiberWorker::fiberEntry() {
+}
+
+void FiberWorker::switchTo(Fiber*) {
+}
+
+void FiberWorker::jump(Fiber&, Fiber&) {
+}
+
+void FiberWorker::execute(std::function<void()> work, std::function<void()>) {
+    runGuarded(work);
+}
+
+size_t FiberWorker::resumeReady() {
+    return 0;
+}
+
+bool FiberWorker::suspendUntil(const std::function<bool()>&) {
+    return false;
+}
+
+#endif
+
+void FiberWorker::retire(std::unique_ptr<Fiber> fiber) {
+    if (fiber->finished) {
+        fiber->work = nullptr;
+        fiber->onAbandon = nullptr;
+        _idle.push_back(std::move(fiber));
+    } else {
+        _suspended.push_back(std::move(fiber));
+        _suspendedCount.fetch_add(1, std::memory_order_relaxed);
+        gSuspendedFibers.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with notifyResumable(); the worker checks predicates only after this
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,229 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file FiberWorker.h
+ * @brief Stackful fibers that let contracts block without blocking their worker thread
+ *
+ * A contract that calls WorkGraph::wait() or WorkContractGroup::wait() normally parks
+ * its worker thread until the wait is satisfied, and enough nested waits can park the
+ * whole pool. In fiber mode each contract runs on its own small stack instead. A
+ * blocking wait then just switches back to the worker, which keeps executing other
+ * contracts and switches the waiting fiber back in once its condition holds.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#if defined(EntropyLinux)
+#define ENTROPY_FIBERS_SUPPORTED 1
+#else
+#define ENTROPY_FIBERS_SUPPORTED 0
+#endif
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief Per-worker-thread fiber scheduler
+ *
+ * Each WorkService worker running in fiber mode owns one FiberWorker. Fibers never
+ * migrate between threads: a fiber that suspends is resumed by the same worker, so
+ * thread_local state seen by the contract stays consistent. Stacks are mmap'd with
+ * a PROT_NONE guard page below them (an overflow faults instead of corrupting the
+ * neighbouring stack) and are pooled with their fiber for reuse. Switching is a few
+ * hand-written instructions on x86-64 and aarch64 that save only the callee-saved
+ * registers; other Linux targets (or builds defining ENTROPY_FIBERS_UCONTEXT, e.g.
+ * for tools that need glibc's shadow-stack handling) fall back to swapcontext().
+ *
+ * Suspension is condition based rather than event based: a waiting fiber hands the
+ * worker a predicate, and the worker re-checks the predicates of its suspended
+ * fibers between contracts. That keeps the existing condition variables untouched -
+ * code that is not on a fiber still blocks exactly as before. Code that can make a
+ * predicate true calls notifyResumable(), which wakes idle workers holding suspended
+ * fibers so they need not poll.
+ *
+ * @code
+ * // Inside a contract - works with or without fiber mode
+ * void waitForDrain(std::atomic<int>& pending) {
+ *     if (!FiberWorker::suspendUntil([&] { return pending.load() == 0; })) {
+ *         while (pending.load() != 0) std::this_thread::yield();  // Not on a fiber
+ *     }
+ * }
+ * @endcode
+ */
+class FiberWorker {
+public:
+    static constexpr size_t DEFAULT_STACK_SIZE = 256 * 1024;
+    static constexpr size_t MAX_FIBER_LOCALS = 8;
+
+    /**
+     * @brief Accessors for a thread_local that must follow the fiber, not the thread
+     *
+     * Values are swapped in when a fiber is switched in and swapped out when it
+     * switches away, so interleaved fibers on one worker each see their own value.
+     */
+    struct FiberLocal {
+        void* (*get)();            ///< Reads the calling thread's value
+        void (*set)(void*);        ///< Writes the calling thread's value
+    };
+
+    /**
+     * @brief Creates a scheduler for the calling thread
+     * @param stackSize Usable bytes per fiber stack (rounded up to whole pages)
+     * @param maxSuspended Most fibers that may be suspended at once
+     * @param onResumable Called by notifyResumable() while this worker has suspended
+     *                    fibers, from the notifying thread; should wake the worker if idle
+     */
+    explicit FiberWorker(size_t stackSize = DEFAULT_STACK_SIZE, size_t maxSuspended = 64,
+                         std::function<void()> onResumable = nullptr);
+
+    /**
+     * @brief Frees pooled stacks
+     *
+     * Fibers still suspended are abandoned (see abandonSuspended()) with an error logged.
+     */
+    ~FiberWorker();
+
+    FiberWorker(const FiberWorker&) = delete;
+    FiberWorker& operator=(const FiberWorker&) = delete;
+
+    /**
+     * @brief Whether this build can run fibers at all
+     * @return true on Linux
+     */
+    static constexpr bool isSupported() noexcept { return ENTROPY_FIBERS_SUPPORTED != 0; }
+
+    /**
+     * @brief Checks whether another fiber may be started
+     * @return false once maxSuspended fibers are waiting
+     */
+    bool canStart() const noexcept { return _suspended.size() < _maxSuspended; }
+
+    /**
+     * @brief Runs work on a pooled fiber
+     *
+     * Returns when the work finishes or suspends. Exceptions escaping the work are
+     * logged and swallowed - they cannot unwind across the fiber boundary.
+     *
+     * @param work Function to run
+     * @param onAbandon Run instead of the rest of the work if the fiber is abandoned
+     *                  while suspended, e.g. to release what the work was holding
+     */
+    void execute(std::function<void()> work, std::function<void()> onAbandon = nullptr);
+
+    /**
+     * @brief Resumes every suspended fiber whose wait condition now holds
+     * @return Number of fibers switched back in
+     */
+    size_t resumeReady();
+
+    /**
+     * @brief Tells workers that a suspended fiber's wait condition may now hold
+     *
+     * Call after making such a condition true, outside any lock a predicate takes.
+     * A fence and a load when no fiber is suspended anywhere, so it is cheap enough
+     * for completion paths.
+     */
+    static void notifyResumable() noexcept;
+
+    /**
+     * @brief Gives up on every suspended fiber
+     *
+     * A suspended fiber cannot be unwound, so each one's onAbandon hook runs on the
+     * calling thread and its stack is leaked rather than freed under live objects.
+     * Anything the work held on that stack (locks, owned objects) stays held.
+     *
+     * @return Number of fibers abandoned
+     */
+    size_t abandonSuspended();
+
+    /**
+     * @brief Counter bumped by every notifyResumable() that found suspended fibers
+     *
+     * Read it before resumeReady(); an idle worker can then sleep until it changes
+     * without missing a notification that raced with the predicate checks.
+     *
+     * @return Current notification count
+     */
+    static uint64_t getResumeEpoch() noexcept;
+
+    /**
+     * @brief Number of fibers waiting on a condition
+     * @return Suspended fiber count
+     */
+    size_t getSuspendedCount() const noexcept { return _suspended.size(); }
+
+    /**
+     * @brief Number of fibers (and stacks) this worker has allocated
+     * @return Live fiber count, suspended or pooled
+     */
+    size_t getFiberCount() const noexcept { return _fiberCount; }
+
+    /**
+     * @brief Checks whether the caller is running on a fiber
+     * @return true inside work started by execute()
+     */
+    static bool isOnFiber() noexcept;
+
+    /**
+     * @brief Suspends the calling fiber until a condition holds
+     *
+     * The predicate is evaluated by the worker thread between contracts, so it must
+     * be cheap and thread-safe. It stays on the fiber's stack while suspended.
+     *
+     * @param ready Condition to wait for
+     * @return false without waiting if the caller is not on a fiber (block normally instead)
+     */
+    static bool suspendUntil(const std::function<bool()>& ready);
+
+    /**
+     * @brief Registers a thread_local that should be saved and restored per fiber
+     *
+     * Call once per variable, typically from a function-local static. Registrations
+     * beyond MAX_FIBER_LOCALS are rejected.
+     *
+     * @param local Accessors for the variable
+     * @return true if registered
+     */
+    static bool registerFiberLocal(FiberLocal local);
+
+private:
+    struct Fiber;
+
+    std::unique_ptr<Fiber> createFiber();
+    void switchTo(Fiber* fiber);
+    void retire(std::unique_ptr<Fiber> fiber);
+    static void fiberEntry();
+    static void jump(Fiber& from, Fiber& to);              ///< Saves from's registers and continues on to
+
+    static thread_local Fiber* stCurrentFiber;              ///< Fiber running on this thread, if any
+
+    size_t _stackSize;                                      ///< Usable stack bytes per fiber
+    size_t _maxSuspended;                                   ///< Suspension limit
+    size_t _fiberCount = 0;                                 ///< Fibers allocated
+    std::vector<std::unique_ptr<Fiber>> _idle;              ///< Finished fibers, ready for reuse
+    std::vector<std::unique_ptr<Fiber>> _suspended;         ///< Fibers waiting on a condition
+    std::unique_ptr<Fiber> _workerContext;                  ///< The thread's own context while a fiber runs
+    std::array<void*, MAX_FIBER_LOCALS> _workerLocals{};    ///< Thread's fiber-local values while a fiber runs
+    std::function<void()> _onResumable;                     ///< Wake hook for notifyResumable()
+    std::atomic<size_t> _suspendedCount{0};                 ///< Mirrors _suspended.size() for notifying threads
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
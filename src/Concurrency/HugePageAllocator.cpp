@@ -0,0 +1,165 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "HugePageAllocator.h"
+#include <cstdio>
+#include <cstring>
+
+#if defined(EntropyLinux)
+#include <sys/mman.h>
+#endif
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+namespace {
+    constexpr size_t FALLBACK_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    std::atomic<uint64_t> gExplicitMappings{0};
+    std::atomic<uint64_t> gTransparentMappings{0};
+    std::atomic<uint64_t> gHeapFallbacks{0};
+
+    size_t roundUp(size_t value, size_t multiple) {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    void* heapAllocate(size_t bytes, size_t alignment) {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+        return ::operator new(bytes);
+    }
+
+    void heapDeallocate(void* memory, size_t alignment) noexcept {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(memory, std::align_val_t(alignment));
+        } else {
+            ::operator delete(memory);
+        }
+    }
+
+#if defined(EntropyLinux)
+    size_t readHugePageSize() {
+        std::FILE* meminfo = std::fopen("/proc/meminfo", "r");
+        if (!meminfo) {
+            return FALLBACK_HUGE_PAGE_SIZE;
+        }
+        char line[256];
+        size_t kib = 0;
+        while (std::fgets(line, sizeof(line), meminfo)) {
+            if (std::sscanf(line, "Hugepagesize: %zu kB", &kib) == 1) {
+                break;
+            }
+        }
+        std::fclose(meminfo);
+        return kib ? kib * 1024 : FALLBACK_HUGE_PAGE_SIZE;
+    }
+
+    /// Maps exactly `mapped` bytes at a huge-page aligned address
+    void* mapAligned(size_t mapped, size_t pageSize) {
+        // Over-map by one huge page, then trim both ends so the range starts on a boundary
+        size_t oversized = mapped + pageSize;
+        void* raw = mmap(nullptr, oversized, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            return nullptr;
+        }
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = roundUp(start, pageSize);
+        if (aligned > start) {
+            munmap(raw, aligned - start);
+        }
+        size_t tail = (start + oversized) - (aligned + mapped);
+        if (tail > 0) {
+            munmap(reinterpret_cast<void*>(aligned + mapped), tail);
+        }
+        return reinterpret_cast<void*>(aligned);
+    }
+#endif
+}
+
+size_t HugePageMemory::hugePageSize() noexcept {
+#if defined(EntropyLinux)
+    static const size_t size = readHugePageSize();
+    return size;
+#else
+    return FALLBACK_HUGE_PAGE_SIZE;
+#endif
+}
+
+bool HugePageMemory::isMapped(size_t bytes, PageAllocationPolicy policy) noexcept {
+#if defined(EntropyLinux)
+    return policy != PageAllocationPolicy::Default && bytes >= hugePageSize();
+#else
+    (void)bytes;
+    (void)policy;
+    return false;
+#endif
+}
+
+void* HugePageMemory::allocate(size_t bytes, size_t alignment, PageAllocationPolicy policy) {
+    if (!isMapped(bytes, policy)) {
+        if (policy != PageAllocationPolicy::Default) {
+            gHeapFallbacks.fetch_add(1, std::memory_order_relaxed);
+        }
+        return heapAllocate(bytes, alignment);
+    }
+
+#if defined(EntropyLinux)
+    const size_t pageSize = hugePageSize();
+    const size_t mapped = roundUp(bytes, pageSize);
+
+    if (policy == PageAllocationPolicy::ExplicitHugePages) {
+        void* memory = mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory != MAP_FAILED) {
+            gExplicitMappings.fetch_add(1, std::memory_order_relaxed);
+            return memory;
+        }
+        // Pool empty or not configured - transparent huge pages are the next best thing
+    }
+
+    if (void* memory = mapAligned(mapped, pageSize)) {
+        // Advisory only: with THP disabled this is still a correct, if 4K-backed, mapping
+        madvise(memory, mapped, MADV_HUGEPAGE);
+        gTransparentMappings.fetch_add(1, std::memory_order_relaxed);
+        return memory;
+    }
+
+    // Mapped sizes must stay recomputable, so a failed mapping cannot quietly become heap memory
+    throw std::bad_alloc();
+#else
+    return heapAllocate(bytes, alignment);   // Unreachable: isMapped() is false off Linux
+#endif
+}
+
+void HugePageMemory::deallocate(void* memory, size_t bytes, size_t alignment, PageAllocationPolicy policy) noexcept {
+    if (!memory) {
+        return;
+    }
+    if (!isMapped(bytes, policy)) {
+        heapDeallocate(memory, alignment);
+        return;
+    }
+#if defined(EntropyLinux)
+    munmap(memory, roundUp(bytes, hugePageSize()));
+#endif
+}
+
+HugePageStats HugePageMemory::getStats() noexcept {
+    HugePageStats stats;
+    stats.explicitMappings = gExplicitMappings.load(std::memory_order_relaxed);
+    stats.transparentMappings = gTransparentMappings.load(std::memory_order_relaxed);
+    stats.heapFallbacks = gHeapFallbacks.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
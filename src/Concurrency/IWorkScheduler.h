@@ -20,7 +20,9 @@
 #include <vector>
 #include <memory>
 #include <atomic>
+#include <cstdint>
 #include <functional>
+#include "CpuTopology.h"
 
 namespace EntropyEngine {
 namespace Core {
@@ -95,6 +97,7 @@ public:
         size_t updateCycleInterval = 16;          ///< How often to refresh internal state (for adaptive schedulers)
         size_t failureSleepTime = 1;              ///< Nanoseconds to sleep when no work found (usually not needed)
         size_t threadCount = 0;                   ///< Number of worker threads (0 = hardware_concurrency)
+        WorkerLocality locality;                  ///< CPU and cache domains per worker, filled in by WorkService - lets schedulers favour groups a cache neighbour just ran
     };
     
     /**
@@ -182,6 +185,18 @@ public:
      * Scheduler should behave like newly constructed. Default is no-op.
      */
     virtual void reset() {}
+
+    /**
+     * @brief Applies new affinity and refresh settings while workers are running
+     *
+     * Called through WorkService::setSchedulerTuning(), for example by
+     * WorkServiceAutoTuner. Schedulers that read these Config values on the hot path
+     * keep them in atomics and update them here. Default is no-op.
+     *
+     * @param maxConsecutiveExecutionCount New Config::maxConsecutiveExecutionCount
+     * @param updateCycleInterval New Config::updateCycleInterval
+     */
+    virtual void applyTuning(size_t /*maxConsecutiveExecutionCount*/, size_t /*updateCycleInterval*/) {}
     
     /**
      * @brief Gets human-readable name for this scheduling strategy
@@ -191,6 +206,21 @@ public:
      * @return Name of the scheduling algorithm (must be a static string)
      */
     virtual const char* getName() const = 0;
+
+protected:
+    /**
+     * @brief Hands out a process-wide unique id for a scheduler instance
+     *
+     * Schedulers that cache per-thread state should tag it with this id rather
+     * than with their address. A scheduler constructed where a destroyed one
+     * lived would otherwise pick up the old instance's cached group pointers.
+     *
+     * @return An id never returned before in this process (never 0)
+     */
+    static uint64_t allocateInstanceId() {
+        static std::atomic<uint64_t> sNextInstanceId{1};
+        return sNextInstanceId.fetch_add(1, std::memory_order_relaxed);
+    }
 };
 
 /**
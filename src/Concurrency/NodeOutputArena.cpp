@@ -0,0 +1,86 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "NodeOutputArena.h"
+#include <algorithm>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+namespace {
+    constexpr size_t CHUNK_ALIGNMENT = 64;
+
+    size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+NodeOutputArena::NodeOutputArena(size_t chunkSize)
+    : _chunkSize(std::max<size_t>(chunkSize, CHUNK_ALIGNMENT)) {
+}
+
+NodeOutputArena::~NodeOutputArena() {
+    // Values whose consumers never ran (cancelled, skipped) or that had no consumers
+    for (auto* output : _outputs) {
+        output->destroyValue();
+        output->~NodeOutput();
+    }
+
+    for (auto& chunk : _chunks) {
+        ::operator delete(chunk.data, chunk.alignment);
+    }
+}
+
+void* NodeOutputArena::bump(size_t size, size_t alignment) {
+    // Oversized or over-aligned values get a chunk of their own so regular chunks stay dense
+    if (size > _chunkSize / 2 || alignment > CHUNK_ALIGNMENT) {
+        Chunk dedicated;
+        dedicated.alignment = std::align_val_t{std::max(alignment, CHUNK_ALIGNMENT)};
+        dedicated.size = size;
+        dedicated.data = static_cast<std::byte*>(::operator new(size, dedicated.alignment));
+        _reservedBytes += size;
+
+        // Keep the active bump chunk last
+        if (_chunks.empty()) {
+            _chunks.push_back(dedicated);
+            _offset = _chunkSize;  // Forces a fresh regular chunk on next bump
+        } else {
+            _chunks.insert(_chunks.end() - 1, dedicated);
+        }
+        return dedicated.data;
+    }
+
+    size_t offset = alignUp(_offset, alignment);
+    if (_chunks.empty() || _chunks.back().size != _chunkSize || offset + size > _chunkSize) {
+        Chunk chunk;
+        chunk.alignment = std::align_val_t{CHUNK_ALIGNMENT};
+        chunk.size = _chunkSize;
+        chunk.data = static_cast<std::byte*>(::operator new(_chunkSize, chunk.alignment));
+        _chunks.push_back(chunk);
+        _reservedBytes += _chunkSize;
+        offset = 0;
+    }
+
+    _offset = offset + size;
+    return _chunks.back().data + offset;
+}
+
+NodeOutput* NodeOutputArena::allocate(size_t size, size_t alignment, void (*destroy)(void*)) {
+    void* slotMemory = bump(sizeof(NodeOutput), alignof(NodeOutput));
+    auto* output = ::new (slotMemory) NodeOutput();
+    output->storage = bump(std::max<size_t>(size, 1), alignment);
+    output->destroy = destroy;
+    _outputs.push_back(output);
+    return output;
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
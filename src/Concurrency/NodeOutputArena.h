@@ -0,0 +1,163 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file NodeOutputArena.h
+ * @brief Arena storage for typed WorkGraph node outputs
+ *
+ * Typed nodes write their result straight into a slot reserved here when the node
+ * is added, and their consumers read it by const reference. The value is destroyed
+ * when its last consumer finishes; the memory goes back when the arena is destroyed.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief One typed node's output value and its consumer bookkeeping
+ *
+ * Lives inside a NodeOutputArena. The producer constructs the value in place,
+ * consumers release it when they finish, and the last release runs the destructor.
+ * Outputs nobody consumes stay alive (and readable) until the arena goes away.
+ */
+struct NodeOutput {
+    enum class State : uint8_t {
+        Empty = 0,        ///< Producer has not run (or threw)
+        Constructed = 1,  ///< Value is live and readable
+        Destroyed = 2     ///< Last consumer finished, destructor has run
+    };
+
+    void* storage = nullptr;                           ///< Arena memory sized and aligned for the value
+    void (*destroy)(void*) = nullptr;                  ///< Type-erased destructor for the value
+    std::atomic<uint32_t> consumers{0};                ///< Consumers that have not released yet
+    std::atomic<State> state{State::Empty};            ///< Lifecycle of the value
+
+    /**
+     * @brief Marks the value as constructed after the producer placed it in storage
+     */
+    void publish() noexcept {
+        state.store(State::Constructed, std::memory_order_release);
+    }
+
+    /**
+     * @brief Checks whether the value is live
+     * @return true between publish() and destruction
+     */
+    bool isConstructed() const noexcept {
+        return state.load(std::memory_order_acquire) == State::Constructed;
+    }
+
+    /**
+     * @brief Called by a consumer when it no longer needs the value
+     *
+     * Runs the destructor when the last registered consumer releases.
+     */
+    void release() noexcept {
+        if (consumers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            destroyValue();
+        }
+    }
+
+    /**
+     * @brief Destroys the value once, if it was constructed
+     */
+    void destroyValue() noexcept {
+        State expected = State::Constructed;
+        if (state.compare_exchange_strong(expected, State::Destroyed, std::memory_order_acq_rel)) {
+            destroy(storage);
+        }
+    }
+};
+
+/**
+ * @brief Chunked bump allocator for NodeOutput slots
+ *
+ * Slots are reserved while the graph is being built (under the graph's own lock),
+ * so the arena itself does no synchronization. Execution only touches the slots
+ * it was handed, which keeps the hand-off between producer and consumers lock-free.
+ *
+ * @code
+ * NodeOutputArena arena;
+ * NodeOutput* out = arena.allocate(sizeof(Mesh), alignof(Mesh),
+ *                                  [](void* p) { static_cast<Mesh*>(p)->~Mesh(); });
+ * ::new (out->storage) Mesh(buildMesh());
+ * out->publish();
+ * @endcode
+ */
+class NodeOutputArena {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 16 * 1024;
+
+    /**
+     * @brief Creates an empty arena; no memory is reserved until the first allocate()
+     * @param chunkSize Bytes per chunk (values larger than this get a dedicated chunk)
+     */
+    explicit NodeOutputArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Destroys any output still alive, then frees every chunk
+     */
+    ~NodeOutputArena();
+
+    NodeOutputArena(const NodeOutputArena&) = delete;
+    NodeOutputArena& operator=(const NodeOutputArena&) = delete;
+
+    /**
+     * @brief Reserves a slot for one value
+     *
+     * Not thread-safe - callers serialize (WorkGraph holds its graph lock).
+     *
+     * @param size sizeof the value
+     * @param alignment alignof the value
+     * @param destroy Destructor thunk for the value
+     * @return Slot with storage set and state Empty
+     */
+    NodeOutput* allocate(size_t size, size_t alignment, void (*destroy)(void*));
+
+    /**
+     * @brief Bytes of chunk memory currently held
+     * @return Sum of all chunk sizes
+     */
+    size_t getReservedBytes() const noexcept { return _reservedBytes; }
+
+    /**
+     * @brief Number of slots handed out
+     * @return Output count
+     */
+    size_t getOutputCount() const noexcept { return _outputs.size(); }
+
+private:
+    struct Chunk {
+        std::byte* data = nullptr;
+        size_t size = 0;
+        std::align_val_t alignment{alignof(std::max_align_t)};
+    };
+
+    void* bump(size_t size, size_t alignment);
+
+    size_t _chunkSize;                        ///< Size of regular chunks
+    std::vector<Chunk> _chunks;               ///< All chunks, newest last
+    size_t _offset = 0;                       ///< Bump offset into the newest regular chunk
+    size_t _reservedBytes = 0;                ///< Total chunk bytes
+    std::vector<NodeOutput*> _outputs;        ///< Every slot, for teardown
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -23,6 +23,11 @@ namespace EntropyEngine {
 namespace Core {
 namespace Concurrency {
 
+WorkContractGroup* NodeScheduler::getTargetGroup(NodeHandle node) const {
+    auto* nodeData = node.getData();
+    return (nodeData && nodeData->targetGroup) ? nodeData->targetGroup : _contractGroup;
+}
+
 bool NodeScheduler::scheduleNode(NodeHandle node) {
     if (_config.enableDebugLogging) {
         ENTROPY_LOG_DEBUG_CAT("NodeScheduler", "scheduleNode() called");
@@ -35,8 +40,11 @@ bool NodeScheduler::scheduleNode(NodeHandle node) {
         return false;
     }
     
+    // Nodes without a target of their own run on the graph's group
+    WorkContractGroup* group = nodeData->targetGroup ? nodeData->targetGroup : _contractGroup;
+    
     // Check capacity
-    if (!hasCapacity()) {
+    if (!hasCapacity(group)) {
         // Try to defer instead
         if (_config.enableDebugLogging) {
             ENTROPY_LOG_DEBUG_CAT("NodeScheduler", "No capacity, deferring node");
@@ -48,11 +56,17 @@ bool NodeScheduler::scheduleNode(NodeHandle node) {
         return deferred;
     }
     
+    // The last attempt before the first run is the one that got a contract; anything
+    // earlier since readyNs was spent deferred or parked
+    if (_config.enableTiming && nodeData->timing.startNs == 0) {
+        nodeData->timing.scheduledNs = NodeTiming::now();
+    }
+    
     // Create work wrapper
     auto work = createWorkWrapper(node);
     
     // Create contract with the node's execution type
-    auto handle = _contractGroup->createContract(std::move(work), nodeData->executionType);
+    auto handle = group->createContract(std::move(work), nodeData->executionType);
     if (!handle.valid()) {
         // Contract group refused - try to defer
         return deferNode(node);
@@ -83,15 +97,56 @@ bool NodeScheduler::scheduleNode(NodeHandle node) {
     return true;
 }
 
-bool NodeScheduler::deferNode(NodeHandle node) {
-    std::lock_guard<std::shared_mutex> lock(_deferredMutex);  // Exclusive lock for modifying queue
+bool NodeScheduler::rescheduleInPlace(NodeHandle node) {
+    auto* nodeData = node.getData();
+    if (!nodeData) {
+        return false;
+    }
+    // The contract lives in whichever group the node was routed to
+    WorkContractGroup* group = nodeData->handle.getGroup();
+    if (!group || !group->rescheduleOnCompletion(nodeData->handle)) {
+        return false;
+    }
     
-    if (_config.enableDebugLogging) {
-        ENTROPY_LOG_DEBUG_CAT("NodeScheduler", "Deferring node, queue size: " + std::to_string(_deferredQueue.size()) + ", max: " + std::to_string(_config.maxDeferredNodes));
+    updateStats(true, false, false);
+    publishScheduledEvent(node);
+    if (_callbacks.onNodeScheduled) {
+        _callbacks.onNodeScheduled(node);
+    }
+    return true;
+}
+
+bool NodeScheduler::deferNode(NodeHandle node) {
+    WorkContractGroup* group = getTargetGroup(node);
+    size_t queueSize = 0;
+    bool dropped = false;
+    {
+        std::lock_guard<std::shared_mutex> lock(_deferredMutex);  // Exclusive lock for modifying queue
+        
+        if (_config.enableDebugLogging) {
+            ENTROPY_LOG_DEBUG_CAT("NodeScheduler", "Deferring node, queue size: " + std::to_string(_deferredTotal) + ", max: " + std::to_string(_config.maxDeferredNodes));
+        }
+        
+        // Check queue capacity (0 = unlimited); the limit covers every target group
+        if (_config.maxDeferredNodes > 0 && _deferredTotal >= _config.maxDeferredNodes) {
+            dropped = true;
+        } else {
+            auto queue = std::find_if(_deferredQueues.begin(), _deferredQueues.end(),
+                                      [group](const DeferredQueue& q) { return q.group == group; });
+            if (queue == _deferredQueues.end()) {
+                _deferredQueues.push_back(DeferredQueue{group, {}});
+                queue = std::prev(_deferredQueues.end());
+            }
+            
+            // Add to deferred queue
+            queue->nodes.push_back(node);
+            queueSize = ++_deferredTotal;
+        }
     }
     
-    // Check queue capacity (0 = unlimited)
-    if (_config.maxDeferredNodes > 0 && _deferredQueue.size() >= _config.maxDeferredNodes) {
+    // Events and callbacks run unlocked: a deferral callback may take an admission
+    // turn right away, which drains these queues
+    if (dropped) {
         // Queue full - drop the node
         auto msg = std::format("NodeScheduler dropping node - deferred queue full (max: {})", 
                                _config.maxDeferredNodes);
@@ -106,20 +161,17 @@ bool NodeScheduler::deferNode(NodeHandle node) {
         return false;
     }
     
-    // Add to deferred queue
-    _deferredQueue.push_back(node);
-    
     // Update statistics
     updateStats(false, true, false);
     
     // Track peak deferred count
     {
         std::lock_guard<std::mutex> statsLock(_statsMutex);
-        _stats.peakDeferred = max(_stats.peakDeferred, _deferredQueue.size());
+        _stats.peakDeferred = max(_stats.peakDeferred, queueSize);
     }
     
     // Publish event
-    publishDeferredEvent(node);
+    publishDeferredEvent(node, queueSize);
     
     // Notify callback
     if (_callbacks.onNodeDeferred) {
@@ -127,35 +179,70 @@ bool NodeScheduler::deferNode(NodeHandle node) {
     }
     
     if (_config.enableDebugLogging) {
-        ENTROPY_LOG_DEBUG_CAT("NodeScheduler", "Node deferred successfully, queue size now: " + std::to_string(_deferredQueue.size()));
+        ENTROPY_LOG_DEBUG_CAT("NodeScheduler", "Node deferred successfully, queue size now: " + std::to_string(queueSize));
     }
     
     return true;
 }
 
 size_t NodeScheduler::processDeferredNodes(size_t maxToSchedule) {
+    // Snapshot the groups; queues are only ever appended
+    std::vector<WorkContractGroup*> groups;
+    {
+        std::shared_lock<std::shared_mutex> lock(_deferredMutex);
+        groups.reserve(_deferredQueues.size());
+        for (const auto& queue : _deferredQueues) {
+            groups.push_back(queue.group);
+        }
+    }
+    
+    size_t scheduled = 0;
+    for (WorkContractGroup* group : groups) {
+        // Each group only takes what it has room for
+        size_t budget = getAvailableCapacity(group);
+        if (maxToSchedule > 0) {
+            budget = min(budget, maxToSchedule - scheduled);
+        }
+        if (budget > 0) {
+            scheduled += processDeferredNodes(group, budget);
+        }
+        if (maxToSchedule > 0 && scheduled >= maxToSchedule) {
+            break;
+        }
+    }
+    return scheduled;
+}
+
+size_t NodeScheduler::processDeferredNodes(WorkContractGroup* group, size_t maxToSchedule) {
     // Determine how many to process
     size_t toProcess = maxToSchedule;
     if (toProcess == 0) {
-        toProcess = getAvailableCapacity();
+        toProcess = getAvailableCapacity(group);
     }
     
     if (toProcess == 0) {
         return 0;  // No capacity
     }
     
-    // Extract nodes from deferred queue
+    // Extract nodes from the group's deferred queue
     std::vector<NodeHandle> nodesToSchedule;
     {
         std::lock_guard<std::shared_mutex> lock(_deferredMutex);  // Exclusive lock for modifying queue
         
-        size_t count = min(toProcess, _deferredQueue.size());
+        auto queue = std::find_if(_deferredQueues.begin(), _deferredQueues.end(),
+                                  [group](const DeferredQueue& q) { return q.group == group; });
+        if (queue == _deferredQueues.end()) {
+            return 0;
+        }
+        
+        size_t count = min(toProcess, queue->nodes.size());
         nodesToSchedule.reserve(count);
         
         for (size_t i = 0; i < count; ++i) {
-            nodesToSchedule.push_back(_deferredQueue.front());
-            _deferredQueue.pop_front();
+            nodesToSchedule.push_back(queue->nodes.front());
+            queue->nodes.pop_front();
         }
+        _deferredTotal -= count;
     }
     
     // Schedule the nodes
@@ -175,35 +262,29 @@ size_t NodeScheduler::processDeferredNodes(size_t maxToSchedule) {
 size_t NodeScheduler::scheduleReadyNodes(const std::vector<NodeHandle>& nodes) {
     size_t scheduled = 0;
     
+    // Capacity is per target group: a full group defers its own nodes without
+    // holding back the rest of the batch bound for groups with room
+    auto scheduleOne = [this, &scheduled](NodeHandle node) {
+        if (!hasCapacity(getTargetGroup(node))) {
+            deferNode(node);
+        } else if (scheduleNode(node)) {
+            scheduled++;
+        }
+    };
+    
     // Try batch scheduling if enabled
     if (_config.enableBatchScheduling && nodes.size() > 1) {
         // Schedule in batches for better efficiency
         for (size_t i = 0; i < nodes.size(); i += _config.batchSize) {
             size_t batchEnd = min(i + _config.batchSize, nodes.size());
-            
             for (size_t j = i; j < batchEnd; ++j) {
-                if (scheduleNode(nodes[j])) {
-                    scheduled++;
-                } else {
-                    // Hit capacity - stop scheduling
-                    return scheduled;
-                }
-            }
-            
-            // Check if we should continue
-            if (!hasCapacity()) {
-                break;
+                scheduleOne(nodes[j]);
             }
         }
     } else {
         // Schedule one by one
         for (const auto& node : nodes) {
-            if (scheduleNode(node)) {
-                scheduled++;
-            } else {
-                // Hit capacity - stop scheduling
-                break;
-            }
+            scheduleOne(node);
         }
     }
     
@@ -217,11 +298,17 @@ std::function<void()> NodeScheduler::createWorkWrapper(NodeHandle node) {
             return;  // Scheduler is gone, do nothing
         }
         
-        auto* nodeData = node.getData();
+        // The data lives in the graph, not the captured handle, so a local copy
+        // reaches it without making the whole wrapper mutable
+        NodeHandle target = node;
+        auto* nodeData = target.getData();
         if (!nodeData) {
             return;
         }
         
+        // Give the node a private spawn buffer for the run and its completion callback
+        WorkGraph::SpawnScope spawnScope(_graph, node);
+        
         // Notify execution starting (check destroyed flag before each callback)
         if (!_destroyed.load(std::memory_order_acquire) && _callbacks.onNodeExecuting) {
             _callbacks.onNodeExecuting(node);
@@ -246,6 +333,11 @@ std::function<void()> NodeScheduler::createWorkWrapper(NodeHandle node) {
                         yielded = true;
                     }
                 }
+            } else if (nodeData->isBranch) {
+                // Branch selector - record the choice for completion processing
+                if (auto* branchWork = std::get_if<BranchWorkFunction>(&nodeData->work)) {
+                    nodeData->selectedBranch = (*branchWork)();
+                }
             } else {
                 // Handle legacy void work function
                 if (auto* voidWork = std::get_if<std::function<void()>>(&nodeData->work)) {
@@ -304,11 +396,8 @@ void NodeScheduler::publishScheduledEvent(NodeHandle node) {
     }
 }
 
-void NodeScheduler::publishDeferredEvent(NodeHandle node) {
+void NodeScheduler::publishDeferredEvent(NodeHandle node, size_t queueSize) {
     if (_eventBus) {
-        // Note: This is called from deferNode() which already holds an exclusive lock
-        // We can safely read the queue size here without additional locking
-        size_t queueSize = _deferredQueue.size();
         _eventBus->publish(NodeDeferredEvent(_graph, node, queueSize));
     }
 }
@@ -22,6 +22,7 @@
 #include "WorkContractGroup.h"
 #include "../Core/EventBus.h"
 #include <deque>
+#include <vector>
 #include <mutex>
 #include <shared_mutex>
 #include <functional>
@@ -104,8 +105,9 @@ public:
         bool enableBatchScheduling;   ///< Schedule multiple nodes in one operation (reduces overhead)
         size_t batchSize;             ///< How many nodes to schedule per batch (tune for your workload)
         bool enableDebugLogging;      ///< Enable verbose debug logging for troubleshooting
+        bool enableTiming;            ///< Stamp NodeTiming::scheduledNs on each admission attempt
         
-        Config() : maxDeferredNodes(100), enableBatchScheduling(true), batchSize(10), enableDebugLogging(false) {}
+        Config() : maxDeferredNodes(100), enableBatchScheduling(true), batchSize(10), enableDebugLogging(false), enableTiming(false) {}
     };
     
     /**
@@ -154,6 +156,7 @@ public:
         , _graph(graph)
         , _eventBus(eventBus)
         , _config(config) {
+        _deferredQueues.push_back(DeferredQueue{contractGroup, {}});
     }
     
     ~NodeScheduler() {
@@ -208,6 +211,18 @@ public:
      */
     bool scheduleNode(NodeHandle node);
     
+    /**
+     * @brief Re-queues a node that is still running on its contract
+     * 
+     * For yielded nodes: the node's current contract is scheduled again as soon as
+     * this run completes, keeping its slot and work wrapper. No allocation, no trip
+     * through the deferred queue. Only valid while called from the node's own run.
+     * 
+     * @param node Handle to the node whose contract is executing
+     * @return true if re-queued; false if the node has no executing contract
+     */
+    bool rescheduleInPlace(NodeHandle node);
+    
     /**
      * @brief Explicitly defers a node without trying to schedule first
      * 
@@ -257,6 +272,19 @@ public:
      */
     size_t processDeferredNodes(size_t maxToSchedule = 0);
     
+    /**
+     * @brief Drains only the nodes waiting on one group
+     * 
+     * Nodes routed to different groups wait in separate FIFOs, so a full group never
+     * holds back nodes bound for one with room. Used by the owning graph's admission
+     * turn on that group.
+     * 
+     * @param group Group whose deferred nodes to schedule
+     * @param maxToSchedule How many to schedule max (0 = the group's free slots)
+     * @return Number of nodes actually scheduled
+     */
+    size_t processDeferredNodes(WorkContractGroup* group, size_t maxToSchedule);
+    
     /**
      * @brief Quick check if we can accept more work right now
      * 
@@ -273,7 +301,16 @@ public:
      * @endcode
      */
     bool hasCapacity() const {
-        return _contractGroup->activeCount() < _contractGroup->capacity();
+        return hasCapacity(_contractGroup);
+    }
+    
+    /**
+     * @brief Capacity check for a specific target group
+     * @param group Group a node is routed to
+     * @return true if that group has free slots
+     */
+    static bool hasCapacity(const WorkContractGroup* group) {
+        return group->activeCount() < group->capacity();
     }
     
     /**
@@ -293,8 +330,17 @@ public:
      * @endcode
      */
     size_t getAvailableCapacity() const {
-        size_t active = _contractGroup->activeCount();
-        size_t capacity = _contractGroup->capacity();
+        return getAvailableCapacity(_contractGroup);
+    }
+    
+    /**
+     * @brief Free slots in a specific target group
+     * @param group Group a node is routed to
+     * @return Number of nodes that could be scheduled there immediately
+     */
+    static size_t getAvailableCapacity(const WorkContractGroup* group) {
+        size_t active = group->activeCount();
+        size_t capacity = group->capacity();
         return (active < capacity) ? (capacity - active) : 0;
     }
     
@@ -315,9 +361,31 @@ public:
      */
     size_t getDeferredCount() const {
         std::shared_lock<std::shared_mutex> lock(_deferredMutex);
-        return _deferredQueue.size();
+        return _deferredTotal;
+    }
+    
+    /**
+     * @brief Number of deferred nodes waiting on one group
+     * @param group Target group
+     * @return Nodes in that group's deferred FIFO
+     */
+    size_t getDeferredCount(const WorkContractGroup* group) const {
+        std::shared_lock<std::shared_mutex> lock(_deferredMutex);
+        for (const auto& queue : _deferredQueues) {
+            if (queue.group == group) {
+                return queue.nodes.size();
+            }
+        }
+        return 0;
     }
     
+    /**
+     * @brief Group a node will be scheduled on
+     * @param node Node to route
+     * @return The node's target group, or the scheduler's group if it has none
+     */
+    WorkContractGroup* getTargetGroup(NodeHandle node) const;
+    
     /**
      * @brief Nuclear option: drops all deferred nodes
      * 
@@ -335,8 +403,11 @@ public:
      */
     size_t clearDeferredNodes() {
         std::lock_guard<std::shared_mutex> lock(_deferredMutex);  // Exclusive lock for writing
-        size_t count = _deferredQueue.size();
-        _deferredQueue.clear();
+        size_t count = _deferredTotal;
+        for (auto& queue : _deferredQueues) {
+            queue.nodes.clear();
+        }
+        _deferredTotal = 0;
         return count;
     }
     
@@ -416,7 +487,7 @@ public:
      */
     size_t getMemoryUsage() const {
         std::shared_lock<std::shared_mutex> lock(_deferredMutex);  // Shared lock for reading
-        return sizeof(*this) + _deferredQueue.size() * sizeof(NodeHandle);
+        return sizeof(*this) + _deferredQueues.size() * sizeof(DeferredQueue) + _deferredTotal * sizeof(NodeHandle);
     }
     
 private:
@@ -429,9 +500,16 @@ private:
     // Safety flag to prevent use after destruction
     mutable std::atomic<bool> _destroyed{false};  ///< Set to true in destructor for safety checks
     
-    // Deferred queue for nodes waiting for capacity
-    mutable std::shared_mutex _deferredMutex;   ///< Reader-writer lock for deferred queue (mutable for const methods)
-    std::deque<NodeHandle> _deferredQueue;      ///< FIFO queue of nodes waiting for capacity
+    /// Nodes waiting for capacity on one target group
+    struct DeferredQueue {
+        WorkContractGroup* group;               ///< Group the nodes are routed to
+        std::deque<NodeHandle> nodes;           ///< FIFO of nodes waiting for its capacity
+    };
+    
+    // Deferred queues for nodes waiting for capacity
+    mutable std::shared_mutex _deferredMutex;   ///< Reader-writer lock for deferred queues (mutable for const methods)
+    std::vector<DeferredQueue> _deferredQueues; ///< One per target group; [0] is the scheduler's own group
+    size_t _deferredTotal = 0;                  ///< Nodes across all deferred queues
     
     // Statistics
     mutable std::mutex _statsMutex;           ///< Protects statistics (separate to reduce contention)
@@ -473,8 +551,9 @@ private:
      * @brief Publishes a "node deferred" event to the event bus
      * 
      * @param node The node that was deferred
+     * @param queueSize Deferred nodes across all queues, including this one
      */
-    void publishDeferredEvent(NodeHandle node);
+    void publishDeferredEvent(NodeHandle node, size_t queueSize);
 };
 
 } // namespace Concurrency
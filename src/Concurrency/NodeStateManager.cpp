@@ -101,6 +101,7 @@ void NodeStateManager::registerNode(NodeHandle node, NodeState initialState) {
         case NodeState::Completed: _stats.completedNodes.fetch_add(1, std::memory_order_relaxed); break;
         case NodeState::Failed:    _stats.failedNodes.fetch_add(1, std::memory_order_relaxed); break;
         case NodeState::Cancelled: _stats.cancelledNodes.fetch_add(1, std::memory_order_relaxed); break;
+        case NodeState::Skipped:   _stats.skippedNodes.fetch_add(1, std::memory_order_relaxed); break;
     }
 }
 
@@ -161,6 +162,10 @@ void NodeStateManager::updateStats(NodeState oldState, NodeState newState) {
             if (_stats.cancelledNodes.load(std::memory_order_relaxed) > 0) 
                 _stats.cancelledNodes.fetch_sub(1, std::memory_order_relaxed); 
             break;
+        case NodeState::Skipped:
+            if (_stats.skippedNodes.load(std::memory_order_relaxed) > 0)
+                _stats.skippedNodes.fetch_sub(1, std::memory_order_relaxed);
+            break;
     }
     
     // Atomically increment new state counter
@@ -172,6 +177,7 @@ void NodeStateManager::updateStats(NodeState oldState, NodeState newState) {
         case NodeState::Completed: _stats.completedNodes.fetch_add(1, std::memory_order_relaxed); break;
         case NodeState::Failed:    _stats.failedNodes.fetch_add(1, std::memory_order_relaxed); break;
         case NodeState::Cancelled: _stats.cancelledNodes.fetch_add(1, std::memory_order_relaxed); break;
+        case NodeState::Skipped:   _stats.skippedNodes.fetch_add(1, std::memory_order_relaxed); break;
     }
 }
 
@@ -210,6 +216,10 @@ void NodeStateManager::publishStateChange(NodeHandle node, NodeState from, NodeS
             _eventBus->publish(NodeCancelledEvent(_graph, node));
             break;
             
+        case NodeState::Skipped:
+            _eventBus->publish(NodeSkippedEvent(_graph, node));
+            break;
+            
         default:
             break;
     }
@@ -98,7 +98,7 @@ public:
     /**
      * @brief Check if a node is in a terminal state
      * @param node The node to check
-     * @return true if node is in Completed, Failed, or Cancelled state
+     * @return true if node is in Completed, Failed, Cancelled, or Skipped state
      */
     bool isTerminal(NodeHandle node) const {
         return isTerminalState(getState(node));
@@ -114,6 +114,7 @@ public:
         stats.completedNodes.store(_stats.completedNodes.load(std::memory_order_relaxed));
         stats.failedNodes.store(_stats.failedNodes.load(std::memory_order_relaxed));
         stats.cancelledNodes.store(_stats.cancelledNodes.load(std::memory_order_relaxed));
+        stats.skippedNodes.store(_stats.skippedNodes.load(std::memory_order_relaxed));
         stats.pendingNodes.store(_stats.pendingNodes.load(std::memory_order_relaxed));
         stats.readyNodes.store(_stats.readyNodes.load(std::memory_order_relaxed));
         stats.scheduledNodes.store(_stats.scheduledNodes.load(std::memory_order_relaxed));
@@ -130,6 +131,7 @@ public:
         _stats.completedNodes.store(0, std::memory_order_relaxed);
         _stats.failedNodes.store(0, std::memory_order_relaxed);
         _stats.cancelledNodes.store(0, std::memory_order_relaxed);
+        _stats.skippedNodes.store(0, std::memory_order_relaxed);
         _stats.pendingNodes.store(0, std::memory_order_relaxed);
         _stats.readyNodes.store(0, std::memory_order_relaxed);
         _stats.scheduledNodes.store(0, std::memory_order_relaxed);
@@ -0,0 +1,277 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "PartitionedScheduler.h"
+#include "WorkContractGroup.h"
+#include "CpuTopology.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+// Thread-local state definition
+thread_local PartitionedScheduler::ThreadState PartitionedScheduler::stThreadState;
+
+PartitionedScheduler::PartitionedScheduler(const Config& config)
+    : PartitionedScheduler(config, Options{}) {
+}
+
+PartitionedScheduler::PartitionedScheduler(const Config& config, const Options& options)
+    : _config(config)
+    , _instanceId(allocateInstanceId())
+    , _options(options)
+    , _updateCycleInterval(config.updateCycleInterval) {
+    WorkerLocality locality = config.locality;
+    size_t workers = config.threadCount;
+    if (workers == 0) {
+        workers = locality.empty() ? CpuTopology::get().getRecommendedWorkerCount() : locality.size();
+    }
+    if (locality.size() < workers) {
+        locality = CpuTopology::get().planWorkers(static_cast<uint32_t>(workers));
+    }
+
+    _workerPartition.resize(workers);
+    if (options.partitionCount > 0) {
+        // Contiguous worker ranges; planWorkers() keeps neighbouring ids on the same L3
+        _partitionCount = std::min(options.partitionCount, workers);
+        for (size_t w = 0; w < workers; ++w) {
+            _workerPartition[w] = w * _partitionCount / workers;
+        }
+    } else {
+        // One partition per L3 domain, numbered in order of first appearance
+        std::vector<uint32_t> domains;
+        for (size_t w = 0; w < workers; ++w) {
+            auto it = std::find(domains.begin(), domains.end(), locality.l3Domains[w]);
+            if (it == domains.end()) {
+                domains.push_back(locality.l3Domains[w]);
+                it = domains.end() - 1;
+            }
+            _workerPartition[w] = static_cast<size_t>(it - domains.begin());
+        }
+        _partitionCount = std::max<size_t>(domains.size(), 1);
+    }
+    _groupsPerPartition.assign(_partitionCount, 0);
+}
+
+size_t PartitionedScheduler::partitionOfLocked(WorkContractGroup* group) {
+    auto it = _assignment.find(group);
+    if (it != _assignment.end()) {
+        return it->second;
+    }
+
+    auto fewest = std::min_element(_groupsPerPartition.begin(), _groupsPerPartition.end());
+    size_t partition = static_cast<size_t>(fewest - _groupsPerPartition.begin());
+    _assignment.emplace(group, partition);
+    ++_groupsPerPartition[partition];
+    return partition;
+}
+
+void PartitionedScheduler::placeLocked(WorkContractGroup* group, size_t partition) {
+    auto it = _assignment.find(group);
+    if (it != _assignment.end()) {
+        --_groupsPerPartition[it->second];
+        it->second = partition;
+    } else {
+        _assignment.emplace(group, partition);
+    }
+    ++_groupsPerPartition[partition];
+}
+
+void PartitionedScheduler::rebuildThreadState(const std::vector<WorkContractGroup*>& groups, size_t threadId) {
+    auto& state = stThreadState;
+    size_t mine = getWorkerPartition(threadId);
+
+    // Other partitions ordered by distance so stealing tries the next partition over first
+    std::vector<std::pair<size_t, WorkContractGroup*>> foreign;
+    state.own.clear();
+
+    std::lock_guard<std::mutex> lock(_assignmentMutex);
+    for (WorkContractGroup* group : groups) {
+        if (!group) continue;
+        size_t partition = partitionOfLocked(group);
+        if (partition == mine) {
+            state.own.push_back(group);
+        } else {
+            foreign.emplace_back((partition + _partitionCount - mine) % _partitionCount, group);
+        }
+    }
+    std::stable_sort(foreign.begin(), foreign.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    state.others.clear();
+    state.others.reserve(foreign.size());
+    for (const auto& entry : foreign) {
+        state.others.push_back(entry.second);
+    }
+
+    state.owner = _instanceId;
+    state.threadId = threadId;
+    state.lastSeenGeneration = _generation.load(std::memory_order_acquire);
+    state.ownCursor = 0;
+    state.stealCursor = 0;
+}
+
+namespace {
+    // Round-robin over a list, returning the first group with scheduled work
+    WorkContractGroup* pickScheduled(const std::vector<WorkContractGroup*>& list, size_t& cursor) {
+        for (size_t attempts = 0; attempts < list.size(); ++attempts) {
+            if (cursor >= list.size()) {
+                cursor = 0;
+            }
+            WorkContractGroup* group = list[cursor++];
+            if (group->approximateScheduledCount() > 0) {
+                return group;
+            }
+        }
+        return nullptr;
+    }
+}
+
+IWorkScheduler::ScheduleResult PartitionedScheduler::selectNextGroup(
+    const std::vector<WorkContractGroup*>& groups,
+    const SchedulingContext& context
+) {
+    if (groups.empty()) {
+        return {nullptr, true};
+    }
+
+    auto& state = stThreadState;
+    if (state.owner != _instanceId || state.threadId != context.threadId ||
+        state.lastSeenGeneration != _generation.load(std::memory_order_acquire)) {
+        rebuildThreadState(groups, context.threadId);
+    }
+
+    if (_options.assignment == PartitionAssignment::ByLoad && context.threadId == 0 &&
+        ++state.selections >= _updateCycleInterval.load(std::memory_order_relaxed)) {
+        state.selections = 0;
+        int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+        int64_t last = _lastRebalance.load(std::memory_order_relaxed);
+        auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(_options.rebalanceInterval);
+        if (now - last >= interval.count() &&
+            _lastRebalance.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            if (rebalance() > 0) {
+                rebuildThreadState(groups, context.threadId);
+            }
+        }
+    }
+
+    if (WorkContractGroup* group = pickScheduled(state.own, state.ownCursor)) {
+        return {group, false};
+    }
+
+    // Own partition is idle; help whichever partition is nearest and has work
+    if (WorkContractGroup* group = pickScheduled(state.others, state.stealCursor)) {
+        return {group, false};
+    }
+
+    return {nullptr, true};
+}
+
+void PartitionedScheduler::notifyGroupsChanged(const std::vector<WorkContractGroup*>& newGroups) {
+    std::lock_guard<std::mutex> lock(_assignmentMutex);
+
+    std::unordered_set<WorkContractGroup*> present(newGroups.begin(), newGroups.end());
+    for (auto it = _assignment.begin(); it != _assignment.end();) {
+        if (!present.count(it->first)) {
+            --_groupsPerPartition[it->second];
+            _pinned.erase(it->first);
+            it = _assignment.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (WorkContractGroup* group : newGroups) {
+        if (group) {
+            partitionOfLocked(group);
+        }
+    }
+
+    _generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void PartitionedScheduler::reset() {
+    std::lock_guard<std::mutex> lock(_assignmentMutex);
+    _assignment.clear();
+    _pinned.clear();
+    std::fill(_groupsPerPartition.begin(), _groupsPerPartition.end(), 0);
+    _generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void PartitionedScheduler::applyTuning(size_t /*maxConsecutiveExecutionCount*/, size_t updateCycleInterval) {
+    _updateCycleInterval.store(updateCycleInterval, std::memory_order_relaxed);
+}
+
+void PartitionedScheduler::assignGroup(WorkContractGroup* group, size_t partition) {
+    if (partition >= _partitionCount) {
+        throw std::invalid_argument("Partition index out of range");
+    }
+
+    std::lock_guard<std::mutex> lock(_assignmentMutex);
+    placeLocked(group, partition);
+    _pinned.insert(group);
+    _generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+size_t PartitionedScheduler::rebalance() {
+    std::lock_guard<std::mutex> lock(_assignmentMutex);
+
+    // Pinned groups count toward their partition's load but never move
+    std::vector<size_t> load(_partitionCount, 0);
+    std::vector<std::pair<size_t, WorkContractGroup*>> movable;
+    for (const auto& [group, partition] : _assignment) {
+        size_t backlog = group->approximateScheduledCount() + group->approximateExecutingCount();
+        if (_pinned.count(group)) {
+            load[partition] += backlog;
+        } else if (backlog > 0) {
+            movable.emplace_back(backlog, group);
+        }
+    }
+
+    // Longest backlog first, each onto the currently lightest partition; ties keep
+    // the group where it is so a balanced layout is left alone
+    std::sort(movable.begin(), movable.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+
+    size_t moved = 0;
+    for (const auto& [backlog, group] : movable) {
+        size_t current = _assignment[group];
+        size_t target = current;
+        for (size_t p = 0; p < _partitionCount; ++p) {
+            if (load[p] < load[target]) {
+                target = p;
+            }
+        }
+        load[target] += backlog;
+        if (target != current) {
+            placeLocked(group, target);
+            ++moved;
+        }
+    }
+
+    if (moved > 0) {
+        _generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+    return moved;
+}
+
+std::optional<size_t> PartitionedScheduler::getGroupPartition(WorkContractGroup* group) const {
+    std::lock_guard<std::mutex> lock(_assignmentMutex);
+    auto it = _assignment.find(group);
+    if (it == _assignment.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
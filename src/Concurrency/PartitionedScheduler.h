@@ -0,0 +1,225 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file PartitionedScheduler.h
+ * @brief Scheduler that gives each work group a home subset of workers
+ *
+ * This file contains PartitionedScheduler, which splits the worker pool into partitions
+ * (by default one per L3 domain) and assigns every group to one of them, so a group's
+ * SignalTree and counters are only touched by the cores that share a cache.
+ */
+
+#pragma once
+
+#include "IWorkScheduler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief How PartitionedScheduler maps groups onto partitions
+ */
+enum class PartitionAssignment : uint8_t {
+    Static,     ///< A group keeps the partition it was given when first seen
+    ByLoad      ///< Busy groups are periodically spread so partitions carry similar backlogs
+};
+
+/**
+ * @brief Scheduler that keeps each group on a subset of workers
+ *
+ * With every worker eligible for every group, each group's ready tree and counters
+ * bounce between all cores. PartitionedScheduler divides the workers into partitions
+ * and homes each group on one: workers serve their own partition's groups first, and
+ * only look at other partitions once their own has nothing scheduled. A group's hot
+ * data therefore stays within a few cores' caches while no worker idles next to work.
+ *
+ * Partitions default to one per L3 domain of the planned worker placement
+ * (Config::locality, or CpuTopology's plan for Config::threadCount). Groups are
+ * assigned to the partition with the fewest groups when first seen, or explicitly
+ * with assignGroup(). In ByLoad mode worker 0 periodically reassigns groups that have
+ * work so each partition's backlog is similar; idle groups stay where they are.
+ *
+ * Advantages:
+ * - Group state stays in the caches of the workers that use it
+ * - Stealing keeps every worker busy when partitions are unevenly loaded
+ *
+ * Limitations:
+ * - Within a partition groups are served round-robin, with no adaptive weighting
+ * - A single-L3 machine gets one partition unless Options::partitionCount is set
+ *
+ * @code
+ * IWorkScheduler::Config config;
+ * config.threadCount = 16;
+ * PartitionedScheduler::Options options;
+ * options.assignment = PartitionAssignment::ByLoad;
+ * auto scheduler = std::make_unique<PartitionedScheduler>(config, options);
+ * auto* partitioned = scheduler.get();
+ *
+ * WorkService::Config serviceConfig;
+ * serviceConfig.threadCount = 16;
+ * WorkService service(serviceConfig, std::move(scheduler));
+ * service.addWorkContractGroup(&physics);
+ * service.addWorkContractGroup(&audio);
+ * partitioned->assignGroup(&audio, 1);   // Keep audio off the physics cores
+ * @endcode
+ */
+class PartitionedScheduler : public IWorkScheduler {
+public:
+    /**
+     * @brief Partitioning options beyond the common scheduler config
+     */
+    struct Options {
+        size_t partitionCount = 0;                                  ///< Worker subsets (0 = one per L3 domain)
+        PartitionAssignment assignment = PartitionAssignment::Static; ///< Group placement policy
+        std::chrono::milliseconds rebalanceInterval{50};            ///< Minimum time between ByLoad rebalances
+    };
+
+private:
+    /// Per-worker view of the current assignment, rebuilt when the generation changes
+    struct ThreadState {
+        uint64_t owner = 0;                             ///< Instance id of the scheduler this state was built for
+        size_t threadId = SIZE_MAX;                     ///< Worker id this state was built for
+        uint64_t lastSeenGeneration = 0;                ///< Assignment generation the lists reflect
+        std::vector<WorkContractGroup*> own;            ///< Groups homed on this worker's partition
+        std::vector<WorkContractGroup*> others;         ///< Everything else, nearest partition first
+        size_t ownCursor = 0;                           ///< Round-robin position in own
+        size_t stealCursor = 0;                         ///< Round-robin position in others
+        size_t selections = 0;                          ///< Calls since the last rebalance check
+    };
+
+    /// Thread-local scheduling state; lets selectNextGroup() run without locks
+    static thread_local ThreadState stThreadState;
+
+    Config _config;                                     ///< Common scheduler configuration
+    uint64_t _instanceId;                               ///< Unique per scheduler; tags thread-local state
+    Options _options;                                   ///< Partitioning options
+    std::atomic<size_t> _updateCycleInterval;           ///< Tunable copy of Config::updateCycleInterval
+    std::vector<size_t> _workerPartition;               ///< Partition per worker id
+    size_t _partitionCount = 1;                         ///< Number of partitions
+
+    // Group placement; read by workers only when rebuilding their ThreadState
+    mutable std::mutex _assignmentMutex;                ///< Guards the fields below
+    std::unordered_map<WorkContractGroup*, size_t> _assignment; ///< Partition per known group
+    std::unordered_set<WorkContractGroup*> _pinned;     ///< Groups placed by assignGroup(); never rebalanced
+    std::vector<size_t> _groupsPerPartition;            ///< Group count per partition
+    std::atomic<uint64_t> _generation{1};               ///< Bumped on every placement change
+    std::atomic<int64_t> _lastRebalance{0};             ///< steady_clock ticks of the last ByLoad pass
+
+    /// Returns the group's partition, placing unknown groups on the least populated one
+    size_t partitionOfLocked(WorkContractGroup* group);
+
+    /// Moves a group between partitions, keeping the counts in step
+    void placeLocked(WorkContractGroup* group, size_t partition);
+
+    /// Rebuilds the calling worker's own/others lists
+    void rebuildThreadState(const std::vector<WorkContractGroup*>& groups, size_t threadId);
+
+public:
+    /**
+     * @brief Constructs with default options (one partition per L3 domain, static placement)
+     *
+     * @param config Scheduler configuration; threadCount should match the WorkService
+     */
+    explicit PartitionedScheduler(const Config& config);
+
+    /**
+     * @brief Constructs with explicit partitioning options
+     *
+     * @param config Scheduler configuration; threadCount should match the WorkService
+     * @param options Partition count and placement policy
+     */
+    PartitionedScheduler(const Config& config, const Options& options);
+
+    ~PartitionedScheduler() override = default;
+
+    /**
+     * @brief Picks a group from the worker's partition, stealing only if it is idle
+     *
+     * @param groups Available work groups
+     * @param context Current thread context (threadId selects the partition)
+     * @return Group with work, or nullptr if no partition has any
+     */
+    ScheduleResult selectNextGroup(
+        const std::vector<WorkContractGroup*>& groups,
+        const SchedulingContext& context
+    ) override;
+
+    /**
+     * @brief Drops removed groups and places new ones
+     */
+    void notifyGroupsChanged(const std::vector<WorkContractGroup*>& newGroups) override;
+
+    /**
+     * @brief Forgets all placements; workers rebuild on their next call
+     */
+    void reset() override;
+
+    /**
+     * @brief Updates how often worker 0 checks for a ByLoad rebalance
+     */
+    void applyTuning(size_t maxConsecutiveExecutionCount, size_t updateCycleInterval) override;
+
+    /**
+     * @brief Returns "Partitioned"
+     */
+    const char* getName() const override { return "Partitioned"; }
+
+    /**
+     * @brief Homes a group on a specific partition
+     *
+     * Pinned groups are never moved by ByLoad rebalancing. Call this after the group has
+     * been added to the service; removing the group drops the pin.
+     *
+     * @param group Group to place
+     * @param partition Partition index, below getPartitionCount()
+     * @throws std::invalid_argument if partition is out of range
+     */
+    void assignGroup(WorkContractGroup* group, size_t partition);
+
+    /**
+     * @brief Spreads groups with work across partitions by backlog
+     *
+     * Longest-backlog-first onto the least loaded partition; groups without work and
+     * pinned groups stay put. Called automatically in ByLoad mode, callable in either.
+     *
+     * @return Number of groups that changed partition
+     */
+    size_t rebalance();
+
+    size_t getPartitionCount() const noexcept { return _partitionCount; }
+
+    /**
+     * @brief Partition a worker serves first
+     * @param threadId Worker id
+     * @return Partition index
+     */
+    size_t getWorkerPartition(size_t threadId) const noexcept {
+        return _workerPartition[threadId % _workerPartition.size()];
+    }
+
+    /**
+     * @brief Partition a group is currently homed on
+     * @param group Group to look up
+     * @return Partition index, or nullopt if the scheduler has not seen the group
+     */
+    std::optional<size_t> getGroupPartition(WorkContractGroup* group) const;
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,487 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "Pipeline.h"
+#include "FiberWorker.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <format>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+namespace {
+    constexpr size_t SOURCE_STAGE = static_cast<size_t>(-1);
+
+    struct Token {
+        uint64_t sequence = 0;   ///< Position in source order
+        std::any value;          ///< Current payload
+        bool failed = false;     ///< A stage threw; remaining stage functions are skipped
+    };
+
+    struct Stage {
+        std::string name;
+        PipelineStageKind kind = PipelineStageKind::Parallel;
+        Pipeline::StageFunction fn;
+
+        // Serial stages only
+        std::mutex mutex;
+        bool busy = false;                              ///< An item is inside the stage
+        uint64_t nextSequence = 0;                      ///< SerialInOrder: sequence allowed in next
+        std::map<uint64_t, Token*> reorderBuffer;       ///< SerialInOrder: early arrivals
+        std::deque<Token*> queue;                       ///< SerialOutOfOrder: arrivals while busy
+        size_t peakQueueDepth = 0;
+
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> failed{0};
+        std::atomic<uint64_t> busyNanos{0};
+    };
+
+    struct DeferredRun {
+        size_t stage;
+        Token* token;
+    };
+}
+
+struct Pipeline::State : std::enable_shared_from_this<Pipeline::State> {
+    WorkContractGroup* group = nullptr;
+    WorkContractGroup::AdmissionTicket admissionTicket;  ///< Set before the first submit
+    std::atomic<uint32_t> admissionRequests{0};         ///< requestAdmission() calls in flight; the destructor waits them out
+    size_t maxTokens = 0;
+
+    Pipeline::SourceFunction source;
+    std::string sourceName;
+    std::atomic<uint64_t> sourceProduced{0};
+    std::atomic<uint64_t> sourceBusyNanos{0};
+    std::vector<std::unique_ptr<Stage>> stages;
+
+    // Run state, guarded by mutex
+    mutable std::mutex mutex;
+    std::condition_variable completion;
+    bool started = false;
+    bool sourceRunning = false;
+    bool sourceDone = false;
+    size_t inFlight = 0;
+    size_t peakInFlight = 0;
+    uint64_t nextSequence = 0;
+    std::vector<Token> tokens;                          ///< Fixed token pool, one per allowed item
+    std::vector<Token*> freeTokens;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point finishTime;
+
+    std::atomic<bool> cancelled{false};                 ///< Stop calling the source
+    std::atomic<bool> detached{false};                  ///< Owner is gone, skip all user code
+    std::atomic<uint64_t> itemsCompleted{0};
+    std::atomic<uint64_t> itemsFailed{0};
+
+    std::mutex deferredMutex;
+    std::deque<DeferredRun> deferred;                   ///< Runs that found the group full
+
+    bool isCompleteLocked() const {
+        return started && sourceDone && !sourceRunning && inFlight == 0;
+    }
+
+    void submit(size_t stage, Token* token) {
+        auto self = shared_from_this();
+        auto handle = group->createContract([self, stage, token]() {
+            if (stage == SOURCE_STAGE) {
+                self->runSource(token);
+            } else {
+                self->runStage(stage, token);
+            }
+        });
+        if (handle.valid()) {
+            handle.schedule();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(deferredMutex);
+            deferred.push_back(DeferredRun{stage, token});
+        }
+        // Runs a turn right away if capacity came back before we queued. Once the owner
+        // is gone the ticket may be unregistered; the deferred run is simply dropped.
+        admissionRequests.fetch_add(1, std::memory_order_seq_cst);
+        if (!detached.load(std::memory_order_seq_cst)) {
+            group->requestAdmission(admissionTicket);
+        }
+        admissionRequests.fetch_sub(1, std::memory_order_release);
+    }
+
+    /// Admission turn: submits deferred runs until the group fills; true if some are left
+    bool drainDeferred() {
+        while (true) {
+            DeferredRun run;
+            {
+                std::lock_guard<std::mutex> lock(deferredMutex);
+                if (deferred.empty()) return false;
+                run = deferred.front();
+                deferred.pop_front();
+            }
+
+            auto self = shared_from_this();
+            auto handle = group->createContract([self, run]() {
+                if (run.stage == SOURCE_STAGE) {
+                    self->runSource(run.token);
+                } else {
+                    self->runStage(run.stage, run.token);
+                }
+            });
+            if (!handle.valid()) {
+                std::lock_guard<std::mutex> lock(deferredMutex);
+                deferred.push_front(run);
+                return true;
+            }
+            handle.schedule();
+        }
+    }
+
+    void pumpSource() {
+        Token* token = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!started || sourceRunning || sourceDone || inFlight >= maxTokens) {
+                return;
+            }
+            if (cancelled.load(std::memory_order_acquire)) {
+                sourceDone = true;
+                if (isCompleteLocked()) {
+                    finishTime = std::chrono::steady_clock::now();
+                    completion.notify_all();
+                    FiberWorker::notifyResumable();
+                }
+                return;
+            }
+            sourceRunning = true;
+            token = freeTokens.back();
+            freeTokens.pop_back();
+            peakInFlight = std::max(peakInFlight, ++inFlight);
+        }
+        submit(SOURCE_STAGE, token);
+    }
+
+    void runSource(Token* token) {
+        bool produced = false;
+        if (!cancelled.load(std::memory_order_acquire) && !detached.load(std::memory_order_acquire)) {
+            auto begin = std::chrono::steady_clock::now();
+            try {
+                produced = source(token->value);
+            } catch (const std::exception& e) {
+                ENTROPY_LOG_ERROR_CAT("Concurrency", std::format("Pipeline source '{}' threw, ending stream: {}", sourceName, e.what()));
+            } catch (...) {
+                ENTROPY_LOG_ERROR_CAT("Concurrency", std::format("Pipeline source '{}' threw, ending stream", sourceName));
+            }
+            sourceBusyNanos.fetch_add(elapsedNanos(begin), std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sourceRunning = false;
+            if (!produced) {
+                sourceDone = true;
+                token->value.reset();
+                freeTokens.push_back(token);
+                --inFlight;
+                if (isCompleteLocked()) {
+                    finishTime = std::chrono::steady_clock::now();
+                    completion.notify_all();
+                    FiberWorker::notifyResumable();
+                }
+                return;
+            }
+            token->sequence = nextSequence++;
+        }
+
+        sourceProduced.fetch_add(1, std::memory_order_relaxed);
+        enterStage(0, token);
+        pumpSource();
+    }
+
+    void enterStage(size_t index, Token* token) {
+        if (index == stages.size()) {
+            retire(token);
+            return;
+        }
+
+        Stage& stage = *stages[index];
+        if (stage.kind != PipelineStageKind::Parallel) {
+            std::lock_guard<std::mutex> lock(stage.mutex);
+            bool inOrder = stage.kind == PipelineStageKind::SerialInOrder;
+            if (stage.busy || (inOrder && token->sequence != stage.nextSequence)) {
+                if (inOrder) {
+                    stage.reorderBuffer.emplace(token->sequence, token);
+                } else {
+                    stage.queue.push_back(token);
+                }
+                stage.peakQueueDepth = std::max(stage.peakQueueDepth,
+                                                inOrder ? stage.reorderBuffer.size() : stage.queue.size());
+                return;
+            }
+            stage.busy = true;
+        }
+        submit(index, token);
+    }
+
+    void runStage(size_t index, Token* token) {
+        Stage& stage = *stages[index];
+
+        if (!token->failed && !detached.load(std::memory_order_acquire)) {
+            auto begin = std::chrono::steady_clock::now();
+            try {
+                stage.fn(token->value);
+                stage.processed.fetch_add(1, std::memory_order_relaxed);
+            } catch (const std::exception& e) {
+                token->failed = true;
+                stage.failed.fetch_add(1, std::memory_order_relaxed);
+                ENTROPY_LOG_WARNING_CAT("Concurrency", std::format("Pipeline stage '{}' threw on item {}: {}", stage.name, token->sequence, e.what()));
+            } catch (...) {
+                token->failed = true;
+                stage.failed.fetch_add(1, std::memory_order_relaxed);
+                ENTROPY_LOG_WARNING_CAT("Concurrency", std::format("Pipeline stage '{}' threw on item {}", stage.name, token->sequence));
+            }
+            stage.busyNanos.fetch_add(elapsedNanos(begin), std::memory_order_relaxed);
+        }
+
+        if (stage.kind != PipelineStageKind::Parallel) {
+            // Hand the stage straight to the next waiting item, keeping it marked busy
+            Token* next = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(stage.mutex);
+                if (stage.kind == PipelineStageKind::SerialInOrder) {
+                    stage.nextSequence++;
+                    auto it = stage.reorderBuffer.begin();
+                    if (it != stage.reorderBuffer.end() && it->first == stage.nextSequence) {
+                        next = it->second;
+                        stage.reorderBuffer.erase(it);
+                    }
+                } else if (!stage.queue.empty()) {
+                    next = stage.queue.front();
+                    stage.queue.pop_front();
+                }
+                stage.busy = next != nullptr;
+            }
+            if (next) {
+                submit(index, next);
+            }
+        }
+
+        enterStage(index + 1, token);
+    }
+
+    void retire(Token* token) {
+        if (token->failed) {
+            itemsFailed.fetch_add(1, std::memory_order_relaxed);
+        } else if (!detached.load(std::memory_order_acquire)) {
+            itemsCompleted.fetch_add(1, std::memory_order_relaxed);
+        }
+        token->value.reset();
+        token->failed = false;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            freeTokens.push_back(token);
+            --inFlight;
+            if (isCompleteLocked()) {
+                finishTime = std::chrono::steady_clock::now();
+                completion.notify_all();
+                FiberWorker::notifyResumable();
+                return;
+            }
+        }
+        pumpSource();
+    }
+
+    static uint64_t elapsedNanos(std::chrono::steady_clock::time_point begin) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - begin).count());
+    }
+};
+
+Pipeline::Pipeline(WorkContractGroup* workContractGroup, size_t maxTokensInFlight, std::string name)
+    : Debug::Named(name)
+    , _state(std::make_shared<State>())
+    , _workContractGroup(workContractGroup) {
+    if (!_workContractGroup) {
+        throw std::invalid_argument("Pipeline requires a valid WorkContractGroup");
+    }
+    if (maxTokensInFlight == 0) {
+        throw std::invalid_argument("Pipeline requires maxTokensInFlight > 0");
+    }
+
+    _state->group = _workContractGroup;
+    _state->maxTokens = maxTokensInFlight;
+
+    // Runs that found the group full wait in its admission queue, which gives us a turn
+    // per freed slot only while something is deferred
+    std::weak_ptr<State> weakState = _state;
+    _admissionTicket = _workContractGroup->registerAdmission([weakState]() {
+        auto state = weakState.lock();
+        return state && state->drainDeferred();
+    });
+    _state->admissionTicket = _admissionTicket;
+}
+
+Pipeline::~Pipeline() {
+    // Contracts keep the state alive; make sure they only do bookkeeping from here on
+    _state->cancelled.store(true, std::memory_order_release);
+    _state->detached.store(true, std::memory_order_seq_cst);
+    
+    // Pairs with submit(): a run that missed the detached flag is still requesting a turn
+    while (_state->admissionRequests.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    _workContractGroup->unregisterAdmission(_admissionTicket);
+}
+
+void Pipeline::setSourceErased(SourceFunction source, std::string name) {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (_state->started) {
+        throw std::logic_error("Cannot change the source of a running Pipeline");
+    }
+    _state->source = std::move(source);
+    _state->sourceName = std::move(name);
+}
+
+void Pipeline::addStageErased(PipelineStageKind kind, StageFunction fn, std::string name) {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (_state->started) {
+        throw std::logic_error("Cannot add stages to a running Pipeline");
+    }
+    auto stage = std::make_unique<Stage>();
+    stage->name = name.empty() ? std::format("stage{}", _state->stages.size()) : std::move(name);
+    stage->kind = kind;
+    stage->fn = std::move(fn);
+    _state->stages.push_back(std::move(stage));
+}
+
+void Pipeline::run() {
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        if (!_state->source) {
+            throw std::logic_error("Pipeline has no source");
+        }
+        if (_state->started) {
+            throw std::logic_error("Pipeline has already been started");
+        }
+
+        _state->tokens.resize(_state->maxTokens);
+        _state->freeTokens.reserve(_state->maxTokens);
+        for (auto& token : _state->tokens) {
+            _state->freeTokens.push_back(&token);
+        }
+        _state->startTime = std::chrono::steady_clock::now();
+        _state->started = true;
+    }
+
+    _state->pumpSource();
+}
+
+void Pipeline::cancel() {
+    _state->cancelled.store(true, std::memory_order_release);
+    // An idle source would otherwise never notice
+    _state->pumpSource();
+}
+
+void Pipeline::wait() {
+    // A stage of another pipeline (or any contract) on a fiber suspends instead of blocking
+    FiberWorker::suspendUntil([this]() {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        return !_state->started || _state->isCompleteLocked();
+    });
+
+    std::unique_lock<std::mutex> lock(_state->mutex);
+    if (!_state->started) {
+        return;
+    }
+    _state->completion.wait(lock, [this]() { return _state->isCompleteLocked(); });
+}
+
+bool Pipeline::isComplete() const {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    return _state->isCompleteLocked();
+}
+
+size_t Pipeline::getTokensInFlight() const {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    return _state->inFlight;
+}
+
+size_t Pipeline::getPeakTokensInFlight() const {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    return _state->peakInFlight;
+}
+
+uint64_t Pipeline::getItemsCompleted() const {
+    return _state->itemsCompleted.load(std::memory_order_relaxed);
+}
+
+uint64_t Pipeline::getItemsFailed() const {
+    return _state->itemsFailed.load(std::memory_order_relaxed);
+}
+
+size_t Pipeline::getStageCount() const {
+    return _state->stages.size();
+}
+
+std::vector<PipelineStageStats> Pipeline::getStageStats() const {
+    double wallSeconds = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        if (_state->started) {
+            auto end = _state->isCompleteLocked() ? _state->finishTime : std::chrono::steady_clock::now();
+            wallSeconds = std::chrono::duration<double>(end - _state->startTime).count();
+        }
+    }
+
+    auto finish = [wallSeconds](PipelineStageStats& stats) {
+        if (wallSeconds > 0.0) {
+            stats.itemsPerSecond = static_cast<double>(stats.itemsProcessed) / wallSeconds;
+            stats.utilization = std::chrono::duration<double>(stats.busyTime).count() / wallSeconds;
+        }
+    };
+
+    std::vector<PipelineStageStats> result;
+    result.reserve(_state->stages.size() + 1);
+
+    PipelineStageStats source;
+    source.name = _state->sourceName;
+    source.kind = PipelineStageKind::SerialInOrder;
+    source.itemsProcessed = _state->sourceProduced.load(std::memory_order_relaxed);
+    source.busyTime = std::chrono::nanoseconds(_state->sourceBusyNanos.load(std::memory_order_relaxed));
+    finish(source);
+    result.push_back(std::move(source));
+
+    for (const auto& stage : _state->stages) {
+        PipelineStageStats stats;
+        stats.name = stage->name;
+        stats.kind = stage->kind;
+        stats.itemsProcessed = stage->processed.load(std::memory_order_relaxed);
+        stats.itemsFailed = stage->failed.load(std::memory_order_relaxed);
+        stats.busyTime = std::chrono::nanoseconds(stage->busyNanos.load(std::memory_order_relaxed));
+        {
+            std::lock_guard<std::mutex> lock(stage->mutex);
+            stats.peakQueueDepth = stage->peakQueueDepth;
+        }
+        finish(stats);
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,272 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file Pipeline.h
+ * @brief Bounded streaming pipeline built on WorkContractGroup
+ *
+ * WorkGraph runs a fixed set of nodes once. A Pipeline instead pulls a stream of items
+ * from a source and pushes each one through a chain of stages - decode, transform,
+ * encode - with several items in different stages at the same time. The number of
+ * items alive at once is capped, so memory stays bounded no matter how long the
+ * stream is or how far a slow stage falls behind.
+ */
+
+#pragma once
+
+#include <any>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "WorkContractGroup.h"
+#include "../Debug/Debug.h"
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief How a pipeline stage may process items concurrently
+ */
+enum class PipelineStageKind : uint8_t {
+    SerialInOrder = 0,     ///< One item at a time, in source order (writers, encoders)
+    SerialOutOfOrder = 1,  ///< One item at a time, whatever order items arrive in
+    Parallel = 2           ///< Any number of items at once (pure transforms)
+};
+
+/**
+ * @brief Throughput counters for one stage, captured by Pipeline::getStageStats()
+ */
+struct PipelineStageStats {
+    std::string name;                                   ///< Stage name
+    PipelineStageKind kind = PipelineStageKind::Parallel;  ///< Concurrency kind
+    uint64_t itemsProcessed = 0;                        ///< Items the stage function completed
+    uint64_t itemsFailed = 0;                           ///< Items whose stage function threw
+    std::chrono::nanoseconds busyTime{0};               ///< Total time spent inside the stage function
+    size_t peakQueueDepth = 0;                          ///< Most items ever waiting for a serial stage
+    double itemsPerSecond = 0.0;                        ///< itemsProcessed over the run's wall time
+    double utilization = 0.0;                           ///< busyTime over wall time (near 1.0 on a serial bottleneck)
+};
+
+/**
+ * @brief Token-limited streaming pipeline over a WorkContractGroup
+ *
+ * The source is called serially and produces one item per call until it returns
+ * std::nullopt. Each item then visits every stage in order, each visit running as one
+ * contract in the group. Parallel stages fan out freely; serial stages run one item at
+ * a time and queue the rest, and SerialInOrder stages additionally restore source order.
+ * At most maxTokensInFlight items exist at once - the source is simply not called again
+ * until an item leaves the last stage.
+ *
+ * Items are carried type-erased. Each stage receives the previous stage's output by
+ * reference; a stage returning void leaves the item unchanged, which is how sinks are
+ * written. If a stage throws, the item is counted as failed and skips the remaining
+ * stage functions, but still passes through serial stages so ordering never stalls.
+ *
+ * Parallel stage functions must be thread-safe. Serial stage functions are never run
+ * concurrently with themselves and may keep state.
+ *
+ * Stage work is only executed by whoever drains the group (WorkService workers or
+ * executeAllBackgroundWork()); wait() does not help. The pipeline may be destroyed
+ * while items are in flight - it cancels, and outstanding contracts finish as no-ops.
+ *
+ * @code
+ * WorkContractGroup group(256);
+ * Pipeline pipeline(&group, 8);  // At most 8 frames in memory
+ *
+ * pipeline.setSource([&]() -> std::optional<Packet> { return demuxer.next(); }, "demux")
+ *         .addStage<Packet>(PipelineStageKind::Parallel,
+ *                           [](Packet& p) { return decode(p); }, "decode")
+ *         .addStage<Frame>(PipelineStageKind::Parallel,
+ *                          [](Frame& f) { return scale(f); }, "scale")
+ *         .addStage<Frame>(PipelineStageKind::SerialInOrder,
+ *                          [&](Frame& f) { encoder.write(f); }, "encode");
+ *
+ * pipeline.run();
+ * pipeline.wait();
+ *
+ * for (const auto& stage : pipeline.getStageStats()) {
+ *     LOG_INFO("{}: {:.1f} items/s, {:.0f}% busy", stage.name, stage.itemsPerSecond,
+ *              stage.utilization * 100.0);
+ * }
+ * @endcode
+ */
+class Pipeline : public Debug::Named {
+public:
+    static constexpr size_t DEFAULT_MAX_TOKENS_IN_FLIGHT = 16;
+
+    using SourceFunction = std::function<bool(std::any&)>;   ///< Type-erased source, false at end of stream
+    using StageFunction = std::function<void(std::any&)>;    ///< Type-erased stage, transforms in place
+
+    /**
+     * @brief Creates an idle pipeline bound to a contract group
+     * @param workContractGroup Group the stage contracts run in (must outlive the run)
+     * @param maxTokensInFlight Most items that may exist at once
+     * @param name Debug name
+     * @throws std::invalid_argument If the group is null or maxTokensInFlight is 0
+     */
+    explicit Pipeline(WorkContractGroup* workContractGroup,
+                      size_t maxTokensInFlight = DEFAULT_MAX_TOKENS_IN_FLIGHT,
+                      std::string name = "Pipeline");
+
+    /**
+     * @brief Cancels the run and detaches from the group
+     *
+     * Items still in flight are dropped as their contracts execute.
+     */
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * @brief Sets the item source
+     *
+     * @tparam Fn Callable returning std::optional<T>; std::nullopt ends the stream
+     * @param source Called serially, once per item
+     * @param name Stage name for statistics
+     * @return *this for chaining
+     * @throws std::logic_error If the pipeline has already been started
+     */
+    template<typename Fn>
+    Pipeline& setSource(Fn source, std::string name = "source") {
+        using Result = std::invoke_result_t<Fn&>;
+        using T = typename Result::value_type;
+        static_assert(std::is_same_v<Result, std::optional<T>>, "Pipeline source must return std::optional<T>");
+
+        setSourceErased([source = std::move(source)](std::any& item) mutable -> bool {
+            std::optional<T> next = std::invoke(source);
+            if (!next) {
+                return false;
+            }
+            item.emplace<T>(std::move(*next));
+            return true;
+        }, std::move(name));
+        return *this;
+    }
+
+    /**
+     * @brief Appends a stage
+     *
+     * @tparam In Type produced by the previous stage (or the source)
+     * @tparam Fn Callable taking In&; its return value replaces the item, void keeps it
+     * @param kind Concurrency kind of this stage
+     * @param fn Stage function
+     * @param name Stage name for statistics
+     * @return *this for chaining
+     * @throws std::logic_error If the pipeline has already been started
+     */
+    template<typename In, typename Fn>
+    Pipeline& addStage(PipelineStageKind kind, Fn fn, std::string name = "") {
+        using Out = std::invoke_result_t<Fn&, In&>;
+
+        addStageErased(kind, [fn = std::move(fn)](std::any& item) mutable {
+            In& in = std::any_cast<In&>(item);
+            if constexpr (std::is_void_v<Out>) {
+                std::invoke(fn, in);
+            } else {
+                item = std::any(std::invoke(fn, in));
+            }
+        }, std::move(name));
+        return *this;
+    }
+
+    /**
+     * @brief Sets the source from an already type-erased function
+     * @param source Writes the next item and returns true, or returns false at end of stream
+     * @param name Stage name for statistics
+     */
+    void setSourceErased(SourceFunction source, std::string name = "source");
+
+    /**
+     * @brief Appends an already type-erased stage
+     * @param kind Concurrency kind of this stage
+     * @param fn Transforms the item in place
+     * @param name Stage name for statistics
+     */
+    void addStageErased(PipelineStageKind kind, StageFunction fn, std::string name = "");
+
+    /**
+     * @brief Starts pulling items from the source
+     *
+     * Returns immediately; the stream is processed by whoever drains the group.
+     *
+     * @throws std::logic_error If no source was set or the pipeline was already started
+     */
+    void run();
+
+    /**
+     * @brief Stops calling the source; items already in flight still finish
+     */
+    void cancel();
+
+    /**
+     * @brief Blocks until the source is exhausted (or cancelled) and every item has left the pipeline
+     */
+    void wait();
+
+    /**
+     * @brief Checks whether the run has finished
+     * @return true once started, drained and the source is done
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Items currently between the source and the end of the last stage
+     * @return Tokens in flight
+     */
+    size_t getTokensInFlight() const;
+
+    /**
+     * @brief Highest getTokensInFlight() seen during the run
+     * @return Peak tokens in flight, never above the configured limit
+     */
+    size_t getPeakTokensInFlight() const;
+
+    /**
+     * @brief Items that made it through every stage
+     * @return Completed item count
+     */
+    uint64_t getItemsCompleted() const;
+
+    /**
+     * @brief Items on which some stage threw
+     * @return Failed item count
+     */
+    uint64_t getItemsFailed() const;
+
+    /**
+     * @brief Number of stages, not counting the source
+     * @return Stage count
+     */
+    size_t getStageCount() const;
+
+    /**
+     * @brief Snapshot of per-stage throughput; entry 0 is the source
+     * @return One entry per stage, source first
+     */
+    std::vector<PipelineStageStats> getStageStats() const;
+
+private:
+    struct State;
+
+    std::shared_ptr<State> _state;                              ///< Shared with in-flight contracts
+    WorkContractGroup* _workContractGroup;                      ///< Group the stages run in
+    WorkContractGroup::AdmissionTicket _admissionTicket;        ///< Admission queue turns for deferred stage runs
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -44,7 +44,7 @@ IWorkScheduler::ScheduleResult RandomScheduler::selectNextGroup(
     groupsWithWork.reserve(groups.size());
     
     for (auto* group : groups) {
-        if (group && group->scheduledCount() > 0) {
+        if (group && group->approximateScheduledCount() > 0) {
             groupsWithWork.push_back(group);
         }
     }
@@ -46,7 +46,7 @@ IWorkScheduler::ScheduleResult RoundRobinScheduler::selectNextGroup(
         attempts++;
         
         // Check if this group has work
-        if (group && group->scheduledCount() > 0) {
+        if (group && group->approximateScheduledCount() > 0) {
             return {group, false};
         }
     }
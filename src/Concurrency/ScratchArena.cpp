@@ -0,0 +1,97 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "ScratchArena.h"
+#include <algorithm>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+ScratchArena::ScratchArena(size_t chunkSize)
+    : _chunkSize(std::max<size_t>(chunkSize, 256)) {
+}
+
+void* ScratchArena::allocateSlow(size_t size, size_t alignment) {
+    // Try the chunks kept from earlier cycles before growing
+    size_t next = _cursor ? _currentChunk + 1 : 0;
+    if (_cursor) {
+        _usedInEarlierChunks += static_cast<size_t>(_cursor - _chunks[_currentChunk].data.get());
+    }
+
+    const size_t needed = size + alignment;
+    if (next >= _chunks.size() || _chunks[next].size < needed) {
+        Chunk chunk;
+        chunk.size = std::max(_chunkSize, needed);
+        chunk.data = std::make_unique<std::byte[]>(chunk.size);
+        _reservedBytes.fetch_add(chunk.size, std::memory_order_relaxed);
+        _chunks.insert(_chunks.begin() + static_cast<std::ptrdiff_t>(next), std::move(chunk));
+        if (next > 0) {
+            _chunkGrowths.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    enterChunk(next);
+    return allocate(size, alignment);
+}
+
+void ScratchArena::enterChunk(size_t index) {
+    _currentChunk = index;
+    _cursor = _chunks[index].data.get();
+    _limit = _cursor + _chunks[index].size;
+}
+
+void ScratchArena::reset() {
+    const size_t used = bytesInUse();
+    if (used > _highWaterMark.load(std::memory_order_relaxed)) {
+        _highWaterMark.store(used, std::memory_order_relaxed);
+    }
+    _resetCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (!_cursor) {
+        return;
+    }
+
+    // This cycle spilled: replace the chunk list with one chunk that would have held it all
+    if (_currentChunk > 0) {
+        size_t total = 0;
+        for (const auto& chunk : _chunks) {
+            total += chunk.size;
+        }
+        _chunks.clear();
+        Chunk merged;
+        merged.size = total;
+        merged.data = std::make_unique<std::byte[]>(total);
+        _chunks.push_back(std::move(merged));
+        _reservedBytes.store(total, std::memory_order_relaxed);
+    }
+
+    _usedInEarlierChunks = 0;
+    enterChunk(0);
+}
+
+size_t ScratchArena::bytesInUse() const noexcept {
+    if (!_cursor) {
+        return 0;
+    }
+    return _usedInEarlierChunks + static_cast<size_t>(_cursor - _chunks[_currentChunk].data.get());
+}
+
+ScratchArenaStats ScratchArena::getStats() const noexcept {
+    ScratchArenaStats stats;
+    stats.highWaterMark = _highWaterMark.load(std::memory_order_relaxed);
+    stats.reservedBytes = _reservedBytes.load(std::memory_order_relaxed);
+    stats.resetCount = _resetCount.load(std::memory_order_relaxed);
+    stats.chunkGrowths = _chunkGrowths.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
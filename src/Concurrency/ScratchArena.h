@@ -0,0 +1,171 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file ScratchArena.h
+ * @brief Per-worker bump allocator for contract-local temporaries
+ *
+ * Contracts that need a temporary buffer usually reach for std::vector or new, and with
+ * every worker doing that at once the global allocator becomes a shared hotspot. Each
+ * WorkService worker instead owns a ScratchArena: allocation is a pointer bump in memory
+ * only that thread touches, and the whole arena is rewound between contracts.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief When WorkService rewinds a worker's scratch arena
+ */
+enum class ScratchResetPolicy : uint8_t {
+    AfterEachContract = 0,   ///< Memory lives for one contract (default)
+    WhenIdle = 1,            ///< Memory lives until the worker runs out of work
+    Manual = 2               ///< Never reset by the service; call ScratchArena::reset() yourself
+};
+
+/**
+ * @brief Usage counters for one arena
+ */
+struct ScratchArenaStats {
+    size_t highWaterMark = 0;    ///< Most bytes ever in use between two resets
+    size_t reservedBytes = 0;    ///< Bytes currently held in chunks
+    uint64_t resetCount = 0;     ///< Number of reset() calls
+    uint64_t chunkGrowths = 0;   ///< Times an allocation spilled into a new chunk
+};
+
+/**
+ * @brief Single-threaded bump allocator that is rewound rather than freed
+ *
+ * Memory comes from a list of chunks. Allocation aligns the cursor and bumps it; when a
+ * chunk runs out the next one is used, or a new one big enough for the request is added.
+ * reset() rewinds to the start, and if the last cycle spilled over several chunks they
+ * are merged into one, so a steady workload settles into a single chunk sized to its
+ * high-water mark.
+ *
+ * Nothing allocated here is ever destroyed, so create() and allocateArray() only accept
+ * trivially destructible types. The owning thread is the only one that may allocate or
+ * reset; getStats() may be called from anywhere.
+ *
+ * @code
+ * work.createContract([]() {
+ *     auto& scratch = WorkService::scratch();
+ *     float* samples = scratch.allocateArray<float>(4096);   // Gone after this contract
+ *     mix(samples, 4096);
+ * });
+ * @endcode
+ */
+class ScratchArena {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Creates an arena; the first chunk is allocated on first use
+     * @param chunkSize Minimum size of each chunk
+     */
+    explicit ScratchArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /**
+     * @brief Allocates raw memory
+     * @param size Bytes to allocate
+     * @param alignment Power-of-two alignment
+     * @return Pointer valid until the next reset()
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        uintptr_t base = reinterpret_cast<uintptr_t>(_cursor);
+        uintptr_t aligned = (base + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        if (_cursor && aligned + size <= reinterpret_cast<uintptr_t>(_limit)) {
+            _cursor = reinterpret_cast<std::byte*>(aligned + size);
+            return reinterpret_cast<void*>(aligned);
+        }
+        return allocateSlow(size, alignment);
+    }
+
+    /**
+     * @brief Constructs one object in the arena
+     * @tparam T Trivially destructible type
+     * @param args Constructor arguments
+     * @return Pointer valid until the next reset()
+     */
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "ScratchArena never runs destructors");
+        return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Allocates a default-initialized array
+     * @tparam T Trivially destructible type
+     * @param count Element count
+     * @return Pointer to count elements, valid until the next reset()
+     */
+    template<typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "ScratchArena never runs destructors");
+        T* first = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        std::uninitialized_default_construct_n(first, count);
+        return first;
+    }
+
+    /**
+     * @brief Releases everything allocated since the last reset
+     */
+    void reset();
+
+    /**
+     * @brief Bytes handed out since the last reset, including alignment padding
+     * @return Bytes in use; only meaningful on the owning thread
+     */
+    size_t bytesInUse() const noexcept;
+
+    /**
+     * @brief Snapshot of the usage counters
+     * @return Stats as of the last reset
+     */
+    ScratchArenaStats getStats() const noexcept;
+
+private:
+    struct Chunk {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    void* allocateSlow(size_t size, size_t alignment);
+    void enterChunk(size_t index);
+
+    size_t _chunkSize;
+    std::vector<Chunk> _chunks;
+    size_t _currentChunk = 0;
+    size_t _usedInEarlierChunks = 0;            ///< Bytes consumed in chunks before _currentChunk
+    std::byte* _cursor = nullptr;               ///< Next free byte in the current chunk
+    std::byte* _limit = nullptr;                ///< End of the current chunk
+
+    // Written by the owner at reset/growth, readable from any thread
+    std::atomic<size_t> _highWaterMark{0};
+    std::atomic<size_t> _reservedBytes{0};
+    std::atomic<uint64_t> _resetCount{0};
+    std::atomic<uint64_t> _chunkGrowths{0};
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,180 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file ShardedCounter.h
+ * @brief Counter spread over cache-line shards so concurrent updates stop sharing a line
+ *
+ * A single atomic counter that every producer and worker updates bounces its cache line
+ * between all cores, and every scheduler read pulls it back. ShardedCounter gives each
+ * thread its own line to update, sums the shards when an exact value is needed, and
+ * serves schedulers a cached value that is refreshed every few reads.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief Non-negative counter whose updates are spread over per-thread shards
+ *
+ * Each shard keeps two monotonic totals, additions and removals, on its own cache line.
+ * Threads are spread round-robin over the shards, so with at least as many shards as
+ * threads every update hits a line no other thread writes.
+ *
+ * load() is exact in the sense that matters for quiescence checks: it reads every
+ * shard's removals before any additions, so any removal it sees comes with the addition
+ * it undoes. Because an item is always added before it is removed, the result can run
+ * ahead of the true count but never behind, and a zero really means empty. It costs two
+ * loads per shard.
+ *
+ * approximate() is for scheduling hints. It returns the calling thread's cached copy of
+ * the last exact value and refreshes it every APPROXIMATE_REFRESH reads. A cached zero is
+ * always re-checked, so new work is never hidden from a scheduler; a stale non-zero only
+ * costs a failed selection.
+ *
+ * @code
+ * ShardedCounter scheduled;
+ * scheduled.add();                        // Producer
+ * scheduled.sub();                        // Worker, likely on another shard
+ * if (scheduled.approximate() > 0) {...}  // Scheduler hint
+ * bool drained = scheduled.load() == 0;   // Exact check
+ * @endcode
+ */
+class ShardedCounter {
+public:
+    /// Non-zero approximate() reads served from the cache between refreshes
+    static constexpr uint32_t APPROXIMATE_REFRESH = 8;
+
+    /// Upper bound on shards per counter
+    static constexpr size_t MAX_SHARDS = 64;
+
+    /**
+     * @brief Shard count for the running machine
+     * @return hardware_concurrency() rounded up to a power of two, at most MAX_SHARDS
+     */
+    static size_t defaultShardCount() noexcept {
+        size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        return std::min(std::bit_ceil(threads), MAX_SHARDS);
+    }
+
+    /**
+     * @brief Creates a zeroed counter
+     * @param shardCount Number of shards, rounded up to a power of two
+     */
+    explicit ShardedCounter(size_t shardCount = defaultShardCount())
+        : _shardCount(std::bit_ceil(std::clamp<size_t>(shardCount, 1, MAX_SHARDS)))
+        , _shards(std::make_unique<Shard[]>(_shardCount)) {
+    }
+
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    /**
+     * @brief Adds to the calling thread's shard
+     * @param count Amount to add
+     * @param order Ordering of the update
+     */
+    void add(size_t count = 1, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        localShard().added.fetch_add(count, order);
+    }
+
+    /**
+     * @brief Subtracts via the calling thread's shard
+     * @param count Amount to subtract; must not exceed what was added
+     * @param order Ordering of the update
+     */
+    void sub(size_t count = 1, std::memory_order order = std::memory_order_seq_cst) noexcept {
+        localShard().removed.fetch_add(count, order);
+    }
+
+    /**
+     * @brief Sums all shards
+     * @param order Ordering of each shard load
+     * @return Current count; may run ahead of concurrent removals, never behind
+     */
+    size_t load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        uint64_t removed = 0;
+        for (size_t i = 0; i < _shardCount; ++i) {
+            removed += _shards[i].removed.load(order);
+        }
+        uint64_t added = 0;
+        for (size_t i = 0; i < _shardCount; ++i) {
+            added += _shards[i].added.load(order);
+        }
+        return added > removed ? static_cast<size_t>(added - removed) : 0;
+    }
+
+    /**
+     * @brief Cheap read for scheduling decisions
+     * @return A recent exact value; zero is always fresh
+     */
+    size_t approximate() const noexcept {
+        Shard& shard = localShard();
+        size_t cached = shard.cached.load(std::memory_order_relaxed);
+        if (cached != 0 &&
+            (shard.reads.fetch_add(1, std::memory_order_relaxed) % APPROXIMATE_REFRESH) != 0) {
+            return cached;
+        }
+        size_t exact = load(std::memory_order_acquire);
+        shard.cached.store(exact, std::memory_order_relaxed);
+        return exact;
+    }
+
+    /**
+     * @brief Overwrites the count; only safe while no other thread touches the counter
+     * @param value New count
+     */
+    void reset(size_t value = 0) noexcept {
+        for (size_t i = 0; i < _shardCount; ++i) {
+            _shards[i].added.store(i == 0 ? value : 0, std::memory_order_relaxed);
+            _shards[i].removed.store(0, std::memory_order_relaxed);
+            _shards[i].cached.store(0, std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    size_t shardCount() const noexcept { return _shardCount; }
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> added{0};             ///< Total ever added through this shard
+        std::atomic<uint64_t> removed{0};           ///< Total ever removed through this shard
+        mutable std::atomic<size_t> cached{0};      ///< Last exact value read through this shard
+        mutable std::atomic<uint32_t> reads{0};     ///< approximate() calls, for refresh pacing
+    };
+
+    /// Round-robin shard seed, assigned on a thread's first update
+    static size_t threadSeed() noexcept {
+        static std::atomic<size_t> nextSeed{0};
+        thread_local size_t seed = nextSeed.fetch_add(1, std::memory_order_relaxed);
+        return seed;
+    }
+
+    Shard& localShard() const noexcept {
+        return _shards[threadSeed() & (_shardCount - 1)];
+    }
+
+    size_t _shardCount;
+    std::unique_ptr<Shard[]> _shards;
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
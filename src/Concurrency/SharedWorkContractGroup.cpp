@@ -0,0 +1,570 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "SharedWorkContractGroup.h"
+#include "WorkContractGroup.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <new>
+#include <stdexcept>
+
+#if defined(EntropyWindows)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(EntropyLinux)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+// Everything in the segment is reached from several address spaces, so it must be address-free
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared segments need lock-free 64-bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared segments need lock-free 32-bit atomics");
+
+/// Segment header; fields above freeListHead are written once by the creator
+struct SharedWorkContractGroup::SegmentHeader {
+    std::atomic<uint64_t> magic{0};                 ///< Published last, once the segment is initialized
+    uint32_t version = 0;
+    uint32_t capacity = 0;
+    uint64_t leafCapacity = 0;
+    uint64_t slotSize = 0;                          ///< Catches processes built with a different JobDescriptor
+    uint64_t treeOffset = 0;
+    uint64_t slotsOffset = 0;
+    uint64_t segmentBytes = 0;
+
+    alignas(64) std::atomic<uint64_t> freeListHead{0};  ///< ABA tag in the high 32 bits, slot index in the low
+    alignas(64) std::atomic<uint64_t> scheduledCount{0};
+    alignas(64) std::atomic<uint32_t> wakeEpoch{0};     ///< Bumped by submissions while anyone sleeps; the futex word
+    std::atomic<uint32_t> sleepers{0};                  ///< Threads parked on wakeEpoch, in any process
+};
+
+/// One job; a cache line each so neighbouring submissions do not share lines
+struct alignas(64) SharedWorkContractGroup::Slot {
+    std::atomic<uint32_t> nextFree{0};
+    uint32_t reserved = 0;
+    JobDescriptor job;
+};
+
+namespace {
+    constexpr uint64_t SEGMENT_MAGIC = 0x454E54524F505951ULL;  // "ENTROPYQ"
+    constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+    constexpr std::chrono::milliseconds WATCHER_POLL{10};
+
+    thread_local uint64_t stSelectionBias = 0;
+
+    size_t roundUp(size_t value, size_t multiple) {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    uint64_t packHead(uint64_t tag, uint32_t index) {
+        return (tag << 32) | index;
+    }
+
+    void validateName(const std::string& name) {
+        if (name.empty() || name.size() > 200) {
+            throw std::invalid_argument("SharedWorkContractGroup: segment name must be 1-200 characters");
+        }
+        for (char c : name) {
+            bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                           c == '-' || c == '_' || c == '.';
+            if (!allowed) {
+                throw std::invalid_argument("SharedWorkContractGroup: invalid character in segment name '" + name + "'");
+            }
+        }
+    }
+
+    struct Mapping {
+        void* base = nullptr;
+        size_t bytes = 0;
+        void* handle = nullptr;
+    };
+
+#if defined(EntropyWindows)
+    std::string platformName(const std::string& name) {
+        return "Local\\" + name;
+    }
+
+    Mapping createMapping(const std::string& name, size_t bytes) {
+        HANDLE handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                           static_cast<DWORD>(static_cast<uint64_t>(bytes) >> 32),
+                                           static_cast<DWORD>(bytes & 0xFFFFFFFFu), platformName(name).c_str());
+        if (!handle) {
+            throw std::runtime_error("SharedWorkContractGroup: cannot create segment '" + name + "'");
+        }
+        if (GetLastError() == ERROR_ALREADY_EXISTS) {
+            CloseHandle(handle);
+            throw std::runtime_error("SharedWorkContractGroup: segment '" + name + "' already exists");
+        }
+        void* base = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+        if (!base) {
+            CloseHandle(handle);
+            throw std::runtime_error("SharedWorkContractGroup: cannot map segment '" + name + "'");
+        }
+        return {base, bytes, handle};
+    }
+
+    Mapping openMapping(const std::string& name, std::chrono::milliseconds) {
+        HANDLE handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, platformName(name).c_str());
+        if (!handle) {
+            throw std::runtime_error("SharedWorkContractGroup: no segment named '" + name + "'");
+        }
+        void* base = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+        if (!base) {
+            CloseHandle(handle);
+            throw std::runtime_error("SharedWorkContractGroup: cannot map segment '" + name + "'");
+        }
+        MEMORY_BASIC_INFORMATION info{};
+        VirtualQuery(base, &info, sizeof(info));
+        return {base, info.RegionSize, handle};
+    }
+
+    void closeMapping(const Mapping& mapping) {
+        UnmapViewOfFile(mapping.base);
+        CloseHandle(static_cast<HANDLE>(mapping.handle));
+    }
+
+    bool unlinkMapping(const std::string&) {
+        return false;   // Windows removes the mapping with its last handle
+    }
+#else
+    std::string platformName(const std::string& name) {
+        return "/" + name;
+    }
+
+    Mapping createMapping(const std::string& name, size_t bytes) {
+        std::string path = platformName(name);
+        int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::runtime_error(errno == EEXIST
+                ? "SharedWorkContractGroup: segment '" + name + "' already exists"
+                : "SharedWorkContractGroup: cannot create segment '" + name + "'");
+        }
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            close(fd);
+            shm_unlink(path.c_str());
+            throw std::runtime_error("SharedWorkContractGroup: cannot size segment '" + name + "'");
+        }
+        void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            shm_unlink(path.c_str());
+            throw std::runtime_error("SharedWorkContractGroup: cannot map segment '" + name + "'");
+        }
+        return {base, bytes, nullptr};
+    }
+
+    Mapping openMapping(const std::string& name, std::chrono::milliseconds timeout) {
+        int fd = shm_open(platformName(name).c_str(), O_RDWR, 0600);
+        if (fd < 0) {
+            throw std::runtime_error("SharedWorkContractGroup: no segment named '" + name + "'");
+        }
+        // The creator sizes the segment right after creating it
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        struct stat info{};
+        while (fstat(fd, &info) == 0 && info.st_size == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        if (info.st_size <= 0) {
+            close(fd);
+            throw std::runtime_error("SharedWorkContractGroup: segment '" + name + "' was never sized");
+        }
+        size_t bytes = static_cast<size_t>(info.st_size);
+        void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            throw std::runtime_error("SharedWorkContractGroup: cannot map segment '" + name + "'");
+        }
+        return {base, bytes, nullptr};
+    }
+
+    void closeMapping(const Mapping& mapping) {
+        munmap(mapping.base, mapping.bytes);
+    }
+
+    bool unlinkMapping(const std::string& name) {
+        return shm_unlink(platformName(name).c_str()) == 0;
+    }
+#endif
+}
+
+std::unique_ptr<SharedWorkContractGroup> SharedWorkContractGroup::create(const std::string& name, size_t capacity) {
+    validateName(name);
+    if (capacity == 0 || capacity >= INVALID_SLOT) {
+        throw std::invalid_argument("SharedWorkContractGroup: capacity must be between 1 and 2^32 - 2");
+    }
+
+    size_t leafCapacity = std::bit_ceil((capacity + 63) / 64);
+    size_t treeOffset = roundUp(sizeof(SegmentHeader), 64);
+    size_t slotsOffset = roundUp(treeOffset + SignalTree::requiredNodes(leafCapacity) * sizeof(std::atomic<uint64_t>), 64);
+    size_t bytes = slotsOffset + capacity * sizeof(Slot);
+
+    Mapping mapping = createMapping(name, bytes);
+    try {
+        auto* header = new (mapping.base) SegmentHeader();
+        header->version = SEGMENT_VERSION;
+        header->capacity = static_cast<uint32_t>(capacity);
+        header->leafCapacity = leafCapacity;
+        header->slotSize = sizeof(Slot);
+        header->treeOffset = treeOffset;
+        header->slotsOffset = slotsOffset;
+        header->segmentBytes = bytes;
+        return std::unique_ptr<SharedWorkContractGroup>(
+            new SharedWorkContractGroup(name, mapping.base, mapping.bytes, mapping.handle, true, true, capacity));
+    } catch (...) {
+        closeMapping(mapping);
+        unlinkMapping(name);
+        throw;
+    }
+}
+
+std::unique_ptr<SharedWorkContractGroup> SharedWorkContractGroup::open(const std::string& name,
+                                                                       std::chrono::milliseconds timeout) {
+    validateName(name);
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    Mapping mapping = openMapping(name, timeout);
+    try {
+        if (mapping.bytes < sizeof(SegmentHeader)) {
+            throw std::runtime_error("SharedWorkContractGroup: segment '" + name + "' is too small");
+        }
+        auto* header = static_cast<SegmentHeader*>(mapping.base);
+        while (header->magic.load(std::memory_order_acquire) != SEGMENT_MAGIC) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                throw std::runtime_error("SharedWorkContractGroup: segment '" + name + "' was never initialized");
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        if (header->version != SEGMENT_VERSION || header->slotSize != sizeof(Slot) ||
+            header->segmentBytes > mapping.bytes) {
+            throw std::runtime_error("SharedWorkContractGroup: segment '" + name + "' has an incompatible layout");
+        }
+        return std::unique_ptr<SharedWorkContractGroup>(
+            new SharedWorkContractGroup(name, mapping.base, mapping.bytes, mapping.handle, false, false, header->capacity));
+    } catch (...) {
+        closeMapping(mapping);
+        throw;
+    }
+}
+
+bool SharedWorkContractGroup::remove(const std::string& name) {
+    validateName(name);
+    return unlinkMapping(name);
+}
+
+SharedWorkContractGroup::SharedWorkContractGroup(std::string name, void* base, size_t bytes, void* platformHandle,
+                                                 bool owner, bool initialize, size_t capacity)
+    : _name(std::move(name))
+    , _base(base)
+    , _bytes(bytes)
+    , _platformHandle(platformHandle)
+    , _owner(owner)
+    , _capacity(capacity) {
+    auto* bytesBase = static_cast<std::byte*>(base);
+    _header = static_cast<SegmentHeader*>(base);
+    auto* nodes = reinterpret_cast<std::atomic<uint64_t>*>(bytesBase + _header->treeOffset);
+    _slots = reinterpret_cast<Slot*>(bytesBase + _header->slotsOffset);
+
+    if (initialize) {
+        size_t nodeCount = SignalTree::requiredNodes(_header->leafCapacity);
+        for (size_t i = 0; i < nodeCount; ++i) {
+            new (&nodes[i]) std::atomic<uint64_t>(0);
+        }
+        // Chain every slot into the free list, lowest index on top
+        for (size_t i = 0; i < _capacity; ++i) {
+            auto* slot = new (&_slots[i]) Slot();
+            slot->nextFree.store(i + 1 < _capacity ? static_cast<uint32_t>(i + 1) : INVALID_SLOT,
+                                 std::memory_order_relaxed);
+        }
+        _header->freeListHead.store(packHead(0, 0), std::memory_order_relaxed);
+    }
+    _readyJobs = std::make_unique<SignalTree>(_header->leafCapacity, nodes, initialize);
+
+    if (initialize) {
+        _header->magic.store(SEGMENT_MAGIC, std::memory_order_release);
+    }
+}
+
+SharedWorkContractGroup::~SharedWorkContractGroup() {
+    detach();
+    _readyJobs.reset();
+    closeMapping({_base, _bytes, _platformHandle});
+    if (_owner) {
+        // Processes still mapping the segment keep it; no new ones can open it
+        unlinkMapping(_name);
+    }
+}
+
+void SharedWorkContractGroup::registerHandler(HandlerId id, Handler handler) {
+    if (id >= MAX_HANDLERS) {
+        throw std::invalid_argument("SharedWorkContractGroup: handler id " + std::to_string(id) + " out of range");
+    }
+    std::lock_guard<std::mutex> lock(_handlerMutex);
+    _handlerStorage.push_back(std::make_unique<Handler>(std::move(handler)));
+    _handlers[id].store(_handlerStorage.back().get(), std::memory_order_release);
+}
+
+bool SharedWorkContractGroup::popFreeSlot(uint32_t& index) {
+    uint64_t head = _header->freeListHead.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t top = static_cast<uint32_t>(head);
+        if (top == INVALID_SLOT) {
+            return false;
+        }
+        uint32_t next = _slots[top].nextFree.load(std::memory_order_relaxed);
+        // The tag changes on every swing, so a slot popped and pushed back in between fails the CAS
+        if (_header->freeListHead.compare_exchange_weak(head, packHead((head >> 32) + 1, next),
+                                                        std::memory_order_acq_rel,
+                                                        std::memory_order_acquire)) {
+            index = top;
+            return true;
+        }
+    }
+}
+
+void SharedWorkContractGroup::pushFreeSlot(uint32_t index) {
+    uint64_t head = _header->freeListHead.load(std::memory_order_acquire);
+    do {
+        _slots[index].nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+    } while (!_header->freeListHead.compare_exchange_weak(head, packHead((head >> 32) + 1, index),
+                                                          std::memory_order_release,
+                                                          std::memory_order_acquire));
+}
+
+bool SharedWorkContractGroup::submit(const JobDescriptor& job) {
+    uint32_t index;
+    if (!popFreeSlot(index)) {
+        return false;
+    }
+    _slots[index].job = job;
+
+    // Count before signalling so the count never runs behind the tree
+    _header->scheduledCount.fetch_add(1, std::memory_order_seq_cst);
+    _readyJobs->set(index);
+    wakeWaiters();
+    return true;
+}
+
+void SharedWorkContractGroup::wakeWaiters() {
+    // Pairs with the sleepers increment in waitForEpochChange(): either the waiter re-checks
+    // after our submission and sees it, or we see the waiter and bump the epoch it sleeps on.
+    // With nobody asleep the submit path stays off the shared epoch line.
+    if (_header->sleepers.load(std::memory_order_seq_cst) == 0) {
+        return;
+    }
+    _header->wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+#if defined(EntropyLinux)
+    // Not FUTEX_PRIVATE: waiters may live in other processes
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_header->wakeEpoch), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+void SharedWorkContractGroup::waitForEpochChange(uint32_t epoch, std::chrono::microseconds timeout,
+                                                 const std::function<bool()>& ready) const {
+    _header->sleepers.fetch_add(1, std::memory_order_seq_cst);
+    // A submission that saw no sleepers left the epoch alone, so look for its work directly
+    if (ready()) {
+        _header->sleepers.fetch_sub(1, std::memory_order_seq_cst);
+        return;
+    }
+#if defined(EntropyLinux)
+    if (_header->wakeEpoch.load(std::memory_order_seq_cst) == epoch) {
+        timespec wait{static_cast<time_t>(timeout.count() / 1000000), static_cast<long>(timeout.count() % 1000000) * 1000};
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&_header->wakeEpoch), FUTEX_WAIT, epoch, &wait, nullptr, 0);
+    }
+#else
+    // No portable cross-process wait; poll the epoch
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (_header->wakeEpoch.load(std::memory_order_seq_cst) == epoch && !ready() &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+#endif
+    _header->sleepers.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+bool SharedWorkContractGroup::waitForWork(std::chrono::microseconds timeout) const {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        uint32_t epoch = _header->wakeEpoch.load(std::memory_order_seq_cst);
+        if (scheduledCount() > 0) {
+            return true;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            return false;
+        }
+        waitForEpochChange(epoch, remaining, [this]() { return scheduledCount() > 0; });
+    }
+}
+
+size_t SharedWorkContractGroup::scheduledCount() const {
+    return static_cast<size_t>(_header->scheduledCount.load(std::memory_order_seq_cst));
+}
+
+void SharedWorkContractGroup::dispatch(const JobDescriptor& job) {
+    Handler* handler = job.handlerId < MAX_HANDLERS
+        ? _handlers[job.handlerId].load(std::memory_order_acquire)
+        : nullptr;
+    if (!handler) {
+        if (_dropped.fetch_add(1, std::memory_order_relaxed) == 0) {
+            ENTROPY_LOG_WARNING_CAT("Concurrency", "SharedWorkContractGroup '" + _name +
+                                    "': dropping job for unregistered handler " + std::to_string(job.handlerId));
+        }
+        return;
+    }
+    (*handler)(job);
+}
+
+bool SharedWorkContractGroup::executeNext() {
+    auto [index, empty] = _readyJobs->select(stSelectionBias);
+    if (index == SignalTree::S_INVALID_SIGNAL_INDEX) {
+        return false;
+    }
+
+    // Copy the job out and recycle the slot before running, so a throwing handler cannot leak it
+    auto slotIndex = static_cast<uint32_t>(index);
+    JobDescriptor job = _slots[slotIndex].job;
+    _header->scheduledCount.fetch_sub(1, std::memory_order_seq_cst);
+    pushFreeSlot(slotIndex);
+
+    dispatch(job);
+    return true;
+}
+
+size_t SharedWorkContractGroup::executeReady(size_t maxJobs) {
+    size_t executed = 0;
+    while (executed < maxJobs && executeNext()) {
+        executed++;
+    }
+    return executed;
+}
+
+void SharedWorkContractGroup::attach(WorkContractGroup& local, size_t maxDrainers) {
+    if (_local) {
+        throw std::logic_error("SharedWorkContractGroup: already attached to a local group");
+    }
+    _local = &local;
+    _maxDrainers = std::max<size_t>(maxDrainers, 1);
+    _attached.store(true, std::memory_order_release);
+
+    _watcher = std::jthread([this](std::stop_token token) {
+        while (!token.stop_requested()) {
+            uint32_t epoch = _header->wakeEpoch.load(std::memory_order_seq_cst);
+            pumpDrainers();
+            waitForEpochChange(epoch, WATCHER_POLL, [this]() { return needsDrainer(); });
+        }
+    });
+}
+
+void SharedWorkContractGroup::detach() {
+    if (!_local) {
+        return;
+    }
+    std::vector<WorkContractHandle> queued;
+    {
+        // No drainer is scheduled past this point, so the list below is complete
+        std::lock_guard<std::mutex> lock(_drainerMutex);
+        _attached.store(false, std::memory_order_release);
+        queued.swap(_drainers);
+    }
+    _watcher.request_stop();
+    _watcher.join();
+    _watcher = std::jthread();
+
+    // Take back drain contracts no worker has picked up; the local group may never run
+    // them again, e.g. after its WorkService stopped
+    for (auto& handle : queued) {
+        if (handle.unschedule() == ScheduleResult::NotScheduled) {
+            handle.release();
+            _inFlight.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    // The rest are executing right now and still point at us; they finish their batch
+    while (_inFlight.load(std::memory_order_acquire) > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    _local = nullptr;
+}
+
+bool SharedWorkContractGroup::scheduleDrainer() {
+    std::lock_guard<std::mutex> lock(_drainerMutex);
+    if (!_attached.load(std::memory_order_acquire)) {
+        return false;
+    }
+    auto handle = _local->createContract([this]() { drain(); });
+    if (!handle.valid()) {
+        return false;
+    }
+    if (handle.schedule() != ScheduleResult::Scheduled) {
+        handle.release();
+        return false;
+    }
+
+    // Drop handles of drainers that have finished, whose slots have moved on
+    std::erase_if(_drainers, [](const WorkContractHandle& drainer) { return !drainer.valid(); });
+    _drainers.push_back(handle);
+    return true;
+}
+
+bool SharedWorkContractGroup::needsDrainer() const {
+    if (!_attached.load(std::memory_order_acquire)) {
+        return false;
+    }
+    size_t inFlight = _inFlight.load(std::memory_order_acquire);
+    return inFlight < _maxDrainers && inFlight < scheduledCount();
+}
+
+void SharedWorkContractGroup::pumpDrainers() {
+    if (!_attached.load(std::memory_order_acquire)) {
+        return;
+    }
+    size_t backlog = scheduledCount();
+    size_t inFlight = _inFlight.load(std::memory_order_acquire);
+    while (inFlight < _maxDrainers && inFlight < backlog) {
+        if (!_inFlight.compare_exchange_weak(inFlight, inFlight + 1, std::memory_order_acq_rel)) {
+            continue;
+        }
+        if (!scheduleDrainer()) {
+            _inFlight.fetch_sub(1, std::memory_order_acq_rel);
+            return;   // Local group full; the watcher retries on its next pass
+        }
+        inFlight++;
+    }
+}
+
+void SharedWorkContractGroup::drain() {
+    size_t executed = 0;
+    while (executed < DRAIN_BATCH && executeNext()) {
+        executed++;
+    }
+
+    // Hand our in-flight slot to a successor while jobs remain; submissions made after we
+    // saw the queue empty wake the watcher instead
+    if (executed == DRAIN_BATCH && _attached.load(std::memory_order_acquire) &&
+        scheduledCount() > 0 && scheduleDrainer()) {
+        return;
+    }
+    _inFlight.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
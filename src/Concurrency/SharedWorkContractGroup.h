@@ -0,0 +1,297 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file SharedWorkContractGroup.h
+ * @brief Work queue in named shared memory, drained by workers of several processes
+ *
+ * This file contains SharedWorkContractGroup, a WorkContractGroup counterpart whose slot
+ * array and SignalTree live in a named shared-memory segment. Jobs are trivially copyable
+ * JobDescriptors routed to handlers each process registers under the same ids.
+ */
+
+#pragma once
+
+#include "SignalTree.h"
+#include "WorkContractHandle.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+class WorkContractGroup;
+
+/**
+ * @brief Fixed-size, trivially copyable job that can cross process boundaries
+ *
+ * Carries a handler id and up to PAYLOAD_CAPACITY bytes of trivially copyable
+ * payload. Pointers inside a payload are only meaningful to the process that wrote
+ * them; pass offsets into other shared memory instead.
+ *
+ * @code
+ * struct Resize { uint32_t imageId; uint16_t width, height; };
+ * auto job = JobDescriptor::make(RESIZE_HANDLER, Resize{7, 640, 480});
+ * Resize args = job.get<Resize>();
+ * @endcode
+ */
+struct JobDescriptor {
+    static constexpr size_t PAYLOAD_CAPACITY = 48;
+
+    uint32_t handlerId = 0;                         ///< Handler to dispatch to
+    uint32_t payloadSize = 0;                       ///< Bytes of payload in use
+    alignas(8) std::byte payload[PAYLOAD_CAPACITY]{};
+
+    /**
+     * @brief Builds a descriptor carrying a copy of value
+     * @tparam T Trivially copyable payload type of at most PAYLOAD_CAPACITY bytes
+     */
+    template<typename T>
+    static JobDescriptor make(uint32_t handlerId, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Job payloads must be trivially copyable");
+        static_assert(sizeof(T) <= PAYLOAD_CAPACITY, "Job payload exceeds JobDescriptor::PAYLOAD_CAPACITY");
+        JobDescriptor job;
+        job.handlerId = handlerId;
+        job.payloadSize = static_cast<uint32_t>(sizeof(T));
+        std::memcpy(job.payload, &value, sizeof(T));
+        return job;
+    }
+
+    /**
+     * @brief Copies the payload out as T
+     * @tparam T The type the descriptor was made with
+     */
+    template<typename T>
+    T get() const {
+        static_assert(std::is_trivially_copyable_v<T>, "Job payloads must be trivially copyable");
+        static_assert(sizeof(T) <= PAYLOAD_CAPACITY, "Job payload exceeds JobDescriptor::PAYLOAD_CAPACITY");
+        T value;
+        std::memcpy(&value, payload, sizeof(T));
+        return value;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<JobDescriptor>, "JobDescriptor must stay trivially copyable");
+
+/**
+ * @brief Lock-free job pool in named shared memory for multi-process worker pools
+ *
+ * Several processes on one host that each run a full WorkService oversubscribe the CPU
+ * when their loads peak at different times. A SharedWorkContractGroup lets them share
+ * one queue instead: any process can submit, and the workers of every attached process
+ * pull from the same SignalTree with the same lock-free select WorkContractGroup uses.
+ *
+ * Since std::function cannot cross address spaces, work is described by a JobDescriptor
+ * and dispatched to a handler registered under its id. Every consuming process must
+ * register the handlers for all ids it may see; jobs with no local handler are dropped
+ * and counted in droppedCount().
+ *
+ * The segment holds a header, the tree's node array and one 64-byte slot per job.
+ * Slots are recycled through a tagged lock-free free list, and a job's slot is
+ * released as soon as its descriptor has been copied out, before the handler runs.
+ *
+ * Workers of a local WorkService reach the queue through attach(): a watcher thread
+ * parks on the segment's wake word (a futex on Linux, polling elsewhere) and keeps up to
+ * a fixed number of drain contracts scheduled in a local WorkContractGroup while jobs are
+ * waiting. The local scheduler then balances shared jobs against local work as usual.
+ *
+ * Limitations: a process that dies after taking a job loses that job, and one that dies
+ * mid-submit leaks a slot. All processes must be built with the same JobDescriptor
+ * layout; the segment header carries a version to catch mismatches.
+ *
+ * @code
+ * // Process A
+ * auto shared = SharedWorkContractGroup::create("EntropyJobs", 4096);
+ * shared->registerHandler(RESIZE, [](const JobDescriptor& job) { resize(job.get<Resize>()); });
+ * WorkContractGroup local(256, "SharedDrain");
+ * service.addWorkContractGroup(&local);
+ * shared->attach(local, service.getThreadCount());
+ *
+ * // Process B
+ * auto queue = SharedWorkContractGroup::open("EntropyJobs");
+ * queue->submit(RESIZE, Resize{7, 640, 480});
+ * @endcode
+ */
+class SharedWorkContractGroup {
+public:
+    using HandlerId = uint32_t;
+    using Handler = std::function<void(const JobDescriptor&)>;
+
+    static constexpr HandlerId MAX_HANDLERS = 256;      ///< Handler ids must be below this
+    static constexpr size_t DRAIN_BATCH = 64;           ///< Jobs a drain contract runs before yielding its worker
+    static constexpr uint32_t SEGMENT_VERSION = 1;      ///< Bumped whenever the segment layout changes
+
+    /**
+     * @brief Creates a new named segment
+     * @param name Segment name; letters, digits, '-', '_' and '.' only
+     * @param capacity Maximum jobs waiting at once
+     * @return Group owning the segment; the name is removed again when it is destroyed
+     * @throws std::invalid_argument for a bad name or capacity
+     * @throws std::runtime_error if the segment exists or cannot be created
+     */
+    static std::unique_ptr<SharedWorkContractGroup> create(const std::string& name, size_t capacity);
+
+    /**
+     * @brief Maps a segment another process created
+     * @param name Segment name given to create()
+     * @param timeout How long to wait for the creator to finish initializing it
+     * @return Group sharing the segment
+     * @throws std::runtime_error if the segment is missing, incompatible or never initialized
+     */
+    static std::unique_ptr<SharedWorkContractGroup> open(const std::string& name,
+                                                         std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief Removes a segment name left behind by a process that crashed
+     * @return true if a segment of that name existed
+     */
+    static bool remove(const std::string& name);
+
+    ~SharedWorkContractGroup();
+
+    SharedWorkContractGroup(const SharedWorkContractGroup&) = delete;
+    SharedWorkContractGroup& operator=(const SharedWorkContractGroup&) = delete;
+
+    /**
+     * @brief Routes jobs with the given id to handler in this process
+     *
+     * Register before jobs with that id can arrive. Re-registering replaces the handler.
+     *
+     * @throws std::invalid_argument if id >= MAX_HANDLERS
+     */
+    void registerHandler(HandlerId id, Handler handler);
+
+    /**
+     * @brief Queues a job for any attached process
+     * @return false if the segment is full
+     */
+    bool submit(const JobDescriptor& job);
+
+    /**
+     * @brief Queues a job built from a trivially copyable payload
+     * @return false if the segment is full
+     */
+    template<typename T>
+    bool submit(HandlerId id, const T& payload) {
+        return submit(JobDescriptor::make(id, payload));
+    }
+
+    /**
+     * @brief Takes one waiting job and runs its handler on the calling thread
+     * @return false if no job was waiting
+     */
+    bool executeNext();
+
+    /**
+     * @brief Runs waiting jobs on the calling thread until none are left
+     * @param maxJobs Upper bound on jobs to run
+     * @return Jobs run
+     */
+    size_t executeReady(size_t maxJobs = std::numeric_limits<size_t>::max());
+
+    /**
+     * @brief Blocks until a job is waiting or the timeout passes
+     * @return true if jobs are waiting
+     */
+    bool waitForWork(std::chrono::microseconds timeout) const;
+
+    /**
+     * @brief Feeds jobs to the workers serving a local group
+     *
+     * Starts a watcher thread that keeps up to maxDrainers drain contracts scheduled
+     * in local while jobs are waiting. Each drain contract runs up to DRAIN_BATCH jobs.
+     * The local group must stay registered with a running WorkService until detach().
+     *
+     * @param local Group whose workers should run shared jobs
+     * @param maxDrainers Drain contracts in flight at once, typically the worker count
+     * @throws std::logic_error if already attached
+     */
+    void attach(WorkContractGroup& local, size_t maxDrainers);
+
+    /**
+     * @brief Stops feeding the local group
+     *
+     * Drain contracts no worker has started are unscheduled and released, so this
+     * returns even if the local group is never executed again. Ones already running
+     * are waited for.
+     */
+    void detach();
+
+    bool isAttached() const { return _local != nullptr; }
+
+    /// Jobs waiting across all processes
+    size_t scheduledCount() const;
+
+    /// Jobs dropped by this process for lack of a handler
+    uint64_t droppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+    size_t capacity() const { return _capacity; }
+    const std::string& name() const { return _name; }
+
+    /// True for the group that created the segment
+    bool isOwner() const { return _owner; }
+
+private:
+    struct SegmentHeader;
+    struct Slot;
+
+    SharedWorkContractGroup(std::string name, void* base, size_t bytes, void* platformHandle,
+                            bool owner, bool initialize, size_t capacity);
+
+    bool popFreeSlot(uint32_t& index);
+    void pushFreeSlot(uint32_t index);
+    void wakeWaiters();
+    void waitForEpochChange(uint32_t epoch, std::chrono::microseconds timeout, const std::function<bool()>& ready) const;
+    void dispatch(const JobDescriptor& job);
+    bool scheduleDrainer();
+    bool needsDrainer() const;
+    void pumpDrainers();
+    void drain();
+
+    std::string _name;
+    void* _base;                                        ///< Start of the mapped segment
+    size_t _bytes;                                      ///< Mapped size
+    void* _platformHandle;                              ///< Mapping handle where the platform needs one
+    bool _owner;
+    size_t _capacity;
+
+    SegmentHeader* _header;
+    Slot* _slots;
+    std::unique_ptr<SignalTree> _readyJobs;             ///< This process's view of the shared tree
+
+    std::array<std::atomic<Handler*>, MAX_HANDLERS> _handlers{};
+    std::vector<std::unique_ptr<Handler>> _handlerStorage;  ///< Keeps replaced handlers alive for running jobs
+    std::mutex _handlerMutex;                           ///< Serializes registerHandler()
+    std::atomic<uint64_t> _dropped{0};
+
+    WorkContractGroup* _local = nullptr;
+    size_t _maxDrainers = 0;
+    std::atomic<bool> _attached{false};                 ///< Cleared first by detach() so no new drainers start
+    std::atomic<size_t> _inFlight{0};                   ///< Drain contracts scheduled or running
+    std::vector<WorkContractHandle> _drainers;          ///< Drain contracts handed to _local; finished ones pruned lazily
+    std::mutex _drainerMutex;                           ///< Guards _drainers against detach()
+    std::jthread _watcher;
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
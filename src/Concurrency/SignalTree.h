@@ -23,7 +23,9 @@
 #include <cstdint> // For uint64_t
 #include <bit> // For std::countr_zero
 #include <stdexcept> // For std::invalid_argument
+#include <vector>
 #include "../CoreCommon.h"
+#include "HugePageAllocator.h"
 
 namespace EntropyEngine {
 namespace Core {
@@ -105,7 +107,8 @@ namespace Concurrency {
     private:
         const size_t _leafCapacity;
         const size_t _totalNodes;
-        std::unique_ptr<std::atomic<uint64_t>[]> _nodes; ///< Tree storage: internal nodes are counters, leaf nodes are bitmaps
+        std::vector<std::atomic<uint64_t>, HugePageAllocator<std::atomic<uint64_t>>> _ownedNodes; ///< Node storage when the tree allocates its own
+        std::atomic<uint64_t>* _nodes; ///< Tree storage: internal nodes are counters, leaf nodes are bitmaps
         
         /**
          * @brief Runtime power-of-2 validation helper
@@ -137,12 +140,14 @@ namespace Concurrency {
         /**
          * @brief Constructs a SignalTree with specified leaf capacity
          * @param leafCapacity Number of leaf nodes (must be power of 2)
+         * @param pagePolicy Page backing for the node array; only trees of 2 MiB and up are affected
          * @throws std::invalid_argument if leafCapacity is not a power of 2
          */
-        explicit SignalTree(size_t leafCapacity):
+        explicit SignalTree(size_t leafCapacity, PageAllocationPolicy pagePolicy = PageAllocationPolicy::Default):
             _leafCapacity(leafCapacity)
             , _totalNodes(2 * leafCapacity - 1)
-            , _nodes(std::make_unique<std::atomic<uint64_t>[]>(_totalNodes)) {
+            , _ownedNodes(_totalNodes, HugePageAllocator<std::atomic<uint64_t>>(pagePolicy))
+            , _nodes(_ownedNodes.data()) {
             
             if (!isPowerOf2(_leafCapacity)) {
                 throw std::invalid_argument("LeafCapacity must be a power of 2 and greater than 0");
@@ -153,6 +158,43 @@ namespace Concurrency {
                 _nodes[i].store(0, std::memory_order_relaxed);
             }
         }
+
+        /**
+         * @brief Constructs a SignalTree over caller-owned node storage
+         *
+         * Several trees may share one node array, e.g. one per process mapping the same
+         * shared memory; all of them see and select the same signals. Only the first
+         * should pass initialize = true.
+         *
+         * @param leafCapacity Number of leaf nodes (must be power of 2)
+         * @param nodes Storage for requiredNodes(leafCapacity) atomics; must outlive the tree
+         * @param initialize Zero the nodes rather than adopt their current contents
+         * @throws std::invalid_argument if leafCapacity is not a power of 2 or nodes is null
+         */
+        SignalTree(size_t leafCapacity, std::atomic<uint64_t>* nodes, bool initialize):
+            _leafCapacity(leafCapacity)
+            , _totalNodes(2 * leafCapacity - 1)
+            , _nodes(nodes) {
+
+            if (!isPowerOf2(_leafCapacity) || !_nodes) {
+                throw std::invalid_argument("LeafCapacity must be a power of 2 and node storage must be provided");
+            }
+
+            if (initialize) {
+                for (size_t i = 0; i < _totalNodes; ++i) {
+                    _nodes[i].store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Node count a tree of the given leaf capacity needs
+         * @param leafCapacity Number of leaf nodes
+         * @return Size of the node array for the external-storage constructor
+         */
+        static constexpr size_t requiredNodes(size_t leafCapacity) {
+            return 2 * leafCapacity - 1;
+        }
         
         SignalTree(const SignalTree&) = delete;
         SignalTree& operator=(const SignalTree&) = delete;
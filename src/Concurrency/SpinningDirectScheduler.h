@@ -118,7 +118,7 @@ public:
         const SchedulingContext& context
     ) override {
         for (auto* group : groups) {
-            if (group && group->scheduledCount() > 0) {
+            if (group && group->approximateScheduledCount() > 0) {
                 return {group, false}; // Never sleep
             }
         }
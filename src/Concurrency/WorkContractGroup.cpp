@@ -9,76 +9,81 @@
 
 #include "WorkContractGroup.h"
 #include "IConcurrencyProvider.h"
+#include "FiberWorker.h"
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <utility>
 
 namespace EntropyEngine {
 namespace Core {
 namespace Concurrency {
+    thread_local uint32_t WorkContractGroup::stDurationSampleCountdown = WorkContractGroup::DURATION_SAMPLE_INTERVAL;
+
     static size_t roundUpToPowerOf2(size_t n) {
         if (n <= 1) return 1;
         return static_cast<size_t>(std::pow(2, std::ceil(std::log2(n))));
     }
 
+    static uint64_t packFreeListHead(uint64_t tag, uint32_t index) {
+        return (tag << 32) | index;
+    }
+
     // Helper function to create appropriately sized SignalTree
-    std::unique_ptr<SignalTreeBase> WorkContractGroup::createSignalTree(size_t capacity) {
+    std::unique_ptr<SignalTreeBase> WorkContractGroup::createSignalTree(size_t capacity, PageAllocationPolicy pagePolicy) {
         size_t leafCount = (capacity + 63) / 64;
         // Ensure minimum of 2 leaves to avoid single-node tree bug
         // where the same node serves as both root counter and leaf bitmap
         size_t powerOf2 = std::max(roundUpToPowerOf2(leafCount), size_t(2));
         
-        return std::make_unique<SignalTree>(powerOf2);
+        return std::make_unique<SignalTree>(powerOf2, pagePolicy);
     }
 
-    WorkContractGroup::WorkContractGroup(size_t capacity, std::string name)
-        : _capacity(capacity)
-        , _contracts(capacity)
-        , _name(name) {
-        
-        // Create SignalTree for ready contracts
-        _readyContracts = createSignalTree(capacity);
-        
-        // Create SignalTree for main thread contracts
-        _mainThreadContracts = createSignalTree(capacity);
+    WorkContractGroup::WorkContractGroup(size_t capacity, std::string name, PageAllocationPolicy pagePolicy)
+        : _pagePolicy(pagePolicy)
+        , _name(name)
+        , _capacity(capacity) {
         
-        // Initialize the lock-free free list
-        // Build a linked list through all slots
-        for (size_t i = 0; i < _capacity - 1; ++i) {
-            _contracts[i].nextFree.store(static_cast<uint32_t>(i + 1), std::memory_order_relaxed);
-        }
-        // Last slot points to INVALID_INDEX
-        _contracts[_capacity - 1].nextFree.store(INVALID_INDEX, std::memory_order_relaxed);
+        // Reserve slot storage without constructing it - untouched pages cost no memory,
+        // and createContract() constructs each slot the first time it is handed out
+        _contracts = static_cast<ContractSlot*>(
+            HugePageMemory::allocate(_capacity * sizeof(ContractSlot), alignof(ContractSlot), _pagePolicy));
         
-        // Head points to first slot
-        _freeListHead.store(0, std::memory_order_relaxed);
+        // Create SignalTree for ready contracts. The main thread tree waits for the
+        // first main thread contract, since most groups never get one.
+        _readyContracts = createSignalTree(capacity, pagePolicy);
     }
     
     WorkContractGroup::WorkContractGroup(WorkContractGroup&& other) noexcept
-        : _capacity(other._capacity)
-        , _contracts(std::move(other._contracts))
+        : _contracts(std::exchange(other._contracts, nullptr))
+        , _untouchedCursor(other._untouchedCursor.exchange(0, std::memory_order_acq_rel))
+        , _constructedCursor(other._constructedCursor.exchange(0, std::memory_order_acq_rel))
+        , _pagePolicy(other._pagePolicy)
         , _readyContracts(std::move(other._readyContracts))
-        , _mainThreadContracts(std::move(other._mainThreadContracts))
-        , _freeListHead(other._freeListHead.load(std::memory_order_acquire))
-        , _activeCount(other._activeCount.load(std::memory_order_acquire))
-        , _scheduledCount(other._scheduledCount.load(std::memory_order_acquire))
-        , _executingCount(other._executingCount.load(std::memory_order_acquire))
-        , _selectingCount(other._selectingCount.load(std::memory_order_acquire))
+        , _mainThreadContracts(other._mainThreadContracts.exchange(nullptr, std::memory_order_acq_rel))
+        , _freeListHead(other._freeListHead.exchange(EMPTY_FREE_LIST, std::memory_order_acq_rel))
         , _mainThreadScheduledCount(other._mainThreadScheduledCount.load(std::memory_order_acquire))
         , _mainThreadExecutingCount(other._mainThreadExecutingCount.load(std::memory_order_acquire))
         , _mainThreadSelectingCount(other._mainThreadSelectingCount.load(std::memory_order_acquire))
         , _name(std::move(other._name))
+        , _capacity(other._capacity)
         , _concurrencyProvider(other._concurrencyProvider)
         , _stopping(other._stopping.load(std::memory_order_acquire))
     {
+        _activeCount.reset(other._activeCount.load());
+        _scheduledCount.reset(other._scheduledCount.load());
+        _executingCount.reset(other._executingCount.load());
+        _selectingCount.reset(other._selectingCount.load());
+
         // Clear the other object to prevent double cleanup
         other._concurrencyProvider = nullptr;
         other._stopping.store(true, std::memory_order_release);
-        other._activeCount.store(0, std::memory_order_release);
-        other._scheduledCount.store(0, std::memory_order_release);
-        other._executingCount.store(0, std::memory_order_release);
-        other._selectingCount.store(0, std::memory_order_release);
+        other._activeCount.reset();
+        other._scheduledCount.reset();
+        other._executingCount.reset();
+        other._selectingCount.reset();
         other._mainThreadScheduledCount.store(0, std::memory_order_release);
         other._mainThreadExecutingCount.store(0, std::memory_order_release);
         other._mainThreadSelectingCount.store(0, std::memory_order_release);
@@ -92,16 +97,24 @@ namespace Concurrency {
             // Clear the provider reference
             _concurrencyProvider = nullptr;
             
+            // Release our own slots before taking over other's
+            unscheduleAllContracts();
+            releaseAllContracts();
+            releaseStorage();
+            
             // Move from other
             const_cast<size_t&>(_capacity) = other._capacity;
-            _contracts = std::move(other._contracts);
+            _contracts = std::exchange(other._contracts, nullptr);
+            _untouchedCursor.store(other._untouchedCursor.exchange(0, std::memory_order_acq_rel), std::memory_order_release);
+            _constructedCursor.store(other._constructedCursor.exchange(0, std::memory_order_acq_rel), std::memory_order_release);
+            _pagePolicy = other._pagePolicy;
             _readyContracts = std::move(other._readyContracts);
-            _mainThreadContracts = std::move(other._mainThreadContracts);
-            _freeListHead.store(other._freeListHead.load(std::memory_order_acquire), std::memory_order_release);
-            _activeCount.store(other._activeCount.load(std::memory_order_acquire), std::memory_order_release);
-            _scheduledCount.store(other._scheduledCount.load(std::memory_order_acquire), std::memory_order_release);
-            _executingCount.store(other._executingCount.load(std::memory_order_acquire), std::memory_order_release);
-            _selectingCount.store(other._selectingCount.load(std::memory_order_acquire), std::memory_order_release);
+            _mainThreadContracts.store(other._mainThreadContracts.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
+            _freeListHead.store(other._freeListHead.exchange(EMPTY_FREE_LIST, std::memory_order_acq_rel), std::memory_order_release);
+            _activeCount.reset(other._activeCount.load());
+            _scheduledCount.reset(other._scheduledCount.load());
+            _executingCount.reset(other._executingCount.load());
+            _selectingCount.reset(other._selectingCount.load());
             _mainThreadScheduledCount.store(other._mainThreadScheduledCount.load(std::memory_order_acquire), std::memory_order_release);
             _mainThreadExecutingCount.store(other._mainThreadExecutingCount.load(std::memory_order_acquire), std::memory_order_release);
             _mainThreadSelectingCount.store(other._mainThreadSelectingCount.load(std::memory_order_acquire), std::memory_order_release);
@@ -112,20 +125,21 @@ namespace Concurrency {
             // Clear the other object
             other._concurrencyProvider = nullptr;
             other._stopping.store(true, std::memory_order_release);
-            other._activeCount.store(0, std::memory_order_release);
-            other._scheduledCount.store(0, std::memory_order_release);
-            other._executingCount.store(0, std::memory_order_release);
+            other._activeCount.reset();
+            other._scheduledCount.reset();
+            other._executingCount.reset();
             other._mainThreadScheduledCount.store(0, std::memory_order_release);
             other._mainThreadExecutingCount.store(0, std::memory_order_release);
-            other._selectingCount.store(0, std::memory_order_release);
+            other._selectingCount.reset();
             other._mainThreadSelectingCount.store(0, std::memory_order_release);
         }
         return *this;
     }
     
     void WorkContractGroup::releaseAllContracts() {
-        // Iterate through all contract slots and release any that are still allocated or scheduled
-        for (uint32_t i = 0; i < _capacity; ++i) {
+        // Iterate through every slot ever handed out and release any that are still allocated or scheduled
+        const uint32_t touched = _constructedCursor.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < touched; ++i) {
             auto& slot = _contracts[i];
             
             // Check if this slot is occupied (not free)
@@ -146,8 +160,9 @@ namespace Concurrency {
     }
 
     void WorkContractGroup::unscheduleAllContracts() {
-        // Iterate through all contract slots and unschedule any that are scheduled
-        for (uint32_t i = 0; i < _capacity; ++i) {
+        // Iterate through every slot ever handed out and unschedule any that are scheduled
+        const uint32_t touched = _constructedCursor.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < touched; ++i) {
             auto& slot = _contracts[i];
             
             // Check if this slot is scheduled
@@ -158,20 +173,14 @@ namespace Concurrency {
                 if (slot.state.compare_exchange_strong(expected, ContractState::Allocated,
                                                       std::memory_order_acq_rel)) {
                     // Remove from appropriate ready set based on execution type
-                    size_t newScheduledCount;
                     if (slot.executionType == ExecutionType::MainThread) {
-                        _mainThreadContracts->clear(i);
-                        newScheduledCount = _mainThreadScheduledCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+                        mainThreadTree()->clear(i);
+                        _mainThreadScheduledCount.fetch_sub(1, std::memory_order_seq_cst);
                     } else {
                         _readyContracts->clear(i);
-                        newScheduledCount = _scheduledCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
-                    }
-                    
-                    // Notify waiters if all scheduled contracts are complete
-                    if (newScheduledCount == 0) {
-                        std::lock_guard<std::mutex> lock(_waitMutex);
-                        _waitCondition.notify_all();
+                        _scheduledCount.sub();
                     }
+                    notifyWaiters();
                 }
                 // If CAS failed, state changed - likely now executing, which is fine
             }
@@ -216,24 +225,132 @@ namespace Concurrency {
         if (provider) {
             provider->notifyGroupDestroyed(this);
         }
+
+        releaseStorage();
+    }
+
+    SignalTreeBase* WorkContractGroup::mainThreadTree() {
+        SignalTreeBase* tree = _mainThreadContracts.load(std::memory_order_acquire);
+        if (tree) {
+            return tree;
+        }
+        
+        // Racing creators each build a tree; the loser's is discarded
+        auto created = createSignalTree(_capacity, _pagePolicy);
+        if (_mainThreadContracts.compare_exchange_strong(tree, created.get(),
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_acquire)) {
+            return created.release();
+        }
+        return tree;
     }
 
-    WorkContractHandle WorkContractGroup::createContract(std::function<void()> work, ExecutionType executionType) {
-        // Pop a free slot from the lock-free stack
-        uint32_t head = _freeListHead.load(std::memory_order_acquire);
+    void WorkContractGroup::releaseStorage() noexcept {
+        delete _mainThreadContracts.exchange(nullptr, std::memory_order_acq_rel);
         
-        while (head != INVALID_INDEX) {
-            // Read the next pointer before we try to swing the head
-            uint32_t next = _contracts[head].nextFree.load(std::memory_order_acquire);
-            
-            // Try to swing the head to the next free slot
-            if (_freeListHead.compare_exchange_weak(head, next, 
-                                                   std::memory_order_acq_rel,
-                                                   std::memory_order_acquire)) {
-                // Success! We got this slot
-                break;
+        if (_contracts) {
+            const uint32_t touched = _constructedCursor.exchange(0, std::memory_order_acq_rel);
+            _untouchedCursor.store(0, std::memory_order_release);
+            for (uint32_t i = 0; i < touched; ++i) {
+                _contracts[i].~ContractSlot();
+            }
+            HugePageMemory::deallocate(_contracts, _capacity * sizeof(ContractSlot), alignof(ContractSlot), _pagePolicy);
+            _contracts = nullptr;
+        }
+        _freeListHead.store(EMPTY_FREE_LIST, std::memory_order_release);
+    }
+
+    bool WorkContractGroup::popFreeSlot(uint32_t& index) noexcept {
+        uint64_t head = _freeListHead.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t top = static_cast<uint32_t>(head);
+            if (top == INVALID_INDEX) {
+                return false;
+            }
+            // Read the next pointer before we try to swing the head. The tag changes on
+            // every swing, so if top was popped and pushed back meanwhile the CAS fails.
+            uint32_t next = _contracts[top].nextFree.load(std::memory_order_acquire);
+            if (_freeListHead.compare_exchange_weak(head, packFreeListHead((head >> 32) + 1, next),
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_acquire)) {
+                index = top;
+                return true;
+            }
+        }
+    }
+
+    void WorkContractGroup::pushFreeSlot(uint32_t index) noexcept {
+        uint64_t head = _freeListHead.load(std::memory_order_acquire);
+        do {
+            _contracts[index].nextFree.store(static_cast<uint32_t>(head), std::memory_order_release);
+        } while (!_freeListHead.compare_exchange_weak(head, packFreeListHead((head >> 32) + 1, index),
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_acquire));
+    }
+
+    uint32_t WorkContractGroup::popFreeSlots(uint32_t maxCount, uint32_t& first) noexcept {
+        uint64_t head = _freeListHead.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t top = static_cast<uint32_t>(head);
+            if (top == INVALID_INDEX || maxCount == 0) {
+                return 0;
+            }
+            // Walk at most maxCount links. If any slot on the way is popped or pushed
+            // meanwhile the head's tag moves on and the CAS below fails, so a successful
+            // CAS means the links we read were the list's.
+            uint32_t count = 1;
+            uint32_t next = _contracts[top].nextFree.load(std::memory_order_acquire);
+            while (count < maxCount && next != INVALID_INDEX) {
+                next = _contracts[next].nextFree.load(std::memory_order_acquire);
+                ++count;
+            }
+            if (_freeListHead.compare_exchange_weak(head, packFreeListHead((head >> 32) + 1, next),
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_acquire)) {
+                first = top;
+                return count;
             }
-            // CAS failed, head now contains the current head value, loop will retry
+        }
+    }
+
+    uint32_t WorkContractGroup::claimUntouchedSlots(uint32_t maxCount, uint32_t& first) noexcept {
+        uint32_t untouched = _untouchedCursor.load(std::memory_order_relaxed);
+        uint32_t take = 0;
+        do {
+            take = std::min<uint32_t>(maxCount, static_cast<uint32_t>(_capacity) - untouched);
+            if (take == 0) {
+                return 0;
+            }
+        } while (!_untouchedCursor.compare_exchange_weak(untouched, untouched + take,
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_relaxed));
+        
+        for (uint32_t index = untouched; index < untouched + take; ++index) {
+            ::new (static_cast<void*>(&_contracts[index])) ContractSlot();
+        }
+        
+        // Publish in claim order so the constructed range never has holes. Earlier
+        // claimants are only a few placement-news behind us, unless preempted.
+        while (_constructedCursor.load(std::memory_order_acquire) != untouched) {
+            std::this_thread::yield();
+        }
+        _constructedCursor.store(untouched + take, std::memory_order_release);
+        
+        first = untouched;
+        return take;
+    }
+
+    WorkContractHandle WorkContractGroup::createContract(std::function<void()> work, ExecutionType executionType) {
+        // Main thread contracts need their ready tree before they can be scheduled
+        if (executionType == ExecutionType::MainThread) {
+            mainThreadTree();
+        }
+        
+        // Pop a recycled slot from the lock-free stack - it is warm in cache
+        uint32_t head = INVALID_INDEX;
+        if (!popFreeSlot(head)) {
+            // Nothing recycled - bump into slots that have never been touched
+            claimUntouchedSlots(1, head);
         }
         
         if (head == INVALID_INDEX) {
@@ -253,23 +370,69 @@ namespace Concurrency {
             slot.executionType = executionType;
         } catch (...) {
             // Return slot to free list if work assignment fails
-            uint32_t oldHead = _freeListHead.load(std::memory_order_acquire);
-            do {
-                slot.nextFree.store(oldHead, std::memory_order_release);
-            } while (!_freeListHead.compare_exchange_weak(oldHead, index,
-                                                          std::memory_order_acq_rel,
-                                                          std::memory_order_acquire));
+            pushFreeSlot(index);
             throw;  // Re-throw the exception
         }
         
         // Transition state to allocated
         slot.state.store(ContractState::Allocated, std::memory_order_release);
         // Increment active count
-        _activeCount.fetch_add(1, std::memory_order_acq_rel);
+        _activeCount.add();
         
         return WorkContractHandle(this, static_cast<uint32_t>(index), generation);
     }
 
+    size_t WorkContractGroup::createContracts(std::span<std::function<void()>> works,
+                                              std::span<WorkContractHandle> handles,
+                                              ExecutionType executionType) {
+        const size_t wanted = std::min(works.size(), handles.size());
+        if (wanted == 0) {
+            return 0;
+        }
+        if (executionType == ExecutionType::MainThread) {
+            mainThreadTree();
+        }
+        
+        size_t created = 0;
+        auto claim = [&](uint32_t index) {
+            auto& slot = _contracts[index];
+            uint32_t generation = slot.generation.load(std::memory_order_acquire);
+            slot.work.swap(works[created]);   // noexcept, unlike assignment
+            slot.executionType = executionType;
+            slot.state.store(ContractState::Allocated, std::memory_order_release);
+            handles[created] = WorkContractHandle(this, index, generation);
+            ++created;
+        };
+        
+        // Pop recycled slots a bounded run at a time: only the slots we take leave the
+        // list, so concurrent createContract() calls keep finding the rest
+        while (created < wanted) {
+            uint32_t first = INVALID_INDEX;
+            uint32_t taken = popFreeSlots(static_cast<uint32_t>(std::min<size_t>(wanted - created, FREE_LIST_POP_BATCH)),
+                                          first);
+            if (taken == 0) {
+                break;
+            }
+            for (uint32_t i = 0; i < taken; ++i) {
+                uint32_t next = _contracts[first].nextFree.load(std::memory_order_acquire);
+                claim(first);
+                first = next;
+            }
+        }
+        
+        // Then never-used slots, claimed with one cursor bump
+        if (created < wanted) {
+            uint32_t first = INVALID_INDEX;
+            uint32_t taken = claimUntouchedSlots(static_cast<uint32_t>(wanted - created), first);
+            for (uint32_t index = first; index < first + taken; ++index) {
+                claim(index);
+            }
+        }
+        
+        _activeCount.add(created);
+        return created;
+    }
+
     ScheduleResult WorkContractGroup::scheduleContract(const WorkContractHandle& handle) {
         if (!validateHandle(handle)) return ScheduleResult::Invalid;
         
@@ -292,11 +455,11 @@ namespace Concurrency {
         
         // Add to appropriate ready set based on execution type
         if (slot.executionType == ExecutionType::MainThread) {
-            _mainThreadContracts->set(index);
+            mainThreadTree()->set(index);
             _mainThreadScheduledCount.fetch_add(1, std::memory_order_acq_rel);
         } else {
             _readyContracts->set(index);
-            _scheduledCount.fetch_add(1, std::memory_order_acq_rel);
+            _scheduledCount.add();
         }
         
         // Notify concurrency provider if set
@@ -325,20 +488,14 @@ namespace Concurrency {
             if (slot.state.compare_exchange_strong(expected, ContractState::Allocated,
                                                   std::memory_order_acq_rel)) {
                 // Remove from appropriate ready set based on execution type
-                size_t newScheduledCount;
                 if (slot.executionType == ExecutionType::MainThread) {
-                    _mainThreadContracts->clear(index);
-                    newScheduledCount = _mainThreadScheduledCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+                    mainThreadTree()->clear(index);
+                    _mainThreadScheduledCount.fetch_sub(1, std::memory_order_seq_cst);
                 } else {
                     _readyContracts->clear(index);
-                    newScheduledCount = _scheduledCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
-                }
-                
-                // Notify waiters if all scheduled contracts are complete
-                if (newScheduledCount == 0) {
-                    std::lock_guard<std::mutex> lock(_waitMutex);
-                    _waitCondition.notify_all();
+                    _scheduledCount.sub();
                 }
+                notifyWaiters();
                 
                 return ScheduleResult::NotScheduled;
             }
@@ -417,17 +574,13 @@ namespace Concurrency {
             bool active;
             
             SelectionGuard(WorkContractGroup* g) : group(g), active(true) {
-                group->_selectingCount.fetch_add(1, std::memory_order_acq_rel);
+                group->_selectingCount.add();
             }
             
             ~SelectionGuard() {
                 if (active) {
-                    auto count = group->_selectingCount.fetch_sub(1, std::memory_order_acq_rel);
-                    if (count == 1) {
-                        // We were the last selecting thread, notify waiters
-                        std::lock_guard<std::mutex> lock(group->_waitMutex);
-                        group->_waitCondition.notify_all();
-                    }
+                    group->_selectingCount.sub();
+                    group->notifyWaiters();
                 }
             }
             
@@ -471,9 +624,10 @@ namespace Concurrency {
         // Get current generation for handle
         uint32_t generation = slot.generation.load(std::memory_order_acquire);
 
-        // Update counters: decrement scheduled, increment executing
-        _scheduledCount.fetch_sub(1, std::memory_order_acq_rel);
-        _executingCount.fetch_add(1, std::memory_order_acq_rel);
+        // Update counters: count it as executing before it stops counting as scheduled,
+        // so wait() never sees both at zero in between
+        _executingCount.add();
+        _scheduledCount.sub();
 
         // Return valid handle
         return WorkContractHandle(this, static_cast<uint32_t>(index), generation);
@@ -491,11 +645,10 @@ namespace Concurrency {
             
             ~SelectionGuard() {
                 if (active) {
-                    auto count = group->_mainThreadSelectingCount.fetch_sub(1, std::memory_order_acq_rel);
+                    auto count = group->_mainThreadSelectingCount.fetch_sub(1, std::memory_order_seq_cst);
                     if (count == 1) {
                         // We were the last selecting thread, notify waiters
-                        std::lock_guard<std::mutex> lock(group->_waitMutex);
-                        group->_waitCondition.notify_all();
+                        group->notifyWaiters();
                     }
                 }
             }
@@ -519,7 +672,13 @@ namespace Concurrency {
             return WorkContractHandle();
         }
         
-        auto [index, _] = _mainThreadContracts->select(biasRef);
+        // No tree yet means no main thread contract was ever created
+        SignalTreeBase* mainThreadContracts = _mainThreadContracts.load(std::memory_order_acquire);
+        if (!mainThreadContracts) {
+            return WorkContractHandle();
+        }
+        
+        auto [index, _] = mainThreadContracts->select(biasRef);
         
         if (index == SignalTreeBase::S_INVALID_SIGNAL_INDEX) {
             return WorkContractHandle();
@@ -552,10 +711,35 @@ namespace Concurrency {
             auto& slot = _contracts[handle.getIndex()];
             auto work = std::move(slot.work);
 
+            // Time a sample of background contracts; the first one always, so a new
+            // group gets an estimate straight away
+            uint64_t average = _averageDurationNs.load(std::memory_order_relaxed);
+            bool sample = slot.executionType == ExecutionType::AnyThread &&
+                          (average == 0 || --stDurationSampleCountdown == 0);
+
             // Execute the work
-            if (work) {
+            if (sample) {
+                stDurationSampleCountdown = DURATION_SAMPLE_INTERVAL;
+                auto start = std::chrono::steady_clock::now();
+                if (work) {
+                    work();
+                }
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+                uint64_t measured = std::max<uint64_t>(static_cast<uint64_t>(elapsed), 1);
+
+                // Racing samples may overwrite each other; the estimate stays approximate
+                average = _averageDurationNs.load(std::memory_order_relaxed);
+                uint64_t next = average == 0 ? measured : average - average / 8 + measured / 8;
+                _averageDurationNs.store(std::max<uint64_t>(next, 1), std::memory_order_relaxed);
+            } else if (work) {
                 work();
             }
+
+            // A contract that will run again keeps its callable
+            if (slot.rescheduleRequested.load(std::memory_order_acquire)) {
+                slot.work = std::move(work);
+            }
         }
     }
 
@@ -563,6 +747,10 @@ namespace Concurrency {
         uint32_t index = handle.getIndex();
         if (index >= _capacity) return;
 
+        if (requeueIfRequested(index, false)) {
+            return;
+        }
+
         auto& slot = _contracts[index];
 
         // Atomically transition to Free. We expect it to be in the Executing state.
@@ -579,6 +767,10 @@ namespace Concurrency {
         uint32_t index = handle.getIndex();
         if (index >= _capacity) return;
 
+        if (requeueIfRequested(index, true)) {
+            return;
+        }
+
         auto& slot = _contracts[index];
 
         // Atomically transition to Free. We expect it to be in the Executing state.
@@ -590,6 +782,51 @@ namespace Concurrency {
             returnSlotToFreeList(index, ContractState::Executing, true /* isMainThread */);
         }
     }
+
+    bool WorkContractGroup::rescheduleOnCompletion(const WorkContractHandle& handle) {
+        if (!validateHandle(handle)) return false;
+        
+        auto& slot = _contracts[handle.getIndex()];
+        if (slot.state.load(std::memory_order_acquire) != ContractState::Executing) {
+            return false;
+        }
+        slot.rescheduleRequested.store(true, std::memory_order_release);
+        return true;
+    }
+
+    bool WorkContractGroup::requeueIfRequested(uint32_t index, bool isMainThread) {
+        auto& slot = _contracts[index];
+        if (!slot.rescheduleRequested.exchange(false, std::memory_order_acq_rel)) {
+            return false;
+        }
+        
+        // Only an executing contract can be re-queued; anything else takes the normal path
+        ContractState expected = ContractState::Executing;
+        if (!slot.state.compare_exchange_strong(expected, ContractState::Scheduled,
+                                                std::memory_order_acq_rel)) {
+            return false;
+        }
+        
+        // Count it as scheduled before it stops counting as executing, so wait()
+        // never sees both at zero in between
+        if (isMainThread) {
+            _mainThreadScheduledCount.fetch_add(1, std::memory_order_acq_rel);
+            _mainThreadExecutingCount.fetch_sub(1, std::memory_order_acq_rel);
+            mainThreadTree()->set(index);
+        } else {
+            _scheduledCount.add();
+            _executingCount.sub();
+            _readyContracts->set(index);
+        }
+        
+        {
+            std::shared_lock<std::shared_mutex> lock(_concurrencyProviderMutex);
+            if (_concurrencyProvider) {
+                _concurrencyProvider->notifyWorkAvailable(this);
+            }
+        }
+        return true;
+    }
     
     size_t WorkContractGroup::executeAllMainThreadWork() {
         return executeMainThreadWork(std::numeric_limits<size_t>::max());
@@ -621,6 +858,7 @@ namespace Concurrency {
         _stopping.store(true, std::memory_order_seq_cst);
         // Wake up any threads waiting in wait()
         _waitCondition.notify_all();
+        FiberWorker::notifyResumable();
     }
     
     void WorkContractGroup::resume() {
@@ -630,22 +868,38 @@ namespace Concurrency {
     }
     
     void WorkContractGroup::wait() {
-        // Use condition variable for efficient waiting instead of busy-wait
-        std::unique_lock<std::mutex> lock(_waitMutex);
-        _waitCondition.wait(lock, [this]() {
+        auto drained = [this]() {
             if (_stopping.load(std::memory_order_seq_cst)) {
                 // When stopping, wait for both executing work AND selecting threads
-                return _executingCount.load(std::memory_order_acquire) == 0 &&
-                       _selectingCount.load(std::memory_order_acquire) == 0 &&
+                // A selecting thread counts as executing before it stops selecting, so
+                // read selecting first
+                return _selectingCount.load() == 0 &&
+                       _executingCount.load() == 0 &&
                        _mainThreadExecutingCount.load(std::memory_order_acquire) == 0 &&
                        _mainThreadSelectingCount.load(std::memory_order_acquire) == 0;
             }
-            // Normal wait - wait for all scheduled AND executing work to complete
-            return _scheduledCount.load(std::memory_order_acquire) == 0 && 
-                   _executingCount.load(std::memory_order_acquire) == 0 &&
+            // Normal wait - wait for all scheduled AND executing work to complete.
+            // Contracts move Scheduled -> Executing (select) and back (reschedule), each
+            // adding to the new counter before leaving the old one; reading executing on
+            // both sides of scheduled catches either move in flight.
+            return _executingCount.load() == 0 &&
+                   _scheduledCount.load() == 0 &&
+                   _executingCount.load() == 0 &&
                    _mainThreadScheduledCount.load(std::memory_order_acquire) == 0 &&
                    _mainThreadExecutingCount.load(std::memory_order_acquire) == 0;
-        });
+        };
+
+        // Inside a contract running on a fiber, give the worker back until we're drained
+        if (FiberWorker::suspendUntil(drained)) {
+            return;
+        }
+
+        // Use condition variable for efficient waiting instead of busy-wait. Registering
+        // first pairs with notifyWaiters(): either a decrement sees us, or we see it.
+        std::unique_lock<std::mutex> lock(_waitMutex);
+        _waiterCount.fetch_add(1, std::memory_order_seq_cst);
+        _waitCondition.wait(lock, drained);
+        _waiterCount.fetch_sub(1, std::memory_order_relaxed);
     }
 
     void WorkContractGroup::executeAllBackgroundWork() {
@@ -672,9 +926,9 @@ namespace Concurrency {
         // Check owner
         if (handle.getOwner() != this) return false;
         
-        // Check index bounds
+        // Check index bounds - slots past the cursor were never handed out
         uint32_t index = handle.getIndex();
-        if (index >= _capacity) return false;
+        if (index >= _constructedCursor.load(std::memory_order_acquire)) return false;
         
         // Check generation
         uint32_t currentGen = _contracts[index].generation.load(std::memory_order_acquire);
@@ -691,6 +945,15 @@ namespace Concurrency {
     size_t WorkContractGroup::executingCount() const noexcept {
         return _executingCount.load(std::memory_order_acquire);
     }
+
+    void WorkContractGroup::notifyWaiters() {
+        // Fiber waiters don't register in _waiterCount
+        FiberWorker::notifyResumable();
+        if (_waiterCount.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(_waitMutex);
+            _waitCondition.notify_all();
+        }
+    }
     
     void WorkContractGroup::returnSlotToFreeList(uint32_t index, ContractState previousState, bool isMainThread) {
         auto& slot = _contracts[index];
@@ -704,22 +967,14 @@ namespace Concurrency {
         // Clear from ready tree if it was scheduled
         if (previousState == ContractState::Scheduled) {
             if (isMainThread) {
-                _mainThreadContracts->clear(index);
+                mainThreadTree()->clear(index);
             } else {
                 _readyContracts->clear(index);
             }
         }
         
         // Push the slot back onto the free list
-        uint32_t oldHead = _freeListHead.load(std::memory_order_acquire);
-        do {
-            slot.nextFree.store(oldHead, std::memory_order_release);
-            if (_freeListHead.compare_exchange_weak(oldHead, index,
-                                                   std::memory_order_acq_rel,
-                                                   std::memory_order_acquire)) {
-                break;
-            }
-        } while (true);
+        pushFreeSlot(index);
         
         // Update counters based on previous state
         if (previousState == ContractState::Allocated) {
@@ -727,46 +982,41 @@ namespace Concurrency {
             // (active count will be decremented below)
         } else if (previousState == ContractState::Scheduled) {
             // Only decrement scheduled count if it was scheduled (not yet executing)
-            size_t newScheduledCount;
             if (isMainThread) {
-                newScheduledCount = _mainThreadScheduledCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+                _mainThreadScheduledCount.fetch_sub(1, std::memory_order_seq_cst);
             } else {
-                newScheduledCount = _scheduledCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
-            }
-            
-            // Notify waiters if all scheduled contracts are complete
-            if (newScheduledCount == 0) {
-                std::lock_guard<std::mutex> lock(_waitMutex);
-                _waitCondition.notify_all();
+                _scheduledCount.sub();
             }
+            notifyWaiters();
         } else if (previousState == ContractState::Executing) {
-            size_t newExecutingCount;
+            // Wakes wait() either when stopping OR when waiting for all work to complete
             if (isMainThread) {
-                newExecutingCount = _mainThreadExecutingCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+                _mainThreadExecutingCount.fetch_sub(1, std::memory_order_seq_cst);
             } else {
-                newExecutingCount = _executingCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
-            }
-            
-            // Notify waiters if this was the last executing contract
-            // (either when stopping OR when wait() is waiting for all work to complete)
-            if (newExecutingCount == 0) {
-                std::lock_guard<std::mutex> lock(_waitMutex);
-                _waitCondition.notify_all();
+                _executingCount.sub();
             }
+            notifyWaiters();
         }
 
         // Always decrement active count
-        auto newActiveCount = _activeCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
-        
-        // Notify all registered callbacks that capacity is available
-        // This allows WorkGraphs to process deferred nodes
-        if (newActiveCount < _capacity) {
-            std::lock_guard<std::mutex> lock(_callbackMutex);
-            for (const auto& callback : _onCapacityAvailableCallbacks) {
-                if (callback) {
-                    callback();
+        _activeCount.sub();
+        
+        // Notify all registered callbacks that capacity is available; a slot was just
+        // freed, so there always is
+        {
+            {
+                std::lock_guard<std::mutex> lock(_callbackMutex);
+                for (const auto& callback : _onCapacityAvailableCallbacks) {
+                    if (callback) {
+                        callback();
+                    }
                 }
             }
+            
+            // One freed slot, one admission turn - only touches clients that are waiting
+            if (_admissionQueueSize.load(std::memory_order_seq_cst) > 0) {
+                admitNextWaiter();
+            }
         }
     }
     
@@ -785,6 +1035,82 @@ namespace Concurrency {
         std::lock_guard<std::mutex> lock(_callbackMutex);
         _onCapacityAvailableCallbacks.erase(it);
     }
+    
+    WorkContractGroup::AdmissionTicket WorkContractGroup::registerAdmission(std::function<bool()> admit) {
+        std::lock_guard<std::mutex> lock(_admissionMutex);
+        _admissionWaiters.push_back(AdmissionWaiter{std::move(admit)});
+        return std::prev(_admissionWaiters.end());
+    }
+    
+    void WorkContractGroup::requestAdmission(AdmissionTicket ticket) {
+        {
+            std::lock_guard<std::mutex> lock(_admissionMutex);
+            // A running turn requeues itself based on what admit() returns
+            if (ticket->queued || ticket->running > 0 || ticket->removed) {
+                return;
+            }
+            ticket->queued = true;
+            _admissionQueue.push_back(&*ticket);
+            _admissionQueueSize.store(_admissionQueue.size(), std::memory_order_seq_cst);
+        }
+        
+        // Pairs with the queue-size check in returnSlotToFreeList(): either that completion
+        // sees us queued, or we see the slot it freed
+        if (_activeCount.load() < _capacity) {
+            admitNextWaiter();
+        }
+    }
+    
+    void WorkContractGroup::unregisterAdmission(AdmissionTicket ticket) {
+        std::unique_lock<std::mutex> lock(_admissionMutex);
+        ticket->removed = true;
+        if (ticket->queued) {
+            _admissionQueue.erase(std::find(_admissionQueue.begin(), _admissionQueue.end(), &*ticket));
+            _admissionQueueSize.store(_admissionQueue.size(), std::memory_order_seq_cst);
+            ticket->queued = false;
+        }
+        _admissionCondition.wait(lock, [&ticket]() { return ticket->running == 0; });
+        _admissionWaiters.erase(ticket);
+    }
+    
+    void WorkContractGroup::admitNextWaiter() {
+        while (true) {
+            AdmissionWaiter* waiter = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(_admissionMutex);
+                if (_admissionQueue.empty()) {
+                    return;
+                }
+                waiter = _admissionQueue.front();
+                _admissionQueue.pop_front();
+                _admissionQueueSize.store(_admissionQueue.size(), std::memory_order_seq_cst);
+                waiter->queued = false;
+                waiter->running++;
+            }
+            
+            // Run unlocked: admit() schedules contracts and may defer again, which calls back
+            // into requestAdmission()
+            bool stillWaiting = waiter->admit();
+            
+            {
+                std::lock_guard<std::mutex> lock(_admissionMutex);
+                waiter->running--;
+                if (waiter->removed) {
+                    _admissionCondition.notify_all();
+                    stillWaiting = false;
+                } else if (stillWaiting && !waiter->queued) {
+                    waiter->queued = true;
+                    _admissionQueue.push_back(waiter);
+                    _admissionQueueSize.store(_admissionQueue.size(), std::memory_order_seq_cst);
+                }
+            }
+            
+            // Slots freed during the turn saw an empty queue; hand them out now
+            if (!stillWaiting || _activeCount.load() >= _capacity) {
+                return;
+            }
+        }
+    }
 
 } // namespace Concurrency
 } // namespace Core
@@ -22,9 +22,11 @@
 #include "WorkContractHandle.h"
 #include "SignalTree.h"
 #include "WorkGraphTypes.h"
+#include "ShardedCounter.h"
 #include <memory>
 #include <vector>
 #include <list>
+#include <deque>
 #include <functional>
 #include <thread>
 #include <condition_variable>
@@ -32,6 +34,8 @@
 #include <shared_mutex>
 #include <optional>
 #include <limits>
+#include <span>
+#include <chrono>
 
 namespace EntropyEngine {
 namespace Core {
@@ -107,6 +111,20 @@ namespace Concurrency {
         /// ensures it's never a valid array index. Static constexpr because it's
         /// a fundamental constant used throughout the lock-free data structure.
         static constexpr uint32_t INVALID_INDEX = ~0u;
+
+        /// Free list head with no slots and a zero ABA tag. The head packs a tag that
+        /// changes on every swing into the high 32 bits and the top slot index into the
+        /// low 32 bits, so a CAS against a stale head fails even if the index matches.
+        static constexpr uint64_t EMPTY_FREE_LIST = INVALID_INDEX;
+
+        /// Most recycled slots createContracts() pops per CAS; bounds the walk a failed CAS repeats
+        static constexpr uint32_t FREE_LIST_POP_BATCH = 64;
+
+        /// Background contracts timed per thread for averageContractDuration(): one in this many
+        static constexpr uint32_t DURATION_SAMPLE_INTERVAL = 16;
+
+        /// Contracts this thread runs before timing the next one; shared by all groups
+        static thread_local uint32_t stDurationSampleCountdown;
         
         
         /**
@@ -122,24 +140,35 @@ namespace Concurrency {
             std::function<void()> work;                    ///< Work function
             std::atomic<uint32_t> nextFree{INVALID_INDEX}; ///< Next free slot
             ExecutionType executionType{ExecutionType::AnyThread}; ///< Execution context (main/any thread)
+            std::atomic<bool> rescheduleRequested{false};  ///< Re-queue instead of freeing when execution completes
         };
         
-        std::vector<ContractSlot> _contracts;             ///< Contract storage
+        // Slots are constructed on first hand-out, so a group sized for peak load only
+        // touches the memory its actual working set needs. Creators claim indices from
+        // _untouchedCursor, construct them, then advance _constructedCursor in claim
+        // order; anything that walks slots stops at _constructedCursor.
+        ContractSlot* _contracts = nullptr;               ///< Contract storage; only [0, _constructedCursor) is constructed
+        std::atomic<uint32_t> _untouchedCursor{0};        ///< First slot never claimed
+        std::atomic<uint32_t> _constructedCursor{0};      ///< First slot not yet constructed and published
+        PageAllocationPolicy _pagePolicy = PageAllocationPolicy::Default; ///< Backing for slots and trees
         std::unique_ptr<SignalTreeBase> _readyContracts;  ///< Ready work queue
-        std::unique_ptr<SignalTreeBase> _mainThreadContracts; ///< Main thread work queue
-        std::atomic<uint32_t> _freeListHead{0};           ///< Free list head
+        std::atomic<SignalTreeBase*> _mainThreadContracts{nullptr}; ///< Main thread work queue, created with the first main thread contract
+        std::atomic<uint64_t> _freeListHead{EMPTY_FREE_LIST}; ///< Head of recycled slots; ABA tag in the high 32 bits, slot index in the low
 
-        std::atomic<size_t> _activeCount{0};              ///< Active contract count
-        std::atomic<size_t> _scheduledCount{0};           ///< Scheduled count
-        std::atomic<size_t> _executingCount{0};           ///< Executing count
-        std::atomic<size_t> _selectingCount{0};           ///< Selection in progress
+        // Touched by every producer and worker; sharded so updates stay on the updating core
+        ShardedCounter _activeCount;                      ///< Active contract count
+        ShardedCounter _scheduledCount;                   ///< Scheduled count
+        ShardedCounter _executingCount;                   ///< Executing count
+        ShardedCounter _selectingCount;                   ///< Selection in progress
         std::atomic<size_t> _mainThreadScheduledCount{0}; ///< Main thread work pending
         std::atomic<size_t> _mainThreadExecutingCount{0}; ///< Main thread work running
         std::atomic<size_t> _mainThreadSelectingCount{0}; ///< Main thread selection count
+        std::atomic<uint64_t> _averageDurationNs{0};      ///< Sampled EWMA of background contract run time (0 = unmeasured)
 
         // Synchronization for wait() operations
         mutable std::mutex _waitMutex;                    ///< Mutex for condition variable
         mutable std::condition_variable _waitCondition;   ///< Condition variable for waiting
+        std::atomic<size_t> _waiterCount{0};              ///< Threads blocked in wait(); counter updates only notify when non-zero
 
         std::string _name;
         
@@ -151,6 +180,21 @@ namespace Concurrency {
         std::list<std::function<void()>> _onCapacityAvailableCallbacks; ///< Capacity callbacks
         mutable std::mutex _callbackMutex; ///< Protects callback list
         
+        /// A client that parks work when the group is full and wants a turn when a slot frees
+        struct AdmissionWaiter {
+            std::function<bool()> admit;                  ///< Schedules parked work; returns true if some is still parked
+            bool queued = false;                          ///< Currently in _admissionQueue
+            bool removed = false;                         ///< Unregistered while a turn was running
+            uint32_t running = 0;                         ///< Turns in progress
+        };
+        
+        // Round-robin admission: only clients that are actually waiting are visited, one per freed slot
+        std::list<AdmissionWaiter> _admissionWaiters;     ///< Registered clients (stable addresses)
+        std::deque<AdmissionWaiter*> _admissionQueue;     ///< Clients waiting for capacity, in turn order
+        std::atomic<size_t> _admissionQueueSize{0};       ///< Lock-free "anyone waiting?" check for the completion path
+        mutable std::mutex _admissionMutex;               ///< Protects the waiter list and queue
+        std::condition_variable _admissionCondition;      ///< Signals unregister when a turn ends
+        
         // Stopping support
         std::atomic<bool> _stopping{false};              ///< Stopping flag
         
@@ -163,6 +207,10 @@ namespace Concurrency {
          * based on peak concurrent load.
          * 
          * @param capacity Maximum number of contracts (typically 1024-8192)
+         * @param name Debug name
+         * @param pagePolicy Page backing for the slot array and signal trees. Worth setting
+         *                   for groups of tens of thousands of contracts and up, where random
+         *                   select/complete traffic otherwise misses the TLB on most accesses.
          * 
          * @code
          * // For a game engine handling frame tasks
@@ -170,9 +218,13 @@ namespace Concurrency {
          * 
          * // For background processing
          * WorkContractGroup backgroundTasks(512);
+         *
+         * // A very large group backed by 2 MiB pages where the OS allows it
+         * WorkContractGroup particles(1 << 20, "Particles", PageAllocationPolicy::TransparentHugePages);
          * @endcode
          */
-        explicit WorkContractGroup(size_t capacity, std::string name = "WorkContractGroup");
+        explicit WorkContractGroup(size_t capacity, std::string name = "WorkContractGroup",
+                                   PageAllocationPolicy pagePolicy = PageAllocationPolicy::Default);
         
         /**
          * @brief Destructor ensures all work is stopped and completed
@@ -231,6 +283,36 @@ namespace Concurrency {
         WorkContractHandle createContract(std::function<void()> work, 
                                         ExecutionType executionType = ExecutionType::AnyThread);
         
+        /**
+         * @brief Creates a batch of contracts with one free-list operation
+         * 
+         * For bursts of thousands of contracts per frame. Instead of one CAS loop per
+         * contract, the whole free list is detached with a single exchange, the needed
+         * slots are taken off it, and the remainder is put back with one CAS. Slots that
+         * have never been used are claimed with a single cursor bump, and the active
+         * count is updated once. While the list is detached, concurrent createContract()
+         * calls fall back to untouched slots and may find none.
+         * 
+         * Creates as many as fit; like createContract(), a full group is not an error.
+         * 
+         * @param works Work functions; each one taken is moved from (left empty)
+         * @param handles Receives one handle per created contract, in order
+         * @param executionType Where these contracts should be executed
+         * @return Number of contracts created (min(works, handles) unless the group filled up)
+         * 
+         * @code
+         * std::vector<std::function<void()>> jobs = buildFrameJobs();
+         * std::vector<WorkContractHandle> handles(jobs.size());
+         * size_t created = group.createContracts(jobs, handles);
+         * for (size_t i = 0; i < created; ++i) {
+         *     handles[i].schedule();
+         * }
+         * @endcode
+         */
+        size_t createContracts(std::span<std::function<void()>> works,
+                               std::span<WorkContractHandle> handles,
+                               ExecutionType executionType = ExecutionType::AnyThread);
+        
         /**
          * @brief Waits for all scheduled and executing contracts to complete
          * 
@@ -307,6 +389,9 @@ namespace Concurrency {
         /**
          * @brief Gets the number of currently allocated contracts
          *
+         * Sums the counter's shards, so it costs a few loads per core; fine for capacity
+         * checks, but schedulers polling every group should use the approximate reads.
+         *
          * @return Number of contracts that have been created but not yet released
          *
          * @code
@@ -328,6 +413,23 @@ namespace Concurrency {
          * @endcode
          */
         size_t scheduledCount() const noexcept { return _scheduledCount.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Cheap, possibly stale scheduledCount() for scheduling decisions
+         *
+         * Served from the calling thread's cached copy and refreshed every few reads.
+         * Zero is always re-checked, so a group with work is never reported empty; a
+         * stale non-zero only costs one failed selectForExecution().
+         *
+         * @return Recent number of scheduled contracts
+         */
+        size_t approximateScheduledCount() const noexcept { return _scheduledCount.approximate(); }
+
+        /**
+         * @brief Cheap, possibly stale executingCount() for scheduling decisions
+         * @return Recent number of executing contracts
+         */
+        size_t approximateExecutingCount() const noexcept { return _executingCount.approximate(); }
         
         /**
          * @brief Gets the number of main thread contracts currently scheduled
@@ -506,6 +608,29 @@ namespace Concurrency {
          */
         void completeMainThreadExecution(const WorkContractHandle& handle);
         
+        /**
+         * @brief Schedules an executing contract again once its current run finishes
+         * 
+         * Call from inside the contract's own work. Instead of being freed on completion,
+         * the contract keeps its slot, handle and work function and goes straight back
+         * to Scheduled. Nothing is allocated and the group's capacity is never given up,
+         * so a contract that repeatedly asks to run again cannot be starved by a full group.
+         * 
+         * @param handle Handle to a contract in the Executing state
+         * @return true if the request was recorded, false if the handle is stale or not executing
+         * 
+         * @code
+         * WorkContractHandle self;
+         * self = group.createContract([&]() {
+         *     if (!pollDevice()) {
+         *         group.rescheduleOnCompletion(self);   // Try again later, same contract
+         *     }
+         * });
+         * self.schedule();
+         * @endcode
+         */
+        bool rescheduleOnCompletion(const WorkContractHandle& handle);
+        
         /**
          * @brief Gets the current state of a contract
          * 
@@ -522,6 +647,20 @@ namespace Concurrency {
          * @return The number of currently executing contracts
          */
         size_t executingCount() const noexcept;
+
+        /**
+         * @brief Sampled moving average of how long this group's background contracts run
+         *
+         * executeContract() times the group's first background contract, then about one
+         * in DURATION_SAMPLE_INTERVAL per thread, and folds each sample into an
+         * exponentially weighted average (weight 1/8). Multiplied by scheduledCount() it
+         * estimates the group's remaining work, which CostAwareScheduler ranks by.
+         *
+         * @return Average duration, or zero before any contract has been timed
+         */
+        std::chrono::nanoseconds averageContractDuration() const noexcept {
+            return std::chrono::nanoseconds(_averageDurationNs.load(std::memory_order_relaxed));
+        }
         
         /**
          * @brief Associates this group with a concurrency provider
@@ -559,6 +698,61 @@ namespace Concurrency {
          */
         void removeOnCapacityAvailable(CapacityCallback it);
         
+        using AdmissionTicket = std::list<AdmissionWaiter>::iterator;
+        
+        /**
+         * @brief Registers a client for round-robin admission when capacity frees up
+         * 
+         * Capacity callbacks run for every client on every completion. Clients that only
+         * care while they have work parked - such as WorkGraphs with deferred nodes - should
+         * register here instead and call requestAdmission() when they park something. Each
+         * freed slot then gives exactly one waiting client a turn, in FIFO order, so the
+         * cost per completion is O(1) however many clients share the group.
+         * 
+         * The admit function runs on the thread that freed the slot, without group locks
+         * held. It should schedule what it can and return true if work is still parked, which
+         * puts the client at the back of the queue for another turn.
+         * 
+         * @param admit Called for each turn
+         * @return Ticket for requestAdmission() and unregisterAdmission()
+         * 
+         * @code
+         * auto ticket = group.registerAdmission([&]() {
+         *     scheduler.processDeferredNodes();
+         *     return scheduler.getDeferredCount() > 0;
+         * });
+         * // ... after deferring work because the group was full
+         * group.requestAdmission(ticket);
+         * @endcode
+         */
+        AdmissionTicket registerAdmission(std::function<bool()> admit);
+        
+        /**
+         * @brief Puts a client in the admission queue
+         * 
+         * Idempotent while the client is queued or taking its turn. If the group already
+         * has a free slot the next turn is run immediately, so a completion that raced
+         * ahead of the request is not lost.
+         * 
+         * @param ticket Ticket from registerAdmission()
+         */
+        void requestAdmission(AdmissionTicket ticket);
+        
+        /**
+         * @brief Removes a client; blocks until any turn it is taking has finished
+         * 
+         * Must not be called from inside the client's own admit function.
+         * 
+         * @param ticket Ticket from registerAdmission()
+         */
+        void unregisterAdmission(AdmissionTicket ticket);
+        
+        /**
+         * @brief Number of clients waiting for a turn
+         * @return Snapshot of the admission queue length
+         */
+        size_t waitingAdmissionCount() const noexcept { return _admissionQueueSize.load(std::memory_order_acquire); }
+        
     private:
         /**
          * @brief Creates a SignalTree sized appropriately for the given capacity
@@ -566,9 +760,11 @@ namespace Concurrency {
          * Handles power-of-2 rounding required by SignalTree's binary structure.
          * 
          * @param capacity Number of work contracts the tree needs to support
+         * @param pagePolicy Page backing for the tree's node array
          * @return Unique pointer to properly sized SignalTree
          */
-        static std::unique_ptr<SignalTreeBase> createSignalTree(size_t capacity);
+        static std::unique_ptr<SignalTreeBase> createSignalTree(size_t capacity,
+                                                                PageAllocationPolicy pagePolicy = PageAllocationPolicy::Default);
         
         /**
          * @brief Validates that a handle belongs to this group with correct generation
@@ -591,6 +787,52 @@ namespace Concurrency {
          * @param isMainThread Whether this is a main thread contract (default: false)
          */
         void returnSlotToFreeList(uint32_t index, ContractState previousState, bool isMainThread = false);
+
+        /**
+         * @brief Pops one recycled slot off the tagged free list
+         * @param index Receives the popped slot index
+         * @return false if the free list was empty
+         */
+        bool popFreeSlot(uint32_t& index) noexcept;
+
+        /**
+         * @brief Pushes one slot onto the tagged free list
+         * @param index Slot to push; its nextFree is overwritten
+         */
+        void pushFreeSlot(uint32_t index) noexcept;
+
+        /**
+         * @brief Pops up to maxCount recycled slots off the tagged free list in one swing
+         * @param maxCount Most slots to take
+         * @param first Receives the first popped slot; the rest follow through nextFree
+         * @return Number of slots popped, 0 if the free list was empty
+         */
+        uint32_t popFreeSlots(uint32_t maxCount, uint32_t& first) noexcept;
+
+        /**
+         * @brief Claims never-used slots and constructs them
+         * @param maxCount Most slots to claim
+         * @param first Receives the first claimed index; the rest follow it
+         * @return Number of slots claimed, 0 once every slot has been touched
+         *
+         * Returns only after the slots are published through _constructedCursor.
+         */
+        uint32_t claimUntouchedSlots(uint32_t maxCount, uint32_t& first) noexcept;
+
+        /**
+         * @brief Wakes wait() callers after a counter moved toward zero
+         *
+         * Counter shards cannot report when the total reaches zero, so every decrement
+         * wakes the waiters, who re-check the exact sums. Without waiters this is one load.
+         */
+        void notifyWaiters();
+        
+        /**
+         * @brief Gives the client at the head of the admission queue one turn
+         * 
+         * Requeues it at the back if it still has work parked.
+         */
+        void admitNextWaiter();
         
         /**
          * @brief Releases all remaining contracts in the group
@@ -605,6 +847,25 @@ namespace Concurrency {
          * Moves scheduled contracts back to allocated state during destruction.
          */
         void unscheduleAllContracts();
+
+        /**
+         * @brief Returns the main thread ready tree, creating it on first use
+         * @return The tree; never null
+         */
+        SignalTreeBase* mainThreadTree();
+
+        /**
+         * @brief Destroys constructed slots and frees slot storage and the main thread tree
+         */
+        void releaseStorage() noexcept;
+
+        /**
+         * @brief Moves a completed contract from Executing back to Scheduled if it asked to
+         * @param index Slot of the contract that finished
+         * @param isMainThread Which counters and ready tree the contract belongs to
+         * @return true if the contract was re-queued and must not be freed
+         */
+        bool requeueIfRequested(uint32_t index, bool isMainThread);
     };
 
 } // namespace Concurrency
@@ -15,11 +15,30 @@
 #include <thread>
 #include <chrono>
 #include <format>
+#include <unordered_set>
 
 namespace EntropyEngine {
 namespace Core {
 namespace Concurrency {
 
+thread_local WorkGraph::SpawnBuffer* WorkGraph::stActiveSpawnBuffer = nullptr;
+
+const bool WorkGraph::S_SPAWN_BUFFER_FIBER_LOCAL = FiberWorker::registerFiberLocal({
+    []() -> void* { return stActiveSpawnBuffer; },
+    [](void* buffer) { stActiveSpawnBuffer = static_cast<SpawnBuffer*>(buffer); }
+});
+
+namespace {
+    /// Closes the run in progress; a yielded node's last run sets its end
+    void recordRunEnd(NodeHandle node) {
+        if (auto* nodeData = node.getData()) {
+            auto& timing = nodeData->timing;
+            timing.endNs = NodeTiming::now();
+            timing.busyNs += timing.endNs - timing.runStartNs;
+        }
+    }
+}
+
 WorkGraph::WorkGraph(WorkContractGroup* workContractGroup)
     : WorkGraph(workContractGroup, WorkGraphConfig{}) {
 }
@@ -27,7 +46,8 @@ WorkGraph::WorkGraph(WorkContractGroup* workContractGroup)
 WorkGraph::WorkGraph(WorkContractGroup* workContractGroup, const WorkGraphConfig& config)
     : Debug::Named("WorkGraph")
     , _workContractGroup(workContractGroup)
-    , _config(config) {
+    , _config(config)
+    , _linkAnchor(std::make_shared<ExternalLinkAnchor>(ExternalLinkAnchor{this})) {
     ENTROPY_PROFILE_ZONE();
     
     if (_config.enableDebugLogging) {
@@ -64,6 +84,7 @@ WorkGraph::WorkGraph(WorkContractGroup* workContractGroup, const WorkGraphConfig
     schedulerConfig.maxDeferredNodes = _config.maxDeferredNodes;
     schedulerConfig.enableBatchScheduling = _config.enableAdvancedScheduling;
     schedulerConfig.enableDebugLogging = _config.enableDebugLogging;
+    schedulerConfig.enableTiming = _config.enableTiming;
     _scheduler = std::make_unique<NodeScheduler>(
         _workContractGroup,
         this,
@@ -87,6 +108,12 @@ WorkGraph::WorkGraph(WorkContractGroup* workContractGroup, const WorkGraphConfig
             // Node could be in Ready or Scheduled state when execution starts
             auto* nodeData = node.getData();
             if (nodeData) {
+                if (_config.enableTiming) {
+                    nodeData->timing.runStartNs = NodeTiming::now();
+                    if (nodeData->timing.startNs == 0) {
+                        nodeData->timing.startNs = nodeData->timing.runStartNs;
+                    }
+                }
                 NodeState currentState = nodeData->state.load(std::memory_order_acquire);
                 if (currentState == NodeState::Ready || currentState == NodeState::Scheduled) {
                     _stateManager->transitionState(node, currentState, NodeState::Executing);
@@ -100,6 +127,10 @@ WorkGraph::WorkGraph(WorkContractGroup* workContractGroup, const WorkGraphConfig
             if (_config.enableDebugLogging) {
                 ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Node completed");
             }
+            // Stamp before completion can drain the graph and wake wait()
+            if (_config.enableTiming) {
+                recordRunEnd(node);
+            }
             onNodeComplete(node);
         }
     };
@@ -109,6 +140,9 @@ WorkGraph::WorkGraph(WorkContractGroup* workContractGroup, const WorkGraphConfig
             if (_config.enableDebugLogging) {
                 ENTROPY_LOG_ERROR_CAT("Concurrency", "WorkGraph: Node failed");
             }
+            if (_config.enableTiming) {
+                recordRunEnd(node);
+            }
             onNodeFailed(node);
         }
     };
@@ -134,8 +168,7 @@ WorkGraph::WorkGraph(WorkContractGroup* workContractGroup, const WorkGraphConfig
                     
                     // If all nodes are "done" (completed/failed/dropped), notify waiters
                     if (pending == 0) {
-                        std::lock_guard<std::mutex> lock(_waitMutex);
-                        _waitCondition.notify_all();
+                        onGraphDrained();
                     }
                     
                     ENTROPY_LOG_ERROR_CAT("WorkGraph", "Node dropped due to deferred queue overflow!");
@@ -143,37 +176,37 @@ WorkGraph::WorkGraph(WorkContractGroup* workContractGroup, const WorkGraphConfig
             }
         }
     };
+    callbacks.onNodeDeferred = [this](NodeHandle node) {
+        // Queue for an admission turn on the group the node waits for; no-op while
+        // already queued or taking one
+        WorkContractGroup* group = _scheduler->getTargetGroup(node);
+        std::unique_lock<std::mutex> lock(_admissionMutex);
+        for (const auto& [ticketGroup, ticket] : _admissionTickets) {
+            if (ticketGroup == group) {
+                auto found = ticket;
+                lock.unlock();   // A turn may run right here and defer again
+                group->requestAdmission(found);
+                return;
+            }
+        }
+    };
     callbacks.onNodeYielded = [this](NodeHandle node) {
         CallbackGuard guard(this);
         if (!_destroyed.load(std::memory_order_acquire)) {
             if (_config.enableDebugLogging) {
                 ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Node yielded");
             }
+            if (_config.enableTiming) {
+                recordRunEnd(node);
+            }
             onNodeYielded(node);
         }
     };
     _scheduler->setCallbacks(callbacks);
     
-    // Register callback for when contract capacity becomes available
-    // This allows us to process deferred nodes at the right time
-    // We process multiple rounds to keep the pipeline full
-    _capacityCallbackIt = _workContractGroup->addOnCapacityAvailable([this]() {
-        CallbackGuard guard(this);
-        if (!_destroyed.load(std::memory_order_acquire) && _scheduler) {
-            if (_config.enableDebugLogging) {
-                ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Capacity available callback triggered");
-            }
-            // Try to process deferred nodes multiple times to fill capacity
-            // This is important when we have many deferred nodes
-            for (size_t i = 0; i < _config.maxDeferredProcessingIterations; i++) {
-                size_t processed = _scheduler->processDeferredNodes();
-                if (processed == 0) break; // No more capacity or no more deferred nodes
-                if (_config.enableDebugLogging) {
-                    ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Capacity callback processed " + std::to_string(processed) + " deferred nodes");
-                }
-            }
-        }
-    });
+    // Deferred nodes wait in the group's admission queue rather than on a capacity callback,
+    // so completions only visit graphs that actually have nodes waiting
+    ensureAdmission(_workContractGroup);
     
     // Register with debug system (can be disabled via config)
     if (_config.enableDebugRegistration) {
@@ -193,10 +226,21 @@ WorkGraph::~WorkGraph() {
     // Set destroyed flag to prevent new callbacks
     _destroyed.store(true, std::memory_order_release);
     
-    // Unregister capacity callback from WorkContractGroup first
-    // This prevents new callbacks from being scheduled
-    if (_workContractGroup) {
-        _workContractGroup->removeOnCapacityAvailable(_capacityCallbackIt);
+    // Links other graphs hold to our nodes now resolve to nothing; a notifier that got
+    // in first holds a callback guard, which the wait below covers
+    {
+        std::lock_guard<std::mutex> links(crossGraphLinkMutex());
+        _linkAnchor->graph = nullptr;
+    }
+    
+    // Leave the admission queues first; this also waits out any turn in progress
+    std::vector<std::pair<WorkContractGroup*, WorkContractGroup::AdmissionTicket>> tickets;
+    {
+        std::lock_guard<std::mutex> lock(_admissionMutex);
+        tickets.swap(_admissionTickets);
+    }
+    for (auto& [group, ticket] : tickets) {
+        group->unregisterAdmission(ticket);
     }
     
     // Wait for all active callbacks to complete
@@ -210,6 +254,25 @@ WorkGraph::~WorkGraph() {
         });
     }
     
+    // Nodes in other graphs still waiting on us would wait forever - cancel them
+    std::vector<ExternalDependant> orphans;
+    {
+        std::unique_lock<std::shared_mutex> lock(_graphMutex);
+        for (auto& node : _nodeHandles) {
+            if (auto* nodeData = isHandleValid(node) ? node.getData() : nullptr) {
+                std::move(nodeData->externalDependants.begin(), nodeData->externalDependants.end(),
+                          std::back_inserter(orphans));
+                nodeData->externalDependants.clear();
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+        std::move(_completionDependants.begin(), _completionDependants.end(), std::back_inserter(orphans));
+        _completionDependants.clear();
+    }
+    notifyExternalDependants(orphans, NodeState::Cancelled);
+    
     // Now safe to proceed with cleanup
     // Unregister from debug system (if registered)
     if (_config.enableDebugRegistration) {
@@ -219,17 +282,7 @@ WorkGraph::~WorkGraph() {
     }
 }
 
-WorkGraph::NodeHandle WorkGraph::addNode(std::function<void()> work, 
-                                        const std::string& name,
-                                        void* userData,
-                                        ExecutionType executionType) {
-    ENTROPY_PROFILE_ZONE();
-    std::unique_lock<std::shared_mutex> lock(_graphMutex);
-    
-    // Create node with the work and execution type
-    WorkGraphNode node(std::move(work), name, executionType);
-    node.userData = userData;
-    
+WorkGraph::NodeHandle WorkGraph::insertNode(WorkGraphNode&& node) {
     // Add to graph and track as pending
     auto handle = _graph.addNode(std::move(node));
     _pendingNodes.fetch_add(1, std::memory_order_relaxed);
@@ -251,11 +304,7 @@ WorkGraph::NodeHandle WorkGraph::addNode(std::function<void()> work,
         if (nodeData && nodeData->pendingDependencies.load() == 0) {
             // Try to transition to ready state
             if (_stateManager->transitionState(handle, NodeState::Pending, NodeState::Ready)) {
-                // Transition to scheduled before actually scheduling
-                if (_stateManager->transitionState(handle, NodeState::Ready, NodeState::Scheduled)) {
-                    // Schedule the node
-                    _scheduler->scheduleNode(handle);
-                }
+                dispatchReady(handle);
             }
         }
     }
@@ -263,11 +312,29 @@ WorkGraph::NodeHandle WorkGraph::addNode(std::function<void()> work,
     return handle;
 }
 
+WorkGraph::NodeHandle WorkGraph::addNode(std::function<void()> work, 
+                                        const std::string& name,
+                                        void* userData,
+                                        ExecutionType executionType,
+                                        WorkContractGroup* targetGroup) {
+    ENTROPY_PROFILE_ZONE();
+    std::unique_lock<std::shared_mutex> lock(_graphMutex);
+    
+    // Create node with the work and execution type
+    WorkGraphNode node(std::move(work), name, executionType);
+    node.userData = userData;
+    node.targetGroup = targetGroup;
+    ensureAdmission(targetGroup);
+    
+    return insertNode(std::move(node));
+}
+
 WorkGraph::NodeHandle WorkGraph::addYieldableNode(YieldableWorkFunction work,
                                                   const std::string& name,
                                                   void* userData,
                                                   ExecutionType executionType,
-                                                  std::optional<uint32_t> maxReschedules) {
+                                                  std::optional<uint32_t> maxReschedules,
+                                                  WorkContractGroup* targetGroup) {
     ENTROPY_PROFILE_ZONE();
     std::unique_lock<std::shared_mutex> lock(_graphMutex);
     
@@ -275,21 +342,8 @@ WorkGraph::NodeHandle WorkGraph::addYieldableNode(YieldableWorkFunction work,
     WorkGraphNode node(std::move(work), name, executionType);
     node.userData = userData;
     node.maxReschedules = maxReschedules;
-    
-    // Add to graph and track as pending
-    auto handle = _graph.addNode(std::move(node));
-    _pendingNodes.fetch_add(1, std::memory_order_relaxed);
-    
-    // Cache the handle for access later
-    _nodeHandles.push_back(handle);
-    
-    // Register with state manager
-    _stateManager->registerNode(handle, NodeState::Pending);
-    
-    // Publish event if enabled
-    if (auto* eventBus = getEventBus()) {
-        eventBus->publish(NodeAddedEvent(this, handle));
-    }
+    node.targetGroup = targetGroup;
+    ensureAdmission(targetGroup);
     
     if (_config.enableDebugLogging) {
         auto msg = std::format("Added yieldable node '{}' with max reschedules: {}", 
@@ -298,22 +352,7 @@ WorkGraph::NodeHandle WorkGraph::addYieldableNode(YieldableWorkFunction work,
         ENTROPY_LOG_DEBUG_CAT("WorkGraph", msg);
     }
     
-    // If execution has already started, check if this node can execute immediately
-    if (_executionStarted.load(std::memory_order_acquire)) {
-        auto* nodeData = handle.getData();
-        if (nodeData && nodeData->pendingDependencies.load() == 0) {
-            // Try to transition to ready state
-            if (_stateManager->transitionState(handle, NodeState::Pending, NodeState::Ready)) {
-                // Transition to scheduled before actually scheduling
-                if (_stateManager->transitionState(handle, NodeState::Ready, NodeState::Scheduled)) {
-                    // Schedule the node
-                    _scheduler->scheduleNode(handle);
-                }
-            }
-        }
-    }
-    
-    return handle;
+    return insertNode(std::move(node));
 }
 
 void WorkGraph::addDependency(NodeHandle from, NodeHandle to) {
@@ -333,6 +372,201 @@ void WorkGraph::addDependency(NodeHandle from, NodeHandle to) {
     // }
 }
 
+WorkGraph::NodeHandle WorkGraph::addBranchNode(BranchWorkFunction selector,
+                                              const std::string& name,
+                                              void* userData,
+                                              ExecutionType executionType) {
+    ENTROPY_PROFILE_ZONE();
+    std::unique_lock<std::shared_mutex> lock(_graphMutex);
+    
+    // Create node with the branch selector
+    WorkGraphNode node(std::move(selector), name, executionType);
+    node.userData = userData;
+    
+    return insertNode(std::move(node));
+}
+
+void WorkGraph::addBranchDependency(NodeHandle branch, NodeHandle to, uint32_t branchIndex) {
+    ENTROPY_PROFILE_ZONE();
+    std::unique_lock<std::shared_mutex> lock(_graphMutex);
+    
+    auto* branchData = branch.getData();
+    if (!branchData || !branchData->isBranch) {
+        throw std::invalid_argument("addBranchDependency requires a node created with addBranchNode");
+    }
+    
+    // Re-labelling an existing conditional edge must not count it twice
+    for (auto& [childIndex, existingIndex] : branchData->branchEdges) {
+        if (childIndex == to.getIndex()) {
+            existingIndex = branchIndex;
+            return;
+        }
+    }
+    
+    // An existing unconditional edge already holds a dependency - just label it
+    bool existed = _graph.isHandleValid(to) && _graph.hasEdge(branch.getIndex(), to.getIndex());
+    
+    // Add edge in the DAG (this checks for cycles)
+    _graph.addEdge(branch, to);
+    
+    branchData->branchEdges.emplace_back(to.getIndex(), branchIndex);
+    if (!existed) {
+        incrementDependencies(to);
+    }
+}
+
+NodeOutput* WorkGraph::allocateOutput(size_t size, size_t alignment, void (*destroy)(void*)) {
+    std::unique_lock<std::shared_mutex> lock(_graphMutex);
+    
+    if (!_outputArena) {
+        _outputArena = std::make_unique<NodeOutputArena>();
+    }
+    return _outputArena->allocate(size, alignment, destroy);
+}
+
+WorkGraph::NodeHandle WorkGraph::addNodeAfter(std::function<void()> work, const std::string& name,
+                                             const std::vector<NodeHandle>& parents,
+                                             std::initializer_list<NodeOutput*> inputs) {
+    ENTROPY_PROFILE_ZONE();
+    std::unique_lock<std::shared_mutex> lock(_graphMutex);
+    
+    for (auto* input : inputs) {
+        if (!input) {
+            throw std::invalid_argument("Invalid typed input handle");
+        }
+        if (input->state.load(std::memory_order_acquire) == NodeOutput::State::Destroyed) {
+            throw std::runtime_error("Typed input was already released by its consumers");
+        }
+    }
+    
+    for (const auto& parent : parents) {
+        auto* parentData = isHandleValid(parent) ? parent.getData() : nullptr;
+        if (!parentData) {
+            throw std::invalid_argument("Invalid parent handle provided to addNodeAfter");
+        }
+        NodeState parentState = parentData->state.load(std::memory_order_acquire);
+        if (isTerminalState(parentState) && parentState != NodeState::Completed) {
+            throw std::runtime_error("Cannot depend on a node that failed, was cancelled or skipped");
+        }
+    }
+    
+    WorkGraphNode node(std::move(work), name);
+    auto handle = _graph.addNode(std::move(node));
+    _pendingNodes.fetch_add(1, std::memory_order_relaxed);
+    _nodeHandles.push_back(handle);
+    _stateManager->registerNode(handle, NodeState::Pending);
+    
+    // Committed: count the node as a consumer before anything can run, so each value
+    // outlives it. Nothing below throws, so the counts never need rolling back.
+    for (auto* input : inputs) {
+        input->consumers.fetch_add(1, std::memory_order_acq_rel);
+    }
+    
+    auto* nodeData = handle.getData();
+    for (const auto& parent : parents) {
+        // A parent marks itself Completed before collecting its children under our lock,
+        // so anything not yet Completed here is guaranteed to see the new edge.
+        if (parent.getData()->state.load(std::memory_order_acquire) == NodeState::Completed) {
+            nodeData->takenParentCount.fetch_add(1, std::memory_order_acq_rel);
+            continue;
+        }
+        // The new node has no outgoing edges, so no edge into it can close a cycle
+        if (_graph.addEdgeUnchecked(parent, handle)) {
+            incrementDependencies(handle);
+        }
+    }
+    
+    if (auto* eventBus = getEventBus()) {
+        eventBus->publish(NodeAddedEvent(this, handle));
+    }
+    
+    // If execution has already started, check if this node can execute immediately
+    if (_executionStarted.load(std::memory_order_acquire) && nodeData->pendingDependencies.load() == 0) {
+        if (_stateManager->transitionState(handle, NodeState::Pending, NodeState::Ready)) {
+            dispatchReady(handle);
+        }
+    }
+    
+    return handle;
+}
+
+std::vector<WorkGraph::NodeHandle> WorkGraph::instantiate(const WorkGraphTemplate& graphTemplate, void* context,
+                                                          void* userData) {
+    ENTROPY_PROFILE_ZONE();
+    if (!graphTemplate.isFinalized()) {
+        throw std::logic_error("WorkGraphTemplate must be finalized before it can be instantiated");
+    }
+    
+    const size_t nodeCount = graphTemplate.getNodeCount();
+    std::vector<NodeHandle> byPosition;
+    byPosition.reserve(nodeCount);
+    
+    std::unique_lock<std::shared_mutex> lock(_graphMutex);
+    
+    _graph.reserve(_nodeHandles.size() + nodeCount);
+    _nodeHandles.reserve(_nodeHandles.size() + nodeCount);
+    
+    // Nodes go in with their dependency counts already final - nothing can run until
+    // we release the lock, and no edge below will touch the counts again
+    const auto inDegrees = graphTemplate.initialInDegrees();
+    for (uint32_t pos = 0; pos < nodeCount; ++pos) {
+        const auto* kernel = &graphTemplate._kernels[graphTemplate.kernelAt(pos)];
+        WorkGraphNode node([kernel, context]() { (*kernel)(context); }, std::string(graphTemplate.nameAt(pos)),
+                           graphTemplate.executionTypeAt(pos));
+        node.pendingDependencies.store(inDegrees[pos], std::memory_order_relaxed);
+        node.userData = userData;
+        
+        auto handle = _graph.addNode(std::move(node));
+        _nodeHandles.push_back(handle);
+        _stateManager->registerNode(handle, NodeState::Pending);
+        byPosition.push_back(handle);
+    }
+    
+    // Template edges are de-duplicated and acyclic, and the new nodes only point at
+    // each other, so each fan-out is appended wholesale
+    const auto edgeOffsets = graphTemplate.edgeOffsets();
+    const auto edgeTargets = graphTemplate.edgeTargets();
+    std::vector<uint32_t> targets;
+    for (size_t pos = 0; pos < nodeCount; ++pos) {
+        uint32_t begin = edgeOffsets[pos];
+        uint32_t end = edgeOffsets[pos + 1];
+        if (begin == end) continue;
+        targets.clear();
+        for (uint32_t e = begin; e < end; ++e) {
+            targets.push_back(byPosition[edgeTargets[e]].getIndex());
+        }
+        _graph.addEdgesUnchecked(byPosition[pos].getIndex(), targets);
+    }
+    
+    _pendingNodes.fetch_add(static_cast<uint32_t>(nodeCount), std::memory_order_relaxed);
+    
+    if (auto* eventBus = getEventBus()) {
+        for (const auto& handle : byPosition) {
+            eventBus->publish(NodeAddedEvent(this, handle));
+        }
+    }
+    
+    // Late instances start right away; the template already knows its roots
+    if (_executionStarted.load(std::memory_order_acquire)) {
+        for (uint32_t root : graphTemplate.roots()) {
+            const auto& handle = byPosition[root];
+            if (_stateManager->transitionState(handle, NodeState::Pending, NodeState::Ready)) {
+                dispatchReady(handle);
+            }
+        }
+    }
+    
+    lock.unlock();
+    
+    // Hand back in the caller's NodeId order
+    const auto positionOf = graphTemplate.positionOf();
+    std::vector<NodeHandle> handles(nodeCount);
+    for (size_t id = 0; id < nodeCount; ++id) {
+        handles[id] = byPosition[positionOf[id]];
+    }
+    return handles;
+}
+
 void WorkGraph::incrementDependencies(NodeHandle node) {
     if (auto* nodeData = node.getData()) {
         auto newCount = nodeData->pendingDependencies.fetch_add(1, std::memory_order_acq_rel) + 1;
@@ -371,22 +605,16 @@ size_t WorkGraph::scheduleRootsLocked() {
                 }
                 // Try to transition to ready state through state manager
                 if (_stateManager->transitionState(handle, NodeState::Pending, NodeState::Ready)) {
-                    // Now transition to scheduled before actually scheduling
-                    if (_stateManager->transitionState(handle, NodeState::Ready, NodeState::Scheduled)) {
+                    // A root parked by suspension still counts - it runs on resume()
+                    bool scheduled = dispatchReady(handle);
+                    if (scheduled) {
+                        rootCount++;
                         if (_config.enableDebugLogging) {
-                            ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: About to call scheduler->scheduleNode");
+                            ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Root node scheduled, deferred or parked");
                         }
-                        // Schedule the root node
-                        bool scheduled = _scheduler->scheduleNode(handle);
-                        if (scheduled) {
-                            rootCount++;
-                            if (_config.enableDebugLogging) {
-                                ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Root node scheduled or deferred");
-                            }
-                        } else {
-                            if (_config.enableDebugLogging) {
-                                ENTROPY_LOG_WARNING_CAT("Concurrency", "WorkGraph: Failed to schedule root node");
-                            }
+                    } else {
+                        if (_config.enableDebugLogging) {
+                            ENTROPY_LOG_WARNING_CAT("Concurrency", "WorkGraph: Failed to schedule root node");
                         }
                     }
                 } else if (_config.enableDebugLogging) {
@@ -404,7 +632,10 @@ size_t WorkGraph::scheduleRootsLocked() {
 }
 
 void WorkGraph::suspend() {
-    _suspended.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(_parkMutex);
+        _suspended.store(true, std::memory_order_release);
+    }
     
     if (_config.enableDebugLogging) {
         ENTROPY_LOG_DEBUG_CAT("WorkGraph", "Graph suspended - no new nodes will be scheduled");
@@ -412,31 +643,172 @@ void WorkGraph::suspend() {
 }
 
 void WorkGraph::resume() {
-    bool wasSuspended = _suspended.exchange(false, std::memory_order_acq_rel);
-    
-    if (wasSuspended) {
-        if (_config.enableDebugLogging) {
-            ENTROPY_LOG_DEBUG_CAT("WorkGraph", "Graph resumed - checking for ready nodes");
+    std::vector<NodeHandle> released;
+    {
+        std::lock_guard<std::mutex> lock(_parkMutex);
+        if (!_suspended.exchange(false, std::memory_order_acq_rel)) {
+            return;
         }
         
-        // Process any deferred nodes that accumulated while suspended
-        if (_scheduler) {
-            size_t processed = _scheduler->processDeferredNodes();
-            if (processed > 0 && _config.enableDebugLogging) {
-                ENTROPY_LOG_DEBUG_CAT("WorkGraph", "Processed " + std::to_string(processed) + " deferred nodes after resume");
+        // Tags that are still suspended keep their nodes parked
+        for (auto it = _parkedReady.begin(); it != _parkedReady.end();) {
+            if (it->first == 0 || !isTagSuspendedLocked(it->first)) {
+                released.insert(released.end(), it->second.begin(), it->second.end());
+                it = _parkedReady.erase(it);
+            } else {
+                ++it;
             }
         }
+        _parkedCount -= released.size();
+    }
+    
+    if (_config.enableDebugLogging) {
+        ENTROPY_LOG_DEBUG_CAT("WorkGraph", "Graph resumed - releasing " + std::to_string(released.size()) + " parked nodes");
+    }
+    
+    // Process any deferred nodes that accumulated while suspended
+    if (_scheduler) {
+        size_t processed = _scheduler->processDeferredNodes();
+        if (processed > 0 && _config.enableDebugLogging) {
+            ENTROPY_LOG_DEBUG_CAT("WorkGraph", "Processed " + std::to_string(processed) + " deferred nodes after resume");
+        }
+    }
+    
+    scheduleParked(released);
+}
+
+void WorkGraph::suspend(uint32_t tag) {
+    if (tag == 0) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(_parkMutex);
+    if (!isTagSuspendedLocked(tag)) {
+        _suspendedTags.push_back(tag);
+        _suspendedTagCount.store(static_cast<uint32_t>(_suspendedTags.size()), std::memory_order_release);
+    }
+}
+
+void WorkGraph::resume(uint32_t tag) {
+    std::vector<NodeHandle> released;
+    {
+        std::lock_guard<std::mutex> lock(_parkMutex);
+        auto it = std::find(_suspendedTags.begin(), _suspendedTags.end(), tag);
+        if (it == _suspendedTags.end()) {
+            return;
+        }
+        _suspendedTags.erase(it);
+        _suspendedTagCount.store(static_cast<uint32_t>(_suspendedTags.size()), std::memory_order_release);
         
-        // Check if any nodes became ready while we were suspended and schedule them
-        std::shared_lock<std::shared_mutex> lock(_graphMutex);
-        for (const auto& handle : _nodeHandles) {
-            auto* nodeData = handle.getData();
-            if (nodeData && nodeData->state.load() == NodeState::Ready) {
-                // Try to transition to scheduled
-                if (_stateManager->transitionState(handle, NodeState::Ready, NodeState::Scheduled)) {
-                    _scheduler->scheduleNode(handle);
-                }
-            }
+        // A graph-wide suspension still holds them; resume() will pick them up
+        if (_suspended.load(std::memory_order_acquire)) {
+            return;
+        }
+        auto parked = _parkedReady.find(tag);
+        if (parked != _parkedReady.end()) {
+            released = std::move(parked->second);
+            _parkedReady.erase(parked);
+            _parkedCount -= released.size();
+        }
+    }
+    
+    scheduleParked(released);
+}
+
+bool WorkGraph::isSuspended(uint32_t tag) const {
+    std::lock_guard<std::mutex> lock(_parkMutex);
+    return isTagSuspendedLocked(tag);
+}
+
+void WorkGraph::setSuspendTag(NodeHandle node, uint32_t tag) {
+    if (!isHandleValid(node)) {
+        throw std::invalid_argument("Invalid node handle for setSuspendTag");
+    }
+    node.getData()->suspendTag.store(tag, std::memory_order_release);
+}
+
+void WorkGraph::setTargetGroup(NodeHandle node, WorkContractGroup* group) {
+    std::unique_lock<std::shared_mutex> lock(_graphMutex);
+    if (!isHandleValid(node)) {
+        throw std::invalid_argument("Invalid node handle for setTargetGroup");
+    }
+    node.getData()->targetGroup = group;
+    ensureAdmission(group);
+}
+
+void WorkGraph::ensureAdmission(WorkContractGroup* group) {
+    if (!group) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_admissionMutex);
+    for (const auto& entry : _admissionTickets) {
+        if (entry.first == group) {
+            return;
+        }
+    }
+    auto ticket = group->registerAdmission([this, group]() {
+        CallbackGuard guard(this);
+        if (_destroyed.load(std::memory_order_acquire) || !_scheduler) {
+            return false;
+        }
+        size_t processed = _scheduler->processDeferredNodes(group, 0);
+        if (_config.enableDebugLogging && processed > 0) {
+            ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Admission turn scheduled " + std::to_string(processed) + " deferred nodes");
+        }
+        return _scheduler->getDeferredCount(group) > 0;
+    });
+    _admissionTickets.emplace_back(group, ticket);
+}
+
+size_t WorkGraph::getParkedCount() const {
+    std::lock_guard<std::mutex> lock(_parkMutex);
+    return _parkedCount;
+}
+
+bool WorkGraph::isTagSuspendedLocked(uint32_t tag) const {
+    return tag != 0 && std::find(_suspendedTags.begin(), _suspendedTags.end(), tag) != _suspendedTags.end();
+}
+
+bool WorkGraph::parkIfSuspended(NodeHandle node) {
+    // Common case: nothing suspended, no lock
+    if (!_suspended.load(std::memory_order_acquire) &&
+        _suspendedTagCount.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    
+    auto* nodeData = node.getData();
+    uint32_t tag = nodeData ? nodeData->suspendTag.load(std::memory_order_acquire) : 0;
+    
+    // Re-check under the lock so a concurrent resume() cannot miss this node
+    std::lock_guard<std::mutex> lock(_parkMutex);
+    if (!_suspended.load(std::memory_order_acquire) && !isTagSuspendedLocked(tag)) {
+        return false;
+    }
+    _parkedReady[tag].push_back(node);
+    ++_parkedCount;
+    return true;
+}
+
+bool WorkGraph::dispatchReady(NodeHandle node) {
+    if (_config.enableTiming) {
+        if (auto* nodeData = node.getData()) {
+            nodeData->timing.readyNs = NodeTiming::now();
+        }
+    }
+    if (parkIfSuspended(node)) {
+        return true;
+    }
+    if (!_stateManager->transitionState(node, NodeState::Ready, NodeState::Scheduled)) {
+        return false;
+    }
+    return _scheduler->scheduleNode(node);
+}
+
+void WorkGraph::scheduleParked(const std::vector<NodeHandle>& nodes) {
+    for (const auto& node : nodes) {
+        // Parked nodes may have been cancelled in the meantime; those stay put
+        if (_stateManager->transitionState(node, NodeState::Ready, NodeState::Scheduled)) {
+            _scheduler->scheduleNode(node);
         }
     }
 }
@@ -490,7 +862,13 @@ void WorkGraph::execute() {
         }
     }
     
-    if (roots == 0 && getPendingCount() > 0) {
+    // An empty graph is complete as soon as it starts
+    if (getPendingCount() == 0) {
+        onGraphDrained();
+    }
+    
+    // Nodes held only by other graphs are not a cycle
+    if (roots == 0 && getPendingCount() > 0 && _externalWaits.load(std::memory_order_acquire) == 0) {
         auto msg = std::format("ERROR: No roots found. Pending count: {}, node count: {}", 
                   getPendingCount(), _nodeHandles.size());
         ENTROPY_LOG_ERROR_CAT("WorkGraph", msg);
@@ -538,6 +916,13 @@ void WorkGraph::onNodeComplete(NodeHandle node) {
         return; // Already processed
     }
     
+    // Splice in anything this node spawned while running. This has to happen before
+    // the pending count drops and before children are released, so neither wait()
+    // nor a dependant can observe the node as finished without its subgraph.
+    if (auto* buffer = activeSpawnBuffer(); buffer && buffer->owner == node && !buffer->nodes.empty()) {
+        spliceSpawnedSubgraph(node, *buffer);
+    }
+    
     // Transition state through state manager
     _stateManager->transitionState(node, NodeState::Executing, NodeState::Completed);
     
@@ -547,8 +932,7 @@ void WorkGraph::onNodeComplete(NodeHandle node) {
     
     // If all nodes are complete, notify waiters
     if (pending == 0) {
-        std::lock_guard<std::mutex> lock(_waitMutex);
-        _waitCondition.notify_all();
+        onGraphDrained();
     }
     
     // Call completion callback if set
@@ -559,12 +943,19 @@ void WorkGraph::onNodeComplete(NodeHandle node) {
     // Schedule children whose dependencies are now satisfied
     // First, copy the children list while holding the lock (minimize critical section)
     std::vector<NodeHandle> children;
+    bool hasExternals = false;
     {
         std::shared_lock<std::shared_mutex> lock(_graphMutex);
         children = this->getChildren(node);
+        hasExternals = !nodeData->externalDependants.empty();
     } // Release lock immediately
+    std::vector<ExternalDependant> externals;
+    if (hasExternals) {
+        externals = takeExternalDependants(nodeData);
+    }
     
     // Process children outside the lock to minimize contention
+    std::vector<NodeHandle> toSkip;
     for (auto& child : children) {
         auto* childData = child.getData();
         if (!childData) continue;
@@ -577,37 +968,31 @@ void WorkGraph::onNodeComplete(NodeHandle node) {
             continue;
         }
         
-        // Decrement dependency count
-        uint32_t remaining = childData->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) - 1;
-        if (_config.enableDebugLogging) {
-            ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Child node dependencies decremented");
-        }
-        
-        // If all dependencies satisfied, try to transition to ready and schedule
-        if (remaining == 0 && childData->failedParentCount.load(std::memory_order_acquire) == 0) {
-            if (_config.enableDebugLogging) {
-                ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Child node is ready - all dependencies satisfied");
-            }
-            if (_stateManager->transitionState(child, NodeState::Pending, NodeState::Ready)) {
-                // Transition to scheduled before actually scheduling
-                if (_stateManager->transitionState(child, NodeState::Ready, NodeState::Scheduled)) {
-                    // Schedule the child immediately
-                    _scheduler->scheduleNode(child);
-                }
-                if (_config.enableDebugLogging) {
-                    ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Scheduled child node");
+        // Branch nodes only take the conditional edges labelled with their selection
+        bool taken = true;
+        if (nodeData->isBranch) {
+            for (const auto& [childIndex, branchIndex] : nodeData->branchEdges) {
+                if (childIndex == child.getIndex()) {
+                    taken = (branchIndex == nodeData->selectedBranch);
+                    break;
                 }
-            } else if (_config.enableDebugLogging) {
-                ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Failed to transition child node to Ready state");
             }
-        } else if (_config.enableDebugLogging && remaining > 0) {
-            ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Child node still has dependencies");
         }
+        
+        releaseDependant(child, taken, toSkip);
+    }
+    
+    // Untaken subtrees are retired inline - they never reach a worker
+    if (!toSkip.empty()) {
+        skipSubtrees(toSkip);
+    }
+    
+    if (!externals.empty()) {
+        notifyExternalDependants(externals, NodeState::Completed);
     }
     
-    // Note: Processing of deferred nodes is now handled via the 
-    // onCapacityAvailable callback from WorkContractGroup, which
-    // is called after contracts are actually freed.
+    // Note: Deferred nodes are admitted through the WorkContractGroup's admission
+    // queue, which gives this graph a turn after contracts are actually freed.
 }
 
 WorkGraph::WaitResult WorkGraph::wait() {
@@ -627,13 +1012,19 @@ WorkGraph::WaitResult WorkGraph::wait() {
         result.completedCount = _completedNodes.load(std::memory_order_acquire);
         result.failedCount = _failedNodes.load(std::memory_order_acquire);
         result.droppedCount = _droppedNodes.load(std::memory_order_acquire);
+        result.skippedCount = _skippedNodes.load(std::memory_order_acquire);
         result.allCompleted = (result.failedCount == 0 && result.droppedCount == 0);
         return result;
     }
     
+    // Called from a contract in fiber mode: let the worker run other work meanwhile
+    bool suspended = FiberWorker::suspendUntil([this]() {
+        return _pendingNodes.load(std::memory_order_acquire) == 0;
+    });
+    
     // Use condition variable for waiting instead of busy-wait
     std::unique_lock<std::mutex> lock(_waitMutex);
-    if (_config.enableDebugLogging) {
+    if (_config.enableDebugLogging && !suspended) {
         ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph::wait() waiting for pending nodes: " + std::to_string(_pendingNodes.load()));
     }
     _waitCondition.wait(lock, [this]() {
@@ -649,6 +1040,7 @@ WorkGraph::WaitResult WorkGraph::wait() {
     result.completedCount = _completedNodes.load(std::memory_order_acquire);
     result.failedCount = _failedNodes.load(std::memory_order_acquire);
     result.droppedCount = _droppedNodes.load(std::memory_order_acquire);
+    result.skippedCount = _skippedNodes.load(std::memory_order_acquire);
     result.allCompleted = (result.failedCount == 0 && result.droppedCount == 0);
     
     // Log warning if nodes were dropped
@@ -698,6 +1090,116 @@ WorkGraph::NodeHandle WorkGraph::addContinuation(const std::vector<NodeHandle>&
     return continuation;
 }
 
+WorkGraph::SpawnHandle WorkGraph::spawn(std::function<void()> work,
+                                        const std::string& name,
+                                        void* userData,
+                                        ExecutionType executionType) {
+    SpawnBuffer* buffer = activeSpawnBuffer();
+    if (!buffer) {
+        throw std::runtime_error("WorkGraph::spawn() must be called from inside a running node of the same graph");
+    }
+    
+    WorkGraphNode node(std::move(work), name, executionType);
+    node.userData = userData;
+    buffer->nodes.push_back(std::move(node));
+    
+    return SpawnHandle{static_cast<uint32_t>(buffer->nodes.size() - 1)};
+}
+
+void WorkGraph::spawnDependency(SpawnHandle from, SpawnHandle to) {
+    SpawnBuffer* buffer = activeSpawnBuffer();
+    if (!buffer) {
+        throw std::runtime_error("WorkGraph::spawnDependency() must be called from inside a running node of the same graph");
+    }
+    
+    if (!from.valid() || !to.valid() ||
+        from.index >= buffer->nodes.size() || to.index >= buffer->nodes.size()) {
+        throw std::invalid_argument("Invalid spawn handle provided to spawnDependency");
+    }
+    
+    // Spawn order doubles as topological order, so a splice never needs a cycle search
+    if (from.index >= to.index) {
+        throw std::invalid_argument("spawnDependency requires 'from' to be spawned before 'to'");
+    }
+    
+    buffer->edges.emplace_back(from.index, to.index);
+}
+
+void WorkGraph::spliceSpawnedSubgraph(NodeHandle owner, SpawnBuffer& buffer) {
+    ENTROPY_PROFILE_ZONE();
+    
+    const size_t count = buffer.nodes.size();
+    std::vector<NodeHandle> spawned;
+    spawned.reserve(count);
+    
+    // Roots have no spawned parent, sinks have no spawned child
+    std::vector<bool> hasParent(count, false);
+    std::vector<bool> hasChild(count, false);
+    for (const auto& [from, to] : buffer.edges) {
+        hasChild[from] = true;
+        hasParent[to] = true;
+    }
+    
+    // Count the new nodes as pending before the owner stops being pending
+    _pendingNodes.fetch_add(static_cast<uint32_t>(count), std::memory_order_acq_rel);
+    
+    {
+        std::unique_lock<std::shared_mutex> lock(_graphMutex);
+        
+        // Owner's dependants as they were before the splice
+        auto dependants = _graph.getChildren(owner);
+        
+        for (auto& node : buffer.nodes) {
+            auto handle = _graph.addNode(std::move(node));
+            _nodeHandles.push_back(handle);
+            _stateManager->registerNode(handle, NodeState::Pending);
+            spawned.push_back(handle);
+        }
+        
+        // Every edge below points into a node created above, so none can close a cycle
+        for (const auto& [from, to] : buffer.edges) {
+            if (_graph.addEdgeUnchecked(spawned[from], spawned[to])) {
+                incrementDependencies(spawned[to]);
+            }
+        }
+        
+        for (size_t i = 0; i < count; ++i) {
+            // Roots are released by the owner's completion like any other child
+            if (!hasParent[i]) {
+                _graph.addEdgeUnchecked(owner, spawned[i]);
+                incrementDependencies(spawned[i]);
+            }
+            
+            // Sinks gate whatever was already waiting on the owner
+            if (!hasChild[i]) {
+                for (auto& dependant : dependants) {
+                    auto* dependantData = dependant.getData();
+                    if (!dependantData || isTerminalState(dependantData->state.load(std::memory_order_acquire))) {
+                        continue;
+                    }
+                    if (_graph.addEdgeUnchecked(spawned[i], dependant)) {
+                        incrementDependencies(dependant);
+                    }
+                }
+            }
+        }
+    }
+    
+    buffer.nodes.clear();
+    buffer.edges.clear();
+    
+    if (auto* eventBus = getEventBus()) {
+        for (const auto& handle : spawned) {
+            eventBus->publish(NodeAddedEvent(this, handle));
+        }
+    }
+    
+    if (_config.enableDebugLogging) {
+        auto msg = std::format("Spliced {} spawned nodes into graph", count);
+        ENTROPY_LOG_DEBUG_CAT("WorkGraph", msg);
+    }
+}
+
 void WorkGraph::onNodeFailed(NodeHandle node) {
     auto* nodeData = node.getData();
     if (!nodeData) return;
@@ -718,8 +1220,7 @@ void WorkGraph::onNodeFailed(NodeHandle node) {
     
     // If all nodes are complete, notify waiters
     if (pending == 0) {
-        std::lock_guard<std::mutex> lock(_waitMutex);
-        _waitCondition.notify_all();
+        onGraphDrained();
     }
     
     // Cancel all dependent nodes
@@ -753,15 +1254,71 @@ void WorkGraph::onNodeYielded(NodeHandle node) {
         return;
     }
     
+    // Spawns only take effect from the run that completes the node
+    if (auto* buffer = activeSpawnBuffer(); buffer && buffer->owner == node && !buffer->nodes.empty()) {
+        auto msg = std::format("Node '{}' yielded with {} spawned nodes - discarding them",
+                              nodeData->name, buffer->nodes.size());
+        ENTROPY_LOG_WARNING_CAT("WorkGraph", msg);
+        buffer->nodes.clear();
+        buffer->edges.clear();
+    }
+    
     // Transition to Yielded state
     if (_stateManager) {
         _stateManager->transitionState(node, NodeState::Executing, NodeState::Yielded);
     }
     
+    // A node parked by parkRunningNode() waits for its wake call; the Yielded state
+    // above is published first so the wake can reschedule it from any thread
+    using YieldPark = WorkGraphNode::YieldPark;
+    YieldPark park = YieldPark::Requested;
+    if (nodeData->yieldPark.compare_exchange_strong(park, YieldPark::Parked, std::memory_order_acq_rel)) {
+        return;
+    }
+    nodeData->yieldPark.store(YieldPark::None, std::memory_order_relaxed);
+    
     // Reschedule the node
     rescheduleYieldedNode(node);
 }
 
+std::function<void()> WorkGraph::parkRunningNode() {
+    SpawnBuffer* buffer = stActiveSpawnBuffer;
+    auto* nodeData = buffer ? buffer->owner.getData() : nullptr;
+    if (!nodeData || !nodeData->isYieldable) {
+        throw std::runtime_error("parkRunningNode() must be called from inside a running yieldable node");
+    }
+    nodeData->yieldPark.store(WorkGraphNode::YieldPark::Requested, std::memory_order_release);
+    
+    // The anchor outlives the graph, so a late wake finds it cleared instead of dangling
+    return [anchor = buffer->graph->_linkAnchor, node = buffer->owner]() {
+        std::optional<CallbackGuard> guard;
+        {
+            std::lock_guard<std::mutex> links(crossGraphLinkMutex());
+            if (!anchor->graph) {
+                return;
+            }
+            guard.emplace(anchor->graph);
+        }
+        guard->graph->wakeParkedNode(node);
+    };
+}
+
+void WorkGraph::wakeParkedNode(NodeHandle node) {
+    auto* nodeData = node.getData();
+    if (!nodeData || _destroyed.load(std::memory_order_acquire)) return;
+    
+    // Still running: leave a note so its yield reschedules as usual
+    using YieldPark = WorkGraphNode::YieldPark;
+    YieldPark park = YieldPark::Requested;
+    if (nodeData->yieldPark.compare_exchange_strong(park, YieldPark::Woken, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (park == YieldPark::Parked &&
+        nodeData->yieldPark.compare_exchange_strong(park, YieldPark::None, std::memory_order_acq_rel)) {
+        rescheduleYieldedNode(node);
+    }
+}
+
 void WorkGraph::rescheduleYieldedNode(NodeHandle node) {
     auto* nodeData = node.getData();
     if (!nodeData) return;
@@ -777,17 +1334,21 @@ void WorkGraph::rescheduleYieldedNode(NodeHandle node) {
     // Transition from Yielded to Ready
     if (_stateManager) {
         if (_stateManager->transitionState(node, NodeState::Yielded, NodeState::Ready)) {
-            // If suspended, don't try to schedule - leave in Ready state
-            if (_suspended.load(std::memory_order_acquire)) {
+            // If suspended, don't try to schedule - park it in Ready state for resume()
+            if (parkIfSuspended(node)) {
                 if (_config.enableDebugLogging) {
-                    ENTROPY_LOG_DEBUG_CAT("WorkGraph", "Graph suspended - yielded node left in Ready state");
+                    ENTROPY_LOG_DEBUG_CAT("WorkGraph", "Graph suspended - yielded node parked in Ready state");
                 }
                 return;
             }
             
             // Transition to scheduled
             if (_stateManager->transitionState(node, NodeState::Ready, NodeState::Scheduled)) {
-                // Schedule with the scheduler
+                // Reuse the contract we are running on; a new one is only needed if
+                // that one is gone
+                if (_scheduler->rescheduleInPlace(node)) {
+                    return;
+                }
                 if (!_scheduler->scheduleNode(node)) {
                     // Failed to schedule - might be deferred
                     if (_config.enableDebugLogging) {
@@ -819,20 +1380,126 @@ void WorkGraph::onNodeCancelled(NodeHandle node) {
     
     // If all nodes are complete, notify waiters
     if (pending == 0) {
-        std::lock_guard<std::mutex> lock(_waitMutex);
-        _waitCondition.notify_all();
+        onGraphDrained();
     }
     
     // Cancel all dependent nodes
     cancelDependents(node);
 }
 
+void WorkGraph::releaseDependant(NodeHandle child, bool taken, std::vector<NodeHandle>& toSkip) {
+    auto* childData = child.getData();
+    if (!childData) return;
+    
+    // Publish the edge outcome before the decrement so whoever releases the child sees it
+    if (taken) {
+        childData->takenParentCount.fetch_add(1, std::memory_order_acq_rel);
+    }
+    
+    // Decrement dependency count. Sequentially consistent so that, paired with the
+    // _executionStarted check below, either we or execute()'s root scan schedules it.
+    uint32_t remaining = childData->pendingDependencies.fetch_sub(1) - 1;
+    if (_config.enableDebugLogging) {
+        ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Child node dependencies decremented");
+    }
+    
+    if (remaining > 0) {
+        if (_config.enableDebugLogging) {
+            ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Child node still has dependencies");
+        }
+        return;
+    }
+    
+    if (childData->failedParentCount.load(std::memory_order_acquire) != 0) {
+        return;  // Cancellation owns this node
+    }
+    
+    // Every incoming edge resolved untaken - nothing upstream wants this node
+    if (childData->takenParentCount.load(std::memory_order_acquire) == 0) {
+        toSkip.push_back(child);
+        return;
+    }
+    
+    // Only external dependencies can resolve before execute(); its root scan picks the node up
+    if (!_executionStarted.load()) {
+        return;
+    }
+    
+    // All dependencies satisfied, try to transition to ready and schedule
+    if (_config.enableDebugLogging) {
+        ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Child node is ready - all dependencies satisfied");
+    }
+    if (_stateManager->transitionState(child, NodeState::Pending, NodeState::Ready)) {
+        // Schedule the child immediately, or park it if suspended
+        dispatchReady(child);
+        if (_config.enableDebugLogging) {
+            ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Scheduled child node");
+        }
+    } else if (_config.enableDebugLogging) {
+        ENTROPY_LOG_DEBUG_CAT("Concurrency", "WorkGraph: Failed to transition child node to Ready state");
+    }
+}
+
+void WorkGraph::skipSubtrees(std::vector<NodeHandle>& toSkip) {
+    ENTROPY_PROFILE_ZONE();
+    
+    std::vector<NodeHandle> children;
+    while (!toSkip.empty()) {
+        NodeHandle node = toSkip.back();
+        toSkip.pop_back();
+        
+        auto* nodeData = node.getData();
+        if (!nodeData) continue;
+        
+        // Claim the node exactly like a completion would
+        bool expected = false;
+        if (!nodeData->completionProcessed.compare_exchange_strong(expected, true,
+                                                                    std::memory_order_acq_rel)) {
+            continue;
+        }
+        if (!_stateManager->transitionState(node, NodeState::Pending, NodeState::Skipped)) {
+            continue;
+        }
+        
+        _skippedNodes.fetch_add(1, std::memory_order_relaxed);
+        uint32_t pending = _pendingNodes.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (pending == 0) {
+            onGraphDrained();
+        }
+        
+        bool hasExternals = false;
+        {
+            std::shared_lock<std::shared_mutex> lock(_graphMutex);
+            children = this->getChildren(node);
+            hasExternals = !nodeData->externalDependants.empty();
+        }
+        
+        if (hasExternals) {
+            notifyExternalDependants(takeExternalDependants(nodeData), NodeState::Skipped);
+        }
+        
+        // Everything leaving a skipped node is untaken
+        for (auto& child : children) {
+            auto* childData = child.getData();
+            if (!childData || childData->state.load(std::memory_order_acquire) == NodeState::Cancelled) {
+                continue;
+            }
+            releaseDependant(child, false, toSkip);
+        }
+    }
+}
+
 void WorkGraph::cancelDependents(NodeHandle failedNode) {
     std::vector<NodeHandle> nodesToCancel;
+    bool hasExternals = false;
     
     {
         std::shared_lock<std::shared_mutex> lock(_graphMutex);
         
+        if (auto* failedData = failedNode.getData()) {
+            hasExternals = !failedData->externalDependants.empty();
+        }
+        
         // Get all children of the failed node
         auto children = this->getChildren(failedNode);
         
@@ -859,6 +1526,210 @@ void WorkGraph::cancelDependents(NodeHandle failedNode) {
         }
         onNodeCancelled(node);
     }
+    
+    if (hasExternals) {
+        auto* failedData = failedNode.getData();
+        notifyExternalDependants(takeExternalDependants(failedData), failedData->state.load(std::memory_order_acquire));
+    }
+}
+
+WorkGraph::ExternalDependency WorkGraph::getExternalHandle(NodeHandle node) {
+    std::shared_lock<std::shared_mutex> lock(_graphMutex);
+    if (!isHandleValid(node)) {
+        throw std::invalid_argument("getExternalHandle requires a valid node of this graph");
+    }
+    return ExternalDependency{this, node};
+}
+
+void WorkGraph::addDependency(const ExternalDependency& from, NodeHandle to) {
+    ENTROPY_PROFILE_ZONE();
+    
+    if (!from.valid()) {
+        throw std::invalid_argument("Invalid external dependency handle");
+    }
+    
+    // A node of our own is just a local edge
+    if (from.graph == this) {
+        if (!from.node.isValid()) {
+            throw std::invalid_argument("A node cannot wait on the completion of its own graph");
+        }
+        addDependency(from.node, to);
+        return;
+    }
+    
+    std::optional<NodeState> resolvedOutcome;
+    {
+        // Cross-graph edges only change under this lock, so the cycle check stays true
+        // until the edge is in
+        std::lock_guard<std::mutex> links(crossGraphLinkMutex());
+        if (wouldCreateExternalCycle(from, to)) {
+            throw std::invalid_argument("Cross-graph dependency would create a cycle");
+        }
+        
+        // Hold the waiting node back first, so it cannot start while we register
+        {
+            std::unique_lock<std::shared_mutex> lock(_graphMutex);
+            auto* toData = isHandleValid(to) ? to.getData() : nullptr;
+            if (!toData) {
+                throw std::invalid_argument("Invalid node handle provided to addDependency");
+            }
+            if (toData->state.load(std::memory_order_acquire) != NodeState::Pending) {
+                throw std::runtime_error("Cannot add a dependency to a node that is no longer pending");
+            }
+            incrementDependencies(to);
+            _externalWaits.fetch_add(1, std::memory_order_acq_rel);
+        }
+        
+        // Register with the source. If it already finished, resolve right here instead.
+        WorkGraph& source = *from.graph;
+        NodeHandle sourceNode = from.node;
+        if (sourceNode.isValid()) {
+            std::unique_lock<std::shared_mutex> lock(source._graphMutex);
+            auto* sourceData = source.isHandleValid(sourceNode) ? sourceNode.getData() : nullptr;
+            if (!sourceData) {
+                resolvedOutcome = NodeState::Cancelled;
+            } else {
+                NodeState sourceState = sourceData->state.load(std::memory_order_acquire);
+                if (isTerminalState(sourceState)) {
+                    resolvedOutcome = sourceState;
+                } else {
+                    sourceData->externalDependants.push_back(ExternalDependant{_linkAnchor, to});
+                }
+            }
+        } else {
+            std::lock_guard<std::mutex> lock(source._waitMutex);
+            if (source._executionStarted.load() && source._pendingNodes.load() == 0) {
+                resolvedOutcome = NodeState::Completed;
+            } else {
+                source._completionDependants.push_back(ExternalDependant{_linkAnchor, to});
+            }
+        }
+    }
+    
+    // Outside the link lock: resolving may finish nodes and notify further graphs
+    if (resolvedOutcome) {
+        resolveExternalDependency(to, *resolvedOutcome);
+    }
+}
+
+void WorkGraph::resolveExternalDependency(NodeHandle node, NodeState outcome) {
+    CallbackGuard guard(this);
+    if (_destroyed.load(std::memory_order_acquire)) {
+        return;
+    }
+    
+    _externalWaits.fetch_sub(1, std::memory_order_acq_rel);
+    
+    auto* nodeData = node.getData();
+    if (!nodeData) return;
+    
+    if (outcome == NodeState::Completed || outcome == NodeState::Skipped) {
+        std::vector<NodeHandle> toSkip;
+        releaseDependant(node, outcome == NodeState::Completed, toSkip);
+        if (!toSkip.empty()) {
+            skipSubtrees(toSkip);
+        }
+        return;
+    }
+    
+    // Failed, cancelled or dropped upstream - same treatment as a failed local parent
+    nodeData->failedParentCount.fetch_add(1, std::memory_order_acq_rel);
+    if (!isTerminalState(nodeData->state.load(std::memory_order_acquire))) {
+        onNodeCancelled(node);
+    }
+}
+
+void WorkGraph::notifyExternalDependants(const std::vector<ExternalDependant>& dependants, NodeState outcome) {
+    for (const auto& dependant : dependants) {
+        // Pin the waiting graph while its anchor is still set; its destructor clears the
+        // anchor under the same lock and then waits for our guard
+        std::optional<CallbackGuard> guard;
+        {
+            std::lock_guard<std::mutex> links(crossGraphLinkMutex());
+            if (!dependant.graph->graph) {
+                continue;
+            }
+            guard.emplace(dependant.graph->graph);
+        }
+        guard->graph->resolveExternalDependency(dependant.node, outcome);
+    }
+}
+
+std::vector<ExternalDependant> WorkGraph::takeExternalDependants(WorkGraphNode* nodeData) {
+    std::unique_lock<std::shared_mutex> lock(_graphMutex);
+    return std::exchange(nodeData->externalDependants, {});
+}
+
+std::mutex& WorkGraph::crossGraphLinkMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+bool WorkGraph::wouldCreateExternalCycle(const ExternalDependency& from, NodeHandle to) {
+    struct Visit {
+        WorkGraph* graph;
+        NodeHandle node;
+    };
+    
+    // Walk forward from `to`: local children, then nodes of other graphs waiting on each
+    // node, then anything waiting on a whole graph we step into
+    std::unordered_map<WorkGraph*, std::vector<bool>> visited;
+    std::unordered_set<WorkGraph*> drainedGraphs;
+    std::vector<Visit> stack{{this, to}};
+    while (!stack.empty()) {
+        Visit current = stack.back();
+        stack.pop_back();
+        auto& seen = visited[current.graph];
+        uint32_t index = current.node.getIndex();
+        if (index >= seen.size()) {
+            seen.resize(index + 1, false);
+        }
+        if (seen[index]) {
+            continue;
+        }
+        seen[index] = true;
+        if (current.graph == from.graph && (!from.node.isValid() || current.node.getIndex() == from.node.getIndex())) {
+            return true;
+        }
+        
+        WorkGraph& graph = *current.graph;
+        std::vector<ExternalDependant> next;
+        {
+            std::shared_lock<std::shared_mutex> lock(graph._graphMutex);
+            auto* nodeData = graph.isHandleValid(current.node) ? current.node.getData() : nullptr;
+            if (!nodeData) {
+                continue;
+            }
+            for (auto& child : graph.getChildren(current.node)) {
+                stack.push_back({&graph, child});
+            }
+            next = nodeData->externalDependants;
+        }
+        if (drainedGraphs.insert(&graph).second) {
+            std::lock_guard<std::mutex> lock(graph._waitMutex);
+            next.insert(next.end(), graph._completionDependants.begin(), graph._completionDependants.end());
+        }
+        for (auto& dependant : next) {
+            if (dependant.graph->graph) {
+                stack.push_back({dependant.graph->graph, dependant.node});
+            }
+        }
+    }
+    return false;
+}
+
+void WorkGraph::onGraphDrained() {
+    std::vector<ExternalDependant> waiters;
+    {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+        _waitCondition.notify_all();
+        if (_executionStarted.load()) {
+            waiters.swap(_completionDependants);
+        }
+    }
+    FiberWorker::notifyResumable();   // wait() on a fiber
+    
+    notifyExternalDependants(waiters, NodeState::Completed);
 }
 
 Core::EventBus* WorkGraph::getEventBus() {
@@ -881,6 +1752,50 @@ WorkGraphStats::Snapshot WorkGraph::getStats() const {
     return stats.toSnapshot();
 }
 
+ExecutionTrace WorkGraph::getExecutionTrace() const {
+    if (!_config.enableTiming) {
+        throw std::logic_error("WorkGraph::getExecutionTrace() requires WorkGraphConfig::enableTiming");
+    }
+
+    std::shared_lock<std::shared_mutex> lock(_graphMutex);
+
+    // Graph slot index -> trace index, for nodes that finished a run
+    constexpr uint32_t NOT_TRACED = ~uint32_t(0);
+    std::vector<uint32_t> traceIndex;
+    ExecutionTrace trace;
+    trace.nodes.reserve(_nodeHandles.size());
+    for (const auto& handle : _nodeHandles) {
+        const auto* nodeData = isHandleValid(handle) ? handle.getData() : nullptr;
+        if (!nodeData || nodeData->timing.startNs == 0 || nodeData->timing.endNs == 0) {
+            continue;
+        }
+        if (handle.getIndex() >= traceIndex.size()) {
+            traceIndex.resize(handle.getIndex() + 1, NOT_TRACED);
+        }
+        traceIndex[handle.getIndex()] = static_cast<uint32_t>(trace.nodes.size());
+
+        ExecutionTrace::Node node;
+        node.name = nodeData->name;
+        node.handle = handle;
+        node.timing = nodeData->timing;
+        trace.nodes.push_back(std::move(node));
+    }
+
+    for (auto& node : trace.nodes) {
+        for (const auto& child : _graph.getChildren(node.handle)) {
+            if (child.getIndex() < traceIndex.size() && traceIndex[child.getIndex()] != NOT_TRACED) {
+                node.successors.push_back(traceIndex[child.getIndex()]);
+            }
+        }
+    }
+
+    return trace;
+}
+
+WorkGraphReport WorkGraph::analyzeExecution(const WorkGraphReport::Options& options) const {
+    return WorkGraphReport::analyze(getExecutionTrace(), options);
+}
+
 } // namespace Concurrency
 } // namespace Core
 } // namespace EntropyEngine
\ No newline at end of file
@@ -28,12 +28,18 @@
 #include <condition_variable>
 #include <variant>
 #include <optional>
+#include <type_traits>
+#include <unordered_map>
 #include "WorkContractGroup.h"
 #include "WorkContractHandle.h"
 #include "../Graph/DirectedAcyclicGraph.h"
 #include "../Graph/AcyclicNodeHandle.h"
 #include "../Debug/Debug.h"
 #include "WorkGraphTypes.h"
+#include "NodeOutputArena.h"
+#include "WorkGraphTemplate.h"
+#include "WorkGraphReport.h"
+#include "FiberWorker.h"
 #include "../Core/EventBus.h"
 #include <memory>
 
@@ -44,6 +50,26 @@ namespace Concurrency {
     // Forward declarations
     class NodeStateManager;
     class NodeScheduler;
+    
+    /**
+     * @brief Stand-in other graphs hold instead of a raw WorkGraph pointer
+     * 
+     * Cleared by the graph's destructor under the cross-graph link mutex, so a link
+     * outliving the waiting graph resolves to nothing instead of dangling.
+     */
+    struct ExternalLinkAnchor {
+        WorkGraph* graph = nullptr;                                  ///< Live graph, or null once destroyed
+    };
+
+    /**
+     * @brief A node in some graph that waits on a node (or the completion) of another graph
+     * 
+     * Recorded on the graph being waited on and resolved from its completion path.
+     */
+    struct ExternalDependant {
+        std::shared_ptr<ExternalLinkAnchor> graph;                   ///< Graph owning the waiting node
+        Graph::AcyclicNodeHandle<WorkGraphNode> node;                ///< The waiting node
+    };
 
     /**
      * @brief The atomic unit of work in a dependency graph with self-managing execution timing
@@ -83,8 +109,8 @@ namespace Concurrency {
         /// Atomic state management (replaces completed/cancelled flags)
         std::atomic<NodeState> state{NodeState::Pending};
         
-        /// Work function to execute - now supports both void and WorkResult returns
-        std::variant<std::function<void()>, YieldableWorkFunction> work;
+        /// Work function to execute - void, WorkResult (yieldable) or branch selector
+        std::variant<std::function<void()>, YieldableWorkFunction, BranchWorkFunction> work;
         
         /// Handle to the work contract (when scheduled)
         WorkContractHandle handle;
@@ -95,6 +121,9 @@ namespace Concurrency {
         /// Number of failed parents (for optimized parent checking)
         std::atomic<uint32_t> failedParentCount{0};
         
+        /// Number of resolved incoming edges that were taken (zero at release means skip)
+        std::atomic<uint32_t> takenParentCount{0};
+        
         /// Track if completion has been processed to prevent double processing
         std::atomic<bool> completionProcessed{false};
         
@@ -113,9 +142,39 @@ namespace Concurrency {
         /// Optional maximum reschedule limit
         std::optional<uint32_t> maxReschedules;
         
+        /// Park-until-woken handshake for a yielding node (see WorkGraph::parkRunningNode)
+        enum class YieldPark : uint8_t {
+            None = 0,        ///< Yield reschedules as usual
+            Requested = 1,   ///< The running node asked to be parked on its next yield
+            Woken = 2,       ///< Woken before the yield was processed - reschedule as usual
+            Parked = 3       ///< Yielded and waiting for its wake call
+        };
+        std::atomic<YieldPark> yieldPark{YieldPark::None};
+        
         /// Is this a yieldable node?
         bool isYieldable = false;
         
+        /// Is this a branch node (work returns the selected branch index)?
+        bool isBranch = false;
+        
+        /// Branch index chosen by the last run of a branch node
+        uint32_t selectedBranch = 0;
+        
+        /// Conditional outgoing edges of a branch node: (child node index, branch index)
+        std::vector<std::pair<uint32_t, uint32_t>> branchEdges;
+        
+        /// Nodes in other graphs waiting on this one (guarded by the owning graph's mutex)
+        std::vector<ExternalDependant> externalDependants;
+        
+        /// Subset this node belongs to for suspend(tag)/resume(tag); 0 means untagged
+        std::atomic<uint32_t> suspendTag{0};
+        
+        /// Group this node's contract is created in; nullptr uses the graph's group
+        WorkContractGroup* targetGroup = nullptr;
+        
+        /// Lifecycle timestamps, only written when WorkGraphConfig::enableTiming is set
+        NodeTiming timing;
+        
         WorkGraphNode() = default;
         
         // Constructor for legacy void() work functions
@@ -126,6 +185,10 @@ namespace Concurrency {
         WorkGraphNode(YieldableWorkFunction w, const std::string& n, ExecutionType execType = ExecutionType::AnyThread) 
             : work(std::move(w)), name(n), executionType(execType), isYieldable(true) {}
         
+        // Constructor for branch selector functions
+        WorkGraphNode(BranchWorkFunction w, const std::string& n, ExecutionType execType = ExecutionType::AnyThread)
+            : work(std::move(w)), name(n), executionType(execType), isBranch(true) {}
+        
         // Move constructor
         WorkGraphNode(WorkGraphNode&& other) noexcept
             : state(other.state.load())
@@ -133,13 +196,22 @@ namespace Concurrency {
             , handle(std::move(other.handle))
             , pendingDependencies(other.pendingDependencies.load())
             , failedParentCount(other.failedParentCount.load())
+            , takenParentCount(other.takenParentCount.load())
             , completionProcessed(other.completionProcessed.load())
             , name(std::move(other.name))
             , userData(other.userData)
             , executionType(other.executionType)
             , rescheduleCount(other.rescheduleCount.load())
             , maxReschedules(other.maxReschedules)
-            , isYieldable(other.isYieldable) {
+            , yieldPark(other.yieldPark.load())
+            , isYieldable(other.isYieldable)
+            , isBranch(other.isBranch)
+            , selectedBranch(other.selectedBranch)
+            , branchEdges(std::move(other.branchEdges))
+            , externalDependants(std::move(other.externalDependants))
+            , suspendTag(other.suspendTag.load())
+            , targetGroup(other.targetGroup)
+            , timing(other.timing) {
             other.userData = nullptr;
         }
         
@@ -151,13 +223,22 @@ namespace Concurrency {
                 handle = std::move(other.handle);
                 pendingDependencies.store(other.pendingDependencies.load());
                 failedParentCount.store(other.failedParentCount.load());
+                takenParentCount.store(other.takenParentCount.load());
                 completionProcessed.store(other.completionProcessed.load());
                 name = std::move(other.name);
                 userData = other.userData;
                 executionType = other.executionType;
                 rescheduleCount.store(other.rescheduleCount.load());
                 maxReschedules = other.maxReschedules;
+                yieldPark.store(other.yieldPark.load());
                 isYieldable = other.isYieldable;
+                isBranch = other.isBranch;
+                selectedBranch = other.selectedBranch;
+                branchEdges = std::move(other.branchEdges);
+                externalDependants = std::move(other.externalDependants);
+                suspendTag.store(other.suspendTag.load());
+                targetGroup = other.targetGroup;
+                timing = other.timing;
                 other.userData = nullptr;
             }
             return *this;
@@ -167,6 +248,58 @@ namespace Concurrency {
         WorkGraphNode(const WorkGraphNode&) = delete;
         WorkGraphNode& operator=(const WorkGraphNode&) = delete;
     };
+    
+    /**
+     * @brief Handle to a node that produces a value of type T
+     * 
+     * Returned by the typed WorkGraph::addNode<T>() overloads. Passing it as an input
+     * to another typed node hands that node a `const T&` to the value, which lives in
+     * the graph's output arena. Converts to a plain NodeHandle for everything else
+     * (addDependency, getChildren, ...).
+     * 
+     * @code
+     * auto mesh = graph.addNode<Mesh>([]{ return loadMesh(); }, "load");
+     * auto bounds = graph.addNode<AABB>([](const Mesh& m) { return computeBounds(m); },
+     *                                   "bounds", mesh);
+     * graph.execute();
+     * graph.wait();
+     * const AABB* result = bounds.tryGet();  // Unconsumed outputs stay readable
+     * @endcode
+     */
+    template<typename T>
+    class TypedNodeHandle {
+    public:
+        TypedNodeHandle() = default;
+        
+        /// Untyped handle of the producing node
+        const NodeHandle& node() const noexcept { return _node; }
+        
+        operator NodeHandle() const noexcept { return _node; }
+        
+        bool isValid() const noexcept { return _node.isValid() && _output != nullptr; }
+        
+        /**
+         * @brief Reads the produced value, if it is currently alive
+         * 
+         * @return The value, or nullptr if the producer has not run, threw, or the
+         *         value was already destroyed after its last consumer finished
+         */
+        const T* tryGet() const noexcept {
+            return (_output && _output->isConstructed()) ? static_cast<const T*>(_output->storage) : nullptr;
+        }
+        
+        /// Arena slot backing the value (for WorkGraph internals)
+        NodeOutput* getOutput() const noexcept { return _output; }
+        
+    private:
+        friend class WorkGraph;
+        
+        TypedNodeHandle(NodeHandle node, NodeOutput* output)
+            : _node(node), _output(output) {}
+        
+        NodeHandle _node;                ///< The producing node
+        NodeOutput* _output = nullptr;   ///< Where its value lives
+    };
 
     /**
      * @brief Orchestrates complex parallel workflows with automatic dependency management
@@ -263,7 +396,10 @@ namespace Concurrency {
         
         WorkContractGroup* _workContractGroup;                               ///< External work executor
         
-        WorkContractGroup::CapacityCallback _capacityCallbackIt;             ///< Capacity callback handle
+        
+        /// Admission queue membership, one per group this graph's nodes are routed to
+        std::vector<std::pair<WorkContractGroup*, WorkContractGroup::AdmissionTicket>> _admissionTickets; ///< [0] is _workContractGroup
+        mutable std::mutex _admissionMutex;                                  ///< Guards _admissionTickets
         
         WorkGraphConfig _config;                                              ///< Graph configuration
         
@@ -282,6 +418,8 @@ namespace Concurrency {
         std::atomic<uint32_t> _completedNodes{0};                           ///< Completed node count
         
         std::atomic<uint32_t> _failedNodes{0};                              ///< Failed node count
+        std::atomic<uint32_t> _skippedNodes{0};                             ///< Skipped node count
+        std::atomic<uint32_t> _externalWaits{0};                            ///< Unresolved dependencies on other graphs
         
         /// Cache of valid node handles for efficient access
         std::vector<Graph::AcyclicNodeHandle<WorkGraphNode>> _nodeHandles;  ///< Pre-allocated for performance
@@ -302,12 +440,108 @@ namespace Concurrency {
         /// Condition variable for waiting on active callbacks
         mutable std::condition_variable _shutdownCondition;                 ///< Destructor waits on this
         
-        /// Suspension state - prevents scheduling new nodes
+        /// Nodes in other graphs waiting for this graph to drain (guarded by _waitMutex)
+        std::vector<ExternalDependant> _completionDependants;               ///< Released by onGraphDrained()
+        
+        /// What other graphs' links and parked-node wake functions point at; cleared first thing in the destructor
+        std::shared_ptr<ExternalLinkAnchor> _linkAnchor;                    ///< Never null
+        
+        /// Storage for typed node outputs, created on first typed node (guarded by _graphMutex)
+        std::unique_ptr<NodeOutputArena> _outputArena;                      ///< Freed with the graph
+        
+        /// Suspension state - prevents scheduling new nodes (written under _parkMutex)
         std::atomic<bool> _suspended{false};                                ///< True when graph is suspended
         
+        /// Guards the parked list and the suspended tags
+        mutable std::mutex _parkMutex;                                      ///< Serializes parking against resume
+        
+        /// Ready nodes held back by suspension, keyed by their suspend tag (guarded by _parkMutex)
+        std::unordered_map<uint32_t, std::vector<Graph::AcyclicNodeHandle<WorkGraphNode>>> _parkedReady; ///< Drained by resume()
+        size_t _parkedCount = 0;                                            ///< Total entries in _parkedReady
+        
+        /// Tags currently suspended by suspend(tag) (guarded by _parkMutex)
+        std::vector<uint32_t> _suspendedTags;                               ///< Few entries - linear search
+        std::atomic<uint32_t> _suspendedTagCount{0};                        ///< Lock-free "any tag suspended?" check
+        
+        /**
+         * @brief Thread-local staging area for nodes spawned by a running node
+         * 
+         * Lives on the executing worker's stack for the duration of one node run.
+         * spawn() appends here without touching _graphMutex; the whole batch is
+         * spliced into the DAG under a single exclusive lock when the owner completes.
+         */
+        struct SpawnBuffer {
+            const WorkGraph* graph = nullptr;                                ///< Graph the owner belongs to
+            Graph::AcyclicNodeHandle<WorkGraphNode> owner;                   ///< Node currently executing
+            std::vector<WorkGraphNode> nodes;                                ///< Spawned nodes, in spawn order
+            std::vector<std::pair<uint32_t, uint32_t>> edges;                ///< Edges between spawned nodes (from, to)
+            SpawnBuffer* previous = nullptr;                                 ///< Outer buffer when runs nest on one thread
+        };
+        
+        /// Innermost spawn buffer of the node running on this thread
+        static thread_local SpawnBuffer* stActiveSpawnBuffer;
+        
+        /// Registers stActiveSpawnBuffer with FiberWorker so suspended nodes keep their own buffer
+        static const bool S_SPAWN_BUFFER_FIBER_LOCAL;
+        
+        /**
+         * @brief RAII guard that publishes a SpawnBuffer for one node run
+         * 
+         * Installed by NodeScheduler's work wrapper around the work function and its
+         * completion callback, so spawn() and onNodeComplete() see the same buffer.
+         * Anything still buffered when the scope ends (failure, yield) is discarded.
+         */
+        class SpawnScope {
+        public:
+            SpawnScope(const WorkGraph* graph, Graph::AcyclicNodeHandle<WorkGraphNode> owner) {
+                _buffer.graph = graph;
+                _buffer.owner = owner;
+                _buffer.previous = stActiveSpawnBuffer;
+                stActiveSpawnBuffer = &_buffer;
+            }
+            
+            ~SpawnScope() {
+                stActiveSpawnBuffer = _buffer.previous;
+            }
+            
+            SpawnScope(const SpawnScope&) = delete;
+            SpawnScope& operator=(const SpawnScope&) = delete;
+            
+        private:
+            SpawnBuffer _buffer;
+        };
+        
+        friend class NodeScheduler;
+        
     public:
         using NodeHandle = Graph::AcyclicNodeHandle<WorkGraphNode>;
         
+        /**
+         * @brief Something in this graph that a node of another graph can wait on
+         * 
+         * Obtained from getExternalHandle() or getCompletionHandle() on the graph being
+         * waited on, then passed to addDependency() on the waiting graph.
+         */
+        struct ExternalDependency {
+            WorkGraph* graph = nullptr;   ///< Graph being waited on
+            NodeHandle node;              ///< Node being waited on (invalid for whole-graph completion)
+            
+            bool valid() const noexcept { return graph != nullptr; }
+        };
+        
+        /**
+         * @brief Reference to a node spawned from inside a running node
+         * 
+         * Only meaningful within the node run that created it - it indexes that run's
+         * spawn buffer and is used to wire dependencies between spawned nodes.
+         */
+        struct SpawnHandle {
+            static constexpr uint32_t INVALID_INDEX = ~0u;
+            uint32_t index = INVALID_INDEX;   ///< Position in the owning run's spawn buffer
+            
+            bool valid() const noexcept { return index != INVALID_INDEX; }
+        };
+        
         /**
          * @brief What you get back from wait() - the final score of your graph execution
          * 
@@ -326,10 +560,11 @@ namespace Concurrency {
          * @endcode
          */
         struct WaitResult {
-            bool allCompleted = false;      ///< True only if every single node succeeded
+            bool allCompleted = false;      ///< True if no node failed or was dropped (skipped is fine)
             uint32_t droppedCount = 0;      ///< Nodes we couldn't schedule (queue overflow)
             uint32_t failedCount = 0;       ///< Nodes that threw exceptions
             uint32_t completedCount = 0;    ///< Nodes that ran successfully
+            uint32_t skippedCount = 0;      ///< Nodes on branches that weren't taken
         };
         
         /**
@@ -425,7 +660,8 @@ namespace Concurrency {
                                    const std::string& name = "",
                                    void* userData = nullptr,
                                    ExecutionType executionType = ExecutionType::AnyThread,
-                                   std::optional<uint32_t> maxReschedules = std::nullopt);
+                                   std::optional<uint32_t> maxReschedules = std::nullopt,
+                                   WorkContractGroup* targetGroup = nullptr);
         
         /**
          * @brief Adds a task to your workflow - it won't run until its time comes
@@ -438,6 +674,7 @@ namespace Concurrency {
          * @param name Human-readable name for debugging
          * @param userData Your own context pointer
          * @param executionType Where to run: AnyThread (worker pool) or MainThread
+         * @param targetGroup Group to run in instead of the graph's (nullptr = graph's group)
          * @return Handle to reference this node
          * 
          * @code
@@ -464,12 +701,19 @@ namespace Concurrency {
          *     "processor", 
          *     context  // Attach as user data
          * );
+         * 
+         * // Latency-sensitive step on its own group, fed by bulk work on the graph's
+         * auto decode = graph.addNode([]{ decodeBatch(); }, "decode");
+         * auto present = graph.addNode([]{ presentFrame(); }, "present", nullptr,
+         *                              ExecutionType::AnyThread, &interactiveGroup);
+         * graph.addDependency(decode, present);
          * @endcode
          */
         NodeHandle addNode(std::function<void()> work, 
                           const std::string& name = "",
                           void* userData = nullptr,
-                          ExecutionType executionType = ExecutionType::AnyThread);
+                          ExecutionType executionType = ExecutionType::AnyThread,
+                          WorkContractGroup* targetGroup = nullptr);
         
         /**
          * @brief Wire up your workflow - tell nodes who they're waiting for
@@ -508,6 +752,208 @@ namespace Concurrency {
          */
         void addDependency(NodeHandle from, NodeHandle to);
         
+        /**
+         * @brief Adds a node whose return value decides which outgoing branch runs
+         * 
+         * The selector runs like any other node and returns a branch index. Edges added
+         * with addBranchDependency() whose index differs are not taken; edges added with
+         * plain addDependency() are always taken. A node whose incoming edges are all
+         * untaken (directly or because their source was skipped) is marked Skipped
+         * without ever getting a work contract - the skip pass runs inline on the
+         * thread that finished the branch and is linear in the size of the skipped region.
+         * 
+         * A node reached by at least one taken edge still runs, so a join after an
+         * if/else runs once whichever side was picked.
+         * 
+         * @param selector Function returning the index of the branch to take
+         * @param name Debug name for the node
+         * @param userData Optional context pointer
+         * @param executionType Where the selector should run
+         * @return Handle to the new branch node
+         * 
+         * @code
+         * auto classify = graph.addBranchNode([&]() -> uint32_t {
+         *     return frame.needsShadows ? 0 : 1;
+         * }, "classify");
+         * auto shadows = graph.addNode([]{ renderShadows(); }, "shadows");
+         * auto cheapLight = graph.addNode([]{ ambientOnly(); }, "ambient");
+         * auto compose = graph.addNode([]{ compose(); }, "compose");
+         * graph.addBranchDependency(classify, shadows, 0);
+         * graph.addBranchDependency(classify, cheapLight, 1);
+         * graph.addDependency(shadows, compose);
+         * graph.addDependency(cheapLight, compose);  // Runs after whichever side ran
+         * @endcode
+         */
+        NodeHandle addBranchNode(BranchWorkFunction selector,
+                                 const std::string& name = "",
+                                 void* userData = nullptr,
+                                 ExecutionType executionType = ExecutionType::AnyThread);
+        
+        /**
+         * @brief Adds an edge from a branch node that is only taken for one branch index
+         * 
+         * Several edges may share an index to fan out a branch. Otherwise behaves like
+         * addDependency(): `to` waits for `branch`, and cycles are rejected.
+         * 
+         * @param branch A node created with addBranchNode()
+         * @param to The node gated by this branch
+         * @param branchIndex Selector value that takes this edge
+         * @throws std::invalid_argument If `branch` is not a branch node or the edge would create a cycle
+         */
+        void addBranchDependency(NodeHandle branch, NodeHandle to, uint32_t branchIndex);
+        
+        /**
+         * @brief Exports one of this graph's nodes so another graph can depend on it
+         * 
+         * @param node The node other graphs will wait on
+         * @return Handle to pass to the waiting graph's addDependency()
+         * @throws std::invalid_argument If the node handle is invalid
+         */
+        ExternalDependency getExternalHandle(NodeHandle node);
+        
+        /**
+         * @brief Exports this graph's completion so another graph can depend on it
+         * 
+         * Resolves the first time the graph drains after execute(), regardless of how
+         * many of its nodes failed.
+         * 
+         * @return Handle to pass to the waiting graph's addDependency()
+         */
+        ExternalDependency getCompletionHandle() { return ExternalDependency{this, NodeHandle()}; }
+        
+        /**
+         * @brief Makes a node of this graph wait on a node or completion of another graph
+         * 
+         * Lets subsystems that own separate graphs order just the parts that interact
+         * instead of wait()-ing on one whole graph before executing the next. The
+         * external edge is resolved through the same dependency counter as local edges:
+         * a completed source releases `to`, a skipped source counts as an untaken edge,
+         * and a failed or cancelled source cancels `to`. The other graph must be alive
+         * when the dependency is added. If it is destroyed before the dependency
+         * resolves, `to` is cancelled; if this graph goes first, the link is dropped.
+         * 
+         * @param from Handle from the other graph's getExternalHandle() or getCompletionHandle()
+         * @param to Node in this graph that waits
+         * @throws std::invalid_argument If a handle is invalid, `from` is this graph's own
+         *         completion, or `from` already waits on `to` through any chain of graphs
+         * @throws std::runtime_error If `to` has already left the Pending state
+         * 
+         * @code
+         * WorkGraph physics(&group), render(&group);
+         * auto integrate = physics.addNode([]{ integrate(); }, "integrate");
+         * auto cull = render.addNode([]{ cullScene(); }, "cull");      // Independent
+         * auto draw = render.addNode([]{ drawScene(); }, "draw");
+         * render.addDependency(cull, draw);
+         * render.addDependency(physics.getExternalHandle(integrate), draw);
+         * physics.execute();
+         * render.execute();   // cull overlaps with physics, draw waits for integrate
+         * @endcode
+         */
+        void addDependency(const ExternalDependency& from, NodeHandle to);
+        
+        /**
+         * @brief Adds a node that produces a typed value from the values of its inputs
+         * 
+         * The work receives `const Inputs&...` - references straight into the arena
+         * slots of the input nodes, no copies and no locks - and returns a T that is
+         * constructed in place in this node's own slot. Dependencies on the inputs are
+         * added automatically. Once every typed consumer of a value has run, the value
+         * is destroyed; values with no consumers live until the graph is destroyed and
+         * can be read with TypedNodeHandle::tryGet().
+         * 
+         * Inputs must not have failed, been cancelled or skipped, or already been
+         * released by their consumers. If an input turns out not to be produced at run
+         * time (e.g. an untaken branch), the node fails and its dependants are cancelled.
+         * 
+         * @tparam T Type of the produced value
+         * @param work Callable `T(const Inputs&...)`
+         * @param name Debug name for the node
+         * @param inputs Typed nodes whose values are passed to work, in order
+         * @return Typed handle to the new node
+         * @throws std::invalid_argument If an input handle is invalid
+         * @throws std::runtime_error If an input can no longer be consumed
+         * 
+         * @code
+         * auto a = graph.addNode<int>([]{ return 20; }, "a");
+         * auto b = graph.addNode<int>([]{ return 22; }, "b");
+         * auto sum = graph.addNode<int>([](const int& x, const int& y) { return x + y; },
+         *                               "sum", a, b);
+         * @endcode
+         */
+        template<typename T, typename Fn, typename... Inputs>
+        TypedNodeHandle<T> addNode(Fn work, const std::string& name, TypedNodeHandle<Inputs>... inputs) {
+            static_assert(!std::is_void_v<T> && !std::is_reference_v<T>,
+                          "Typed nodes must produce an object type");
+            static_assert(std::is_invocable_r_v<T, Fn&, const Inputs&...>,
+                          "Typed node work must be callable with const references to its inputs and return T");
+            
+            NodeOutput* output = allocateOutput(sizeof(T), alignof(T),
+                                                +[](void* value) { static_cast<T*>(value)->~T(); });
+            
+            auto node = addNodeAfter([work = std::move(work), output, ...in = inputs.getOutput()]() mutable {
+                if (!(true && ... && in->isConstructed())) {
+                    (in->release(), ...);
+                    throw std::runtime_error("Typed node input was never produced");
+                }
+                try {
+                    ::new (output->storage) T(std::invoke(work, *static_cast<const Inputs*>(in->storage)...));
+                } catch (...) {
+                    (in->release(), ...);
+                    throw;
+                }
+                output->publish();
+                (in->release(), ...);
+            }, name, {inputs.node()...}, {inputs.getOutput()...});
+            
+            return TypedNodeHandle<T>(node, output);
+        }
+        
+        /**
+         * @brief Adds a typed source node with no inputs and no name
+         * 
+         * @tparam T Type of the produced value
+         * @param work Callable returning T
+         * @return Typed handle to the new node
+         */
+        template<typename T, typename Fn>
+        TypedNodeHandle<T> addNode(Fn work) {
+            return addNode<T>(std::move(work), std::string());
+        }
+        
+        /**
+         * @brief Stamps out one copy of a prebuilt template into this graph
+         * 
+         * The template was validated and topologically sorted when it was finalized, so
+         * this is a straight copy: nodes are appended in template order with their
+         * dependency counts preset from the template's in-degree array, and each node's
+         * fan-out is appended in one go. No cycle checks, no per-edge locking - O(nodes
+         * + edges) under a single lock. Safe to call while the graph is executing, even
+         * from inside one of its nodes: node storage never relocates, so nodes already
+         * running keep their data in place. The instance's roots are scheduled
+         * immediately in that case.
+         * 
+         * @param graphTemplate Finalized template (must outlive this graph's execution)
+         * @param context Pointer passed to every node kernel of this instance
+         * @param userData User data attached to every node of this instance
+         * @return Handles of the new nodes, indexed by the template's NodeIds
+         * @throws std::logic_error If the template has not been finalized
+         * 
+         * @code
+         * WorkGraphTemplate tmpl;
+         * auto load = tmpl.addNode([](void* ctx) { load(static_cast<Asset*>(ctx)); }, "load");
+         * auto decode = tmpl.addNode([](void* ctx) { decode(static_cast<Asset*>(ctx)); }, "decode");
+         * tmpl.addDependency(load, decode);
+         * tmpl.finalize();
+         * 
+         * for (auto& asset : assets) {
+         *     auto nodes = graph.instantiate(tmpl, &asset);
+         *     graph.addDependency(nodes[decode], uploadAll);  // Instances wire up like any node
+         * }
+         * @endcode
+         */
+        std::vector<NodeHandle> instantiate(const WorkGraphTemplate& graphTemplate, void* context = nullptr,
+                                            void* userData = nullptr);
+        
         /**
          * @brief Kicks off your workflow by scheduling all nodes that have no dependencies
          * 
@@ -568,9 +1014,10 @@ namespace Concurrency {
         /**
          * @brief Resumes graph execution after suspension
          * 
-         * Allows scheduling to continue. Any nodes that became ready while
-         * suspended will be scheduled. Yielded nodes waiting to reschedule
-         * will also continue.
+         * Allows scheduling to continue. Nodes that became ready while suspended
+         * were parked as they did, so only those are visited - cost is proportional
+         * to the parked nodes, not the graph. Yielded nodes waiting to reschedule
+         * will also continue. Nodes whose tag is still suspended stay parked.
          * 
          * Thread-safe. Safe to call even if not suspended.
          * 
@@ -591,6 +1038,74 @@ namespace Concurrency {
          */
         bool isSuspended() const noexcept { return _suspended.load(std::memory_order_acquire); }
         
+        /**
+         * @brief Assigns a node to a subset that can be suspended on its own
+         * 
+         * Set the tag before the node can become ready; a node that is already
+         * scheduled is not pulled back.
+         * 
+         * @param node Node to tag
+         * @param tag Subset id, 0 to clear
+         * @throws std::invalid_argument if the handle is invalid
+         */
+        void setSuspendTag(NodeHandle node, uint32_t tag);
+        
+        /**
+         * @brief Suspends only the nodes carrying a tag
+         * 
+         * Tagged nodes that become ready are parked; the rest of the graph keeps
+         * running. Thread-safe. Tag 0 (untagged) is ignored.
+         * 
+         * @code
+         * graph.setSuspendTag(upload, STREAMING);
+         * graph.setSuspendTag(decompress, STREAMING);
+         * graph.suspend(STREAMING);   // Stop streaming work while loading a level
+         * // ...
+         * graph.resume(STREAMING);    // Parked streaming nodes are scheduled
+         * @endcode
+         * 
+         * @param tag Subset to hold back
+         */
+        void suspend(uint32_t tag);
+        
+        /**
+         * @brief Lifts a tag suspension and schedules that tag's parked nodes
+         * 
+         * If the whole graph is still suspended the nodes stay parked until resume().
+         * Thread-safe. Safe to call for a tag that is not suspended.
+         * 
+         * @param tag Subset to release
+         */
+        void resume(uint32_t tag);
+        
+        /**
+         * @brief Checks if a tag is currently suspended
+         * @param tag Subset to check
+         * @return true if suspend(tag) was called and resume(tag) hasn't been called yet
+         */
+        bool isSuspended(uint32_t tag) const;
+        
+        /**
+         * @brief Number of ready nodes waiting for a resume
+         * @return Nodes parked by graph-wide or tag suspension
+         */
+        size_t getParkedCount() const;
+        
+        /**
+         * @brief Routes a node to a different WorkContractGroup
+         * 
+         * The node then uses that group's capacity and whatever scheduling weight the
+         * WorkService gives it; dependencies across groups resolve as usual. For node
+         * kinds whose add call has no targetGroup parameter. Set it before the node can
+         * become ready. The group must be serviced (e.g. added to a WorkService) and
+         * must outlive the graph.
+         * 
+         * @param node Node to route
+         * @param group Target group, nullptr for the graph's group
+         * @throws std::invalid_argument if the handle is invalid
+         */
+        void setTargetGroup(NodeHandle node, WorkContractGroup* group);
+        
         /**
          * @brief Blocks until your entire workflow finishes - success or failure
          * 
@@ -644,8 +1159,8 @@ namespace Concurrency {
         /**
          * @brief Manually drain the deferred queue when capacity becomes available
          * 
-         * Schedules deferred nodes when capacity frees up. Usually automatic via
-         * callbacks.
+         * Schedules deferred nodes when capacity frees up. Usually automatic: the
+         * graph takes a turn in the contract group's admission queue.
          * 
          * @return How many deferred nodes were successfully scheduled
          * 
@@ -704,7 +1219,41 @@ namespace Concurrency {
          * @endcode
          */
         WorkGraphStats::Snapshot getStats() const;
-        
+
+        /**
+         * @brief Timestamps and edges of every node that ran, for offline analysis
+         *
+         * Call after wait(). Nodes still in flight have no end stamp and are left out.
+         *
+         * @return Trace in node creation order
+         * @throws std::logic_error If the graph was not created with enableTiming
+         */
+        ExecutionTrace getExecutionTrace() const;
+
+        /**
+         * @brief Why did the run take as long as it did?
+         *
+         * Critical path, available vs achieved parallelism over time, idle worker-time
+         * split into dependency vs capacity-deferral causes, and the nodes whose wait
+         * cost the most beyond their slack. See WorkGraphReport.
+         *
+         * @param options Worker count and report sizes
+         * @return Structured report
+         * @throws std::logic_error If the graph was not created with enableTiming
+         *
+         * @code
+         * WorkGraphConfig config;
+         * config.enableTiming = true;
+         * WorkGraph graph(&group, config);
+         * // ... build, execute(), wait()
+         * auto report = graph.analyzeExecution();
+         * if (report.idle.deferral > report.idle.dependency) {
+         *     // Contract group too small for this graph's fan-out
+         * }
+         * @endcode
+         */
+        WorkGraphReport analyzeExecution(const WorkGraphReport::Options& options = {}) const;
+
         /**
          * @brief Access the configuration this graph was created with
          * @return The config struct passed to constructor (or defaults)
@@ -812,7 +1361,118 @@ namespace Concurrency {
             return _graph.getChildren(node);
         }
         
+        /**
+         * @brief Emits a child node from inside a running node of this graph
+         * 
+         * For work discovered at runtime (spatial subdivision, recursive splits). The
+         * node lands in a buffer owned by the calling worker - no graph lock is taken.
+         * When the running node completes, the whole subgraph is spliced in at once:
+         * spawned roots hang off the running node, and the running node's existing
+         * dependants additionally wait on every spawned sink. If the running node
+         * fails or yields, its spawned nodes are discarded.
+         * 
+         * @param work Function to execute
+         * @param name Debug name for the spawned node
+         * @param userData Optional context pointer
+         * @param executionType Where the spawned node should run
+         * @return Handle for wiring with spawnDependency() during this run
+         * @throws std::runtime_error If the calling thread is not running a node of this graph
+         * 
+         * @code
+         * auto split = graph.addNode([&graph, region]() {
+         *     if (region.size() <= LEAF_SIZE) { process(region); return; }
+         *     auto left = graph.spawn([=]{ process(region.left()); }, "left");
+         *     auto right = graph.spawn([=]{ process(region.right()); }, "right");
+         *     auto merge = graph.spawn([=]{ mergeHalves(region); }, "merge");
+         *     graph.spawnDependency(left, merge);
+         *     graph.spawnDependency(right, merge);
+         * }, "split");
+         * auto consume = graph.addNode([]{ useResult(); }, "consume");
+         * graph.addDependency(split, consume);  // Also waits on "merge"
+         * @endcode
+         */
+        SpawnHandle spawn(std::function<void()> work,
+                          const std::string& name = "",
+                          void* userData = nullptr,
+                          ExecutionType executionType = ExecutionType::AnyThread);
+        
+        /**
+         * @brief Makes one spawned node wait for another
+         * 
+         * Both handles must come from the current node run, and `from` must have been
+         * spawned before `to`. Spawn order therefore is a topological order, which keeps
+         * the splice cycle-free without a graph search.
+         * 
+         * @param from Spawned node that must finish first
+         * @param to Spawned node that waits
+         * @throws std::runtime_error If not called from inside a running node of this graph
+         * @throws std::invalid_argument If a handle is invalid or `from` was not spawned before `to`
+         */
+        void spawnDependency(SpawnHandle from, SpawnHandle to);
+        
+        /**
+         * @brief Checks whether spawn() is usable on the calling thread
+         * 
+         * @return true if this thread is currently running a node of this graph
+         */
+        bool canSpawn() const noexcept {
+            return activeSpawnBuffer() != nullptr;
+        }
+        
+        /**
+         * @brief Holds the running yieldable node back from rescheduling until woken
+         * 
+         * Call from inside a yieldable node just before it returns WorkResult::Yield.
+         * Instead of going straight back to its group, the node waits in Yielded state
+         * and uses no worker time until the returned function is called. The wake call
+         * reschedules it through the normal path - including the admission queue if the
+         * group is full - from whichever thread makes it. Waking before the yield has
+         * been processed is fine; the node is then rescheduled as usual.
+         * 
+         * Works for the innermost node running on the calling thread, whatever graph it
+         * belongs to, so I/O and other services can park their callers without knowing
+         * the graph.
+         * 
+         * @return Wake function; call it once. It is a no-op once the graph is destroyed.
+         * @throws std::runtime_error If no yieldable node is running on the calling thread
+         * 
+         * @code
+         * graph.addYieldableNode([&]() -> WorkResult {
+         *     if (!request) {
+         *         request = service.start(WorkGraph::parkRunningNode());
+         *         return WorkResult::Yield;   // Resumes when the service calls the wake function
+         *     }
+         *     consume(request->result());
+         *     return WorkResult::Complete;
+         * });
+         * @endcode
+         */
+        static std::function<void()> parkRunningNode();
+        
     private:
+        /**
+         * @brief Finds the spawn buffer of this graph's node running on this thread
+         * 
+         * @return The buffer, or nullptr if the innermost running node is not ours
+         */
+        SpawnBuffer* activeSpawnBuffer() const noexcept {
+            SpawnBuffer* buffer = stActiveSpawnBuffer;
+            return (buffer && buffer->graph == this) ? buffer : nullptr;
+        }
+        
+        /**
+         * @brief Moves a completed node's spawned subgraph into the DAG
+         * 
+         * One exclusive lock for the whole batch. Adds the nodes, wires their internal
+         * edges, hangs spawned roots off the owner and makes the owner's existing
+         * dependants wait on spawned sinks. Must run before the owner's own dependants
+         * are released and before it leaves the pending count.
+         * 
+         * @param owner The node that spawned the subgraph
+         * @param buffer Its spawn buffer (emptied by this call)
+         */
+        void spliceSpawnedSubgraph(NodeHandle owner, SpawnBuffer& buffer);
+        
         /**
          * @brief The domino effect handler - when one task finishes, what happens next?
          * 
@@ -866,6 +1526,109 @@ namespace Concurrency {
          */
         void cancelDependents(NodeHandle failedNode);
         
+        /**
+         * @brief Resolves one incoming edge of a dependant
+         * 
+         * Records whether the edge was taken and drops the dependency count. When the
+         * last dependency resolves, the dependant is scheduled if any taken edge reached
+         * it, or queued on `toSkip` otherwise.
+         * 
+         * @param child The dependant whose edge resolved
+         * @param taken Whether the edge carries execution (false for untaken branches and skipped parents)
+         * @param toSkip Worklist for skipSubtrees()
+         */
+        void releaseDependant(NodeHandle child, bool taken, std::vector<NodeHandle>& toSkip);
+        
+        /**
+         * @brief Resolves a dependency this graph's node has on another graph
+         * 
+         * Called by the source graph from its completion path.
+         * 
+         * @param node The waiting node in this graph
+         * @param outcome Terminal state of the source (Completed for graph completion)
+         */
+        void resolveExternalDependency(NodeHandle node, NodeState outcome);
+        
+        /**
+         * @brief Hands a terminal node's outcome to dependants in other graphs
+         * 
+         * @param dependants Waiters detached from the node under _graphMutex
+         * @param outcome The node's terminal state
+         */
+        void notifyExternalDependants(const std::vector<ExternalDependant>& dependants, NodeState outcome);
+        
+        /**
+         * @brief Detaches a terminal node's dependants in other graphs
+         * 
+         * Takes _graphMutex exclusively: addDependency() appends under it, and two
+         * completion paths may reach the same node. Only call once the list was seen
+         * non-empty under the shared lock - the node is terminal, so it cannot refill.
+         */
+        std::vector<ExternalDependant> takeExternalDependants(WorkGraphNode* nodeData);
+        
+        /**
+         * @brief Whether `to` in this graph already reaches `from` through local and cross-graph edges
+         * 
+         * Caller holds crossGraphLinkMutex(), which keeps every anchored graph alive and
+         * the cross-graph edges still. A completion handle is reached through any of its
+         * graph's nodes.
+         */
+        bool wouldCreateExternalCycle(const ExternalDependency& from, NodeHandle to);
+        
+        /// Serializes cross-graph link changes and anchor teardown
+        static std::mutex& crossGraphLinkMutex();
+        
+        /**
+         * @brief Called when the pending count reaches zero
+         * 
+         * Wakes wait() and releases graphs depending on this graph's completion.
+         */
+        void onGraphDrained();
+        
+        /**
+         * @brief Reserves an arena slot for a typed node's value
+         * 
+         * @param size sizeof the output type
+         * @param alignment alignof the output type
+         * @param destroy Destructor thunk for the output type
+         * @return The new output slot
+         */
+        NodeOutput* allocateOutput(size_t size, size_t alignment, void (*destroy)(void*));
+        
+        /**
+         * @brief Adds a node and its incoming edges under one lock
+         * 
+         * Unlike addNode() followed by addDependency(), the node can never be scheduled
+         * before its edges exist. Parents that already completed are counted as satisfied
+         * rather than wired, since they will never signal again.
+         * 
+         * Typed nodes pass the output slots they read as `inputs`. The node is registered
+         * as a consumer of each only once it is committed, so a rejected node leaves the
+         * consumer counts untouched.
+         * 
+         * @param work Function to execute
+         * @param name Debug name for the node
+         * @param parents Nodes that must complete first
+         * @param inputs Output slots the node consumes
+         * @return Handle to the new node
+         * @throws std::invalid_argument If a parent or input handle is invalid
+         * @throws std::runtime_error If a parent failed, was cancelled or skipped, or an
+         *         input was already released by its consumers
+         */
+        NodeHandle addNodeAfter(std::function<void()> work, const std::string& name,
+                                const std::vector<NodeHandle>& parents,
+                                std::initializer_list<NodeOutput*> inputs = {});
+        
+        /**
+         * @brief Marks nodes Skipped and resolves their outgoing edges as untaken
+         * 
+         * Iterative worklist pass - no contracts, no workers. Dependants that still get
+         * a taken edge elsewhere are scheduled normally.
+         * 
+         * @param toSkip Nodes whose dependencies all resolved untaken (consumed)
+         */
+        void skipSubtrees(std::vector<NodeHandle>& toSkip);
+        
         /**
          * @brief Handles the bookkeeping when a node gets cancelled
          * 
@@ -906,6 +1669,41 @@ namespace Concurrency {
          */
         void rescheduleYieldedNode(NodeHandle node);
         
+        /// Wake side of parkRunningNode(); reschedules the node if its yield already parked it
+        void wakeParkedNode(NodeHandle node);
+        
+        /**
+         * @brief Parks a Ready node if the graph or its tag is suspended
+         * 
+         * Lock-free when nothing is suspended. The check is repeated under _parkMutex,
+         * which suspend and resume also hold, so a node cannot be parked after the
+         * resume that should have released it.
+         * 
+         * @param node Node in Ready state
+         * @return true if the node was parked
+         */
+        bool parkIfSuspended(NodeHandle node);
+        
+        /**
+         * @brief Moves a Ready node to Scheduled and hands it to the scheduler, or parks it
+         * 
+         * @param node Node in Ready state
+         * @return true if the node was scheduled, deferred or parked
+         */
+        bool dispatchReady(NodeHandle node);
+        
+        /// Schedules nodes taken off the parked list (skips any no longer Ready)
+        void scheduleParked(const std::vector<NodeHandle>& nodes);
+        
+        /// Whether suspend(tag) is in effect; caller holds _parkMutex
+        bool isTagSuspendedLocked(uint32_t tag) const;
+        
+        /// Adds a built node as Pending and dispatches it if execution already started; caller holds _graphMutex
+        NodeHandle insertNode(WorkGraphNode&& node);
+        
+        /// Joins a group's admission queue the first time a node is routed to it
+        void ensureAdmission(WorkContractGroup* group);
+        
     };
 
 } // namespace Concurrency
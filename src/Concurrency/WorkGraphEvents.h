@@ -217,6 +217,25 @@ struct NodeCancelledEvent : WorkGraphEvent {
         : WorkGraphEvent(g), node(n), failedParent(parent) {}
 };
 
+/**
+ * @brief A node was skipped because no branch leading to it was taken
+ * 
+ * Fired during the skip pass that follows a branch node's decision. Skipped nodes
+ * never get a work contract, so this is the only trace they leave.
+ * 
+ * @code
+ * eventBus->subscribe<NodeSkippedEvent>([](const auto& event) {
+ *     LOG_DEBUG("Optional stage {} skipped this frame", event.node.getData()->name);
+ * });
+ * @endcode
+ */
+struct NodeSkippedEvent : WorkGraphEvent {
+    NodeHandle node;              ///< The skipped node
+    
+    NodeSkippedEvent(const WorkGraph* g, NodeHandle n)
+        : WorkGraphEvent(g), node(n) {}
+};
+
 /**
  * @brief All dependencies satisfied - this node is ready to rock!
  * 
@@ -0,0 +1,270 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "WorkGraphReport.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+namespace {
+    /// Level change of the running/queued/deferred counts at one instant
+    struct Event {
+        int64_t time;
+        double running;
+        double queued;
+        double deferred;
+    };
+
+    /// Stretch of time over which the counts are constant
+    struct Segment {
+        int64_t begin;
+        int64_t end;
+        double running;
+        double queued;
+        double deferred;
+    };
+
+    std::chrono::nanoseconds toNanoseconds(double ns) {
+        return std::chrono::nanoseconds(std::llround(ns));
+    }
+}
+
+WorkGraphReport WorkGraphReport::analyze(const ExecutionTrace& trace, const Options& options) {
+    WorkGraphReport report;
+    const size_t n = trace.nodes.size();
+    report.nodeCount = n;
+    if (n == 0) {
+        return report;
+    }
+
+    // Normalize timestamps: missing ready/scheduled stamps collapse onto the next stage
+    std::vector<int64_t> ready(n), scheduled(n), duration(n);
+    std::vector<double> runWeight(n);
+    std::vector<uint32_t> inDegree(n, 0);
+    int64_t origin = INT64_MAX;
+    int64_t finish = INT64_MIN;
+    for (size_t i = 0; i < n; ++i) {
+        const auto& node = trace.nodes[i];
+        const auto& timing = node.timing;
+        if (timing.startNs == 0 || timing.endNs < timing.startNs) {
+            throw std::invalid_argument("WorkGraphReport: node '" + node.name + "' has no complete run");
+        }
+        ready[i] = timing.readyNs != 0 ? std::min(timing.readyNs, timing.startNs) : timing.startNs;
+        scheduled[i] = timing.scheduledNs != 0 ? std::clamp(timing.scheduledNs, ready[i], timing.startNs) : ready[i];
+
+        // Yielded nodes are off-worker between runs; spread their busy time over the span
+        int64_t span = timing.endNs - timing.startNs;
+        duration[i] = timing.busyNs > 0 ? std::min(timing.busyNs, span) : span;
+        runWeight[i] = span > 0 ? double(duration[i]) / double(span) : 0.0;
+
+        origin = std::min(origin, ready[i]);
+        finish = std::max(finish, timing.endNs);
+        report.totalWork += std::chrono::nanoseconds(duration[i]);
+
+        for (uint32_t successor : node.successors) {
+            if (successor >= n || successor == i) {
+                throw std::invalid_argument("WorkGraphReport: node '" + node.name + "' has an invalid successor");
+            }
+            inDegree[successor]++;
+        }
+    }
+    report.wallTime = std::chrono::nanoseconds(finish - origin);
+
+    // Topological order (Kahn), which also rejects cycles
+    std::vector<uint32_t> order;
+    order.reserve(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        if (inDegree[i] == 0) {
+            order.push_back(i);
+        }
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (uint32_t successor : trace.nodes[order[head]].successors) {
+            if (--inDegree[successor] == 0) {
+                order.push_back(successor);
+            }
+        }
+    }
+    if (order.size() != n) {
+        throw std::invalid_argument("WorkGraphReport: trace contains a cycle");
+    }
+
+    // Critical path method on the measured durations
+    std::vector<int64_t> earliestStart(n, 0);
+    std::vector<int64_t> latestStart(n, 0);
+    int64_t criticalPathTime = 0;
+    for (uint32_t i : order) {
+        int64_t earliestFinish = earliestStart[i] + duration[i];
+        criticalPathTime = std::max(criticalPathTime, earliestFinish);
+        for (uint32_t successor : trace.nodes[i].successors) {
+            earliestStart[successor] = std::max(earliestStart[successor], earliestFinish);
+        }
+    }
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        uint32_t i = *it;
+        int64_t latestFinish = criticalPathTime;
+        for (uint32_t successor : trace.nodes[i].successors) {
+            latestFinish = std::min(latestFinish, latestStart[successor]);
+        }
+        latestStart[i] = latestFinish - duration[i];
+    }
+    report.criticalPathTime = std::chrono::nanoseconds(criticalPathTime);
+
+    // Walk back from the last node to finish through the predecessor that gated each step
+    std::vector<std::vector<uint32_t>> predecessors(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        for (uint32_t successor : trace.nodes[i].successors) {
+            predecessors[successor].push_back(i);
+        }
+    }
+    std::vector<bool> critical(n, false);
+    uint32_t current = order.front();
+    for (uint32_t i : order) {
+        if (earliestStart[i] + duration[i] > earliestStart[current] + duration[current]) {
+            current = i;
+        }
+    }
+    while (true) {
+        report.criticalPath.push_back(current);
+        critical[current] = true;
+        bool found = false;
+        for (uint32_t predecessor : predecessors[current]) {
+            if (earliestStart[predecessor] + duration[predecessor] == earliestStart[current]) {
+                current = predecessor;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            break;
+        }
+    }
+    std::reverse(report.criticalPath.begin(), report.criticalPath.end());
+
+    if (criticalPathTime > 0) {
+        report.availableParallelism = double(report.totalWork.count()) / double(criticalPathTime);
+    }
+    if (report.wallTime.count() > 0) {
+        report.achievedParallelism = double(report.totalWork.count()) / double(report.wallTime.count());
+    }
+
+    // Sweep the per-node intervals into stretches of constant running/queued/deferred counts
+    std::vector<Event> events;
+    events.reserve(n * 6);
+    for (size_t i = 0; i < n; ++i) {
+        const auto& timing = trace.nodes[i].timing;
+        events.push_back({ready[i], 0.0, 0.0, 1.0});
+        events.push_back({scheduled[i], 0.0, 1.0, -1.0});
+        events.push_back({timing.startNs, runWeight[i], -1.0, 0.0});
+        events.push_back({timing.endNs, -runWeight[i], 0.0, 0.0});
+    }
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.time < b.time; });
+
+    std::vector<Segment> segments;
+    double running = 0.0, queued = 0.0, deferred = 0.0, peakRunning = 0.0;
+    for (size_t i = 0; i < events.size(); ) {
+        int64_t time = events[i].time;
+        for (; i < events.size() && events[i].time == time; ++i) {
+            running += events[i].running;
+            queued += events[i].queued;
+            deferred += events[i].deferred;
+        }
+        peakRunning = std::max(peakRunning, running);
+        if (i < events.size() && events[i].time > time) {
+            segments.push_back({time, events[i].time, std::max(running, 0.0), std::max(queued, 0.0), std::max(deferred, 0.0)});
+        }
+    }
+
+    report.workerCount = options.workerCount != 0
+        ? options.workerCount
+        : std::max<size_t>(1, size_t(std::ceil(peakRunning - 1e-9)));
+
+    // Charge idle worker-time to the most specific reason that applies
+    double dependencyIdle = 0.0, deferralIdle = 0.0, dispatchIdle = 0.0;
+    for (const auto& segment : segments) {
+        double length = double(segment.end - segment.begin);
+        double idle = std::max(0.0, double(report.workerCount) - segment.running);
+        double byDeferral = std::min(idle, segment.deferred);
+        double byDispatch = std::min(idle - byDeferral, segment.queued);
+        deferralIdle += byDeferral * length;
+        dispatchIdle += byDispatch * length;
+        dependencyIdle += (idle - byDeferral - byDispatch) * length;
+    }
+    report.idle.dependency = toNanoseconds(dependencyIdle);
+    report.idle.deferral = toNanoseconds(deferralIdle);
+    report.idle.dispatch = toNanoseconds(dispatchIdle);
+
+    // Average the counts over equal-width buckets
+    if (options.timelineSamples > 0 && report.wallTime.count() > 0) {
+        size_t samples = options.timelineSamples;
+        double width = double(report.wallTime.count()) / double(samples);
+        report.timeline.resize(samples);
+        for (size_t s = 0; s < samples; ++s) {
+            report.timeline[s].begin = toNanoseconds(double(s) * width);
+        }
+        for (const auto& segment : segments) {
+            double begin = double(segment.begin - origin);
+            double end = double(segment.end - origin);
+            size_t bucket = std::min(samples - 1, size_t(begin / width));
+            for (; bucket < samples && double(bucket) * width < end; ++bucket) {
+                double overlap = std::min(end, double(bucket + 1) * width) - std::max(begin, double(bucket) * width);
+                if (overlap <= 0.0) {
+                    continue;
+                }
+                auto& sample = report.timeline[bucket];
+                sample.running += segment.running * overlap / width;
+                sample.queued += segment.queued * overlap / width;
+                sample.deferred += segment.deferred * overlap / width;
+            }
+        }
+    }
+
+    // Rank nodes by the wait their slack could not absorb
+    std::vector<NodeMetrics> metrics;
+    for (uint32_t i = 0; i < n; ++i) {
+        const auto& timing = trace.nodes[i].timing;
+        int64_t wait = timing.startNs - ready[i];
+        int64_t slack = latestStart[i] - earliestStart[i];
+        int64_t contribution = std::max<int64_t>(0, wait - slack);
+        if (contribution == 0) {
+            continue;
+        }
+        NodeMetrics node;
+        node.node = i;
+        node.name = trace.nodes[i].name;
+        node.earliestStart = std::chrono::nanoseconds(earliestStart[i]);
+        node.duration = std::chrono::nanoseconds(duration[i]);
+        node.wait = std::chrono::nanoseconds(wait);
+        node.deferred = std::chrono::nanoseconds(scheduled[i] - ready[i]);
+        node.slack = std::chrono::nanoseconds(slack);
+        node.slackContribution = std::chrono::nanoseconds(contribution);
+        node.critical = critical[i];
+        metrics.push_back(std::move(node));
+    }
+    size_t keep = std::min(options.topSlackCount, metrics.size());
+    std::partial_sort(metrics.begin(), metrics.begin() + keep, metrics.end(),
+                      [](const NodeMetrics& a, const NodeMetrics& b) {
+                          if (a.slackContribution != b.slackContribution) {
+                              return a.slackContribution > b.slackContribution;
+                          }
+                          return a.wait > b.wait;
+                      });
+    metrics.resize(keep);
+    report.topSlack = std::move(metrics);
+
+    return report;
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
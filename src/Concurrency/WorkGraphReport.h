@@ -0,0 +1,178 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file WorkGraphReport.h
+ * @brief Post-execution analysis of a WorkGraph run: critical path, parallelism and idle time
+ *
+ * WorkGraphStats says how many nodes finished; it cannot say why a run took as long as
+ * it did. With WorkGraphConfig::enableTiming set, every node records when its
+ * dependencies were satisfied, when a contract group accepted it, and when it ran.
+ * WorkGraphReport combines those timestamps with the DAG to answer the usual questions:
+ * how long is the critical path, how much parallelism did the graph offer versus what
+ * the workers achieved, and were idle workers starved by dependencies or by nodes
+ * stuck behind a full contract group.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "WorkGraphTypes.h"
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+    /**
+     * @brief Per-node timestamps recorded when WorkGraphConfig::enableTiming is set
+     *
+     * steady_clock nanoseconds since its epoch; zero means the event never happened.
+     * Each field is written by whichever thread owns the node at that stage, and read
+     * only after the graph has drained.
+     */
+    struct NodeTiming {
+        int64_t readyNs = 0;        ///< All dependencies satisfied
+        int64_t scheduledNs = 0;    ///< First contract accepted; later than readyNs when deferred or parked
+        int64_t startNs = 0;        ///< First run started on a worker
+        int64_t endNs = 0;          ///< Last run finished
+        int64_t busyNs = 0;         ///< Time inside the work function, summed over yields
+        int64_t runStartNs = 0;     ///< Start of the run in progress
+
+        /// Current steady_clock time in the units above
+        static int64_t now() noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    };
+
+    /**
+     * @brief The executed part of a graph, detached from the graph itself
+     *
+     * Only nodes that ran (completed or failed) appear; edges to nodes that were
+     * cancelled or skipped are dropped. WorkGraph::getExecutionTrace() builds one, and
+     * tools can build their own to analyze recorded or synthetic runs.
+     */
+    struct ExecutionTrace {
+        struct Node {
+            std::string name;
+            NodeHandle handle;                  ///< Node in the source graph, if any
+            NodeTiming timing;
+            std::vector<uint32_t> successors;   ///< Indices into nodes
+        };
+
+        std::vector<Node> nodes;
+    };
+
+    /**
+     * @brief Structured result of analyzing one execution
+     *
+     * All node references are indices into the analyzed ExecutionTrace. Times are
+     * measured from the earliest ready (or start) timestamp in the trace.
+     *
+     * - **Critical path**: the longest chain of node durations through the DAG, i.e. the
+     *   makespan with unlimited workers and zero overhead.
+     * - **Parallelism**: available = total work / critical path; achieved = total work /
+     *   wall time.
+     * - **Idle time**: worker-time not spent running nodes, split by what the idle
+     *   workers were waiting for. While deferred nodes (ready but refused by a full
+     *   contract group, or parked by suspend()) exist, idle time is charged to
+     *   capacity deferral; while scheduled contracts sit unclaimed, to dispatch;
+     *   otherwise to dependencies.
+     * - **Slack**: how far a node could have slipped without lengthening the critical
+     *   path. A node's slack contribution is the part of its wait (ready to start) that
+     *   its slack could not absorb - the amount it pushed the run past the ideal.
+     *
+     * @code
+     * WorkGraphConfig config;
+     * config.enableTiming = true;
+     * WorkGraph graph(&group, config);
+     * // ... build, execute(), wait()
+     *
+     * WorkGraphReport::Options options;
+     * options.workerCount = service.getThreadCount();
+     * auto report = graph.analyzeExecution(options);
+     * LOG_INFO("critical path {} of {} wall, parallelism {:.1f} available / {:.1f} achieved",
+     *          report.criticalPathTime, report.wallTime,
+     *          report.availableParallelism, report.achievedParallelism);
+     * for (const auto& node : report.topSlack) {
+     *     LOG_INFO("  {} cost {} beyond its slack", node.name, node.slackContribution);
+     * }
+     * @endcode
+     */
+    struct WorkGraphReport {
+        struct Options {
+            /// Workers the run had available; 0 uses the peak observed concurrency
+            size_t workerCount = 0;
+
+            /// Buckets in the parallelism timeline
+            size_t timelineSamples = 64;
+
+            /// Entries kept in topSlack
+            size_t topSlackCount = 10;
+        };
+
+        struct NodeMetrics {
+            uint32_t node = 0;                          ///< Index into the trace
+            std::string name;
+            std::chrono::nanoseconds earliestStart{0};  ///< Start with unlimited workers
+            std::chrono::nanoseconds duration{0};       ///< Time spent running
+            std::chrono::nanoseconds wait{0};           ///< Ready until first run
+            std::chrono::nanoseconds deferred{0};       ///< Part of wait spent deferred or parked
+            std::chrono::nanoseconds slack{0};          ///< Allowed delay before the critical path grows
+            std::chrono::nanoseconds slackContribution{0};  ///< Wait beyond slack
+            bool critical = false;                      ///< On the critical path
+        };
+
+        /// Averages over one timeline bucket
+        struct Sample {
+            std::chrono::nanoseconds begin{0};
+            double running = 0.0;       ///< Nodes executing (achieved parallelism)
+            double queued = 0.0;        ///< Scheduled, waiting for a worker
+            double deferred = 0.0;      ///< Ready, waiting for contract capacity or resume()
+
+            /// Nodes that could have been running
+            double available() const { return running + queued + deferred; }
+        };
+
+        struct IdleTime {
+            std::chrono::nanoseconds dependency{0};     ///< Nothing was ready
+            std::chrono::nanoseconds deferral{0};       ///< Ready nodes were refused capacity
+            std::chrono::nanoseconds dispatch{0};       ///< Scheduled contracts not yet claimed
+        };
+
+        size_t nodeCount = 0;
+        size_t workerCount = 0;
+
+        std::chrono::nanoseconds wallTime{0};
+        std::chrono::nanoseconds totalWork{0};
+        std::chrono::nanoseconds criticalPathTime{0};
+
+        double availableParallelism = 0.0;
+        double achievedParallelism = 0.0;
+
+        std::vector<uint32_t> criticalPath;     ///< Root to sink
+        IdleTime idle;
+        std::vector<Sample> timeline;
+        std::vector<NodeMetrics> topSlack;      ///< Largest slack contribution first; nodes that cost nothing are omitted
+
+        /**
+         * @brief Analyzes a trace in O((nodes + edges) log nodes)
+         * @throws std::invalid_argument If the trace has unfinished nodes, bad edges or a cycle
+         */
+        static WorkGraphReport analyze(const ExecutionTrace& trace, const Options& options);
+        static WorkGraphReport analyze(const ExecutionTrace& trace) { return analyze(trace, Options{}); }
+    };
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
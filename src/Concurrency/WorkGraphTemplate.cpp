@@ -0,0 +1,121 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "WorkGraphTemplate.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+WorkGraphTemplate::NodeId WorkGraphTemplate::addNode(TemplateWorkFunction work, const std::string& name,
+                                                     ExecutionType executionType, KindId kind) {
+    if (_finalized) {
+        throw std::logic_error("Cannot add nodes to a finalized WorkGraphTemplate");
+    }
+    _kernels.push_back(std::move(work));
+    _nodes.push_back(NodeSpec{static_cast<uint32_t>(_kernels.size() - 1), kind, name, executionType});
+    return static_cast<NodeId>(_nodes.size() - 1);
+}
+
+void WorkGraphTemplate::addDependency(NodeId from, NodeId to) {
+    if (_finalized) {
+        throw std::logic_error("Cannot add dependencies to a finalized WorkGraphTemplate");
+    }
+    if (from >= _nodes.size() || to >= _nodes.size()) {
+        throw std::invalid_argument("Invalid node id provided to WorkGraphTemplate::addDependency");
+    }
+    if (from == to) {
+        throw std::invalid_argument("Self-loops are not allowed in a WorkGraphTemplate");
+    }
+    _edges.emplace_back(from, to);
+}
+
+void WorkGraphTemplate::finalize() {
+    if (_finalized) {
+        return;
+    }
+
+    const uint32_t nodeCount = static_cast<uint32_t>(_nodes.size());
+
+    // Duplicates would double-count dependencies in every instance
+    std::sort(_edges.begin(), _edges.end());
+    _edges.erase(std::unique(_edges.begin(), _edges.end()), _edges.end());
+
+    // Edges are sorted by source, so the CSR rows fall out directly (still in NodeId space)
+    std::vector<uint32_t> offsets(nodeCount + 1, 0);
+    std::vector<uint32_t> inDegrees(nodeCount, 0);
+    for (const auto& [from, to] : _edges) {
+        offsets[from + 1]++;
+        inDegrees[to]++;
+    }
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    // Kahn's algorithm - the order doubles as the cycle check
+    std::vector<uint32_t> order;
+    order.reserve(nodeCount);
+    std::vector<uint32_t> remaining = inDegrees;
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        if (remaining[i] == 0) {
+            order.push_back(i);
+        }
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        uint32_t id = order[head];
+        for (uint32_t e = offsets[id]; e < offsets[id + 1]; ++e) {
+            uint32_t target = _edges[e].second;
+            if (--remaining[target] == 0) {
+                order.push_back(target);
+            }
+        }
+    }
+    if (order.size() != nodeCount) {
+        throw std::invalid_argument("WorkGraphTemplate contains a dependency cycle");
+    }
+
+    // Compact everything into topological order
+    _positionOf.assign(nodeCount, 0);
+    for (uint32_t pos = 0; pos < nodeCount; ++pos) {
+        _positionOf[order[pos]] = pos;
+    }
+
+    std::vector<NodeSpec> sortedNodes;
+    sortedNodes.reserve(nodeCount);
+    _edgeOffsets.assign(nodeCount + 1, 0);
+    _edgeTargets.clear();
+    _edgeTargets.reserve(_edges.size());
+    _initialInDegrees.assign(nodeCount, 0);
+    _roots.clear();
+
+    for (uint32_t pos = 0; pos < nodeCount; ++pos) {
+        uint32_t id = order[pos];
+        sortedNodes.push_back(std::move(_nodes[id]));
+        _initialInDegrees[pos] = inDegrees[id];
+        if (inDegrees[id] == 0) {
+            _roots.push_back(pos);
+        }
+        _edgeOffsets[pos] = static_cast<uint32_t>(_edgeTargets.size());
+        for (uint32_t e = offsets[id]; e < offsets[id + 1]; ++e) {
+            _edgeTargets.push_back(_positionOf[_edges[e].second]);
+        }
+    }
+    _edgeOffsets[nodeCount] = static_cast<uint32_t>(_edgeTargets.size());
+
+    _nodes = std::move(sortedNodes);
+    _edges.clear();
+    _edges.shrink_to_fit();
+    _finalized = true;
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,205 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file WorkGraphTemplate.h
+ * @brief Prebuilt, validated WorkGraph topology that can be stamped out many times
+ *
+ * Building a WorkGraph node by node pays for a cycle check on every edge and a lock
+ * round-trip on every call. When the same shape is built over and over (one per
+ * entity, one per frame, one per request) that work is identical each time. A
+ * WorkGraphTemplate does it once: nodes and edges are recorded, finalize() validates
+ * and topologically sorts them, and the result is compacted into flat arrays that
+ * WorkGraph::instantiate() copies into a live graph in a single pass.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "WorkGraphTypes.h"
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+class WorkGraph;
+
+/**
+ * @brief Reusable node/edge layout for WorkGraph::instantiate()
+ *
+ * Each template node carries a kernel that receives the per-instance context pointer
+ * passed to instantiate(), so one template serves every instance without rebuilding
+ * closures. Once finalized the template is immutable and may be instantiated from
+ * several threads at once.
+ *
+ * The template owns the kernels; instances call them by reference, so the template
+ * must outlive every graph instantiated from it.
+ *
+ * @code
+ * WorkGraphTemplate perEntity;
+ * auto anim    = perEntity.addNode([](void* e) { animate(static_cast<Entity*>(e)); }, "anim");
+ * auto physics = perEntity.addNode([](void* e) { simulate(static_cast<Entity*>(e)); }, "physics");
+ * auto sync    = perEntity.addNode([](void* e) { syncTransform(static_cast<Entity*>(e)); }, "sync");
+ * perEntity.addDependency(anim, sync);
+ * perEntity.addDependency(physics, sync);
+ * perEntity.finalize();  // Validates once
+ *
+ * for (auto& entity : entities) {
+ *     graph.instantiate(perEntity, &entity);  // O(nodes + edges), no validation
+ * }
+ * graph.execute();
+ * @endcode
+ */
+class WorkGraphTemplate {
+public:
+    using NodeId = uint32_t;                               ///< Index of a template node in insertion order
+    using TemplateWorkFunction = std::function<void(void*)>;  ///< Kernel invoked with the instance context
+    using KindId = uint32_t;                               ///< Stable id naming a node's kernel across builds, see WorkGraphTopology
+
+    static constexpr KindId NO_KIND = ~KindId(0);          ///< Node has a kernel but no stable id; cannot be serialized
+
+    WorkGraphTemplate() = default;
+    WorkGraphTemplate(const WorkGraphTemplate&) = delete;
+    WorkGraphTemplate& operator=(const WorkGraphTemplate&) = delete;
+    WorkGraphTemplate(WorkGraphTemplate&&) noexcept = default;
+    WorkGraphTemplate& operator=(WorkGraphTemplate&&) noexcept = default;
+
+    /**
+     * @brief Records a node in the template
+     * @param work Kernel run for every instance, called with that instance's context
+     * @param name Debug name copied into each instance
+     * @param executionType Where instances of this node run
+     * @param kind Id of the kernel, needed to save the topology and rebind it on load
+     * @return Id used for addDependency() and to index instantiate()'s result
+     * @throws std::logic_error If the template was already finalized
+     */
+    NodeId addNode(TemplateWorkFunction work, const std::string& name = "",
+                   ExecutionType executionType = ExecutionType::AnyThread, KindId kind = NO_KIND);
+
+    /**
+     * @brief Records that `to` waits for `from`
+     *
+     * Cycles are not checked here; finalize() rejects them all at once.
+     *
+     * @param from Node that runs first
+     * @param to Node that runs after
+     * @throws std::invalid_argument If an id is out of range or the edge is a self-loop
+     * @throws std::logic_error If the template was already finalized
+     */
+    void addDependency(NodeId from, NodeId to);
+
+    /**
+     * @brief Validates, sorts and compacts the template
+     *
+     * Removes duplicate edges, topologically sorts the nodes (Kahn's algorithm), and
+     * lays out fan-out lists, initial in-degrees and the root list as flat arrays in
+     * topological order. Calling it again is a no-op.
+     *
+     * @throws std::invalid_argument If the edges contain a cycle
+     */
+    void finalize();
+
+    /**
+     * @brief Checks whether instantiate() may use this template
+     * @return true after a successful finalize()
+     */
+    bool isFinalized() const noexcept { return _finalized; }
+
+    /**
+     * @brief Number of nodes each instance adds
+     * @return Template node count
+     */
+    size_t getNodeCount() const noexcept { return _bound ? _bound->kinds.size() : _nodes.size(); }
+
+    /**
+     * @brief Number of edges each instance adds (after de-duplication once finalized)
+     * @return Template edge count
+     */
+    size_t getEdgeCount() const noexcept { return _finalized ? edgeTargets().size() : _edges.size(); }
+
+    /**
+     * @brief Number of nodes with no dependencies
+     * @return Root count, or 0 before finalize()
+     */
+    size_t getRootCount() const noexcept { return roots().size(); }
+
+private:
+    friend class WorkGraph;
+    friend class WorkGraphTopology;
+
+    struct NodeSpec {
+        uint32_t kernel = 0;                              ///< Index into _kernels, shared by all instances
+        KindId kind = NO_KIND;                            ///< Stable kernel id for serialization
+        std::string name;                                 ///< Debug name
+        ExecutionType executionType = ExecutionType::AnyThread;
+    };
+
+    // Builder input, in insertion order; reordered into topological order by finalize()
+    std::vector<NodeSpec> _nodes;                         ///< Node specs (topological order once finalized)
+    std::vector<TemplateWorkFunction> _kernels;           ///< One per node when built here, one per kind when bound from a topology
+    std::vector<std::pair<NodeId, NodeId>> _edges;        ///< Raw edges as recorded, cleared by finalize()
+
+    /**
+     * @brief Layout read in place from a WorkGraphTopology image
+     *
+     * Set by WorkGraphTopology::bind() instead of filling the vectors above, so binding
+     * a large topology copies nothing per node. Kernels are indexed by kind.
+     */
+    struct BoundLayout {
+        std::shared_ptr<const void> image;                ///< Keeps the mapping or buffer alive
+        std::span<const uint32_t> edgeOffsets;
+        std::span<const uint32_t> edgeTargets;
+        std::span<const uint32_t> initialInDegrees;
+        std::span<const uint32_t> roots;
+        std::span<const uint32_t> positionOf;
+        std::span<const uint32_t> kinds;
+        std::span<const uint8_t> executionTypes;
+        std::span<const uint32_t> nameIds;
+        std::span<const uint32_t> nameOffsets;
+        const char* nameBytes = nullptr;
+    };
+
+    // Compacted layout - every index below is a topological position, not a NodeId
+    std::vector<uint32_t> _edgeOffsets;                   ///< CSR row starts, size nodes + 1
+    std::vector<uint32_t> _edgeTargets;                   ///< CSR fan-out targets
+    std::vector<uint32_t> _initialInDegrees;              ///< Dependency count each instance starts with
+    std::vector<uint32_t> _roots;                         ///< Positions with no dependencies
+    std::vector<uint32_t> _positionOf;                    ///< NodeId -> topological position
+    std::optional<BoundLayout> _bound;                    ///< Replaces _nodes and the vectors above when bound
+    bool _finalized = false;
+
+    // Readers go through these so built and bound templates look the same
+    std::span<const uint32_t> edgeOffsets() const { return _bound ? _bound->edgeOffsets : std::span<const uint32_t>(_edgeOffsets); }
+    std::span<const uint32_t> edgeTargets() const { return _bound ? _bound->edgeTargets : std::span<const uint32_t>(_edgeTargets); }
+    std::span<const uint32_t> initialInDegrees() const { return _bound ? _bound->initialInDegrees : std::span<const uint32_t>(_initialInDegrees); }
+    std::span<const uint32_t> roots() const { return _bound ? _bound->roots : std::span<const uint32_t>(_roots); }
+    std::span<const uint32_t> positionOf() const { return _bound ? _bound->positionOf : std::span<const uint32_t>(_positionOf); }
+    uint32_t kernelAt(uint32_t pos) const { return _bound ? _bound->kinds[pos] : _nodes[pos].kernel; }
+    KindId kindAt(uint32_t pos) const { return _bound ? _bound->kinds[pos] : _nodes[pos].kind; }
+    ExecutionType executionTypeAt(uint32_t pos) const {
+        return _bound ? static_cast<ExecutionType>(_bound->executionTypes[pos]) : _nodes[pos].executionType;
+    }
+    std::string_view nameAt(uint32_t pos) const {
+        if (!_bound) return _nodes[pos].name;
+        uint32_t id = _bound->nameIds[pos];
+        return {_bound->nameBytes + _bound->nameOffsets[id], _bound->nameOffsets[id + 1] - _bound->nameOffsets[id]};
+    }
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
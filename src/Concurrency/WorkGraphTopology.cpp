@@ -0,0 +1,420 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "WorkGraphTopology.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#if defined(EntropyWindows)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+namespace {
+    constexpr char FILE_MAGIC[8] = {'E', 'N', 'T', 'G', 'R', 'A', 'P', 'H'};
+    constexpr uint32_t BYTE_ORDER_TAG = 0x01020304;
+    constexpr size_t SECTION_ALIGNMENT = 8;
+
+    enum Section : size_t {
+        EdgeOffsets,
+        EdgeTargets,
+        InDegrees,
+        Roots,
+        PositionOf,
+        Kinds,
+        NameIds,
+        ExecutionTypes,
+        NameOffsets,
+        NameBytes,
+        SectionCount
+    };
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;                              ///< BYTE_ORDER_TAG as written by the saving machine
+        uint32_t nodeCount;
+        uint32_t edgeCount;
+        uint32_t rootCount;
+        uint32_t nameCount;
+        uint64_t nameBytesSize;
+        uint64_t totalBytes;
+        uint64_t sections[SectionCount];                 ///< Byte offset of each section from the start of the image
+    };
+
+    size_t alignUp(size_t value) {
+        return (value + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+    }
+
+    [[noreturn]] void invalid(const std::string& reason) {
+        throw std::runtime_error("WorkGraphTopology: " + reason);
+    }
+
+    template<typename T>
+    std::span<const T> section(const std::byte* data, const FileHeader& header, Section which, size_t count) {
+        uint64_t offset = header.sections[which];
+        if (offset % alignof(T) != 0 || offset > header.totalBytes ||
+            header.totalBytes - offset < static_cast<uint64_t>(count) * sizeof(T)) {
+            invalid("section " + std::to_string(static_cast<size_t>(which)) + " lies outside the image");
+        }
+        return {reinterpret_cast<const T*>(data + offset), count};
+    }
+}
+
+std::vector<std::byte> WorkGraphTopology::serialize(const WorkGraphTemplate& graphTemplate) {
+    if (!graphTemplate.isFinalized()) {
+        throw std::logic_error("WorkGraphTemplate must be finalized before it can be serialized");
+    }
+
+    const uint32_t nodeCount = static_cast<uint32_t>(graphTemplate.getNodeCount());
+    const auto edgeOffsets = graphTemplate.edgeOffsets();
+    const auto edgeTargets = graphTemplate.edgeTargets();
+    const auto inDegrees = graphTemplate.initialInDegrees();
+    const auto roots = graphTemplate.roots();
+    const auto positionOf = graphTemplate.positionOf();
+
+    // Intern names; graphs stamped from a few kinds repeat them heavily
+    std::unordered_map<std::string_view, uint32_t> nameIndex;
+    std::vector<std::string_view> names;
+    std::vector<uint32_t> nameIds(nodeCount);
+    std::vector<uint32_t> kinds(nodeCount);
+    std::vector<uint8_t> executionTypes(nodeCount);
+    uint64_t nameBytesSize = 0;
+    for (uint32_t pos = 0; pos < nodeCount; ++pos) {
+        std::string_view name = graphTemplate.nameAt(pos);
+        KindId kind = graphTemplate.kindAt(pos);
+        if (kind == WorkGraphTemplate::NO_KIND) {
+            throw std::invalid_argument("WorkGraphTopology: node '" + std::string(name) + "' has no kind id to bind it by");
+        }
+        auto [it, inserted] = nameIndex.try_emplace(name, static_cast<uint32_t>(names.size()));
+        if (inserted) {
+            names.push_back(name);
+            nameBytesSize += name.size();
+        }
+        nameIds[pos] = it->second;
+        kinds[pos] = kind;
+        executionTypes[pos] = static_cast<uint8_t>(graphTemplate.executionTypeAt(pos));
+    }
+    if (nameBytesSize > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("WorkGraphTopology: names exceed 4 GiB");
+    }
+    std::vector<uint32_t> nameOffsets(names.size() + 1, 0);
+    for (size_t i = 0; i < names.size(); ++i) {
+        nameOffsets[i + 1] = nameOffsets[i] + static_cast<uint32_t>(names[i].size());
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_TAG;
+    header.nodeCount = nodeCount;
+    header.edgeCount = static_cast<uint32_t>(edgeTargets.size());
+    header.rootCount = static_cast<uint32_t>(roots.size());
+    header.nameCount = static_cast<uint32_t>(names.size());
+    header.nameBytesSize = nameBytesSize;
+
+    const size_t sectionBytes[SectionCount] = {
+        edgeOffsets.size() * sizeof(uint32_t),
+        edgeTargets.size() * sizeof(uint32_t),
+        inDegrees.size() * sizeof(uint32_t),
+        roots.size() * sizeof(uint32_t),
+        positionOf.size() * sizeof(uint32_t),
+        kinds.size() * sizeof(uint32_t),
+        nameIds.size() * sizeof(uint32_t),
+        executionTypes.size(),
+        nameOffsets.size() * sizeof(uint32_t),
+        static_cast<size_t>(nameBytesSize)
+    };
+    size_t cursor = alignUp(sizeof(FileHeader));
+    for (size_t i = 0; i < SectionCount; ++i) {
+        header.sections[i] = cursor;
+        cursor = alignUp(cursor + sectionBytes[i]);
+    }
+    header.totalBytes = cursor;
+
+    std::vector<std::byte> image(cursor);
+    auto write = [&image, &header](Section which, const void* source, size_t bytes) {
+        if (bytes > 0) {
+            std::memcpy(image.data() + header.sections[which], source, bytes);
+        }
+    };
+    std::memcpy(image.data(), &header, sizeof(header));
+    write(EdgeOffsets, edgeOffsets.data(), sectionBytes[EdgeOffsets]);
+    write(EdgeTargets, edgeTargets.data(), sectionBytes[EdgeTargets]);
+    write(InDegrees, inDegrees.data(), sectionBytes[InDegrees]);
+    write(Roots, roots.data(), sectionBytes[Roots]);
+    write(PositionOf, positionOf.data(), sectionBytes[PositionOf]);
+    write(Kinds, kinds.data(), sectionBytes[Kinds]);
+    write(NameIds, nameIds.data(), sectionBytes[NameIds]);
+    write(ExecutionTypes, executionTypes.data(), sectionBytes[ExecutionTypes]);
+    write(NameOffsets, nameOffsets.data(), sectionBytes[NameOffsets]);
+    size_t nameCursor = header.sections[NameBytes];
+    for (const auto& name : names) {
+        std::memcpy(image.data() + nameCursor, name.data(), name.size());
+        nameCursor += name.size();
+    }
+    return image;
+}
+
+void WorkGraphTopology::save(const WorkGraphTemplate& graphTemplate, const std::string& path) {
+    auto image = serialize(graphTemplate);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    if (!file) {
+        throw std::runtime_error("WorkGraphTopology: cannot write '" + path + "'");
+    }
+}
+
+/// Owns the bytes behind a topology and every template bound from it
+struct WorkGraphTopology::Image {
+    std::vector<std::byte> owned;                        ///< Backing store for fromBytes()
+    void* mapping = nullptr;                             ///< Mapped base for open()
+    void* platformHandle = nullptr;                      ///< Mapping handle where the platform needs one
+    size_t mappedSize = 0;
+
+    Image() = default;
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
+
+    ~Image() {
+        if (mapping) {
+#if defined(EntropyWindows)
+            UnmapViewOfFile(mapping);
+            CloseHandle(static_cast<HANDLE>(platformHandle));
+#else
+            munmap(mapping, mappedSize);
+#endif
+        }
+    }
+};
+
+WorkGraphTopology WorkGraphTopology::fromBytes(std::vector<std::byte> bytes) {
+    WorkGraphTopology topology;
+    auto image = std::make_shared<Image>();
+    image->owned = std::move(bytes);
+    topology._image = image;
+    topology.adopt(image->owned.data(), image->owned.size());
+    return topology;
+}
+
+WorkGraphTopology WorkGraphTopology::open(const std::string& path) {
+    WorkGraphTopology topology;
+    auto image = std::make_shared<Image>();
+#if defined(EntropyWindows)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        invalid("cannot open '" + path + "'");
+    }
+    LARGE_INTEGER fileSize{};
+    GetFileSizeEx(file, &fileSize);
+    if (fileSize.QuadPart < static_cast<LONGLONG>(sizeof(FileHeader))) {
+        CloseHandle(file);
+        invalid("'" + path + "' is too small");
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    void* base = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!base) {
+        if (mapping) CloseHandle(mapping);
+        invalid("cannot map '" + path + "'");
+    }
+    image->mapping = base;
+    image->platformHandle = mapping;
+    size_t size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        invalid("cannot open '" + path + "'");
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        invalid("'" + path + "' is too small");
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        invalid("cannot map '" + path + "'");
+    }
+    image->mapping = base;
+#endif
+    image->mappedSize = size;
+    topology._image = image;
+    // On failure the image's destructor unmaps
+    topology.adopt(static_cast<const std::byte*>(base), size);
+    return topology;
+}
+
+void WorkGraphTopology::adopt(const std::byte* data, size_t size) {
+    _data = data;
+    _size = size;
+
+    if (size < sizeof(FileHeader)) {
+        invalid("image is too small");
+    }
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        invalid("not a graph topology image");
+    }
+    if (header.byteOrder != BYTE_ORDER_TAG) {
+        invalid("image was written with a different byte order");
+    }
+    if (header.version != FORMAT_VERSION) {
+        invalid("unsupported format version " + std::to_string(header.version));
+    }
+    if (header.totalBytes > size) {
+        invalid("image is truncated");
+    }
+
+    const uint32_t nodeCount = header.nodeCount;
+    _nodeCount = nodeCount;
+    _edgeCount = header.edgeCount;
+    _edgeOffsets = section<uint32_t>(data, header, EdgeOffsets, size_t(nodeCount) + 1);
+    _edgeTargets = section<uint32_t>(data, header, EdgeTargets, header.edgeCount);
+    _inDegrees = section<uint32_t>(data, header, InDegrees, nodeCount);
+    _roots = section<uint32_t>(data, header, Roots, header.rootCount);
+    _positionOf = section<uint32_t>(data, header, PositionOf, nodeCount);
+    _kinds = section<uint32_t>(data, header, Kinds, nodeCount);
+    _nameIds = section<uint32_t>(data, header, NameIds, nodeCount);
+    _executionTypes = section<uint8_t>(data, header, ExecutionTypes, nodeCount);
+    _nameOffsets = section<uint32_t>(data, header, NameOffsets, size_t(header.nameCount) + 1);
+    _nameBytes = reinterpret_cast<const char*>(section<char>(data, header, NameBytes, header.nameBytesSize).data());
+
+    // Every edge must point forward in topological order; that alone rules out cycles
+    if (_edgeOffsets[0] != 0 || _edgeOffsets[nodeCount] != header.edgeCount) {
+        invalid("edge offsets do not cover the edge list");
+    }
+    std::vector<uint32_t> seen(nodeCount, 0);
+    for (uint32_t pos = 0; pos < nodeCount; ++pos) {
+        if (_edgeOffsets[pos] > _edgeOffsets[pos + 1]) {
+            invalid("edge offsets are not monotonic");
+        }
+        for (uint32_t e = _edgeOffsets[pos]; e < _edgeOffsets[pos + 1]; ++e) {
+            uint32_t target = _edgeTargets[e];
+            if (target <= pos || target >= nodeCount) {
+                invalid("edge " + std::to_string(pos) + " -> " + std::to_string(target) + " is not in topological order");
+            }
+            seen[target]++;
+        }
+    }
+    uint32_t rootCount = 0;
+    for (uint32_t pos = 0; pos < nodeCount; ++pos) {
+        if (seen[pos] != _inDegrees[pos]) {
+            invalid("in-degree of node " + std::to_string(pos) + " does not match its edges");
+        }
+        rootCount += _inDegrees[pos] == 0 ? 1 : 0;
+        if (_nameIds[pos] >= header.nameCount || _executionTypes[pos] > static_cast<uint8_t>(ExecutionType::MainThread)) {
+            invalid("node " + std::to_string(pos) + " has an invalid name or execution type");
+        }
+    }
+    if (rootCount != _roots.size()) {
+        invalid("root list does not match the in-degrees");
+    }
+    for (size_t i = 0; i < _roots.size(); ++i) {
+        if (_roots[i] >= nodeCount || _inDegrees[_roots[i]] != 0 || (i > 0 && _roots[i] <= _roots[i - 1])) {
+            invalid("root list does not match the in-degrees");
+        }
+    }
+
+    // positionOf must be a permutation; reuse the counts as marks
+    std::fill(seen.begin(), seen.end(), 0);
+    for (uint32_t id = 0; id < nodeCount; ++id) {
+        uint32_t pos = _positionOf[id];
+        if (pos >= nodeCount || seen[pos]++ != 0) {
+            invalid("node id mapping is not a permutation");
+        }
+    }
+
+    if (_nameOffsets[0] != 0 || _nameOffsets[header.nameCount] != header.nameBytesSize) {
+        invalid("name offsets do not cover the name table");
+    }
+    for (uint32_t i = 0; i < header.nameCount; ++i) {
+        if (_nameOffsets[i] > _nameOffsets[i + 1]) {
+            invalid("name offsets are not monotonic");
+        }
+    }
+}
+
+WorkGraphTopology::WorkGraphTopology(WorkGraphTopology&& other) noexcept {
+    *this = std::move(other);
+}
+
+WorkGraphTopology& WorkGraphTopology::operator=(WorkGraphTopology&& other) noexcept {
+    if (this != &other) {
+        // The spans point into the image, which moves with the shared pointer
+        _image = std::move(other._image);
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _nodeCount = std::exchange(other._nodeCount, 0);
+        _edgeCount = std::exchange(other._edgeCount, 0);
+        _edgeOffsets = std::exchange(other._edgeOffsets, {});
+        _edgeTargets = std::exchange(other._edgeTargets, {});
+        _inDegrees = std::exchange(other._inDegrees, {});
+        _roots = std::exchange(other._roots, {});
+        _positionOf = std::exchange(other._positionOf, {});
+        _kinds = std::exchange(other._kinds, {});
+        _nameIds = std::exchange(other._nameIds, {});
+        _executionTypes = std::exchange(other._executionTypes, {});
+        _nameOffsets = std::exchange(other._nameOffsets, {});
+        _nameBytes = std::exchange(other._nameBytes, nullptr);
+    }
+    return *this;
+}
+
+WorkGraphTopology::~WorkGraphTopology() = default;
+
+bool WorkGraphTopology::isMapped() const noexcept {
+    return _image && _image->mapping != nullptr;
+}
+
+std::span<const uint32_t> WorkGraphTopology::getSuccessors(uint32_t position) const {
+    return _edgeTargets.subspan(_edgeOffsets[position], _edgeOffsets[position + 1] - _edgeOffsets[position]);
+}
+
+std::string_view WorkGraphTopology::getName(uint32_t position) const {
+    uint32_t id = _nameIds[position];
+    return {_nameBytes + _nameOffsets[id], _nameOffsets[id + 1] - _nameOffsets[id]};
+}
+
+WorkGraphTemplate WorkGraphTopology::bind(std::span<const WorkGraphTemplate::TemplateWorkFunction> kernels) const {
+    for (KindId kind : _kinds) {
+        if (kind >= kernels.size() || !kernels[kind]) {
+            throw std::invalid_argument("WorkGraphTopology: no kernel bound for kind " + std::to_string(kind));
+        }
+    }
+
+    WorkGraphTemplate bound;
+    bound._kernels.assign(kernels.begin(), kernels.end());
+    bound._bound = WorkGraphTemplate::BoundLayout{
+        _image, _edgeOffsets, _edgeTargets, _inDegrees, _roots, _positionOf,
+        _kinds, _executionTypes, _nameIds, _nameOffsets, _nameBytes
+    };
+    bound._finalized = true;
+    return bound;
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,183 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file WorkGraphTopology.h
+ * @brief Compact binary image of a finalized WorkGraphTemplate, loadable by memory mapping
+ *
+ * Large static graphs rebuilt through addNode()/addDependency() pay for a cycle check
+ * per edge and an allocation per node on every launch. WorkGraphTopology stores the
+ * already-validated, topologically sorted layout of a WorkGraphTemplate - CSR fan-out,
+ * in-degrees, roots, interned names and node kind ids - in one flat file that is mapped
+ * read-only at startup and bound to kernels by kind id.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "WorkGraphTemplate.h"
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief Read-only, position-independent view of a serialized graph topology
+ *
+ * The image is a header followed by 8-byte aligned arrays, all indexed by topological
+ * position as in WorkGraphTemplate:
+ *
+ * | Section        | Type     | Count      | Meaning                                   |
+ * |----------------|----------|------------|-------------------------------------------|
+ * | edgeOffsets    | uint32   | nodes + 1  | CSR row starts into edgeTargets           |
+ * | edgeTargets    | uint32   | edges      | Successor positions                       |
+ * | inDegrees      | uint32   | nodes      | Dependency count each instance starts with|
+ * | roots          | uint32   | roots      | Positions with no dependencies            |
+ * | positionOf     | uint32   | nodes      | Original NodeId -> position               |
+ * | kinds          | uint32   | nodes      | Kernel kind id per node                   |
+ * | nameIds        | uint32   | nodes      | Index into the interned name table        |
+ * | executionTypes | uint8    | nodes      | ExecutionType per node                    |
+ * | nameOffsets    | uint32   | names + 1  | Byte ranges into nameBytes                |
+ * | nameBytes      | char     | -          | Unique names, not terminated              |
+ *
+ * Files are native-endian; a byte-order tag in the header rejects foreign ones. Loading
+ * checks the header and, in O(nodes + edges) without allocating per node, that every
+ * edge points forward in topological order (so the graph is acyclic) and that the
+ * in-degrees and roots match the edges. Nothing else is rebuilt.
+ *
+ * @code
+ * // Offline, or on first launch
+ * WorkGraphTemplate tmpl;
+ * auto load = tmpl.addNode({}, "load", ExecutionType::AnyThread, LOAD_KIND);
+ * auto bake = tmpl.addNode({}, "bake", ExecutionType::AnyThread, BAKE_KIND);
+ * tmpl.addDependency(load, bake);
+ * tmpl.finalize();
+ * WorkGraphTopology::save(tmpl, "pipeline.egt");
+ *
+ * // At startup
+ * auto topology = WorkGraphTopology::open("pipeline.egt");
+ * std::vector<WorkGraphTemplate::TemplateWorkFunction> kernels(KIND_COUNT);
+ * kernels[LOAD_KIND] = [](void* ctx) { loadAsset(ctx); };
+ * kernels[BAKE_KIND] = [](void* ctx) { bakeAsset(ctx); };
+ * WorkGraphTemplate bound = topology.bind(kernels);
+ * graph.instantiate(bound, &asset);
+ * @endcode
+ */
+class WorkGraphTopology {
+public:
+    using KindId = WorkGraphTemplate::KindId;
+
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Serializes a finalized template
+     * @param graphTemplate Template whose nodes all carry a kind id
+     * @return The binary image
+     * @throws std::logic_error If the template is not finalized
+     * @throws std::invalid_argument If a node has no kind id
+     */
+    static std::vector<std::byte> serialize(const WorkGraphTemplate& graphTemplate);
+
+    /**
+     * @brief Serializes a finalized template to a file
+     * @throws std::runtime_error If the file cannot be written
+     * @see serialize()
+     */
+    static void save(const WorkGraphTemplate& graphTemplate, const std::string& path);
+
+    /**
+     * @brief Maps a topology file read-only
+     * @throws std::runtime_error If the file cannot be mapped or fails validation
+     */
+    static WorkGraphTopology open(const std::string& path);
+
+    /**
+     * @brief Takes ownership of an in-memory image
+     * @throws std::runtime_error If the image fails validation
+     */
+    static WorkGraphTopology fromBytes(std::vector<std::byte> bytes);
+
+    WorkGraphTopology(WorkGraphTopology&& other) noexcept;
+    WorkGraphTopology& operator=(WorkGraphTopology&& other) noexcept;
+    WorkGraphTopology(const WorkGraphTopology&) = delete;
+    WorkGraphTopology& operator=(const WorkGraphTopology&) = delete;
+    ~WorkGraphTopology();
+
+    /**
+     * @brief Builds a finalized template whose nodes run kernels[kind]
+     *
+     * The template reads the flat arrays and names in place and shares ownership of
+     * the image, so it may outlive this topology. Only the kernels are copied; no
+     * validation or sorting is repeated.
+     *
+     * @param kernels Kernel per kind id
+     * @return Template ready for WorkGraph::instantiate(); NodeIds match the saved template
+     * @throws std::invalid_argument If a kind used by the topology has no kernel
+     */
+    WorkGraphTemplate bind(std::span<const WorkGraphTemplate::TemplateWorkFunction> kernels) const;
+
+    size_t getNodeCount() const noexcept { return _nodeCount; }
+    size_t getEdgeCount() const noexcept { return _edgeCount; }
+    size_t getRootCount() const noexcept { return _roots.size(); }
+    size_t getNameCount() const noexcept { return _nameOffsets.empty() ? 0 : _nameOffsets.size() - 1; }
+
+    /// Start of the image, e.g. to copy it elsewhere
+    const std::byte* getBytes() const noexcept { return _data; }
+
+    /// Size of the image in bytes
+    size_t getByteSize() const noexcept { return _size; }
+
+    /// True when the image is a file mapping rather than heap memory
+    bool isMapped() const noexcept;
+
+    // Per-position accessors; positions are topological, see getPosition()
+    std::span<const uint32_t> getSuccessors(uint32_t position) const;
+    uint32_t getInDegree(uint32_t position) const { return _inDegrees[position]; }
+    KindId getKind(uint32_t position) const { return _kinds[position]; }
+    ExecutionType getExecutionType(uint32_t position) const { return static_cast<ExecutionType>(_executionTypes[position]); }
+    std::string_view getName(uint32_t position) const;
+    std::span<const uint32_t> getRoots() const { return _roots; }
+
+    /// Topological position of the saved template's NodeId
+    uint32_t getPosition(WorkGraphTemplate::NodeId id) const { return _positionOf[id]; }
+
+private:
+    struct Image;
+
+    WorkGraphTopology() = default;
+
+    void adopt(const std::byte* data, size_t size);
+
+    std::shared_ptr<Image> _image;                        ///< Mapping or buffer; shared with bound templates
+    const std::byte* _data = nullptr;
+    size_t _size = 0;
+
+    uint32_t _nodeCount = 0;
+    uint32_t _edgeCount = 0;
+    std::span<const uint32_t> _edgeOffsets;
+    std::span<const uint32_t> _edgeTargets;
+    std::span<const uint32_t> _inDegrees;
+    std::span<const uint32_t> _roots;
+    std::span<const uint32_t> _positionOf;
+    std::span<const uint32_t> _kinds;
+    std::span<const uint32_t> _nameIds;
+    std::span<const uint8_t> _executionTypes;
+    std::span<const uint32_t> _nameOffsets;
+    const char* _nameBytes = nullptr;
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -76,8 +76,9 @@ namespace Concurrency {
      * - Executing → Completed/Failed/Yielded (based on return value or exceptions)
      * - Yielded → Ready (for rescheduling)
      * - Any state → Cancelled (if parent fails)
+     * - Pending → Skipped (if every incoming edge was left untaken by a branch)
      * 
-     * Terminal states (Completed, Failed, Cancelled) are final - no further transitions.
+     * Terminal states (Completed, Failed, Cancelled, Skipped) are final - no further transitions.
      */
     enum class NodeState : uint8_t {
         Pending   = 0,  ///< Waiting for dependencies - can't run yet
@@ -87,7 +88,8 @@ namespace Concurrency {
         Completed = 4,  ///< Finished successfully - triggered children
         Failed    = 5,  ///< Exception thrown - children will be cancelled
         Cancelled = 6,  ///< Skipped due to parent failure - never ran
-        Yielded   = 7   ///< Suspended execution, will be rescheduled
+        Yielded   = 7,  ///< Suspended execution, will be rescheduled
+        Skipped   = 8   ///< On an untaken branch - never scheduled, never ran
     };
     
     /**
@@ -122,7 +124,7 @@ namespace Concurrency {
         Success = 0,    ///< Work function completed without throwing
         Failed = 1,     ///< Work function threw an exception
         Cancelled = 2,  ///< Never ran due to parent failure
-        Skipped = 3     ///< Skipped for other reasons (reserved for future use)
+        Skipped = 3     ///< Never ran because no branch leading to it was taken
     };
     
     /**
@@ -168,8 +170,8 @@ namespace Concurrency {
         /// Maximum deferred queue size (0 = unlimited) - prevents unbounded memory growth
         size_t maxDeferredNodes = 0;  // Unlimited by default
         
-        /// Maximum iterations when processing deferred nodes - controls how aggressively we fill capacity
-        /// Higher values ensure more aggressive filling of available capacity
+        /// No longer used: deferred nodes are admitted through the WorkContractGroup's
+        /// round-robin admission queue, one turn per freed slot. Kept for source compatibility.
         size_t maxDeferredProcessingIterations = 10;
         
         /// Enable debug logging - verbose output for troubleshooting
@@ -178,6 +180,9 @@ namespace Concurrency {
         /// Enable debug registration - makes graph visible in debug tools
         bool enableDebugRegistration = false;
         
+        /// Record per-node ready/start/end timestamps - required by WorkGraph::analyzeExecution()
+        bool enableTiming = false;
+        
         /// Use shared event bus instead of creating own - for system-wide event correlation
         std::shared_ptr<Core::EventBus> sharedEventBus = nullptr;
         
@@ -204,6 +209,7 @@ namespace Concurrency {
         std::atomic<uint32_t> completedNodes{0};     ///< Successfully finished nodes
         std::atomic<uint32_t> failedNodes{0};        ///< Nodes that threw exceptions
         std::atomic<uint32_t> cancelledNodes{0};     ///< Nodes skipped due to parent failure
+        std::atomic<uint32_t> skippedNodes{0};       ///< Nodes on untaken branches
         std::atomic<uint32_t> pendingNodes{0};       ///< Waiting for dependencies
         std::atomic<uint32_t> readyNodes{0};         ///< Ready but not yet scheduled
         std::atomic<uint32_t> scheduledNodes{0};     ///< In the work queue
@@ -225,6 +231,7 @@ namespace Concurrency {
             uint32_t completedNodes = 0;
             uint32_t failedNodes = 0;
             uint32_t cancelledNodes = 0;
+            uint32_t skippedNodes = 0;
             uint32_t pendingNodes = 0;
             uint32_t readyNodes = 0;
             uint32_t scheduledNodes = 0;
@@ -243,6 +250,7 @@ namespace Concurrency {
             snap.completedNodes = completedNodes.load(std::memory_order_relaxed);
             snap.failedNodes = failedNodes.load(std::memory_order_relaxed);
             snap.cancelledNodes = cancelledNodes.load(std::memory_order_relaxed);
+            snap.skippedNodes = skippedNodes.load(std::memory_order_relaxed);
             snap.pendingNodes = pendingNodes.load(std::memory_order_relaxed);
             snap.readyNodes = readyNodes.load(std::memory_order_relaxed);
             snap.scheduledNodes = scheduledNodes.load(std::memory_order_relaxed);
@@ -258,6 +266,7 @@ namespace Concurrency {
     using NodeCallback = std::function<void(NodeHandle)>;                ///< Callbacks that receive nodes
     using WorkFunction = std::function<void()>;                          ///< The actual work to execute (legacy)
     using YieldableWorkFunction = std::function<WorkResult()>;           ///< Work that can yield/suspend
+    using BranchWorkFunction = std::function<uint32_t()>;                ///< Work that picks which branch to take
     using CompletionCallback = std::function<void(ExecutionResult)>;     ///< Notified when work completes
     
     /**
@@ -272,7 +281,8 @@ namespace Concurrency {
     inline constexpr bool isTerminalState(NodeState state) {
         return state == NodeState::Completed || 
                state == NodeState::Failed || 
-               state == NodeState::Cancelled;
+               state == NodeState::Cancelled ||
+               state == NodeState::Skipped;
     }
     
     /**
@@ -299,7 +309,7 @@ namespace Concurrency {
         // Define valid transitions
         switch (from) {
             case NodeState::Pending:
-                return to == NodeState::Ready || to == NodeState::Cancelled;
+                return to == NodeState::Ready || to == NodeState::Cancelled || to == NodeState::Skipped;
                 
             case NodeState::Ready:
                 return to == NodeState::Scheduled || to == NodeState::Cancelled;
@@ -340,6 +350,7 @@ namespace Concurrency {
             case NodeState::Failed:    return "Failed";
             case NodeState::Cancelled: return "Cancelled";
             case NodeState::Yielded:   return "Yielded";
+            case NodeState::Skipped:   return "Skipped";
             default:                   return "Unknown";
         }
     }
@@ -6,27 +6,49 @@
 #include <cmath>
 #include <algorithm>
 #include <limits>
+#include <format>
 
 #include "WorkContractGroup.h"
 #include "AdaptiveRankingScheduler.h"
+#include "FiberWorker.h"
+#include "../Logging/Logger.h"
 
 namespace EntropyEngine {
 namespace Core {
 namespace Concurrency {
     thread_local size_t WorkService::stSoftFailureCount = 0;
     thread_local size_t WorkService::stThreadId = 0;
+    thread_local ScratchArena* WorkService::stScratchArena = nullptr;
+
+    namespace {
+        int64_t steadyNanoseconds() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+    }
 
     WorkService::WorkService(Config config, std::unique_ptr<IWorkScheduler> scheduler)
-        : _config(config) {
+        : _config(config)
+        , _maxSoftFailureCount(config.maxSoftFailureCount)
+        , _idleWaitTimeout(std::max<size_t>(config.idleWaitTimeout, 1)) {
 
-        // Always clamp to a range of 1 to hardware concurrency.
+        // Default to what the affinity mask and CPU quota let us run, then clamp to a range of 1 to hardware concurrency.
+        const CpuTopology& topology = CpuTopology::get();
         if (_config.threadCount == 0) {
-            _config.threadCount = std::thread::hardware_concurrency();
+            _config.threadCount = topology.getRecommendedWorkerCount();
         }
-        _config.threadCount = std::clamp(_config.threadCount, (uint32_t)1, std::thread::hardware_concurrency());
+        _config.threadCount = std::clamp(_config.threadCount, (uint32_t)1, std::max(std::thread::hardware_concurrency(), 1u));
 
-        // Update scheduler config with thread count
+        if (_config.useFibers && !FiberWorker::isSupported()) {
+            ENTROPY_LOG_WARNING_CAT("Concurrency", "WorkService: fiber mode is not supported on this platform, using plain worker threads");
+            _config.useFibers = false;
+        }
+
+        _workerCounters = std::make_unique<WorkerCounters[]>(_config.threadCount);
+
+        // Update scheduler config with thread count and placement
         _config.schedulerConfig.threadCount = _config.threadCount;
+        _config.schedulerConfig.locality = topology.planWorkers(_config.threadCount);
 
         // Create scheduler if not provided
         if (!scheduler) {
@@ -46,10 +68,23 @@ namespace Concurrency {
             return; // Already running
         }
 
+        _scratchArenas.clear();
+        for (uint32_t i = 0; i < _config.threadCount; i++) {
+            _scratchArenas.push_back(std::make_unique<ScratchArena>(_config.scratchChunkSize));
+        }
+
         for (uint32_t i = 0; i < _config.threadCount; i++) {
             _threads.emplace_back([this, threadId = i](const std::stop_token& stoken) {
                 stThreadId = threadId;
+                if (_config.pinWorkers) {
+                    uint32_t cpu = _config.schedulerConfig.locality.cpus[threadId];
+                    if (!CpuTopology::pinCurrentThread(cpu)) {
+                        ENTROPY_LOG_WARNING_CAT("Concurrency", "WorkService: could not pin worker " + std::to_string(threadId) + " to CPU " + std::to_string(cpu));
+                    }
+                }
+                stScratchArena = _scratchArenas[threadId].get();
                 executeWork(stoken);
+                stScratchArena = nullptr;
             });
         }
 
@@ -154,15 +189,53 @@ namespace Concurrency {
         return _config.threadCount;
     }
 
+    const WorkerLocality& WorkService::getWorkerLocality() const {
+        return _config.schedulerConfig.locality;
+    }
+
     size_t WorkService::getSoftFailureCount() const {
-        return _config.maxSoftFailureCount;
+        return _maxSoftFailureCount.load(std::memory_order_relaxed);
     }
 
     size_t WorkService::setSoftFailureCount(size_t softFailureCount) {
-        if (softFailureCount != _config.maxSoftFailureCount) {
-            _config.maxSoftFailureCount = softFailureCount;
+        _maxSoftFailureCount.store(softFailureCount, std::memory_order_relaxed);
+        return softFailureCount;
+    }
+
+    size_t WorkService::getIdleWaitTimeout() const {
+        return _idleWaitTimeout.load(std::memory_order_relaxed);
+    }
+
+    size_t WorkService::setIdleWaitTimeout(size_t idleWaitTimeout) {
+        idleWaitTimeout = std::max<size_t>(idleWaitTimeout, 1);
+        _idleWaitTimeout.store(idleWaitTimeout, std::memory_order_relaxed);
+        return idleWaitTimeout;
+    }
+
+    IWorkScheduler::Config WorkService::getSchedulerConfig() const {
+        std::lock_guard<std::mutex> lock(_tuningMutex);
+        return _config.schedulerConfig;
+    }
+
+    void WorkService::setSchedulerTuning(size_t maxConsecutiveExecutionCount, size_t updateCycleInterval) {
+        std::lock_guard<std::mutex> lock(_tuningMutex);
+        _config.schedulerConfig.maxConsecutiveExecutionCount = maxConsecutiveExecutionCount;
+        _config.schedulerConfig.updateCycleInterval = updateCycleInterval;
+        _scheduler->applyTuning(maxConsecutiveExecutionCount, updateCycleInterval);
+    }
+
+    std::vector<WorkService::WorkerStats> WorkService::getWorkerStats() const {
+        std::vector<WorkerStats> stats(_config.threadCount);
+        for (size_t i = 0; i < stats.size(); ++i) {
+            const auto& counters = _workerCounters[i];
+            stats[i].contractsExecuted = counters.contractsExecuted.load(std::memory_order_relaxed);
+            stats[i].selectionFailures = counters.selectionFailures.load(std::memory_order_relaxed);
+            stats[i].sleeps = counters.sleeps.load(std::memory_order_relaxed);
+            stats[i].wakeups = counters.wakeups.load(std::memory_order_relaxed);
+            stats[i].idleNanoseconds = counters.idleNanoseconds.load(std::memory_order_relaxed);
+            stats[i].wakeLatencyNanoseconds = counters.wakeLatencyNanoseconds.load(std::memory_order_relaxed);
         }
-        return _config.maxSoftFailureCount;
+        return stats;
     }
 
     size_t WorkService::getFailureSleepTime() const {
@@ -179,8 +252,60 @@ namespace Concurrency {
 
     void WorkService::executeWork(const std::stop_token& token) {
         WorkContractGroup* lastExecutedGroup = nullptr;
+        WorkerCounters& counters = _workerCounters[stThreadId];
+
+        // Counters have a single writer, so plain load + store avoids locked instructions
+        auto bump = [](std::atomic<uint64_t>& counter, uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        };
+
+        std::unique_ptr<FiberWorker> fibers;
+        if (_config.useFibers) {
+            // A fiber's wait condition coming true wakes us like new work does
+            fibers = std::make_unique<FiberWorker>(_config.fiberStackSize, _config.maxSuspendedFibers, [this]() {
+                {
+                    std::lock_guard<std::mutex> lock(_workAvailableMutex);
+                    _workAvailable = true;
+                }
+                _workAvailableCV.notify_all();
+            });
+        }
+        auto hasSuspendedFibers = [&fibers]() {
+            return fibers && fibers->getSuspendedCount() > 0;
+        };
+
+        // Suspended contracts may still point into the arena, so it only rewinds when none are left
+        auto rewindScratch = [&]() {
+            if (stScratchArena->bytesInUse() > 0 && !hasSuspendedFibers()) {
+                stScratchArena->reset();
+            }
+        };
+
+        // Suspended fibers hold contracts mid-execution, so after a stop request they get
+        // a bounded grace period to finish; whatever is still suspended then is abandoned
+        int64_t abandonFibersAt = 0;
+        while (true) {
+            if (token.stop_requested()) {
+                if (!hasSuspendedFibers()) {
+                    break;
+                }
+                int64_t now = steadyNanoseconds();
+                if (abandonFibersAt == 0) {
+                    abandonFibersAt = now + static_cast<int64_t>(_config.fiberStopTimeout) * 1000000;
+                } else if (now >= abandonFibersAt) {
+                    size_t abandoned = fibers->abandonSuspended();
+                    ENTROPY_LOG_WARNING_CAT("Concurrency", std::format("WorkService: abandoned {} suspended fibers on stop", abandoned));
+                    break;
+                }
+            }
+
+            // Read before the predicates are checked, so a notification racing with the
+            // checks still cuts the idle wait below short
+            uint64_t resumeEpoch = FiberWorker::getResumeEpoch();
+            if (fibers && fibers->resumeReady() > 0) {
+                stSoftFailureCount = 0;
+            }
 
-        while (!token.stop_requested()) {
             // Get current snapshot of groups with shared_lock (HOT PATH)
             std::vector<WorkContractGroup*> groupsSnapshot;
             {
@@ -191,9 +316,12 @@ namespace Concurrency {
             if (groupsSnapshot.empty()) {
                 // Wait on condition variable instead of sleeping
                 std::unique_lock<std::mutex> lock(_workAvailableMutex);
+                int64_t parkedAt = steadyNanoseconds();
                 _workAvailableCV.wait_for(lock, std::chrono::milliseconds(1), [this, &token]() {
                     return _workAvailable.load() || token.stop_requested();
                 });
+                bump(counters.sleeps, 1);
+                bump(counters.idleNanoseconds, static_cast<uint64_t>(steadyNanoseconds() - parkedAt));
                 continue;
             }
 
@@ -212,6 +340,7 @@ namespace Concurrency {
                 if (scheduleResult.group->isStopping()) {
                     // Group is paused, try another one
                     stSoftFailureCount++;
+                    bump(counters.selectionFailures, 1);
                     continue;
                 }
 
@@ -219,13 +348,14 @@ namespace Concurrency {
                 // Double-check the group isn't stopping right before we use it
                 if (scheduleResult.group->isStopping()) {
                     stSoftFailureCount++;
+                    bump(counters.selectionFailures, 1);
                     continue;
                 }
 
                 auto contract = scheduleResult.group->selectForExecution();
                 if (contract.valid()) {
                     // Check stop token again before executing work to prevent deadlocks during shutdown
-                    if (token.stop_requested()) {
+                    if (token.stop_requested() && !hasSuspendedFibers()) {
                         // Mark contract as completed even though we didn't execute it
                         // This properly transitions it from Executing to Free state
                         scheduleResult.group->completeExecution(contract);
@@ -233,13 +363,29 @@ namespace Concurrency {
                     }
 
                     // Execute the work
-                    scheduleResult.group->executeContract(contract);
-                    scheduleResult.group->completeExecution(contract);
+                    auto* group = scheduleResult.group;
+                    if (fibers && fibers->canStart()) {
+                        // Completion happens on the fiber, after any suspension inside the work;
+                        // an abandoned fiber still frees its slot so the group can drain
+                        fibers->execute([this, group, contract]() {
+                            group->executeContract(contract);
+                            group->completeExecution(contract);
+                            _scheduler->notifyWorkExecuted(group, stThreadId);
+                        }, [group, contract]() {
+                            group->completeExecution(contract);
+                        });
+                    } else {
+                        group->executeContract(contract);
+                        group->completeExecution(contract);
+                        _scheduler->notifyWorkExecuted(group, stThreadId);
+                    }
 
-                    // Notify scheduler of successful execution
-                    _scheduler->notifyWorkExecuted(scheduleResult.group, stThreadId);
+                    if (_config.scratchReset == ScratchResetPolicy::AfterEachContract) {
+                        rewindScratch();
+                    }
 
                     // Update tracking
+                    bump(counters.contractsExecuted, 1);
                     lastExecutedGroup = scheduleResult.group;
                     stSoftFailureCount = 0;
                     continue;
@@ -247,13 +393,37 @@ namespace Concurrency {
             }
 
             // No work found
-            if (scheduleResult.shouldSleep || stSoftFailureCount >= _config.maxSoftFailureCount) {
+            bump(counters.selectionFailures, 1);
+            if (_config.scratchReset != ScratchResetPolicy::Manual) {
+                rewindScratch();
+            }
+
+            // With fibers suspended, sleep until new work or notifyResumable(); their
+            // predicates were just checked, so there is nothing to poll in between
+            if (hasSuspendedFibers() || scheduleResult.shouldSleep ||
+                stSoftFailureCount >= _maxSoftFailureCount.load(std::memory_order_relaxed)) {
                 // Use condition variable for efficient waiting
                 std::unique_lock<std::mutex> lock(_workAvailableMutex);
                 _workAvailable = false;
-                _workAvailableCV.wait_for(lock, std::chrono::milliseconds(10), [this, &token]() {
-                    return _workAvailable.load() || token.stop_requested();
-                });
+                _parkedWorkers.fetch_add(1, std::memory_order_relaxed);
+                int64_t parkedAt = steadyNanoseconds();
+                bool notified = _workAvailableCV.wait_for(
+                    lock, std::chrono::microseconds(_idleWaitTimeout.load(std::memory_order_relaxed)),
+                    [this, &token, &fibers, &hasSuspendedFibers, resumeEpoch]() {
+                        // While stopping with fibers left, keep sleeping between notifications
+                        return _workAvailable.load() || (token.stop_requested() && !hasSuspendedFibers()) ||
+                               (fibers && FiberWorker::getResumeEpoch() != resumeEpoch);
+                    });
+                int64_t wokeAt = steadyNanoseconds();
+                _parkedWorkers.fetch_sub(1, std::memory_order_relaxed);
+
+                bump(counters.sleeps, 1);
+                bump(counters.idleNanoseconds, static_cast<uint64_t>(wokeAt - parkedAt));
+                int64_t notifiedAt = _lastNotifyTime.load(std::memory_order_relaxed);
+                if (notified && !token.stop_requested() && notifiedAt >= parkedAt) {
+                    bump(counters.wakeups, 1);
+                    bump(counters.wakeLatencyNanoseconds, static_cast<uint64_t>(std::max<int64_t>(wokeAt - notifiedAt, 0)));
+                }
                 stSoftFailureCount = 0;
             } else {
                 stSoftFailureCount++;
@@ -267,6 +437,9 @@ namespace Concurrency {
 
     void WorkService::notifyWorkAvailable(WorkContractGroup* group) {
         // We don't need to track which group has work, just that work is available
+        if (_parkedWorkers.load(std::memory_order_relaxed) > 0) {
+            _lastNotifyTime.store(steadyNanoseconds(), std::memory_order_relaxed);
+        }
         _workAvailable = true;
         _workAvailableCV.notify_one();
     }
@@ -289,6 +462,23 @@ namespace Concurrency {
         stThreadId = 0;
     }
     
+    ScratchArena& WorkService::scratch() {
+        if (stScratchArena) {
+            return *stScratchArena;
+        }
+        static thread_local ScratchArena threadArena;
+        return threadArena;
+    }
+
+    std::vector<ScratchArenaStats> WorkService::getScratchStats() const {
+        std::vector<ScratchArenaStats> stats;
+        stats.reserve(_scratchArenas.size());
+        for (const auto& arena : _scratchArenas) {
+            stats.push_back(arena->getStats());
+        }
+        return stats;
+    }
+    
     WorkService::MainThreadWorkResult WorkService::executeMainThreadWork(size_t maxContracts) {
         MainThreadWorkResult result{0, 0, false};
         
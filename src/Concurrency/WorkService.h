@@ -27,6 +27,7 @@
 #include <limits>
 #include "IWorkScheduler.h"
 #include "IConcurrencyProvider.h"
+#include "ScratchArena.h"
 
 namespace EntropyEngine {
 namespace Core {
@@ -110,6 +111,22 @@ public:
         bool moreWorkAvailable;      ///< Whether there's more work that could be executed
     };
     
+    /**
+     * @brief Activity counters of one worker thread
+     *
+     * Counters only grow; sample twice and subtract to get rates. Each worker updates its
+     * own cache line with relaxed stores, so a snapshot taken while running is not a
+     * consistent cut across fields.
+     */
+    struct WorkerStats {
+        uint64_t contractsExecuted = 0;          ///< Contracts the worker started
+        uint64_t selectionFailures = 0;          ///< Loop iterations that found no contract to run
+        uint64_t sleeps = 0;                     ///< Times the worker parked waiting for work
+        uint64_t wakeups = 0;                    ///< Parks ended by a work notification rather than the timeout
+        uint64_t idleNanoseconds = 0;            ///< Time spent parked
+        uint64_t wakeLatencyNanoseconds = 0;     ///< Sum over wakeups of the delay from notification to running
+    };
+
     /**
      * @brief Configuration parameters for the work service.
      *
@@ -118,9 +135,21 @@ public:
      * them based on your use case.
      */
     struct Config {
-        uint32_t threadCount = 0;                ///< Worker thread count - 0 means use all CPU cores
+        uint32_t threadCount = 0;                ///< Worker thread count - 0 means one per usable CPU (see CpuTopology::getRecommendedWorkerCount)
+        bool pinWorkers = false;                 ///< Pin each worker to the CPU CpuTopology::planWorkers() picked for it
         size_t maxSoftFailureCount = 5;         ///< Number of times work selection is allowed to fail before sleeping.  Yields after every failure.
         size_t failureSleepTime = 1;             ///< Sleep duration in nanoseconds when no work found - prevents CPU spinning
+        size_t idleWaitTimeout = 10000;          ///< Microseconds an idle worker parks before polling again; notifications wake it sooner
+
+        // Fiber mode (Linux only, ignored elsewhere)
+        bool useFibers = false;                  ///< Run contracts on fibers so blocking waits inside them suspend instead of parking the worker
+        size_t fiberStackSize = 256 * 1024;      ///< Usable stack bytes per fiber (one guard page is added below)
+        size_t maxSuspendedFibers = 64;          ///< Per worker; past this, new contracts run directly on the worker stack
+        size_t fiberStopTimeout = 100;           ///< Milliseconds a stopping worker waits for suspended fibers before abandoning them
+
+        // Per-worker scratch arenas (see scratch())
+        ScratchResetPolicy scratchReset = ScratchResetPolicy::AfterEachContract;  ///< When workers rewind their arena
+        size_t scratchChunkSize = ScratchArena::DEFAULT_CHUNK_SIZE;               ///< Initial arena chunk size per worker
 
         // Scheduler-specific configuration
         IWorkScheduler::Config schedulerConfig;   ///< Configuration passed to scheduler
@@ -131,7 +160,9 @@ public:
      *
      * The service is created in a stopped state. You must call start() to begin
      * executing work. Thread count is clamped to hardware concurrency, so asking
-     * for 1000 threads on an 8-core machine gets you 8 threads.
+     * for 1000 threads on an 8-core machine gets you 8 threads. The default (0)
+     * honours the affinity mask and cgroup CPU quota, so a 2-CPU container on a
+     * 64-core host gets 2 workers.
      *
      * Uses AdaptiveRankingScheduler by default if no scheduler is provided.
      *
@@ -141,7 +172,7 @@ public:
      * @code
      * // Use default adaptive ranking scheduler
      * WorkService::Config config;
-     * config.threadCount = 0;  // Use all CPU cores
+     * config.threadCount = 0;  // One worker per usable CPU
      * WorkService service(config);
      *
      * // Or provide a custom scheduler
@@ -177,7 +208,10 @@ public:
      * @brief Signals all worker threads to stop (non-blocking).
      *
      * Requests workers to stop without waiting. Returns immediately while
-     * workers complete their current contract before stopping.
+     * workers complete their current contract before stopping. In fiber mode a
+     * worker keeps resuming its suspended fibers for up to Config::fiberStopTimeout,
+     * then abandons the rest: their contracts are marked complete without finishing
+     * and whatever their stacks held is leaked (see FiberWorker::abandonSuspended()).
      *
      * @code
      * service.requestStop();  // Signal workers to stop (non-blocking)
@@ -301,9 +335,67 @@ public:
      */
     size_t getThreadCount() const;
 
+    /**
+     * @brief Planned CPU and cache domains of each worker
+     *
+     * Binding only with Config::pinWorkers; otherwise the OS may move workers.
+     *
+     * @code
+     * auto& locality = service.getWorkerLocality();
+     * for (size_t peer : locality.getNeighbours(0, CacheLevel::L3)) {
+     *     // peer shares worker 0's L3
+     * }
+     * @endcode
+     * @return Placement indexed by worker id
+     */
+    const WorkerLocality& getWorkerLocality() const;
+
     size_t getSoftFailureCount() const;
     size_t setSoftFailureCount(size_t softFailureCount);
 
+    /**
+     * @brief Gets how long an idle worker parks before polling again (in microseconds).
+     * @return Current park timeout
+     */
+    size_t getIdleWaitTimeout() const;
+
+    /**
+     * @brief Sets how long an idle worker parks before polling again; takes effect on the next park.
+     * @param idleWaitTimeout Timeout in microseconds, at least 1
+     * @return The timeout now in effect
+     */
+    size_t setIdleWaitTimeout(size_t idleWaitTimeout);
+
+    /**
+     * @brief Current scheduler configuration, including any tuning applied since construction
+     * @return Copy of the scheduler config
+     */
+    IWorkScheduler::Config getSchedulerConfig() const;
+
+    /**
+     * @brief Changes scheduler affinity and refresh settings while running
+     *
+     * Forwards to IWorkScheduler::applyTuning(); schedulers that do not use the values
+     * ignore them.
+     *
+     * @param maxConsecutiveExecutionCount New affinity length
+     * @param updateCycleInterval New refresh interval
+     */
+    void setSchedulerTuning(size_t maxConsecutiveExecutionCount, size_t updateCycleInterval);
+
+    /**
+     * @brief Activity counters of every worker
+     *
+     * @code
+     * auto before = service.getWorkerStats();
+     * std::this_thread::sleep_for(100ms);
+     * auto after = service.getWorkerStats();
+     * double idle = double(after[0].idleNanoseconds - before[0].idleNanoseconds) / 100e6;
+     * @endcode
+     * @return One entry per worker, indexed by worker id
+     */
+    std::vector<WorkerStats> getWorkerStats() const;
+
     bool isRunning() const;
 
     /**
@@ -392,6 +484,32 @@ public:
      */
     static void resetThreadLocalState();
 
+    /**
+     * @brief Gets the calling thread's scratch arena
+     *
+     * Inside a contract run by a worker this is the worker's own arena, rewound according
+     * to Config::scratchReset. While fibers are suspended on a worker its arena is not
+     * rewound, since their contracts may still hold scratch memory. Any other thread gets
+     * a thread-local arena that is never reset automatically.
+     *
+     * @return Arena owned by the calling thread
+     *
+     * @code
+     * group.createContract([&]() {
+     *     auto* indices = WorkService::scratch().allocateArray<uint32_t>(count);
+     *     buildIndices(indices, count);
+     *     upload(indices, count);
+     * });  // indices is reclaimed when the worker moves on
+     * @endcode
+     */
+    static ScratchArena& scratch();
+
+    /**
+     * @brief Usage counters of every worker's scratch arena
+     * @return One entry per worker thread, empty before start()
+     */
+    std::vector<ScratchArenaStats> getScratchStats() const;
+
 private:
     /**
      * @brief The main execution loop for worker threads - core of the work system
@@ -417,6 +535,12 @@ private:
      * This is private because it's the internal worker thread implementation.
      * Users interact with the system through WorkContractGroup and handles.
      *
+     * In fiber mode every contract runs on a pooled fiber and suspended fibers whose wait
+     * condition holds are resumed at the top of each iteration. An idle worker with
+     * suspended fibers sleeps until FiberWorker::notifyResumable() or new work wakes it.
+     * After a stop request the loop keeps running until no fiber is left suspended or
+     * Config::fiberStopTimeout passes, whichever comes first.
+     *
      * @param token Stop token for cooperative thread cancellation
      */
     void executeWork(const std::stop_token& token);
@@ -435,6 +559,31 @@ private:
     /// Provides a stable thread ID (0 to threadCount-1) for the lifetime of each worker thread.
     /// Thread-local because each thread needs its own unique, persistent identifier.
     static thread_local size_t stThreadId;
+
+    /// The worker's arena while it runs executeWork(), null on other threads
+    static thread_local ScratchArena* stScratchArena;
+
+    std::vector<std::unique_ptr<ScratchArena>> _scratchArenas;  ///< One per worker, outlive their threads for stats
+
+    /// Live counters behind WorkerStats, one cache line per worker
+    struct alignas(64) WorkerCounters {
+        std::atomic<uint64_t> contractsExecuted{0};
+        std::atomic<uint64_t> selectionFailures{0};
+        std::atomic<uint64_t> sleeps{0};
+        std::atomic<uint64_t> wakeups{0};
+        std::atomic<uint64_t> idleNanoseconds{0};
+        std::atomic<uint64_t> wakeLatencyNanoseconds{0};
+    };
+    std::unique_ptr<WorkerCounters[]> _workerCounters;         ///< Indexed by worker id
+
+    // Knobs that can change while workers run (see WorkServiceAutoTuner)
+    std::atomic<size_t> _maxSoftFailureCount;                   ///< Live Config::maxSoftFailureCount
+    std::atomic<size_t> _idleWaitTimeout;                       ///< Live Config::idleWaitTimeout
+    mutable std::mutex _tuningMutex;                            ///< Guards tuning writes to _config.schedulerConfig
+
+    // Wake latency measurement; notifications only stamp a time while someone is parked
+    std::atomic<size_t> _parkedWorkers{0};                      ///< Workers currently parked
+    std::atomic<int64_t> _lastNotifyTime{0};                    ///< steady_clock ns of the latest notification
 };
 
 } // Concurrency
@@ -0,0 +1,202 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+#include "WorkServiceAutoTuner.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+WorkServiceAutoTuner::WorkServiceAutoTuner(WorkService& service)
+    : WorkServiceAutoTuner(service, Config{}) {
+}
+
+WorkServiceAutoTuner::WorkServiceAutoTuner(WorkService& service, const Config& config)
+    : _service(service)
+    , _config(config) {
+}
+
+WorkServiceAutoTuner::~WorkServiceAutoTuner() {
+    stop();
+}
+
+void WorkServiceAutoTuner::start() {
+    if (_thread.joinable()) {
+        return;
+    }
+    _thread = std::jthread([this](std::stop_token token) {
+        while (!token.stop_requested()) {
+            step();
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wakeCV.wait_for(lock, token, _config.interval, []() { return false; });
+        }
+    });
+}
+
+void WorkServiceAutoTuner::stop() {
+    if (!_thread.joinable()) {
+        return;
+    }
+    _thread.request_stop();
+    _thread.join();
+    _thread = std::jthread();
+}
+
+WorkServiceAutoTuner::Observation WorkServiceAutoTuner::observe(
+    const std::vector<WorkService::WorkerStats>& stats,
+    std::chrono::steady_clock::time_point now) const {
+    Observation observation;
+    uint64_t idleNs = 0, failures = 0, wakeups = 0, wakeLatencyNs = 0;
+    for (size_t i = 0; i < stats.size() && i < _previousStats.size(); ++i) {
+        const auto& current = stats[i];
+        const auto& previous = _previousStats[i];
+        observation.contractsExecuted += current.contractsExecuted - previous.contractsExecuted;
+        observation.sleeps += current.sleeps - previous.sleeps;
+        failures += current.selectionFailures - previous.selectionFailures;
+        wakeups += current.wakeups - previous.wakeups;
+        idleNs += current.idleNanoseconds - previous.idleNanoseconds;
+        wakeLatencyNs += current.wakeLatencyNanoseconds - previous.wakeLatencyNanoseconds;
+    }
+
+    double elapsedNs = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - _previousTime).count());
+    double workerNs = elapsedNs * static_cast<double>(stats.size());
+    if (workerNs > 0.0) {
+        observation.idleFraction = std::clamp(static_cast<double>(idleNs) / workerNs, 0.0, 1.0);
+        double busySeconds = std::max(workerNs - static_cast<double>(idleNs), 0.0) / 1e9;
+        if (busySeconds > 0.0) {
+            observation.contractsPerBusyWorkerSecond =
+                static_cast<double>(observation.contractsExecuted) / busySeconds;
+        }
+    }
+    uint64_t attempts = failures + observation.contractsExecuted;
+    if (attempts > 0) {
+        observation.failureRatio = static_cast<double>(failures) / static_cast<double>(attempts);
+    }
+    if (wakeups > 0) {
+        observation.wakeLatency = std::chrono::nanoseconds(wakeLatencyNs / wakeups);
+    }
+    return observation;
+}
+
+void WorkServiceAutoTuner::record(std::vector<Decision>& decisions, const char* parameter,
+                                  size_t oldValue, size_t newValue, const std::string& reason) {
+    Decision decision{parameter, oldValue, newValue, reason};
+    if (_config.logDecisions) {
+        ENTROPY_LOG_INFO_CAT("Concurrency", "WorkServiceAutoTuner: " + decision.parameter + " " +
+                             std::to_string(oldValue) + " -> " + std::to_string(newValue) + " (" + reason + ")");
+    }
+    _history.push_back(decision);
+    while (_history.size() > HISTORY_LENGTH) {
+        _history.pop_front();
+    }
+    decisions.push_back(std::move(decision));
+}
+
+std::vector<WorkServiceAutoTuner::Decision> WorkServiceAutoTuner::step() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<Decision> decisions;
+
+    auto now = std::chrono::steady_clock::now();
+    auto stats = _service.getWorkerStats();
+    if (!_hasBaseline || stats.size() != _previousStats.size()) {
+        _previousStats = std::move(stats);
+        _previousTime = now;
+        _hasBaseline = true;
+        return decisions;
+    }
+
+    Observation observation = observe(stats, now);
+    _previousStats = std::move(stats);
+    _previousTime = now;
+    _lastObservation = observation;
+
+    bool wakesKnown = observation.wakeLatency.count() > 0;
+    bool wakesSlow = wakesKnown && observation.wakeLatency > _config.targetWakeLatency;
+    bool wakesVerySlow = wakesKnown && observation.wakeLatency > _config.targetWakeLatency * 4;
+    bool mostlyIdle = observation.idleFraction > _config.highIdleFraction;
+
+    // Spin budget: spinning longer before parking only pays when waking is expensive
+    size_t spin = _service.getSoftFailureCount();
+    size_t newSpin = spin;
+    std::string spinReason;
+    if (wakesSlow && observation.sleeps > 0) {
+        newSpin = spin * 2;
+        spinReason = "wake latency above target";
+    } else if (!wakesSlow && observation.failureRatio > _config.highFailureRatio) {
+        newSpin = spin / 2;
+        spinReason = "selections mostly failing";
+    }
+    newSpin = std::clamp(newSpin, _config.minSoftFailureCount, _config.maxSoftFailureCount);
+    if (newSpin != spin) {
+        _service.setSoftFailureCount(newSpin);
+        record(decisions, "softFailureCount", spin, newSpin, spinReason);
+    }
+
+    // Park timeout: idle workers can poll rarely as long as notifications reach them quickly
+    size_t wait = _service.getIdleWaitTimeout();
+    size_t newWait = wait;
+    std::string waitReason;
+    if (wakesVerySlow) {
+        newWait = wait / 2;
+        waitReason = "wake latency over 4x target";
+    } else if (mostlyIdle && !wakesSlow) {
+        newWait = wait * 2;
+        waitReason = "workers mostly idle";
+    }
+    newWait = std::clamp(newWait, _config.minIdleWaitTimeout, _config.maxIdleWaitTimeout);
+    if (newWait != wait) {
+        _service.setIdleWaitTimeout(newWait);
+        record(decisions, "idleWaitTimeout", wait, newWait, waitReason);
+    }
+
+    // Affinity: amortize selection over short contracts, rotate sooner between long ones
+    auto schedulerConfig = _service.getSchedulerConfig();
+    size_t consecutive = schedulerConfig.maxConsecutiveExecutionCount;
+    size_t newConsecutive = consecutive;
+    std::string consecutiveReason;
+    if (observation.contractsExecuted > 0) {
+        if (observation.contractsPerBusyWorkerSecond > _config.shortContractRate) {
+            newConsecutive = consecutive * 2;
+            consecutiveReason = "short contracts";
+        } else if (observation.contractsPerBusyWorkerSecond < _config.longContractRate) {
+            newConsecutive = consecutive / 2;
+            consecutiveReason = "long contracts";
+        }
+    }
+    newConsecutive = std::clamp(newConsecutive, _config.minConsecutiveExecutionCount,
+                                _config.maxConsecutiveExecutionCount);
+    if (newConsecutive != consecutive) {
+        size_t cycle = schedulerConfig.updateCycleInterval;
+        size_t newCycle = newConsecutive * 2;
+        _service.setSchedulerTuning(newConsecutive, newCycle);
+        record(decisions, "maxConsecutiveExecutionCount", consecutive, newConsecutive, consecutiveReason);
+        if (newCycle != cycle) {
+            record(decisions, "updateCycleInterval", cycle, newCycle, "follows maxConsecutiveExecutionCount");
+        }
+    }
+
+    return decisions;
+}
+
+WorkServiceAutoTuner::Observation WorkServiceAutoTuner::getLastObservation() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _lastObservation;
+}
+
+std::vector<WorkServiceAutoTuner::Decision> WorkServiceAutoTuner::getHistory() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return {_history.begin(), _history.end()};
+}
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -0,0 +1,188 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * Copyright (c) 2025 Jonathan "Geenz" Goodman
+ * This file is part of the Entropy Core project.
+ */
+
+/**
+ * @file WorkServiceAutoTuner.h
+ * @brief Online adjustment of WorkService and scheduler knobs from worker statistics
+ *
+ * This file contains WorkServiceAutoTuner, which samples WorkService::getWorkerStats()
+ * at a fixed interval and nudges the spin budget, the idle park timeout and the
+ * scheduler's affinity length within configured bounds.
+ */
+
+#pragma once
+
+#include "WorkService.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace EntropyEngine {
+namespace Core {
+namespace Concurrency {
+
+/**
+ * @brief Adjusts WorkService tuning knobs online instead of per deployment
+ *
+ * The right spin budget, park timeout and affinity length depend on the workload: tiny
+ * contracts want long affinity runs to amortize selection, long contracts want short ones
+ * for fairness; bursty producers want workers to spin a little before parking, steady idle
+ * services want them parked and polling rarely. The tuner observes the workers over each
+ * interval and applies one multiplicative step per knob when the evidence is clear:
+ *
+ * | Knob                          | Raised (x2) when                            | Lowered (/2) when                          |
+ * |-------------------------------|---------------------------------------------|--------------------------------------------|
+ * | soft failure count (spin)     | woken workers are slower than the target    | failed selections dominate, wakes are fast |
+ * | idle wait timeout             | workers are mostly idle, wakes are fast     | wakes take over 4x the target              |
+ * | maxConsecutiveExecutionCount  | contracts are short (high rate per worker)  | contracts are long (low rate per worker)   |
+ *
+ * updateCycleInterval follows maxConsecutiveExecutionCount at twice its value. Every
+ * change is clamped to the configured bounds, recorded in getHistory() and, unless
+ * disabled, logged under the "Concurrency" category.
+ *
+ * Run it in the background with start(), or call step() yourself from an existing
+ * update loop.
+ *
+ * @code
+ * WorkService service(config);
+ * service.start();
+ * WorkServiceAutoTuner tuner(service);
+ * tuner.start();
+ * // ...
+ * tuner.stop();
+ * service.stop();
+ * @endcode
+ */
+class WorkServiceAutoTuner {
+public:
+    /**
+     * @brief Sampling interval, bounds and thresholds
+     */
+    struct Config {
+        std::chrono::milliseconds interval{250};            ///< Time between steps when running in the background
+
+        size_t minSoftFailureCount = 1;                     ///< Lower bound for WorkService::setSoftFailureCount()
+        size_t maxSoftFailureCount = 64;                    ///< Upper bound for WorkService::setSoftFailureCount()
+        size_t minIdleWaitTimeout = 1000;                   ///< Lower bound for the park timeout, microseconds
+        size_t maxIdleWaitTimeout = 100000;                 ///< Upper bound for the park timeout, microseconds
+        size_t minConsecutiveExecutionCount = 1;            ///< Lower bound for scheduler affinity length
+        size_t maxConsecutiveExecutionCount = 64;           ///< Upper bound for scheduler affinity length
+
+        double highIdleFraction = 0.5;                      ///< Above this, workers count as mostly idle
+        double highFailureRatio = 0.9;                      ///< Failed selections per loop iteration that count as spinning
+        std::chrono::microseconds targetWakeLatency{50};    ///< Acceptable notification-to-running delay
+        double shortContractRate = 100000.0;                ///< Contracts per busy worker-second above which contracts are short
+        double longContractRate = 1000.0;                   ///< Contracts per busy worker-second below which contracts are long
+        bool logDecisions = true;                           ///< Log each change at info level
+    };
+
+    /**
+     * @brief What the workers did over the last interval
+     */
+    struct Observation {
+        double idleFraction = 0.0;                          ///< Share of worker time spent parked
+        double failureRatio = 0.0;                          ///< Failed selections over failed plus executed
+        std::chrono::nanoseconds wakeLatency{0};            ///< Mean notification-to-running delay; 0 if no wakeups
+        double contractsPerBusyWorkerSecond = 0.0;          ///< Contracts started per second of non-parked worker time
+        uint64_t contractsExecuted = 0;                     ///< Contracts started during the interval
+        uint64_t sleeps = 0;                                ///< Parks during the interval
+    };
+
+    /**
+     * @brief One knob change
+     */
+    struct Decision {
+        std::string parameter;                              ///< Knob name, e.g. "idleWaitTimeout"
+        size_t oldValue = 0;
+        size_t newValue = 0;
+        std::string reason;                                 ///< Which observation triggered it
+    };
+
+    /// Decisions kept by getHistory()
+    static constexpr size_t HISTORY_LENGTH = 64;
+
+    /**
+     * @brief Creates a tuner with default bounds
+     * @param service Service to observe and adjust; must outlive the tuner
+     */
+    explicit WorkServiceAutoTuner(WorkService& service);
+
+    /**
+     * @brief Creates a tuner with custom bounds
+     * @param service Service to observe and adjust; must outlive the tuner
+     * @param config Interval, bounds and thresholds
+     */
+    WorkServiceAutoTuner(WorkService& service, const Config& config);
+
+    ~WorkServiceAutoTuner();
+
+    WorkServiceAutoTuner(const WorkServiceAutoTuner&) = delete;
+    WorkServiceAutoTuner& operator=(const WorkServiceAutoTuner&) = delete;
+
+    /**
+     * @brief Starts stepping every Config::interval on a background thread
+     */
+    void start();
+
+    /**
+     * @brief Stops the background thread; knobs keep their current values
+     */
+    void stop();
+
+    bool isRunning() const { return _thread.joinable(); }
+
+    /**
+     * @brief Observes the interval since the previous step and applies adjustments
+     *
+     * The first call only records a baseline.
+     *
+     * @return Changes made by this step
+     */
+    std::vector<Decision> step();
+
+    /**
+     * @brief Observation behind the most recent step
+     */
+    Observation getLastObservation() const;
+
+    /**
+     * @brief Most recent decisions, oldest first, at most HISTORY_LENGTH
+     */
+    std::vector<Decision> getHistory() const;
+
+    const Config& getConfig() const { return _config; }
+
+private:
+    Observation observe(const std::vector<WorkService::WorkerStats>& stats,
+                        std::chrono::steady_clock::time_point now) const;
+    void record(std::vector<Decision>& decisions, const char* parameter,
+                size_t oldValue, size_t newValue, const std::string& reason);
+
+    WorkService& _service;
+    Config _config;
+
+    mutable std::mutex _mutex;                              ///< Serializes step() and guards the fields below
+    std::vector<WorkService::WorkerStats> _previousStats;   ///< Baseline for the next step
+    std::chrono::steady_clock::time_point _previousTime;
+    bool _hasBaseline = false;
+    Observation _lastObservation;
+    std::deque<Decision> _history;
+
+    std::condition_variable_any _wakeCV;                    ///< Lets stop() interrupt the interval wait
+    std::mutex _wakeMutex;
+    std::jthread _thread;
+};
+
+} // namespace Concurrency
+} // namespace Core
+} // namespace EntropyEngine
@@ -44,8 +44,19 @@
 // Concurrency
 #include "Concurrency/WorkContractHandle.h"
 #include "Concurrency/WorkContractGroup.h"
+#include "Concurrency/SharedWorkContractGroup.h"
 #include "Concurrency/WorkGraph.h"
+#include "Concurrency/WorkGraphTopology.h"
+#include "Concurrency/WorkGraphReport.h"
 #include "Concurrency/WorkService.h"
+#include "Concurrency/WorkServiceAutoTuner.h"
+#include "Concurrency/Pipeline.h"
+#include "Concurrency/FiberWorker.h"
+#include "Concurrency/AsyncIO.h"
+#include "Concurrency/Channel.h"
+#include "Concurrency/ScratchArena.h"
+#include "Concurrency/HugePageAllocator.h"
+#include "Concurrency/CpuTopology.h"
 #include "Concurrency/SignalTree.h"
 #include "Concurrency/IConcurrencyProvider.h"
 #include "Concurrency/IWorkScheduler.h"
@@ -53,4 +64,6 @@
 #include "Concurrency/SpinningDirectScheduler.h"
 #include "Concurrency/AdaptiveRankingScheduler.h"
 #include "Concurrency/RandomScheduler.h"
-#include "Concurrency/RoundRobinScheduler.h"
\ No newline at end of file
+#include "Concurrency/RoundRobinScheduler.h"
+#include "Concurrency/PartitionedScheduler.h"
+#include "Concurrency/CostAwareScheduler.h"
@@ -9,6 +9,11 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -95,19 +100,98 @@ namespace Graph {
         Node& operator=(const Node&) = delete;
     };
 
+    /**
+     * @brief Node array that never relocates its elements
+     *
+     * Nodes live in chunks that double in size (64, 128, 256, ...) behind a fixed
+     * directory, so appending allocates a new chunk instead of moving existing nodes.
+     * A pointer to a node's data therefore stays valid while the graph grows, and
+     * indexing never touches memory that an append rewrites - a thread may read a node
+     * it already holds a handle to while another thread appends under the owner's lock.
+     *
+     * @tparam T The node data type
+     */
+    template<class T>
+    class NodeStorage {
+        static constexpr uint32_t FIRST_CHUNK_SHIFT = 6;    ///< First chunk holds 64 nodes
+        static constexpr size_t MAX_CHUNKS = 32 - FIRST_CHUNK_SHIFT + 1; ///< Enough chunks for every uint32_t index
+
+        std::array<Node<T>*, MAX_CHUNKS> _chunks{};         ///< Chunk c holds 64 << c nodes; never moved once allocated
+        std::atomic<size_t> _size{0};                       ///< Constructed nodes, published after construction
+
+        static size_t chunkCapacity(size_t chunk) { return size_t(1) << (chunk + FIRST_CHUNK_SHIFT); }
+
+        static void locate(size_t index, size_t& chunk, size_t& offset) {
+            // Chunk c starts at 64 * (2^c - 1), so index + 64 has its top bit at c + 6
+            uint64_t biased = static_cast<uint64_t>(index) + (uint64_t(1) << FIRST_CHUNK_SHIFT);
+            chunk = static_cast<size_t>(std::bit_width(biased)) - 1 - FIRST_CHUNK_SHIFT;
+            offset = static_cast<size_t>(biased - (uint64_t(1) << (chunk + FIRST_CHUNK_SHIFT)));
+        }
+
+    public:
+        NodeStorage() = default;
+        NodeStorage(const NodeStorage&) = delete;
+        NodeStorage& operator=(const NodeStorage&) = delete;
+
+        ~NodeStorage() {
+            size_t count = _size.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < count; ++i) {
+                (*this)[i].~Node<T>();
+            }
+            for (size_t c = 0; c < MAX_CHUNKS; ++c) {
+                if (_chunks[c]) {
+                    ::operator delete(_chunks[c], std::align_val_t{alignof(Node<T>)});
+                }
+            }
+        }
+
+        /**
+         * @brief Appends a node; existing nodes stay where they are
+         * @param node Node to move in
+         * @return Reference to the stored node
+         */
+        Node<T>& emplace_back(Node<T>&& node) {
+            size_t index = _size.load(std::memory_order_relaxed);
+            size_t chunk, offset;
+            locate(index, chunk, offset);
+            if (!_chunks[chunk]) {
+                _chunks[chunk] = static_cast<Node<T>*>(::operator new(chunkCapacity(chunk) * sizeof(Node<T>),
+                                                                     std::align_val_t{alignof(Node<T>)}));
+            }
+            Node<T>* slot = ::new (static_cast<void*>(_chunks[chunk] + offset)) Node<T>(std::move(node));
+            _size.store(index + 1, std::memory_order_release);
+            return *slot;
+        }
+
+        size_t size() const { return _size.load(std::memory_order_acquire); }
+
+        Node<T>& operator[](size_t index) {
+            size_t chunk, offset;
+            locate(index, chunk, offset);
+            return _chunks[chunk][offset];
+        }
+
+        const Node<T>& operator[](size_t index) const {
+            size_t chunk, offset;
+            locate(index, chunk, offset);
+            return _chunks[chunk][offset];
+        }
+    };
+
     template<class T>
     /**
      * @brief Cache-friendly directed acyclic graph implementation
      *
-     * Manages dependencies between entities while preventing cycles. Uses contiguous
-     * storage for cache efficiency and generation-based handles for safe node references.
-     * Ideal for task scheduling, build systems, and dependency management.
+     * Manages dependencies between entities while preventing cycles. Nodes sit in
+     * chunked NodeStorage that never relocates them, so a pointer from getNodeData()
+     * stays valid while other nodes are added, and generation-based handles keep node
+     * references safe. Ideal for task scheduling, build systems, and dependency management.
      *
      * @tparam T The type of data to be stored in each node of the graph.
      */
     class DirectedAcyclicGraph {
         // Hot data - frequently accessed together
-        std::vector<Node<T>> _nodes;           ///< Contiguous storage for all graph nodes. Designed for cache efficiency.
+        NodeStorage<T> _nodes;                 ///< Chunked storage for all graph nodes. Growing never relocates existing nodes.
         std::vector<EdgeList> _edges;          ///< Simple edge storage per node for robustness.
         
         // Cold data - rarely accessed
@@ -121,7 +205,7 @@ namespace Graph {
         /**
          * @brief Constructs a new DirectedAcyclicGraph instance
          *
-         * Pre-allocates storage for 64 nodes to reduce initial reallocations.
+         * Pre-allocates edge storage for 64 nodes to reduce initial reallocations.
          *
          * @code
          * // Create a graph to store integer data
@@ -133,7 +217,6 @@ namespace Graph {
          * @endcode
          */
         DirectedAcyclicGraph() {
-            _nodes.reserve(64);
             _edges.reserve(64);
         }
 
@@ -299,10 +382,88 @@ namespace Graph {
             _edges[toIdx].incoming.push_back(fromIdx);
         }
 
+        /**
+         * @brief Adds a directed edge without the cycle check
+         *
+         * For callers that can prove acyclicity structurally - for example when
+         * `to` is a freshly added node with no outgoing edges yet. Skips the DFS
+         * that addEdge() performs, so bulk wiring stays linear in the number of
+         * edges. Duplicate edges are still ignored.
+         *
+         * @param from Source node handle
+         * @param to Destination node handle
+         * @return true if the edge was added, false if it already existed
+         * @throws std::invalid_argument If handles are invalid or form a self-loop
+         *
+         * @code
+         * auto parent = graph.addNode("Parent");
+         * auto fresh = graph.addNode("Fresh");
+         * graph.addEdgeUnchecked(parent, fresh);  // fresh has no edges, cannot cycle
+         * @endcode
+         */
+        bool addEdgeUnchecked(AcyclicNodeHandle<T> from, AcyclicNodeHandle<T> to) {
+            if (!isHandleValid(from) || !isHandleValid(to)) {
+                throw std::invalid_argument("Invalid handle provided to addEdgeUnchecked");
+            }
+
+            uint32_t fromIdx = from.getIndex();
+            uint32_t toIdx = to.getIndex();
+
+            if (fromIdx == toIdx) {
+                throw std::invalid_argument("Self-loops are not allowed in acyclic graph");
+            }
+
+            if (hasEdge(fromIdx, toIdx)) {
+                return false;
+            }
+
+            _edges[fromIdx].outgoing.push_back(toIdx);
+            _edges[toIdx].incoming.push_back(fromIdx);
+            return true;
+        }
+
+        /**
+         * @brief Appends a node's whole fan-out in one call, with no checks at all
+         *
+         * Meant for stamping out topology that was validated ahead of time (see
+         * WorkGraphTemplate): no cycle check, no duplicate check, no handle validation.
+         * The caller guarantees every index is live, distinct from `fromIndex`, and
+         * that the resulting graph is still acyclic.
+         *
+         * @param fromIndex Index of the source node
+         * @param toIndices Indices of the destination nodes, without duplicates
+         *
+         * @code
+         * std::vector<uint32_t> fanOut = {b.getIndex(), c.getIndex()};
+         * graph.addEdgesUnchecked(a.getIndex(), fanOut);
+         * @endcode
+         */
+        void addEdgesUnchecked(uint32_t fromIndex, std::span<const uint32_t> toIndices) {
+            auto& outgoing = _edges[fromIndex].outgoing;
+            outgoing.insert(outgoing.end(), toIndices.begin(), toIndices.end());
+            for (uint32_t toIdx : toIndices) {
+                _edges[toIdx].incoming.push_back(fromIndex);
+            }
+        }
+
+        /**
+         * @brief Reserves storage for at least `nodeCount` nodes
+         *
+         * Lets bulk insertion grow the edge array once instead of repeatedly.
+         * Node storage is chunked and never relocates, so existing handles and
+         * data pointers stay valid either way.
+         *
+         * @param nodeCount Total number of nodes the graph should hold without reallocating
+         */
+        void reserve(size_t nodeCount) {
+            _edges.reserve(nodeCount);
+        }
+
         /**
          * @brief Gets mutable pointer to node data
          *
-         * Returns nullptr if the handle is invalid.
+         * Returns nullptr if the handle is invalid. The pointer stays valid until
+         * the node is removed; adding other nodes never moves it.
          *
          * @param node Handle to the node
          * @return Pointer to the node's data, or nullptr if invalid